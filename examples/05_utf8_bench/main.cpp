@@ -0,0 +1,170 @@
+/**
+ * UTF-8 Microbenchmark
+ * 对比逐码点展开的旧实现与 SIMD 计数 / Utf8OffsetIndex 的性能
+ */
+
+#include "lite_utf8.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace liteDui;
+
+namespace legacy {
+
+// 以下为改造前的实现：每次调用都展开全部码点或从头扫描
+
+int getCharCount(const std::string& text) {
+    return static_cast<int>(Utf8Helper::toCodePoints(text).size());
+}
+
+int byteToCodePointIndex(const std::vector<Utf8Helper::CodePointInfo>& codePoints, int bytePos) {
+    for (size_t i = 0; i < codePoints.size(); ++i) {
+        if (codePoints[i].byteOffset == bytePos) return static_cast<int>(i);
+        if (codePoints[i].byteOffset > bytePos) return static_cast<int>(i > 0 ? i - 1 : 0);
+    }
+    return static_cast<int>(codePoints.size());
+}
+
+int utf8ByteToUtf16Index(const std::string& text, int bytePos) {
+    int utf16Index = 0;
+    int i = 0;
+    while (i < bytePos && i < static_cast<int>(text.length())) {
+        auto c = static_cast<unsigned char>(text[i]);
+        utf16Index += ((c & 0xF8) == 0xF0) ? 2 : 1;
+        i += Utf8Helper::getCharByteLength(c);
+    }
+    return utf16Index;
+}
+
+} // namespace legacy
+
+namespace {
+
+volatile size_t g_sink = 0;
+
+template <typename Fn>
+double measureMs(int iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        g_sink = g_sink + fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+void report(const char* name, double legacyMs, double newMs) {
+    std::printf("  %-28s legacy %10.4f ms   new %10.4f ms   x%.1f\n",
+                name, legacyMs, newMs, newMs > 0 ? legacyMs / newMs : 0.0);
+}
+
+std::string makeText(size_t bytes, int nonAsciiPercent, std::mt19937& rng) {
+    static const char* ascii[] = {"the ", "quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog. "};
+    static const char* wide[] = {"中文", "日本語", "한국어", "émigré ", "😀", "Ω≈ç"};
+    std::string text;
+    text.reserve(bytes + 16);
+    while (text.size() < bytes) {
+        if (static_cast<int>(rng() % 100) < nonAsciiPercent) {
+            text += wide[rng() % 6];
+        } else {
+            text += ascii[rng() % 8];
+        }
+    }
+    return text;
+}
+
+// 光标位置一定落在字符边界上
+std::vector<int> makeQueries(const std::string& text, size_t count, std::mt19937& rng) {
+    std::vector<int> queries;
+    queries.reserve(count);
+    while (queries.size() < count) {
+        int pos = static_cast<int>(rng() % (text.size() + 1));
+        while (pos < static_cast<int>(text.size()) &&
+               Utf8Helper::isContinuationByte(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+        queries.push_back(pos);
+    }
+    return queries;
+}
+
+void runSuite(const char* title, const std::string& text, std::mt19937& rng) {
+    std::printf("%s (%zu bytes)\n", title, text.size());
+    const int iterations = 50;
+    auto queries = makeQueries(text, 256, rng);
+
+    report("validate (vs toCodePoints)",
+           measureMs(iterations, [&] { return Utf8Helper::toCodePoints(text).size(); }),
+           measureMs(iterations, [&] { return static_cast<size_t>(Utf8Helper::validate(text)); }));
+
+    report("count code points",
+           measureMs(iterations, [&] { return static_cast<size_t>(legacy::getCharCount(text)); }),
+           measureMs(iterations, [&] { return Utf8Helper::countCodePoints(text.data(), text.size()); }));
+
+    report("utf16 length",
+           measureMs(iterations, [&] {
+               return static_cast<size_t>(legacy::utf8ByteToUtf16Index(text, static_cast<int>(text.size())));
+           }),
+           measureMs(iterations, [&] { return Utf8Helper::utf16Length(text.data(), text.size()); }));
+
+    // 256 次 字节 -> 码点 查询：旧实现每次展开码点并线性查找，新实现构建一次索引后二分查找
+    Utf8OffsetIndex index;
+    report("256x byte -> code point",
+           measureMs(2, [&] {
+               size_t sum = 0;
+               for (int q : queries) {
+                   auto codePoints = Utf8Helper::toCodePoints(text);
+                   sum += legacy::byteToCodePointIndex(codePoints, q);
+               }
+               return sum;
+           }),
+           measureMs(2, [&] {
+               index.build(text);
+               size_t sum = 0;
+               for (int q : queries) sum += index.byteToCodePoint(q);
+               return sum;
+           }));
+
+    report("256x byte -> utf16",
+           measureMs(2, [&] {
+               size_t sum = 0;
+               for (int q : queries) sum += legacy::utf8ByteToUtf16Index(text, q);
+               return sum;
+           }),
+           measureMs(2, [&] {
+               index.build(text);
+               size_t sum = 0;
+               for (int q : queries) sum += index.byteToUtf16(q);
+               return sum;
+           }));
+
+    // 校验两种实现结果一致
+    auto codePoints = Utf8Helper::toCodePoints(text);
+    index.build(text);
+    for (int q : queries) {
+        if (static_cast<size_t>(legacy::byteToCodePointIndex(codePoints, q)) != index.byteToCodePoint(q) ||
+            static_cast<size_t>(legacy::utf8ByteToUtf16Index(text, q)) != index.byteToUtf16(q)) {
+            std::printf("  MISMATCH at byte %d\n", q);
+            break;
+        }
+    }
+    std::printf("\n");
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(20240601);
+    const size_t sizes[] = {4 * 1024, 64 * 1024, 256 * 1024};
+    for (size_t bytes : sizes) {
+        char title[64];
+        std::snprintf(title, sizeof(title), "ASCII text, %zu KB", bytes / 1024);
+        runSuite(title, makeText(bytes, 0, rng), rng);
+        std::snprintf(title, sizeof(title), "Mixed CJK/emoji text, %zu KB", bytes / 1024);
+        runSuite(title, makeText(bytes, 40, rng), rng);
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * Text Truncate Check
+ * 单行快速路径截断检查：Clip 不为省略号预留宽度，保留所有放得下的字形；
+ * Ellipsis 的结果连同省略号不超过可用宽度；整行放得下时不截断。
+ */
+
+#include "lite_text_renderer.h"
+
+#include <cstdio>
+#include <string>
+
+using namespace liteDui;
+
+namespace {
+
+int g_failures = 0;
+
+void expect(bool condition, const char* what, const std::string& detail = std::string()) {
+    if (!condition) {
+        std::printf("  FAILED: %s %s\n", what, detail.c_str());
+        ++g_failures;
+    }
+}
+
+int glyphCount(const sk_sp<SkTextBlob>& blob) {
+    if (!blob) return 0;
+    int count = 0;
+    SkTextBlob::Iter iter(*blob);
+    SkTextBlob::Iter::Run run;
+    while (iter.next(&run)) {
+        count += run.fGlyphCount;
+    }
+    return count;
+}
+
+// 宽度 maxWidth 内能完整放下的字符数（文本为单字节字符，每个字符一个字形簇）
+int fittingClusters(const LiteShapedText& shaped, size_t length, float maxWidth) {
+    int count = 0;
+    for (size_t i = 1; i <= length; ++i) {
+        if (shaped.getXForOffset(i) > maxWidth) break;
+        count = static_cast<int>(i);
+    }
+    return count;
+}
+
+void checkWidth(const LiteShapedText& shaped, size_t length, float maxWidth) {
+    std::string label = "width " + std::to_string(maxWidth);
+
+    float clipWidth = 0.0f;
+    auto clip = shaped.makeTruncatedBlob(maxWidth, false, &clipWidth);
+    int expected = fittingClusters(shaped, length, maxWidth);
+    expect(glyphCount(clip) == expected, "clip keeps every glyph that fits",
+           label + ": " + std::to_string(glyphCount(clip)) + " of " + std::to_string(expected));
+    expect(clipWidth <= maxWidth, "clip width", label + ": " + std::to_string(clipWidth));
+    expect(clipWidth == shaped.getXForOffset(expected), "clip width at cluster boundary", label);
+
+    float ellipsisWidth = 0.0f;
+    auto ellipsis = shaped.makeTruncatedBlob(maxWidth, true, &ellipsisWidth);
+    if (ellipsis) {
+        expect(ellipsisWidth <= maxWidth, "ellipsis width", label + ": " + std::to_string(ellipsisWidth));
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::string text = "The quick brown fox jumps over the lazy dog 0123456789";
+    FontSpec font;
+    font.fontSize = 14.0f;
+
+    auto shaped = LiteTextRenderer::getInstance().shape(text, font);
+    if (!shaped || !shaped->getBlob()) {
+        std::printf("no font available, skipped\n");
+        return 0;
+    }
+
+    float fullWidth = shaped->getWidth();
+    for (float width = 1.0f; width < fullWidth + 10.0f; width += 0.75f) {
+        checkWidth(*shaped, text.size(), width);
+    }
+
+    // 整行放得下时返回完整文本
+    float width = 0.0f;
+    auto full = shaped->makeTruncatedBlob(fullWidth, false, &width);
+    expect(glyphCount(full) == static_cast<int>(text.size()) && width == fullWidth, "full line fits");
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,193 @@
+/**
+ * lite_cell_renderer.h - 表格单元格渲染器
+ *
+ * 默认情况下单元格按文本绘制（经过整形缓存）。监控类表格的大部分单元格是
+ * 数字、百分比或状态，这里提供不需要文本整形的渲染器：
+ * - LiteNumberCellRenderer：数值格式化后用缓存的 ASCII 字形表直接生成字形串
+ * - LiteProgressBarCellRenderer：单元格内进度条
+ * - LiteSparklineCellRenderer：由一组数值绘制迷你折线图
+ * - LiteStatusDotCellRenderer：彩色状态圆点（可附带状态文本）
+ *
+ * 渲染器通过 LiteTable::setColumnRenderer 按列设置，只在 UI 线程调用。
+ */
+
+#pragma once
+
+#include "lite_common.h"
+#include "lite_font_manager.h"
+#include "lite_table_model.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SkCanvas;
+
+namespace liteDui {
+
+/**
+ * 单元格绘制参数
+ */
+struct CellRenderContext {
+    const LiteTableModel* model = nullptr;
+    size_t row = 0;            // 模型行
+    size_t col = 0;            // 模型列
+    float x = 0, y = 0;        // 单元格左上角（内容坐标）
+    float width = 0, height = 0;
+    float padding = 0;         // 水平内边距
+    FontSpec font;
+    Color textColor;           // 已合并单元格样式的文本颜色
+    TextAlign align = TextAlign::Left;
+    bool selected = false;
+};
+
+/**
+ * LiteCellRenderer - 单元格渲染器接口
+ */
+class LiteCellRenderer {
+public:
+    virtual ~LiteCellRenderer() = default;
+
+    /**
+     * 绘制单元格内容（背景已由表格绘制）
+     */
+    virtual void draw(SkCanvas* canvas, const CellRenderContext& context) = 0;
+
+    /**
+     * 是否绘制整形文本；为 false 时表格的行预取跳过该列
+     */
+    virtual bool usesShapedText() const { return false; }
+};
+
+using LiteCellRendererPtr = std::shared_ptr<LiteCellRenderer>;
+
+/**
+ * LiteNumericText - 数值文本快速绘制
+ *
+ * 每种字体缓存一张可打印 ASCII 字符的字形与步进表，数值字符串直接映射为
+ * 字形串，不经过整形与整形缓存（数值频繁变化时缓存几乎不会命中）。
+ * 不做字距调整，数字在常见字体中等宽，对齐效果与整形结果一致。
+ */
+class LiteNumericText {
+public:
+    /**
+     * 测量宽度；含表外字符（非 ASCII 或字体缺字）时返回 false
+     */
+    static bool measure(const char* text, size_t length, const FontSpec& font, float& width);
+
+    /**
+     * 在矩形内垂直居中绘制
+     * @return 含表外字符或宽度不足时返回 false（未绘制），由调用方回退到普通文本绘制
+     */
+    static bool draw(SkCanvas* canvas, const char* text, size_t length, const FontSpec& font,
+                     const Color& color, float x, float y, float width, float height,
+                     TextAlign align = TextAlign::Right);
+
+    /**
+     * 清空字形表；LiteFontManager 的字体版本变化时会自动清空
+     */
+    static void clearCache();
+};
+
+/**
+ * LiteNumberCellRenderer - 数值单元格
+ */
+class LiteNumberCellRenderer : public LiteCellRenderer {
+public:
+    struct Format {
+        int decimals = 2;                 // 小数位数
+        bool thousandsSeparator = false;  // 整数部分每三位加逗号
+        double scale = 1.0;               // 显示前乘以该系数（如 100 显示百分数）
+        std::string prefix;               // 前缀，如 "$"
+        std::string suffix;               // 后缀，如 "%"
+        Color negativeColor = Color::Transparent();   // 负数颜色，透明表示使用文本颜色
+    };
+
+    LiteNumberCellRenderer() = default;
+    explicit LiteNumberCellRenderer(const Format& format) : m_format(format) {}
+
+    void setFormat(const Format& format) { m_format = format; }
+    const Format& getFormat() const { return m_format; }
+
+    void draw(SkCanvas* canvas, const CellRenderContext& context) override;
+
+    /**
+     * 格式化数值，返回写入的字节数（不含结尾 '\0'）
+     */
+    static size_t format(double value, const Format& format, char* buffer, size_t size);
+
+private:
+    Format m_format;
+};
+
+/**
+ * LiteProgressBarCellRenderer - 单元格内进度条
+ */
+class LiteProgressBarCellRenderer : public LiteCellRenderer {
+public:
+    LiteProgressBarCellRenderer(double minimum = 0.0, double maximum = 100.0)
+        : m_minimum(minimum), m_maximum(maximum) {}
+
+    void setRange(double minimum, double maximum) { m_minimum = minimum; m_maximum = maximum; }
+    void setBarColor(const Color& color) { m_barColor = color; }
+    void setTrackColor(const Color& color) { m_trackColor = color; }
+    void setBarHeight(float height) { m_barHeight = height; }   // 0 表示按行高自动
+    void setShowLabel(bool show) { m_showLabel = show; }        // 在进度条上显示百分比
+
+    void draw(SkCanvas* canvas, const CellRenderContext& context) override;
+
+private:
+    double m_minimum;
+    double m_maximum;
+    Color m_barColor = Color::fromRGB(66, 133, 244);
+    Color m_trackColor = Color::fromRGB(230, 230, 230);
+    float m_barHeight = 0.0f;
+    bool m_showLabel = true;
+};
+
+/**
+ * LiteSparklineCellRenderer - 迷你折线图
+ *
+ * 数据来自 LiteTableModel::getCellSeries，按单元格内的最小/最大值缩放。
+ * 点数超过像素宽度时按像素列保留最小/最大值，不丢失尖峰。
+ */
+class LiteSparklineCellRenderer : public LiteCellRenderer {
+public:
+    void setLineColor(const Color& color) { m_lineColor = color; }
+    void setLineWidth(float width) { m_lineWidth = width; }
+    void setFillColor(const Color& color) { m_fillColor = color; }   // 透明表示不填充
+    void setShowLastPoint(bool show) { m_showLastPoint = show; }
+
+    void draw(SkCanvas* canvas, const CellRenderContext& context) override;
+
+private:
+    Color m_lineColor = Color::fromRGB(66, 133, 244);
+    Color m_fillColor = Color::Transparent();
+    float m_lineWidth = 1.5f;
+    bool m_showLastPoint = true;
+    std::vector<double> m_series;   // 复用的缓冲区
+};
+
+/**
+ * LiteStatusDotCellRenderer - 状态圆点
+ *
+ * 按单元格文本查找颜色，未登记的状态使用默认颜色。
+ */
+class LiteStatusDotCellRenderer : public LiteCellRenderer {
+public:
+    void setStatusColor(const std::string& status, const Color& color) { m_colors[status] = color; }
+    void setDefaultColor(const Color& color) { m_defaultColor = color; }
+    void setRadius(float radius) { m_radius = radius; }
+    void setShowText(bool show) { m_showText = show; }   // 在圆点右侧显示状态文本
+
+    void draw(SkCanvas* canvas, const CellRenderContext& context) override;
+    bool usesShapedText() const override { return m_showText; }
+
+private:
+    std::unordered_map<std::string, Color> m_colors;
+    Color m_defaultColor = Color::fromRGB(158, 158, 158);
+    float m_radius = 4.0f;
+    bool m_showText = true;
+};
+
+} // namespace liteDui
@@ -0,0 +1,205 @@
+/**
+ * lite_columnar_table_model.h - 列式表格模型
+ *
+ * 按列连续存储带类型的数据，供大数据量表格使用：
+ * - Int64 / Double / Timestamp 列直接存放数值（每格 8 字节）
+ * - String 列做字典编码，单元格只存 32 位编号，重复字符串只保存一份
+ * - 单元格颜色为稀疏覆盖，不占用普通单元格的空间
+ * - 只在绘制可见单元格时才格式化为文本（可按列自定义格式化函数）
+ *
+ * 排序、筛选、聚合等扫描可以直接遍历列数组（见 getInt64Data 等）。
+ */
+
+#pragma once
+
+#include "lite_table_model.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * 列数据类型
+ */
+enum class ColumnType {
+    Int64,
+    Double,
+    Timestamp,   // 自 1970-01-01 UTC 起的毫秒数，按本地时间显示
+    String       // 字典编码字符串
+};
+
+/**
+ * 单元格值的只读视图
+ */
+struct ColumnValue {
+    ColumnType type = ColumnType::Int64;
+    bool isNull = false;
+    int64_t intValue = 0;                       // Int64 / Timestamp
+    double doubleValue = 0.0;                   // Double
+    const std::string* stringValue = nullptr;   // String（指向列字典，模型修改前有效）
+};
+
+/**
+ * 一批行的列数据（用于 appendBlock），各数组长度均为批内行数，按列类型只填写对应数组
+ */
+struct ColumnBlock {
+    std::vector<int64_t> ints;             // Int64 / Timestamp
+    std::vector<double> doubles;           // Double
+    std::vector<uint32_t> codes;           // String：批内字典编号（globalCodes 时为列字典编号）
+    std::vector<std::string> dictionary;   // String：批内字典（globalCodes 时为列字典新增的项）
+    std::vector<uint8_t> present;          // 每行 1 表示有值，0 表示 null
+
+    // String：编号已由调用方（如在后台去重的加载器）换成列字典编号，dictionary[0] 的编号为
+    // dictionaryBase，应等于追加前列字典的大小；模型只追加这些项，不逐项查找
+    bool globalCodes = false;
+    uint32_t dictionaryBase = 0;
+};
+
+/**
+ * LiteColumnarTableModel - 列式表格模型
+ */
+class LiteColumnarTableModel : public LiteTableModel {
+public:
+    // 单元格格式化函数，只对可见单元格调用
+    using Formatter = std::function<std::string(const ColumnValue& value)>;
+
+    LiteColumnarTableModel() = default;
+
+    // LiteTableModel
+    size_t getRowCount() const override { return m_rowCount; }
+    size_t getColumnCount() const override { return m_columns.size(); }
+    std::string getCellText(size_t row, size_t col) const override;
+    TableCellStyle getCellStyle(size_t row, size_t col) const override;
+    // 数值列直接拷贝，字符串列以字典编码提供
+    using LiteTableModel::getSortColumn;
+    void getSortColumn(size_t col, size_t first, size_t count, TableSortColumn& out) const override;
+    // 数值列直接返回存储的值
+    bool getCellNumber(size_t row, size_t col, double& value) const override;
+
+    // ==================== 列 ====================
+
+    /**
+     * 添加列，已有行以 null 填充
+     * @return 列索引
+     */
+    size_t addColumn(const std::string& name, ColumnType type);
+    const std::string& getColumnName(size_t col) const { return m_columns[col].name; }
+    ColumnType getColumnType(size_t col) const { return m_columns[col].type; }
+
+    /**
+     * 设置列格式化函数，传入空函数恢复默认格式
+     */
+    void setFormatter(size_t col, Formatter formatter);
+
+    // ==================== 行与单元格 ====================
+
+    void reserve(size_t rows);
+
+    /**
+     * 追加一行（所有列为 null），返回行号
+     */
+    size_t appendRow();
+
+    /**
+     * 批量追加 rowCount 行，blocks 与列一一对应（缺少的列为 null）
+     * 只发出一次插入通知；批内字典按项合并到列字典，不逐行查找
+     * blocks 按值传入，调用方可移入以免复制字典字符串
+     * @return 第一行的行号
+     */
+    size_t appendBlock(std::vector<ColumnBlock> blocks, size_t rowCount);
+
+    /**
+     * 清空所有行与字典（保留列定义）
+     */
+    void clear();
+
+    void setInt64(size_t row, size_t col, int64_t value);
+    void setDouble(size_t row, size_t col, double value);
+    void setTimestamp(size_t row, size_t col, int64_t millis);
+    void setString(size_t row, size_t col, const std::string& value);
+    void setNull(size_t row, size_t col);
+
+    ColumnValue getValue(size_t row, size_t col) const;
+    bool isNull(size_t row, size_t col) const;
+
+    /**
+     * 批量修改：期间不发出变化通知，结束时合并为一次通知
+     * 可嵌套，最外层 endUpdate 时通知
+     */
+    void beginUpdate();
+    void endUpdate();
+
+    // ==================== 稀疏样式覆盖 ====================
+
+    void setCellStyle(size_t row, size_t col, const TableCellStyle& style);
+    void clearCellStyle(size_t row, size_t col);
+    void clearCellStyles();
+
+    // ==================== 列数据直接访问（用于扫描） ====================
+
+    // Int64 / Timestamp 列
+    const std::vector<int64_t>& getInt64Data(size_t col) const { return m_columns[col].ints; }
+    // Double 列
+    const std::vector<double>& getDoubleData(size_t col) const { return m_columns[col].doubles; }
+    // String 列：每行的字典编号与字典本身
+    const std::vector<uint32_t>& getStringCodes(size_t col) const { return m_columns[col].codes; }
+    const std::deque<std::string>& getDictionary(size_t col) const { return m_columns[col].dictionary; }
+
+    /**
+     * 估算数据占用的内存（字节，不含 std::vector 的预留空间）
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    struct Column {
+        // 禁止拷贝：拷贝后索引仍指向原字典（vector 扩容时因此只能移动）
+        Column() = default;
+        Column(Column&&) = default;
+        Column& operator=(Column&&) = default;
+        Column(const Column&) = delete;
+        Column& operator=(const Column&) = delete;
+
+        std::string name;
+        ColumnType type;
+        std::vector<int64_t> ints;       // Int64 / Timestamp
+        std::vector<double> doubles;     // Double
+        std::vector<uint32_t> codes;     // String
+        // 字符串只保存一份：deque 追加时元素地址不变，索引以 string_view 引用字典项
+        std::deque<std::string> dictionary;
+        std::unordered_map<std::string_view, uint32_t> dictionaryIndex;
+        size_t indexed = 0;   // dictionary 中已加入索引的项数，其余在下一次 intern 时补建
+        std::vector<uint64_t> presentBits;   // 每行 1 位，置位表示有值（非 null）
+        Formatter formatter;
+    };
+
+    static std::string formatDefault(const ColumnValue& value);
+    // 行号占高 32 位、列号占低 32 位
+    static uint64_t styleKey(size_t row, size_t col) {
+        return (static_cast<uint64_t>(row) << 32) | static_cast<uint32_t>(col);
+    }
+
+    Column* columnFor(size_t row, size_t col, ColumnType type);
+    void setPresent(Column& column, size_t row, bool present);
+    void resizeColumn(Column& column, size_t rows);
+    uint32_t intern(Column& column, const std::string& value);
+    void rowsChanged(size_t first, size_t count);
+
+    std::vector<Column> m_columns;
+    size_t m_rowCount = 0;
+    std::unordered_map<uint64_t, TableCellStyle> m_styles;
+
+    // 批量修改状态
+    int m_updateDepth = 0;
+    bool m_pendingReset = false;
+    size_t m_pendingInsertFirst = 0;
+    size_t m_pendingInsertCount = 0;
+    size_t m_pendingChangeFirst = SIZE_MAX;   // 批量期间被修改的已有行范围
+    size_t m_pendingChangeLast = 0;
+};
+
+} // namespace liteDui
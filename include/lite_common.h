@@ -176,10 +176,11 @@ struct MouseEvent {
     MouseButton button;
     bool pressed;
     bool released;
+    int mods;   // GLFW 修饰键位（Shift = 1，Ctrl = 2）
 
-    MouseEvent() : x(0), y(0), button(MouseButton::Left), pressed(false), released(false) {}
+    MouseEvent() : x(0), y(0), button(MouseButton::Left), pressed(false), released(false), mods(0) {}
     MouseEvent(float xpos, float ypos, MouseButton btn = MouseButton::Left)
-        : x(xpos), y(ypos), button(btn), pressed(false), released(false) {}
+        : x(xpos), y(ypos), button(btn), pressed(false), released(false), mods(0) {}
 };
 
 // 键盘事件结构体
@@ -43,11 +43,15 @@ public:
     void setTextColor(const Color& color);
     void setFontSize(float size);
     void setFontFamily(const std::string& family);
+    void setFontWeight(FontWeight weight);
+    void setFontStyle(FontStyle style);
     void setTextAlign(TextAlign align);
     const std::string& getText() const { return m_text; }
     Color getTextColor() const { return m_textColor; }
     float getFontSize() const { return m_fontSize; }
     const std::string& getFontFamily() const { return m_fontFamily; }
+    FontWeight getFontWeight() const { return m_fontWeight; }
+    FontStyle getFontStyle() const { return m_fontStyle; }
     TextAlign getTextAlign() const { return m_textAlign; }
 
     // Tooltip 属性
@@ -106,6 +110,11 @@ protected:
      */
     SkFont getFont() const;
 
+    /**
+     * 获取当前容器配置的字体描述（用于单行文本快速绘制）
+     */
+    FontSpec getFontSpec() const;
+
     // 背景属性
     Color m_backgroundColor = Color::White();
 
@@ -116,9 +125,12 @@ protected:
 
     // 文本属性
     std::string m_text;
+    uint64_t m_textVersion = 0;   // m_text 每次修改递增，供子类判断缓存的布局是否过期
     Color m_textColor = Color::Black();
     float m_fontSize = 14.0f;
     std::string m_fontFamily = LITE_DEFAULT_FONT_FAMILY;
+    FontWeight m_fontWeight = FontWeight::Normal;
+    FontStyle m_fontStyle = FontStyle::Normal;
     TextAlign m_textAlign = TextAlign::Left;
 
     // Tooltip 属性
@@ -0,0 +1,156 @@
+/**
+ * lite_csv_loader.h - CSV/TSV 并行加载
+ *
+ * 把 CSV/TSV 文件加载到 LiteColumnarTableModel：
+ * - 文件以内存映射方式读取，不整体拷贝到内存
+ * - open 时同步解析表头并根据前若干行推断列类型，随后在多个线程上按块解析
+ * - 块边界按与记录解析相同的引号规则确定：每块先从 4 种词法状态（字段开头、未加引号、
+ *   引号内、引号内遇到引号）同时扫描一遍，得到块起点状态 -> 块终点状态的映射，
+ *   依次复合即得每块起点的状态，由此找到块内第一条记录的起点。第 k 块只依赖前 k 块的映射，
+ *   因此首块无需等待即可解析，首屏在第一块完成后即可显示
+ * - 解析结果按块存放为列数组，由 UI 线程在 poll 中按文件顺序批量追加到模型
+ * - 字符串去重在工作线程中完成：各块的批内字典并入每列的共享字典，编号换成模型列字典的编号，
+ *   UI 线程只追加编号数组与按编号顺序新增的字典项，不查找、不复制字符串
+ *
+ * 引号按 RFC 4180 处理：以引号开头的字段为带引号字段，其中 "" 表示一个引号；
+ * 其它位置的引号（如 5'10"）是普通字符。
+ * 类型推断后出现的不符合类型的值按 null 处理，并计入 Progress::mismatchCount；
+ * 字段数与列数不同的行计入 Progress::malformedRowCount（多出的字段被丢弃，缺少的为 null）。
+ * 加载期间不应修改加载列中的字符串值（模型列字典的编号由加载器分配）。
+ * 除 poll 外的接口只能在 UI 线程调用。
+ */
+
+#pragma once
+
+#include "lite_columnar_table_model.h"
+#include "lite_mapped_file.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * CSV/TSV 加载选项
+ */
+struct CsvLoadOptions {
+    char delimiter = 0;             // 0 表示自动（.tsv/.tab 为制表符，否则按首行检测）
+    bool hasHeader = true;          // 首行为列名
+    size_t sampleRows = 1000;       // 类型推断采样行数
+    size_t threadCount = 0;         // 0 表示按 CPU 核数
+    size_t chunkBytes = 8u << 20;   // 每块的字节数（首块取其 1/8，尽快显示首屏）
+    bool inferTypes = true;         // 为 false 时所有列均为 String
+};
+
+/**
+ * LiteCsvLoader - CSV/TSV 并行加载器
+ */
+class LiteCsvLoader {
+public:
+    using Options = CsvLoadOptions;
+
+    /**
+     * 加载进度（在 poll 中更新）
+     */
+    struct Progress {
+        uint64_t bytesLoaded = 0;       // 已追加到模型的字节数
+        uint64_t totalBytes = 0;
+        size_t rowCount = 0;            // 已追加到模型的行数
+        size_t mismatchCount = 0;       // 不符合推断类型而置为 null 的单元格数
+        size_t malformedRowCount = 0;   // 字段数与列数不同的行数
+        bool unterminatedQuote = false; // 文件在带引号字段中结束（其后内容全部归入该字段）
+        bool finished = false;
+        bool cancelled = false;
+    };
+
+    using ProgressCallback = std::function<void(const Progress& progress)>;
+
+    LiteCsvLoader();
+    ~LiteCsvLoader();
+
+    LiteCsvLoader(const LiteCsvLoader&) = delete;
+    LiteCsvLoader& operator=(const LiteCsvLoader&) = delete;
+
+    /**
+     * 打开文件，清空模型并按表头与推断的类型重建列，然后开始后台解析
+     * 模型应为新建或只用于本次加载的模型（已有列会被保留在前面）
+     * @return 无法打开或映射文件时返回 false
+     */
+    bool open(const std::string& path, std::shared_ptr<LiteColumnarTableModel> model,
+              const Options& options = Options());
+
+    /**
+     * 把已完成的块按顺序追加到模型（UI 线程每帧调用）
+     * @return 有新行追加或加载结束时返回 true
+     */
+    bool poll();
+
+    /**
+     * 停止后台解析，已追加的行保留
+     */
+    void cancel();
+
+    void setProgressCallback(ProgressCallback callback) { m_progressCallback = std::move(callback); }
+    const Progress& getProgress() const { return m_progress; }
+    bool isFinished() const { return m_progress.finished; }
+
+    /**
+     * 列名与推断出的列类型（open 之后有效）
+     */
+    const std::vector<std::string>& getColumnNames() const { return m_columnNames; }
+    const std::vector<ColumnType>& getColumnTypes() const { return m_columnTypes; }
+    char getDelimiter() const { return m_delimiter; }
+
+    /**
+     * 推断单个字段的类型（空字段返回 false）
+     */
+    static bool inferFieldType(const char* text, size_t length, ColumnType& type);
+
+private:
+    struct Chunk;
+    struct SharedDictionary;
+
+    void stop();
+    void workerLoop();
+    uint8_t scanChunk(size_t chunk) const;
+    std::unique_ptr<Chunk> parseChunk(size_t chunk, uint8_t startState) const;
+    void takeDictionaryEntries(Chunk& chunk);
+    void finish(bool cancelled);
+
+    std::shared_ptr<LiteColumnarTableModel> m_model;
+    std::shared_ptr<const LiteMappedFile> m_file;
+    std::vector<std::string> m_columnNames;
+    std::vector<ColumnType> m_columnTypes;
+    size_t m_firstColumn = 0;   // 模型中第一个加载列的索引
+    char m_delimiter = ',';
+
+    // 块划分：第 k 块拥有起点位于 [m_chunkStarts[k], m_chunkStarts[k + 1]) 的行
+    std::vector<uint64_t> m_chunkStarts;
+    std::vector<uint8_t> m_charClasses;   // 字节 -> 字符类别（与分隔符有关）
+    std::vector<uint8_t> m_scanTable;     // [4 个起点状态各自的当前状态][字节] -> 下一组状态
+    std::vector<uint16_t> m_transitions;  // 每块的起点状态 -> 终点状态映射，UINT16_MAX 表示尚未扫描
+    std::vector<uint8_t> m_startStates;   // 每块起点处的词法状态
+    size_t m_stateKnown = 0;              // 起点状态已知的块数
+    size_t m_nextScan = 0;
+    size_t m_nextParse = 0;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::map<size_t, std::unique_ptr<Chunk>> m_done;   // 已解析、尚未追加的块
+    std::vector<std::unique_ptr<SharedDictionary>> m_dictionaries;   // 与加载列一一对应，非 String 列为空
+    std::atomic<bool> m_cancel{false};
+
+    size_t m_nextCommit = 0;
+    Progress m_progress;
+    ProgressCallback m_progressCallback;
+};
+
+} // namespace liteDui
@@ -10,14 +10,96 @@
 #include "lite_common.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkFontStyle.h"
+#include "include/core/SkTypeface.h"
 #include "modules/skparagraph/include/FontCollection.h"
+#include "modules/skparagraph/include/TypefaceFontProvider.h"
 #include "modules/skparagraph/include/TextStyle.h"
 #include "modules/skparagraph/include/ParagraphStyle.h"
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class SkCanvas;
 
 namespace liteDui {
 
+/**
+ * FontSpec - 字体描述
+ * 用于以值语义描述一次文本绘制/测量所需的字体参数，可作为缓存键
+ */
+struct FontSpec {
+    float fontSize = 14.0f;
+    std::string fontFamily;     // 空则使用默认字体族
+    FontWeight weight = FontWeight::Normal;
+    FontStyle style = FontStyle::Normal;
+
+    bool operator==(const FontSpec& other) const {
+        return fontSize == other.fontSize && weight == other.weight &&
+               style == other.style && fontFamily == other.fontFamily;
+    }
+    bool operator!=(const FontSpec& other) const { return !(*this == other); }
+};
+
+struct FontSpecHash {
+    size_t operator()(const FontSpec& spec) const {
+        size_t h = std::hash<std::string>()(spec.fontFamily);
+        h ^= std::hash<float>()(spec.fontSize) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= static_cast<size_t>(spec.weight) * 31u + static_cast<size_t>(spec.style) + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+/**
+ * TextMetrics - 文本测量结果
+ */
+struct TextMetrics {
+    float width = 0.0f;      // 最长行宽度
+    float height = 0.0f;     // 总高度
+    float baseline = 0.0f;   // 首行基线到顶部的距离
+    int lineCount = 0;       // 行数
+};
+
+/**
+ * FallbackScript - 字体回退缓存使用的文字分类
+ * 按 Unicode 区块粗分，同一分类内的字符通常由同一个回退字体覆盖
+ */
+enum class FallbackScript {
+    Latin,
+    Greek,
+    Cyrillic,
+    Armenian,
+    Hebrew,
+    Arabic,
+    Indic,
+    Thai,
+    Lao,
+    Tibetan,
+    Myanmar,
+    Georgian,
+    Hangul,
+    Kana,
+    Han,
+    Symbols,
+    Emoji,
+    Other,
+    Count
+};
+
+/**
+ * WarmUpGlyphSet - 预置的字形预热集合
+ */
+enum class WarmUpGlyphSet {
+    Ascii,        // 可打印 ASCII 字符
+    CommonCJK     // 常用汉字与中文标点（界面文本中出现频率最高的约 400 个字）
+};
+
 /**
  * LiteFontManager - 字体管理器单例
  * 
@@ -25,14 +107,84 @@ namespace liteDui {
  * - 全局 SkFontMgr 实例
  * - 全局 FontCollection 实例（支持字体回退）
  * - 便捷的样式构造方法
+ * - 字体查找缓存（按 family/weight/slant 缓存匹配结果）
+ * - 文本测量缓存（与绘制解耦，供布局和命中测试使用）
+ * - 字体回退缓存（按 请求字体族 + 文字分类 缓存回退结果，可配置回退链并持久化）
+ *
+ * 初始化（fontconfig 扫描、FontCollection 构建）可以通过 startInitialization()
+ * 提前在后台线程进行；getInstance() 只在初始化仍未完成时阻塞。
+ *
+ * 字形预热：登记的字符由各窗口在空闲帧中绘制到离屏 GPU 表面，
+ * 提前完成光栅化并上传到字形图集，避免打开新界面时首帧卡顿。
  */
 class LiteFontManager {
 public:
     /**
      * 获取单例实例
+     * 后台初始化尚未完成时阻塞等待；从未启动过初始化时在当前线程同步完成
      */
     static LiteFontManager& getInstance();
 
+    /**
+     * 在后台线程启动字体初始化（可重复调用，只生效一次）
+     * LiteWindowManager 构造时调用，使 fontconfig 扫描与窗口、GL 初始化并行
+     */
+    static void startInitialization();
+
+    /**
+     * 初始化是否已完成（不阻塞）
+     */
+    static bool isInitialized();
+
+    /**
+     * 初始化本身的耗时（毫秒），未完成时为 0
+     */
+    double getInitializationTime() const { return m_initTimeMs; }
+
+    /**
+     * 调用方因等待后台初始化而阻塞的总时间（毫秒），完全重叠时为 0
+     */
+    double getInitializationWaitTime() const { return m_initWaitUs.load() / 1000.0; }
+
+    /**
+     * 是否使用系统字体（默认 true），必须在初始化开始之前调用
+     * 关闭后不再创建 fontconfig 字体管理器、不扫描系统字体目录，
+     * 只能使用 registerFont 注册的字体，启动更快。
+     */
+    static void setUseSystemFonts(bool enabled);
+    bool isUsingSystemFonts() const { return m_useSystemFonts; }
+
+    /**
+     * 注册字体文件（以内存映射方式加载，不需要安装到系统）
+     * 注册的字体优先于同名系统字体，并参与字符回退。
+     * 应在 UI 线程调用，最好在创建控件之前完成注册。
+     * @param path 字体文件路径（TTF/OTF；字体集合文件只注册第一个字体）
+     * @param alias 字体族别名，空则使用字体自身的族名
+     * @return 文件无法映射或不是有效字体时返回 false
+     */
+    bool registerFont(const std::string& path, const std::string& alias = "");
+
+    /**
+     * 从内存注册字体（数据会被拷贝）
+     */
+    bool registerFont(const void* data, size_t length, const std::string& alias = "");
+
+    /**
+     * 从 SkData 注册字体（不拷贝，数据需在进程生命周期内有效）
+     */
+    bool registerFont(sk_sp<SkData> data, const std::string& alias = "");
+
+    /**
+     * 已注册的字体族名称
+     */
+    std::vector<std::string> getRegisteredFamilies() const;
+
+    /**
+     * 字体配置版本，注册字体、修改默认字体族等使字体匹配结果变化的操作后递增
+     * 其他模块按 FontSpec 缓存的字形数据在版本变化时应丢弃
+     */
+    uint64_t getFontGeneration() const { return m_fontGeneration.load(std::memory_order_acquire); }
+
     /**
      * 禁用拷贝和移动
      */
@@ -52,32 +204,65 @@ public:
     sk_sp<skia::textlayout::FontCollection> getFontCollection() const { return m_fontCollection; }
 
     /**
-     * 获取默认字体族名称
+     * 获取默认字体族名称（可在任意线程调用）
      */
-    const std::string& getDefaultFontFamily() const { return m_defaultFontFamily; }
+    std::string getDefaultFontFamily() const;
 
     /**
      * 设置默认字体族名称
+     * 测量缓存与整形缓存中字体族为空（即默认字体）的结果随之失效，字体版本递增
      */
     void setDefaultFontFamily(const std::string& family);
 
+    /**
+     * 查找字体（带缓存）
+     * 首次请求某个 (family, weight, slant) 组合时通过 SkFontMgr 匹配，
+     * 之后直接返回缓存结果；匹配失败的结果同样会被缓存。
+     * @param fontFamily 字体族名称（空则使用默认）
+     * @param weight 字体粗细
+     * @param style 字体样式
+     */
+    sk_sp<SkTypeface> matchTypeface(const std::string& fontFamily,
+                                    FontWeight weight = FontWeight::Normal,
+                                    FontStyle style = FontStyle::Normal) const;
+
     /**
      * 创建 SkFont 实例
      * @param fontSize 字体大小
      * @param fontFamily 字体族名称（空则使用默认）
+     * @param weight 字体粗细
+     * @param style 字体样式
      */
-    SkFont createFont(float fontSize, const std::string& fontFamily = "") const;
+    SkFont createFont(float fontSize, const std::string& fontFamily = "",
+                      FontWeight weight = FontWeight::Normal,
+                      FontStyle style = FontStyle::Normal) const;
+
+    /**
+     * 根据字体描述创建 SkFont 实例
+     */
+    SkFont createFont(const FontSpec& spec) const {
+        return createFont(spec.fontSize, spec.fontFamily, spec.weight, spec.style);
+    }
 
     /**
      * 创建 TextStyle
      * @param color 文本颜色
      * @param fontSize 字体大小
      * @param fontFamily 字体族名称（空则使用默认）
+     * @param weight 字体粗细
+     * @param style 字体样式
      */
     skia::textlayout::TextStyle createTextStyle(
         const Color& color,
         float fontSize,
-        const std::string& fontFamily = "") const;
+        const std::string& fontFamily = "",
+        FontWeight weight = FontWeight::Normal,
+        FontStyle style = FontStyle::Normal) const;
+
+    /**
+     * 将 liteDui 的字体粗细/样式转换为 SkFontStyle
+     */
+    static SkFontStyle toSkFontStyle(FontWeight weight, FontStyle style);
 
     /**
      * 创建 ParagraphStyle
@@ -85,15 +270,311 @@ public:
      */
     skia::textlayout::ParagraphStyle createParagraphStyle(TextAlign textAlign) const;
 
+    /**
+     * 测量文本尺寸（带缓存）
+     * 单行简单文本通过整形缓存直接得到结果，其余情况使用段落排版测量。
+     * @param text 文本（UTF-8）
+     * @param font 字体描述
+     * @param maxWidth 最大宽度，<= 0 表示不限制（不自动换行）
+     */
+    TextMetrics measureText(const std::string& text, const FontSpec& font, float maxWidth = 0.0f) const;
+
+    /**
+     * 清空文本测量缓存（修改字体配置后调用）
+     */
+    void clearMeasureCache();
+
+    // ==================== 字体回退 ====================
+
+    /**
+     * 获取字符所属的回退分类
+     */
+    static FallbackScript classifyScript(SkUnichar character);
+
+    /**
+     * 回退分类名称（配置文件与缓存文件中使用），如 "han"、"emoji"
+     */
+    static const char* getScriptName(FallbackScript script);
+    static bool parseScriptName(const std::string& name, FallbackScript& script);
+
+    /**
+     * 查找能显示 character 的回退字体（带缓存）
+     * 按 (请求字体族, 文字分类, weight, slant) 缓存，命中且该字体包含此字符时直接返回；
+     * 未命中时依次尝试配置的回退链，最后才通过 SkFontMgr 按字符搜索。
+     * @return 找不到时返回 nullptr
+     */
+    sk_sp<SkTypeface> matchFallbackTypeface(const std::string& fontFamily,
+                                            SkUnichar character,
+                                            FontWeight weight = FontWeight::Normal,
+                                            FontStyle style = FontStyle::Normal) const;
+
+    /**
+     * 为某个文字分类指定显式回退链（按顺序尝试），会清除该分类已缓存的结果
+     * 回退链中的字体会立即解析，首次遇到该文字时无需再搜索
+     */
+    void setFallbackChain(FallbackScript script, const std::vector<std::string>& families);
+    std::vector<std::string> getFallbackChain(FallbackScript script) const;
+
+    /**
+     * 从配置文件加载回退链，每行格式为 "分类: 字体1, 字体2"，# 开头为注释
+     * @return 文件无法打开时返回 false
+     */
+    bool loadFallbackConfig(const std::string& path);
+
+    /**
+     * 设置回退缓存文件并立即加载其中的结果
+     * 之后解析出的新回退字体由后台任务合并写回该文件，下次启动时只需按字体族名匹配，
+     * 不必再按字符搜索系统字体。传入空字符串关闭持久化。
+     */
+    void setFallbackCachePath(const std::string& path);
+    const std::string& getFallbackCachePath() const { return m_fallbackCachePath; }
+
+    /**
+     * 将当前回退缓存立即写入缓存文件
+     */
+    bool saveFallbackCache() const;
+
+    /**
+     * 清空回退缓存（不影响已配置的回退链）
+     */
+    void clearFallbackCache();
+
+    /**
+     * 获取某个字体族已知的回退字体族（已解析结果与配置的回退链），
+     * 用于 skparagraph 的 TextStyle，使其优先按字体族匹配而不是按字符搜索
+     */
+    std::vector<std::string> getFallbackFamilies(const std::string& fontFamily) const;
+
+    /**
+     * 同上，但已解析结果只取该 weight / 样式下的（createTextStyle 使用，结果按回退缓存版本缓存）
+     */
+    std::vector<std::string> getFallbackFamilies(const std::string& fontFamily, FontWeight weight,
+                                                 FontStyle style) const;
+
+    // ==================== 字形预热 ====================
+
+    /**
+     * 登记预置字符集，按 font 指定的字体族、字号和样式预热
+     */
+    void addWarmUpGlyphs(WarmUpGlyphSet set, const FontSpec& font);
+
+    /**
+     * 登记应用已知的文本（如界面字符串），其中的字符按 font 预热
+     * 同一字体下重复的字符只登记一次
+     */
+    void addWarmUpText(const std::string& text, const FontSpec& font);
+
+    /**
+     * 已登记的预热任务数（每个任务为同一字体下的一小批字符）
+     */
+    size_t getWarmUpTaskCount() const;
+
+    /**
+     * 执行预热任务，直到用完 budgetMs 或没有剩余任务
+     * 每个 GPU 上下文各自维护 cursor（初始为 0），多个窗口互不影响。
+     * 调用方应在空闲帧中调用，并在之后提交 GPU 命令。
+     * @param canvas 离屏画布（需属于目标 GPU 上下文）
+     * @param cursor 该上下文已完成的任务数，调用后更新
+     * @return 仍有剩余任务返回 true
+     */
+    bool runWarmUp(SkCanvas* canvas, size_t& cursor, double budgetMs) const;
+
+    // 预热用离屏表面的边长（像素）
+    static constexpr int kWarmUpSurfaceSize = 512;
+
 private:
     LiteFontManager();
-    ~LiteFontManager() = default;
+    ~LiteFontManager();
+
+    // 获取单例但不等待初始化
+    static LiteFontManager& instance();
+
+    void initialize(bool background);
+    void waitForInitialization();
+
+    /**
+     * 预先解析默认字体族的常用样式，避免首次绘制时查询 fontconfig
+     */
+    void preloadDefaultTypefaces();
+
+    // 字体缓存键：family + weight + slant
+    struct TypefaceKey {
+        std::string family;
+        int weight;
+        int slant;
+
+        bool operator==(const TypefaceKey& other) const {
+            return weight == other.weight && slant == other.slant && family == other.family;
+        }
+    };
+
+    struct TypefaceKeyHash {
+        size_t operator()(const TypefaceKey& key) const {
+            size_t h = std::hash<std::string>()(key.family);
+            h ^= static_cast<size_t>(key.weight) * 31u + static_cast<size_t>(key.slant) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    // 测量缓存键：文本 + 字体 + 最大宽度
+    struct MeasureKey {
+        std::string text;
+        FontSpec font;
+        float maxWidth;
+
+        bool operator==(const MeasureKey& other) const {
+            return maxWidth == other.maxWidth && font == other.font && text == other.text;
+        }
+    };
+
+    struct MeasureKeyHash {
+        size_t operator()(const MeasureKey& key) const {
+            size_t h = std::hash<std::string>()(key.text);
+            h ^= FontSpecHash()(key.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<float>()(key.maxWidth) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    TextMetrics measureTextUncached(const std::string& text, const FontSpec& font, float maxWidth) const;
+
+    // 回退缓存键：请求字体族 + 文字分类 + weight + slant
+    struct FallbackKey {
+        std::string family;
+        FallbackScript script;
+        int weight;
+        int slant;
+
+        bool operator==(const FallbackKey& other) const {
+            return script == other.script && weight == other.weight &&
+                   slant == other.slant && family == other.family;
+        }
+    };
 
-    void initialize();
+    struct FallbackKeyHash {
+        size_t operator()(const FallbackKey& key) const {
+            size_t h = std::hash<std::string>()(key.family);
+            h ^= static_cast<size_t>(key.script) * 131u + static_cast<size_t>(key.weight) * 31u +
+                 static_cast<size_t>(key.slant) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    // 按字符的回退缓存键：分类结果恰好缺少某个字符时使用
+    struct FallbackCharacterKey {
+        std::string family;
+        SkUnichar character;
+        int weight;
+        int slant;
+
+        bool operator==(const FallbackCharacterKey& other) const {
+            return character == other.character && weight == other.weight &&
+                   slant == other.slant && family == other.family;
+        }
+    };
+
+    struct FallbackCharacterKeyHash {
+        size_t operator()(const FallbackCharacterKey& key) const {
+            size_t h = std::hash<std::string>()(key.family);
+            h ^= static_cast<size_t>(key.character) * 131u + static_cast<size_t>(key.weight) * 31u +
+                 static_cast<size_t>(key.slant) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    // createTextStyle 的字体族列表缓存项，version 与 m_fallbackVersion 不同时重新生成
+    struct StyleFamilies {
+        uint64_t version = 0;
+        std::vector<SkString> families;
+    };
+
+    // 回退缓存项：从缓存文件加载的项只有字体族名，首次使用时才解析并校验
+    struct FallbackEntry {
+        std::string resolvedFamily;   // 空表示没有可用的回退字体
+        sk_sp<SkTypeface> typeface;
+        bool resolved = false;
+        bool verified = false;        // 是否已确认包含该分类的字符
+    };
+
+    // 先匹配注册的字体，再匹配系统字体（要求已持有 m_typefaceMutex）
+    sk_sp<SkTypeface> matchFamilyStyleLocked(const std::string& family, const SkFontStyle& style) const;
+
+    // 以下方法要求已持有 m_fallbackMutex
+    sk_sp<SkTypeface> discoverFallbackLocked(const std::string& family, FallbackScript script,
+                                             SkUnichar character, const SkFontStyle& style) const;
+    std::string formatFallbackCacheLocked() const;
+    // style 为空时包含所有样式的已解析结果
+    std::vector<std::string> collectFallbackFamiliesLocked(const std::string& family, const SkFontStyle* style) const;
+    std::vector<SkString> getStyleFamilies(const std::string& family, const SkFontStyle& style) const;
+    // 标记缓存文件需要更新，由后台任务合并写入
+    void scheduleFallbackSaveLocked() const;
+
+    // 后台保存任务：取当前缓存内容写入文件，期间又有变化时再提交一次
+    void flushFallbackCache() const;
+    static bool writeFallbackCache(const std::string& path, const std::string& content);
+
+    // 预热任务：同一字体下的一批码点
+    struct WarmUpTask {
+        FontSpec font;
+        std::vector<SkUnichar> characters;
+    };
+
+    static constexpr size_t kWarmUpBatchSize = 64;
+
+    void addWarmUpCharacters(const std::vector<SkUnichar>& characters, const FontSpec& font);
+    void drawWarmUpTask(SkCanvas* canvas, const WarmUpTask& task) const;
+
+    // 测量缓存上限，超出后整体清空（测量结果的重建代价很低）
+    static constexpr size_t kMaxMeasureCacheSize = 8192;
 
     sk_sp<SkFontMgr> m_fontMgr;
+    sk_sp<skia::textlayout::TypefaceFontProvider> m_fontProvider;   // 注册的字体（受 m_typefaceMutex 保护）
     sk_sp<skia::textlayout::FontCollection> m_fontCollection;
-    std::string m_defaultFontFamily;
+    std::string m_defaultFontFamily;   // 受 m_typefaceMutex 保护（渲染线程与后台线程都会读取）
+    bool m_useSystemFonts = true;
+
+    // 初始化状态
+    std::once_flag m_initOnce;
+    std::once_flag m_startOnce;
+    std::thread m_initThread;
+    std::atomic<bool> m_initStarted{false};
+    std::atomic<bool> m_initialized{false};
+    std::atomic<int64_t> m_initWaitUs{0};
+    double m_initTimeMs = 0.0;
+    std::atomic<uint64_t> m_fontGeneration{1};
+
+    // 字体查找缓存（渲染线程与后台线程都可能访问）
+    mutable std::mutex m_typefaceMutex;
+    mutable std::unordered_map<TypefaceKey, sk_sp<SkTypeface>, TypefaceKeyHash> m_typefaceCache;
+
+    // 文本测量缓存
+    mutable std::mutex m_measureMutex;
+    mutable std::unordered_map<MeasureKey, TextMetrics, MeasureKeyHash> m_measureCache;
+
+    // 字体回退缓存与回退链
+    mutable std::mutex m_fallbackMutex;
+    mutable std::unordered_map<FallbackKey, FallbackEntry, FallbackKeyHash> m_fallbackCache;
+    std::vector<std::string> m_fallbackChains[static_cast<size_t>(FallbackScript::Count)];
+    std::string m_fallbackCachePath;
+    // 回退结果或回退链变化时递增，使 m_styleFamilies 失效
+    mutable uint64_t m_fallbackVersion = 1;
+    // 按 (字体族, 文字分类 Other, weight, slant) 缓存 createTextStyle 的字体族列表
+    mutable std::unordered_map<FallbackKey, StyleFamilies, FallbackKeyHash> m_styleFamilies;
+    // 按字符搜索的结果，nullptr 表示没有字体包含该字符（否定缓存，避免反复搜索系统字体）
+    mutable std::unordered_map<FallbackCharacterKey, sk_sp<SkTypeface>, FallbackCharacterKeyHash> m_fallbackCharacters;
+    static constexpr size_t kMaxFallbackCharacters = 4096;
+    static constexpr size_t kMaxStyleFamilies = 256;
+    // 缓存文件的延迟保存（受 m_fallbackMutex 保护）；写文件时持有 m_fallbackFileMutex
+    mutable bool m_fallbackDirty = false;
+    mutable bool m_fallbackSaveScheduled = false;
+    mutable std::condition_variable m_fallbackSaveCv;
+    mutable std::mutex m_fallbackFileMutex;
+    uint64_t m_fallbackSaveGroup;
+
+    // 字形预热任务（只追加，各上下文按自己的进度消费）
+    mutable std::mutex m_warmUpMutex;
+    std::vector<WarmUpTask> m_warmUpTasks;
+    std::unordered_map<FontSpec, std::unordered_set<SkUnichar>, FontSpecHash> m_warmUpSeen;
 };
 
 } // namespace liteDui
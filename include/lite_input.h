@@ -5,16 +5,12 @@
 #pragma once
 
 #include "lite_container.h"
+#include "lite_text_line.h"
+#include "lite_utf8.h"
 #include <chrono>
 #include <vector>
 #include <memory>
 
-// 前向声明
-class SkFont;
-namespace skia::textlayout {
-    class Paragraph;
-}
-
 namespace liteDui {
 
 class LiteInput;
@@ -95,12 +91,16 @@ private:
     void deleteSelected();
     void updateCursorBlink();
     void resetCursorBlink();
-    
-    // 使用 skparagraph 的文本测量辅助方法
-    std::unique_ptr<skia::textlayout::Paragraph> buildParagraph(
-        const std::string& text, const Color& color, float maxWidth) const;
-    std::vector<float> getCharPositions(const std::string& text, float maxWidth) const;
-    int xToCharIndex(const std::string& text, float x, float maxWidth) const;
+
+    // 所有文本修改的统一入口：把 [start, end) 替换为 text，并增量更新文本布局
+    void replaceText(int start, int end, const std::string& text);
+
+    // 文本布局辅助方法（基于 LiteTextLine，每个编辑版本只整形一次）
+    void syncTextLine();
+    int toDisplayOffset(int bytePos) const;
+    int fromDisplayOffset(int displayPos) const;
+    float cursorXForOffset(int bytePos);
+    int offsetForX(float x);
     void ensureCursorVisible(float visibleWidth);
 
     ControlState m_state = ControlState::Normal;
@@ -118,6 +118,13 @@ private:
     float m_scrollOffset = 0.0f;
     std::chrono::steady_clock::time_point m_lastBlinkTime;
 
+    // 文本布局：显示文本的分段整形结果，由渲染、光标、选择和命中测试共享
+    LiteTextLine m_textLine;
+    uint64_t m_layoutTextVersion = 0; // m_textLine 对应的 m_textVersion
+    InputType m_layoutInputType = InputType::Text;
+    int m_charCount = 0;              // 当前文本的字符（码点）数
+    Utf8OffsetIndex m_offsetIndex;    // 密码模式下 字节偏移 <-> 字符序号 的映射
+
     // 样式
     Color m_placeholderColor = Color(0.6f, 0.6f, 0.6f, 1.0f);
     Color m_cursorColor = Color::Black();
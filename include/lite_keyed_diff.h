@@ -0,0 +1,46 @@
+/**
+ * lite_keyed_diff.h - 按键比较新旧两组行
+ *
+ * 用新快照整体刷新列表/表格时，按每行的键把新行与现有行对应起来：
+ * - 键相同的行视为同一行（保留其选择、行高等视图状态，只比较内容）
+ * - 没有对应的旧行被删除，没有对应的新行被插入
+ * - 保留行中位于最长递增子序列（按旧行号）之外的行是最少需要移动的行
+ *
+ * 键重复时第 k 个新行对应第 k 个同键的旧行。O(n log n)。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * LiteKeyedDiff - 按键比较的结果
+ */
+struct LiteKeyedDiff {
+    static constexpr uint32_t kInserted = UINT32_MAX;
+
+    std::vector<uint32_t> sources;   // 每个新行对应的旧行，kInserted 表示新插入
+    size_t oldCount = 0;
+    size_t removedCount = 0;
+    size_t insertedCount = 0;
+    size_t movedCount = 0;           // 需要移动的保留行数
+
+    /**
+     * 行数不变且每个新行都对应同一位置的旧行（只可能有内容变化）
+     */
+    bool isIdentity() const { return removedCount == 0 && insertedCount == 0 && movedCount == 0; }
+
+    /**
+     * 旧行 -> 新行，被删除的旧行为 kInserted
+     */
+    std::vector<uint32_t> targets() const;
+
+    static LiteKeyedDiff compute(const std::vector<std::string>& oldKeys, const std::vector<std::string>& newKeys);
+};
+
+} // namespace liteDui
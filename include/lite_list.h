@@ -7,6 +7,9 @@
 #pragma once
 
 #include "lite_scroll_view.h"
+#include "lite_row_heights.h"
+#include "lite_row_prefetcher.h"
+#include "lite_selection_model.h"
 #include <vector>
 
 namespace liteDui {
@@ -20,9 +23,14 @@ using LiteListPtr = std::shared_ptr<LiteList>;
 struct ListItem {
     std::string text;
     std::string id;
-    bool selected = false;
     void* userData = nullptr;
 
+    /**
+     * 已弃用：选择状态由 LiteSelectionModel 保存（见 LiteList::isSelected / getSelectionModel）。
+     * 此字段只是选择模型的只读镜像，由 LiteList 在选择变化时同步，修改它不会改变选择
+     */
+    bool selected = false;
+
     ListItem() = default;
     ListItem(const std::string& t, const std::string& i = "")
         : text(t), id(i) {}
@@ -44,6 +52,13 @@ public:
     void insertItem(size_t index, const std::string& text, const std::string& id = "");
     void removeItem(size_t index);
     void clearItems();
+    /**
+     * 用新的列表项整体刷新（可移入）：按键与现有项对应，只增删新增/消失的项，
+     * 选中状态与已测量高度随项保留，文本变化的项在有测量回调时重新测量；
+     * 视口内第一个选中项（没有时为顶部项）保持屏幕位置。key 为空时按 id，id 为空时按文本
+     */
+    using ItemKeyFunction = std::function<std::string(const ListItem& item)>;
+    void setItems(std::vector<ListItem> items, const ItemKeyFunction& key = ItemKeyFunction());
     size_t getItemCount() const { return m_items.size(); }
     ListItem* getItem(size_t index);
     const ListItem* getItem(size_t index) const;
@@ -58,10 +73,32 @@ public:
     std::vector<int> getSelectedIndices() const;
     void clearSelection();
     void selectAll();
+    /**
+     * 选择模型（选中状态按区间保存，不在列表项中），可直接监听按区间报告的选择变化
+     */
+    LiteSelectionModel& getSelectionModel() { return m_selection; }
+    const LiteSelectionModel& getSelectionModel() const { return m_selection; }
 
     // 样式设置
+    // 默认项目高度，也是尚未测量的项目的估计高度
     void setItemHeight(float height);
     float getItemHeight() const { return m_itemHeight; }
+
+    /**
+     * 可变项目高度，height <= 0 表示恢复为默认高度
+     */
+    void setItemHeightAt(size_t index, float height);
+    float getItemHeightAt(size_t index) const;
+
+    /**
+     * 项目高度测量回调，项目第一次进入视口时调用并缓存结果，
+     * 尚未测量的项目按默认高度估计
+     */
+    void setItemHeightProvider(std::function<float(size_t index)> provider);
+
+    // 丢弃已设置/测量的高度，有测量回调时重新测量
+    void invalidateItemHeight(size_t index);
+    void invalidateItemHeights();
     
     void setItemPadding(float padding) { m_itemPadding = padding; markDirty(); }
     float getItemPadding() const { return m_itemPadding; }
@@ -78,6 +115,10 @@ public:
     void setShowAlternateRows(bool show) { m_showAlternateRows = show; markDirty(); }
     bool isShowAlternateRows() const { return m_showAlternateRows; }
 
+    // 后台预取即将滚入视口的行的文本整形结果
+    void setPrefetchEnabled(bool enabled) { m_prefetcher.setEnabled(enabled); }
+    bool isPrefetchEnabled() const { return m_prefetcher.isEnabled(); }
+
     // 回调
     void setOnSelectionChanged(SelectionChangedCallback callback);
     void setOnItemClicked(std::function<void(int)> callback);
@@ -88,7 +129,7 @@ public:
     void onMouseMoved(const MouseEvent& event) override;
     void onMouseExited(const MouseEvent& event) override;
 
-    // 重写获取内容高度（列表的内容高度 = 项目数 × 项目高度）
+    // 重写获取内容高度（列表的内容高度 = 各项目高度之和）
     float getContentHeight() const override;
 
 protected:
@@ -111,13 +152,22 @@ private:
      * @param index 项目索引
      * @param y 项目的 Y 坐标
      * @param width 项目宽度
+     * @param height 项目高度
      */
-    void drawItem(SkCanvas* canvas, size_t index, float y, float width);
+    void drawItem(SkCanvas* canvas, size_t index, float y, float width, float height);
+
+    // 按选择模型同步 [first, end) 项的 ListItem::selected 镜像
+    void syncSelectedFlags(size_t first, size_t end);
 
     std::vector<ListItem> m_items;
+    LiteSelectionModel m_selection;
     ListSelectionMode m_selectionMode = ListSelectionMode::Single;
     int m_hoverIndex = -1;
     
+    // 项目高度偏移索引（与 m_items 一一对应）
+    LiteRowHeights m_itemHeights;
+    std::function<float(size_t)> m_itemHeightProvider;
+
     // 样式
     float m_itemHeight = 36.0f;
     float m_itemPadding = 12.0f;
@@ -126,6 +176,8 @@ private:
     Color m_alternateColor = Color::fromRGB(245, 245, 245);
     bool m_showAlternateRows = false;
 
+    LiteRowPrefetcher m_prefetcher;
+
     // 回调
     SelectionChangedCallback m_onSelectionChanged;
     std::function<void(int)> m_onItemClicked;
@@ -0,0 +1,59 @@
+/**
+ * lite_listener_list.h - 按 ID 注册的监听器列表
+ *
+ * 模型类共用的监听器管理：add 返回 ID，remove 按 ID 注销，notify 依次回调。
+ * 只在 UI 线程使用，不加锁。
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * LiteListenerList - 监听器列表，回调参数为 Args
+ */
+template <typename... Args>
+class LiteListenerList {
+public:
+    using Listener = std::function<void(Args...)>;
+
+    /**
+     * 注册监听器
+     * @return 监听器 ID，用于 remove
+     */
+    size_t add(Listener listener) {
+        size_t id = m_nextId++;
+        m_listeners.emplace_back(id, std::move(listener));
+        return id;
+    }
+
+    void remove(size_t id) {
+        m_listeners.erase(std::remove_if(m_listeners.begin(), m_listeners.end(),
+                                         [id](const std::pair<size_t, Listener>& entry) {
+                                             return entry.first == id;
+                                         }),
+                          m_listeners.end());
+    }
+
+    bool empty() const { return m_listeners.empty(); }
+
+    void notify(Args... args) const {
+        // 拷贝一份，监听器在回调中注销自己也是安全的
+        auto listeners = m_listeners;
+        for (auto& entry : listeners) {
+            if (entry.second) entry.second(args...);
+        }
+    }
+
+private:
+    std::vector<std::pair<size_t, Listener>> m_listeners;
+    size_t m_nextId = 1;
+};
+
+} // namespace liteDui
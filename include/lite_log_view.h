@@ -0,0 +1,185 @@
+/**
+ * lite_log_view.h - 流式日志查看控件
+ *
+ * 面向数 GB 级别日志的只读查看器，基于 LiteScrollView：
+ * - 数据源为日志文件（按偏移读取，文件增长时继续索引）或定长的追加式环形缓冲区
+ * - 文件不做内存映射：日志轮转截断文件后读取只会得到短读，不会触发 SIGBUS
+ * - 行索引为稀疏检查点（每 kCheckpointInterval 行记录一个起始偏移），
+ *   文件模式下由后台线程增量构建，内存占用与文件大小基本无关
+ * - 只截取、整形和绘制可见行，行文本不常驻内存
+ * - 跟随尾部模式：新数据到达时自动滚动到底部，向上滚动时自动退出
+ */
+
+#pragma once
+
+#include "lite_scroll_view.h"
+#include "lite_font_manager.h"
+#include "lite_mapped_file.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace liteDui {
+
+class LiteLogView;
+using LiteLogViewPtr = std::shared_ptr<LiteLogView>;
+
+/**
+ * LiteLogView - 流式日志查看控件
+ *
+ * append/appendLine 可在任意线程调用；其余接口只能在 UI 线程调用。
+ */
+class LiteLogView : public LiteScrollView {
+public:
+    LiteLogView();
+    ~LiteLogView() override;
+
+    /**
+     * 打开日志文件，后台建立行索引
+     * 文件被截断（如日志轮转）时自动重新打开
+     * @return 打开失败返回 false
+     */
+    bool openFile(const std::string& path);
+    const std::string& getFilePath() const { return m_filePath; }
+
+    /**
+     * 切换为环形缓冲区模式，容量满时丢弃最旧的整行
+     */
+    void setRingBuffer(size_t capacityBytes);
+    size_t getRingBufferCapacity() const { return m_ring.size(); }
+
+    /**
+     * 向环形缓冲区追加数据（线程安全）
+     */
+    void append(const std::string& text);
+    void appendLine(const std::string& line);
+
+    /**
+     * 关闭数据源并清空内容
+     */
+    void close();
+
+    /**
+     * 已索引的行数（在 update 中刷新）
+     */
+    size_t getLineCount() const { return m_lineCount; }
+
+    /**
+     * 获取一行文本（按需从数据源截取）
+     */
+    std::string getLine(size_t line) const;
+
+    /**
+     * 后台索引是否仍在进行
+     */
+    bool isIndexing() const { return m_indexing.load(); }
+
+    // 跟随尾部
+    void setFollowTail(bool follow);
+    bool isFollowTail() const { return m_followTail; }
+
+    // 单行最多显示的字节数，超长行截断显示
+    void setMaxLineBytes(size_t bytes) { m_maxLineBytes = std::max<size_t>(bytes, 16); markDirty(); }
+    size_t getMaxLineBytes() const { return m_maxLineBytes; }
+
+    // 文件增长检测间隔（毫秒）
+    void setPollInterval(int ms) { m_pollInterval = std::chrono::milliseconds(std::max(ms, 10)); }
+
+    float getContentWidth() const override;
+    float getContentHeight() const override;
+
+    void update() override;
+
+    // 事件处理
+    void onScroll(const ScrollEvent& event) override;
+    void onMouseMoved(const MouseEvent& event) override;
+    void onKeyPressed(const KeyEvent& event) override;
+
+protected:
+    void renderContent(SkCanvas* canvas) override;
+
+private:
+    enum class SourceMode { None, File, Ring };
+
+    // 稀疏行索引检查点：line 行从 offset 开始（line 为 kCheckpointInterval 的整数倍）
+    struct Checkpoint {
+        uint64_t line;
+        uint64_t offset;
+    };
+
+    // 行索引（偏移均为数据源逻辑偏移，受 m_mutex 保护）
+    struct LineIndex {
+        std::deque<Checkpoint> checkpoints;
+        uint64_t firstLine = 0;        // 保留的第一行行号（环形缓冲丢弃旧行后递增）
+        uint64_t firstLineStart = 0;
+        uint64_t newlines = 0;         // 已索引范围内的换行符总数
+        uint64_t lastLineStart = 0;    // 最后一个换行符之后的偏移
+        uint64_t end = 0;              // 已索引范围终点
+    };
+
+    static constexpr uint64_t kCheckpointInterval = 1024;
+    static constexpr uint64_t kNotFound = static_cast<uint64_t>(-1);
+
+    // 扫描 [data, data + length) 中的换行符，更新计数并追加检查点
+    static void scanLineBreaks(const char* data, size_t length, uint64_t baseOffset,
+                               uint64_t& newlines, uint64_t& lastLineStart,
+                               std::deque<Checkpoint>& checkpoints);
+
+    void resetIndexLocked(uint64_t startOffset);
+    void indexLoop();
+    void pollFileGrowth();
+    void syncFont();
+
+    // 以下方法要求已持有 m_mutex
+    uint64_t lineCountLocked() const;
+    uint64_t lineStartLocked(uint64_t line) const;
+    uint64_t findNewlineLocked(uint64_t from, uint64_t to) const;
+    const char* fileBytesLocked(uint64_t from, size_t& length) const;
+    std::string readBytesLocked(uint64_t from, uint64_t to) const;
+    void dropRingLinesLocked(size_t incoming);
+
+    // 截取 [first, first + count) 行的显示文本
+    std::vector<std::string> collectLines(size_t first, size_t count) const;
+    bool isAtBottom() const;
+    void scrollToBottom();
+
+    // 数据源
+    SourceMode m_mode = SourceMode::None;
+    std::string m_filePath;
+    std::shared_ptr<const LiteFileHandle> m_file;   // 后台线程持有副本，关闭时不受影响
+    uint64_t m_fileSize = 0;                        // 允许索引的文件长度，只在 UI 线程加锁修改
+    mutable std::atomic<bool> m_truncated{false};   // 读取时发现文件已变短，等待 update 重新打开
+    mutable std::vector<char> m_readCache;          // 文件模式下最近读取的一块数据（受 m_mutex 保护）
+    mutable uint64_t m_readCacheOffset = 0;
+    std::vector<char> m_ring;
+    uint64_t m_sourceGeneration = 0;   // 数据源切换后递增，后台线程据此丢弃过期结果
+
+    // 索引与后台线程
+    mutable std::mutex m_mutex;
+    std::condition_variable m_indexCv;
+    std::thread m_indexer;
+    bool m_stopIndexer = false;
+    LineIndex m_index;
+    std::atomic<bool> m_indexing{false};
+    std::atomic<uint64_t> m_revision{0};   // 内容变化计数，由 update 在 UI 线程消费
+    uint64_t m_seenRevision = 0;
+    size_t m_lineCount = 0;
+
+    std::chrono::milliseconds m_pollInterval{500};
+    std::chrono::steady_clock::time_point m_lastPoll;
+
+    // 显示
+    bool m_followTail = true;
+    size_t m_maxLineBytes = 4096;
+    FontSpec m_fontSpec;
+    float m_lineHeight = 0.0f;
+    float m_maxLineWidth = 0.0f;   // 已显示行的最大宽度（只增不减）
+};
+
+} // namespace liteDui
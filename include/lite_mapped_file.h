@@ -0,0 +1,90 @@
+/**
+ * lite_mapped_file.h - 只读内存映射文件
+ *
+ * LiteFileHandle 打开文件并查询大小，map 把文件的前 size 字节只读映射为 LiteMappedFile。
+ * 映射以 shared_ptr 持有：文件增长后重新映射时，仍在后台线程读取旧映射的代码不受影响；
+ * 映射建立后即使关闭文件句柄也仍然有效。
+ *
+ * 映射只适合内容不会被截断的文件：访问超出新文件末尾的页面会触发 SIGBUS。
+ * 可能被截断的文件（如正在轮转的日志）应使用 LiteFileHandle::read。
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace liteDui {
+
+/**
+ * LiteMappedFile - 一段只读映射（size 为 0 时 data 为空）
+ */
+struct LiteMappedFile {
+    const char* data = nullptr;
+    uint64_t size = 0;
+#ifdef _WIN32
+    void* mapping = nullptr;
+#endif
+
+    LiteMappedFile() = default;
+    ~LiteMappedFile();
+
+    LiteMappedFile(const LiteMappedFile&) = delete;
+    LiteMappedFile& operator=(const LiteMappedFile&) = delete;
+
+    /**
+     * 提示内核将按顺序读取，加大预读
+     */
+    void adviseSequential() const;
+
+    /**
+     * 已读完的 [from, to) 中的整页不再需要常驻，交还给页缓存
+     */
+    void release(uint64_t from, uint64_t to) const;
+};
+
+/**
+ * LiteFileHandle - 只读文件句柄
+ */
+class LiteFileHandle {
+public:
+    LiteFileHandle() = default;
+    ~LiteFileHandle();
+
+    LiteFileHandle(const LiteFileHandle&) = delete;
+    LiteFileHandle& operator=(const LiteFileHandle&) = delete;
+
+    bool open(const std::string& path);
+    uint64_t querySize() const;
+
+    /**
+     * 从 offset 处读取最多 length 字节，返回实际读到的字节数（可在多个线程中同时调用）
+     * 文件已被截断时返回值小于 length，不会像访问映射那样触发 SIGBUS
+     */
+    size_t read(uint64_t offset, char* buffer, size_t length) const;
+
+    /**
+     * 提示内核将按顺序读取，加大预读
+     */
+    void adviseSequential() const;
+
+    /**
+     * 映射文件的前 size 字节（只读、共享），size 为 0 时返回空映射，失败返回 nullptr
+     */
+    std::shared_ptr<const LiteMappedFile> map(uint64_t size) const;
+
+    /**
+     * 打开并映射整个文件
+     */
+    static std::shared_ptr<const LiteMappedFile> mapFile(const std::string& path);
+
+private:
+#ifdef _WIN32
+    void* m_handle = reinterpret_cast<void*>(static_cast<intptr_t>(-1));   // INVALID_HANDLE_VALUE
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace liteDui
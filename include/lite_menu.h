@@ -60,6 +60,11 @@ public:
     void onMouseMoved(const MouseEvent& event) override;
     
 private:
+    // 根据菜单项文本计算菜单宽度（不小于 kMinMenuWidth）
+    float measureMenuWidth() const;
+
+    static constexpr float kMinMenuWidth = 180.0f;
+
     LiteMenu* m_menu;
     int m_hoverIndex = -1;
 };
@@ -0,0 +1,115 @@
+/**
+ * lite_mpsc_queue.h - 无锁多生产者单消费者队列
+ *
+ * 任意线程 push，单个消费者线程（通常是 UI 线程）一次取出全部元素。
+ * 基于链表：push 只有一次原子交换，不加锁、不会阻塞 UI 线程。
+ *
+ * 生产者在交换 head 与链接 next 之间被挂起时，消费者会暂时看不到其后的元素，
+ * 这些元素在下一次 drain 时取出，不会丢失。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * LiteMpscQueue - 无锁 MPSC 队列（T 需可默认构造和移动）
+ */
+template <typename T>
+class LiteMpscQueue {
+public:
+    LiteMpscQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+
+    ~LiteMpscQueue() {
+        std::vector<T> rest;
+        drain(rest);
+        if (m_tail != &m_stub) {
+            delete m_tail;
+        }
+    }
+
+    LiteMpscQueue(const LiteMpscQueue&) = delete;
+    LiteMpscQueue& operator=(const LiteMpscQueue&) = delete;
+
+    /**
+     * 入队（任意线程）
+     */
+    void push(T value) {
+        Node* node = new Node(std::move(value));
+        link(node, node);
+        m_size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * 批量入队（任意线程），整批只有一次原子交换，批内顺序保持不变
+     */
+    void pushBatch(std::vector<T> values) {
+        if (values.empty()) return;
+        Node* first = new Node(std::move(values[0]));
+        Node* last = first;
+        for (size_t i = 1; i < values.size(); ++i) {
+            Node* node = new Node(std::move(values[i]));
+            last->next.store(node, std::memory_order_relaxed);
+            last = node;
+        }
+        link(first, last);
+        m_size.fetch_add(values.size(), std::memory_order_relaxed);
+    }
+
+    /**
+     * 取出当前可见的元素追加到 out（仅消费者线程调用）
+     * @param maxCount 最多取出的个数
+     * @return 取出的个数
+     */
+    size_t drain(std::vector<T>& out, size_t maxCount = SIZE_MAX) {
+        size_t count = 0;
+        while (count < maxCount) {
+            Node* next = m_tail->next.load(std::memory_order_acquire);
+            if (!next) break;
+            out.push_back(std::move(next->value));
+            // 已取出的节点成为新的哨兵
+            if (m_tail != &m_stub) {
+                delete m_tail;
+            }
+            m_tail = next;
+            ++count;
+        }
+        if (count > 0) {
+            m_size.fetch_sub(count, std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    /**
+     * 近似元素数（生产者并发入队时只作参考）
+     */
+    size_t sizeApprox() const { return m_size.load(std::memory_order_relaxed); }
+    bool empty() const { return sizeApprox() == 0; }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value;
+
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+    };
+
+    void link(Node* first, Node* last) {
+        Node* prev = m_head.exchange(last, std::memory_order_acq_rel);
+        prev->next.store(first, std::memory_order_release);
+    }
+
+    std::atomic<Node*> m_head;    // 最后入队的节点（生产者端）
+    Node* m_tail;                 // 哨兵：其 next 为下一个待取出的节点（消费者端）
+    Node m_stub;
+    std::atomic<size_t> m_size{0};
+};
+
+} // namespace liteDui
@@ -0,0 +1,123 @@
+/**
+ * lite_piece_table.h - 分片表文本缓冲区
+ *
+ * 为大文本编辑提供 O(片段数) 的插入/删除：
+ * - 原始文本只读保存，新输入的文本追加到 add 缓冲区
+ * - 文档由若干指向两个缓冲区的片段（piece）顺序组成
+ * - 两个缓冲区各自维护换行符位置表，按行号定位和按偏移求行号均为二分查找
+ *
+ * 所有偏移均为 UTF-8 字节偏移，行以 '\n' 分隔（行文本不含换行符）。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * LitePieceTable - 分片表
+ */
+class LitePieceTable {
+public:
+    LitePieceTable();
+    explicit LitePieceTable(std::string text);
+
+    /**
+     * 整体替换文本（原始缓冲区接管字符串，不做拷贝）
+     */
+    void setText(std::string text);
+
+    /**
+     * 文本总字节数
+     */
+    size_t length() const { return m_length; }
+    bool empty() const { return m_length == 0; }
+
+    /**
+     * 行数（空文本为 1 行）
+     */
+    size_t getLineCount() const { return m_lineBreaks + 1; }
+
+    /**
+     * 行首字节偏移
+     */
+    size_t getLineStart(size_t line) const;
+
+    /**
+     * 行的字节长度（不含换行符）
+     */
+    size_t getLineLength(size_t line) const;
+
+    /**
+     * 获取偏移所在的行号
+     */
+    size_t getLineAt(size_t offset) const;
+
+    /**
+     * 获取整行文本（不含换行符）
+     */
+    std::string getLine(size_t line) const;
+
+    /**
+     * 获取 [offset, offset + count) 范围的文本
+     */
+    std::string getText(size_t offset, size_t count) const;
+    std::string getText() const { return getText(0, m_length); }
+
+    /**
+     * 在 offset 处插入文本
+     */
+    void insert(size_t offset, const std::string& text);
+
+    /**
+     * 删除 [offset, offset + count) 范围的文本
+     */
+    void erase(size_t offset, size_t count);
+
+    /**
+     * 统计范围内的换行符数量
+     */
+    size_t countLineBreaks(size_t offset, size_t count) const;
+
+private:
+    enum class Source : uint8_t { Original, Add };
+
+    struct Piece {
+        Source source;
+        size_t start;      // 在缓冲区中的起始偏移
+        size_t length;
+        size_t lineBreaks; // 片段内换行符数量
+    };
+
+    struct Buffer {
+        std::string text;
+        std::vector<size_t> lineBreaks;   // 换行符在缓冲区中的偏移（递增）
+    };
+
+    const Buffer& buffer(Source source) const {
+        return source == Source::Original ? m_original : m_add;
+    }
+
+    // 缓冲区 [start, start + length) 内的换行符数量
+    size_t countBufferBreaks(Source source, size_t start, size_t length) const;
+    // 找到包含 offset 的片段下标（offset == length() 时返回片段数）
+    size_t findPiece(size_t offset, size_t* pieceOffset) const;
+    // 在 offset 处切分片段，返回切分点之后片段的下标
+    size_t splitAt(size_t offset);
+    // 重建片段起点/换行数前缀和
+    void rebuildPrefix();
+
+    Buffer m_original;
+    Buffer m_add;
+    std::vector<Piece> m_pieces;
+    std::vector<size_t> m_pieceOffsets;     // 每个片段的文档起始偏移
+    std::vector<size_t> m_pieceLineBreaks;  // 每个片段之前的换行符总数
+    size_t m_length = 0;
+    size_t m_lineBreaks = 0;
+};
+
+} // namespace liteDui
@@ -0,0 +1,98 @@
+/**
+ * lite_row_heights.h - 可变行高的偏移索引
+ *
+ * 为虚拟化的列表/表格保存每行高度，并支持：
+ * - 行号 → 顶部偏移、偏移 → 行号：O(log n)
+ * - 修改单行高度：O(log n)
+ * - 尚未测量的行按估计高度计算，修改估计高度为 O(1)
+ *
+ * 内部用两棵 Fenwick 树分别累计已测量行的高度和行数，
+ * 前 i 行的总高度 = 已测量高度之和 + (i - 已测量行数) × 估计高度。
+ * 没有任何已测量行时不分配树，所有查询退化为乘除法。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * LiteRowHeights - 行高偏移索引
+ */
+class LiteRowHeights {
+public:
+    LiteRowHeights() = default;
+    explicit LiteRowHeights(float estimatedHeight) : m_estimate(estimatedHeight) {}
+
+    /**
+     * 清除所有已测量高度，行数设为 count
+     */
+    void reset(size_t count);
+
+    /**
+     * 一次设置全部行高（O(n) 建树），height <= 0 表示未测量
+     */
+    void assign(std::vector<float> heights);
+
+    size_t getCount() const { return m_count; }
+
+    /**
+     * 未测量行的估计高度
+     */
+    void setEstimatedHeight(float height) { m_estimate = height > 0 ? height : 0; }
+    float getEstimatedHeight() const { return m_estimate; }
+
+    // ==================== 单行 ====================
+
+    /**
+     * 设置已测量的行高；height <= 0 表示恢复为估计高度
+     */
+    void setHeight(size_t row, float height);
+    float getHeight(size_t row) const;
+    bool isMeasured(size_t row) const;
+    bool hasMeasuredRows() const { return m_measured > 0; }
+
+    // ==================== 偏移 ====================
+
+    /**
+     * 第 row 行的顶部偏移；row == getCount() 时为总高度
+     */
+    float getOffset(size_t row) const;
+    float getTotalHeight() const { return getOffset(m_count); }
+
+    /**
+     * 包含偏移 y 的行；y < 0 返回 0，y 超出总高度返回 getCount()
+     */
+    size_t getRowAt(float y) const;
+
+    // ==================== 行变化 ====================
+    // 新插入的行未测量。变化点之后的行较少时（如在末尾追加、删除末尾的行）就地更新树，
+    // 为 O((n - index) log n)；否则（如从头部删除）在下一次查询时重建，为 O(n)，
+    // 两次查询之间的多次编辑只重建一次
+
+    void insertRows(size_t index, size_t count);
+    void removeRows(size_t index, size_t count);
+
+private:
+    void ensureTree() const;
+    void addToTree(size_t row, double height, int32_t count);
+    void updateTreeFrom(size_t index);
+    void extendTree(size_t from) const;
+
+    size_t m_count = 0;
+    float m_estimate = 0;
+
+    // 每行的已测量高度，0 表示未测量；没有已测量行时为空
+    std::vector<float> m_heights;
+    size_t m_measured = 0;
+
+    // Fenwick 树（下标从 1 开始），只累计已测量的行
+    mutable std::vector<double> m_heightTree;
+    mutable std::vector<int32_t> m_countTree;
+    mutable bool m_treeDirty = false;
+};
+
+} // namespace liteDui
@@ -0,0 +1,115 @@
+/**
+ * lite_row_prefetcher.h - 行文本整形预取
+ *
+ * 虚拟化列表/表格只为可见行整形文本。快速滚动到新区域时，
+ * 一帧内要整形一整屏文本，容易掉帧。LiteRowPrefetcher 根据滚动速度
+ * 预测即将进入视口的行，在 LiteTaskPool 的工作线程中提前整形，
+ * 结果进入 LiteTextRenderer 的整形缓存，绘制时只需取缓存。
+ *
+ * 预取窗口移动后，已滑出窗口的行不再整形：排队中的任务被丢弃，
+ * 正在执行的任务在处理每一行前检查窗口与代号。
+ */
+
+#pragma once
+
+#include "lite_font_manager.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * LiteRowPrefetcher - 行文本整形预取器
+ *
+ * 只能在 UI 线程调用；由控件持有，随控件销毁时取消全部未完成的预取。
+ */
+class LiteRowPrefetcher {
+public:
+    // 收集一行需要绘制的文本（UI 线程调用，文本被拷贝到后台任务中）
+    using RowTextProvider = std::function<void(size_t row, std::vector<std::string>& texts)>;
+
+    LiteRowPrefetcher();
+    ~LiteRowPrefetcher();
+
+    LiteRowPrefetcher(const LiteRowPrefetcher&) = delete;
+    LiteRowPrefetcher& operator=(const LiteRowPrefetcher&) = delete;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * 预取提前量（秒）：按当前滚动速度折算为视口外需要预取的行数
+     */
+    void setLookahead(float seconds) { m_lookahead = seconds > 0 ? seconds : 0; }
+    float getLookahead() const { return m_lookahead; }
+
+    /**
+     * 绘制时调用：更新滚动速度并提交视口外需要预取的行
+     * @param scrollY 当前垂直滚动偏移
+     * @param rowHeight 行高
+     * @param firstVisible, lastVisible 可见行范围（闭区间）
+     * @param rowCount 总行数
+     * @param font 绘制使用的字体
+     * @param provider 行文本提供者
+     */
+    void update(float scrollY, float rowHeight, size_t firstVisible, size_t lastVisible,
+                size_t rowCount, const FontSpec& font, const RowTextProvider& provider);
+
+    /**
+     * 取消所有未完成的预取（行内容变化时调用）
+     */
+    void cancel();
+
+    /**
+     * 头部 count 行被删除、其余行依次前移时调用（滚动保留最新行）
+     * 已提交的预取继续有效，任务按删除的行数换算行号
+     */
+    void shiftRows(size_t count);
+
+    /**
+     * 当前估计的滚动速度（行/秒，向下为正）
+     */
+    float getVelocity() const { return m_velocity; }
+
+private:
+    // UI 线程与工作线程共享的状态，任务据此判断自己是否已过期
+    struct SharedState {
+        std::atomic<uint64_t> generation{0};
+        std::atomic<size_t> windowBegin{0};
+        std::atomic<size_t> windowEnd{0};
+        std::atomic<size_t> shifted{0};   // shiftRows 累计前移的行数
+    };
+
+    // 一个后台任务处理的一批行
+    struct Batch {
+        std::vector<size_t> rows;
+        std::vector<std::vector<std::string>> texts;
+    };
+
+    static constexpr size_t kBatchRows = 8;
+
+    void submitBatch(Batch&& batch);
+
+    uint64_t m_group;
+    std::shared_ptr<SharedState> m_state;
+    bool m_enabled = true;
+    float m_lookahead = 0.3f;
+
+    // 滚动速度估计（行/秒，指数平滑）
+    float m_velocity = 0.0f;
+    float m_lastScrollY = 0.0f;
+    float m_lastRowHeight = 0.0f;
+    bool m_hasLastSample = false;
+    std::chrono::steady_clock::time_point m_lastSampleTime;
+
+    // 已提交的预取窗口 [m_submittedBegin, m_submittedEnd)
+    size_t m_submittedBegin = 0;
+    size_t m_submittedEnd = 0;
+    FontSpec m_font;
+};
+
+} // namespace liteDui
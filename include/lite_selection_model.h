@@ -0,0 +1,116 @@
+/**
+ * lite_selection_model.h - 行选择模型
+ *
+ * LiteTable 与 LiteList 共用的选择状态，按有序、互不相交的区间保存选中的行：
+ * - 成员查询为 O(log r)（r 为区间数）
+ * - 全选与清空只保留 0 或 1 个区间，与行数无关
+ * - 连续范围（Shift + 点击）只增加一个区间
+ * - 变化通知按区间报告，而不是每行一次
+ */
+
+#pragma once
+
+#include "lite_listener_list.h"
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * 行区间 [first, first + count)
+ */
+struct SelectionRange {
+    size_t first = 0;
+    size_t count = 0;
+
+    size_t end() const { return first + count; }
+};
+
+/**
+ * LiteSelectionModel - 区间集合形式的选择模型
+ */
+class LiteSelectionModel {
+public:
+    /**
+     * 选择变化监听器，changed 为发生变化的行所在的最小区间
+     */
+    using ChangeListener = std::function<void(const SelectionRange& changed)>;
+
+    // ==================== 查询 ====================
+
+    bool isSelected(size_t index) const;
+    bool isEmpty() const { return m_ranges.empty(); }
+    size_t getCount() const { return m_count; }
+
+    /**
+     * 第一个选中的行，没有选中时返回 -1
+     */
+    long long getFirst() const { return m_ranges.empty() ? -1 : static_cast<long long>(m_ranges.front().first); }
+
+    const std::vector<SelectionRange>& getRanges() const { return m_ranges; }
+
+    /**
+     * 展开为行号列表（只在需要逐行处理时调用）
+     */
+    std::vector<size_t> getSelectedIndices() const;
+
+    // ==================== 修改 ====================
+
+    void select(size_t index) { selectRange(index, 1); }
+    void deselect(size_t index) { deselectRange(index, 1); }
+    void toggle(size_t index);
+
+    void selectRange(size_t first, size_t count);
+    void deselectRange(size_t first, size_t count);
+
+    /**
+     * 选中一组行（可无序、可重复），合并为区间后只通知一次
+     */
+    void selectIndices(std::vector<size_t> indices);
+
+    /**
+     * 只选中 index（单选）
+     */
+    void setSingle(size_t index);
+
+    void selectAll(size_t itemCount);
+    void clear();
+
+    /**
+     * 只保留第一个选中的行（切换到单选模式时使用）
+     */
+    void keepFirst();
+
+    /**
+     * Shift + 点击的起点，-1 表示没有
+     */
+    void setAnchor(long long index) { m_anchor = index; }
+    long long getAnchor() const { return m_anchor; }
+
+    // ==================== 行变化 ====================
+    // 数据插入/删除行时平移选择，不发出通知
+
+    void insertItems(size_t index, size_t count);
+    void removeItems(size_t index, size_t count);
+
+    // ==================== 监听 ====================
+
+    size_t addListener(ChangeListener listener);
+    void removeListener(size_t id);
+
+private:
+    // 返回实际变化的行数
+    size_t addRange(size_t first, size_t end);
+    size_t removeRange(size_t first, size_t end);
+    void notify(size_t first, size_t end);
+
+    std::vector<SelectionRange> m_ranges;   // 按 first 升序，互不相交且不相邻
+    size_t m_count = 0;
+    long long m_anchor = -1;
+
+    LiteListenerList<const SelectionRange&> m_listeners;
+};
+
+} // namespace liteDui
@@ -62,6 +62,14 @@ public:
      */
     void end();
 
+    /**
+     * 在离屏表面上执行字形预热（见 LiteFontManager::runWarmUp），空闲帧调用
+     * 字体尚未初始化完成时直接返回，不阻塞
+     * @param budgetMs 本次最多占用的时间
+     * @return 仍有剩余任务返回 true
+     */
+    bool warmUpGlyphs(double budgetMs);
+
 private:
     void* m_windowId;  // 存储 GLFWwindow* 指针
     int m_width;
@@ -69,6 +77,10 @@ private:
     
     sk_sp<GrDirectContext> m_context;
     sk_sp<SkSurface> m_surface;
+
+    // 字形预热
+    sk_sp<SkSurface> m_warmUpSurface;
+    size_t m_warmUpCursor = 0;
     
     /**
      * 初始化Skia GPU上下文和表面
@@ -5,6 +5,19 @@
 #pragma once
 
 #include "lite_scroll_view.h"
+#include "lite_cell_renderer.h"
+#include "lite_csv_loader.h"
+#include "lite_mpsc_queue.h"
+#include "lite_row_heights.h"
+#include "lite_row_prefetcher.h"
+#include "lite_selection_model.h"
+#include "lite_table_model.h"
+#include "lite_table_filter.h"
+#include "lite_table_grouping.h"
+#include "lite_table_sorter.h"
+#include <deque>
+#include <map>
+#include <unordered_set>
 #include <vector>
 
 namespace liteDui {
@@ -20,50 +33,44 @@ struct TableColumn {
     float width = 100.0f;
     TextAlign align = TextAlign::Left;
     bool resizable = true;
+    bool sortable = true;                          // 点击表头是否排序
+    TableSortType sortType = TableSortType::Auto;  // 排序时的比较方式
+    LiteCellRendererPtr renderer;                  // 为空时按文本绘制
+    TableAggregate aggregate = TableAggregate::None;   // 组头与页脚中显示的聚合值
 
     TableColumn() = default;
     TableColumn(const std::string& t, float w = 100.0f, TextAlign a = TextAlign::Left)
         : title(t), width(w), align(a) {}
 };
 
-/**
- * 表格单元格
- */
-struct TableCell {
-    std::string text;
-    Color textColor = Color::Black();
-    Color backgroundColor = Color::Transparent();
-    void* userData = nullptr;
-
-    TableCell() = default;
-    TableCell(const std::string& t) : text(t) {}
-};
-
-/**
- * 表格行
- */
-struct TableRow {
-    std::vector<TableCell> cells;
-    bool selected = false;
-    void* userData = nullptr;
-
-    TableRow() = default;
-    TableRow(const std::vector<std::string>& texts) {
-        for (const auto& t : texts) {
-            cells.emplace_back(t);
-        }
-    }
-};
-
 /**
  * LiteTable - 表格控件
  * 
- * 支持多列显示、行选择、表头固定、可滚动
+ * 支持多列显示、行选择、表头固定、可滚动。
+ * 数据来自 LiteTableModel，绘制时只查询可见单元格；
+ * 默认使用内置的 LiteRowTableModel，addRow 等行操作作用于内置模型。
+ *
+ * 排序与筛选只改变显示的行（视图行 -> 模型行的映射），不移动模型数据；
+ * 除 getModelRow / getViewRow 外，接口与回调中的行号均为模型行号。
+ * 点击表头按该列排序，再次点击切换降序、第三次取消；Shift + 点击追加为次要排序键。
+ * 按列分组时每组前插入一个组头行（点击折叠/展开），组头行没有对应的模型行。
  */
 class LiteTable : public LiteScrollView {
 public:
     LiteTable();
-    ~LiteTable() override = default;
+    ~LiteTable() override;
+
+    // 数据模型
+    /**
+     * 设置数据模型，传入 nullptr 恢复内置模型
+     * 表格第 i 列显示模型第 i 列的数据，列的标题、宽度和对齐仍由 addColumn 定义
+     */
+    void setModel(std::shared_ptr<LiteTableModel> model);
+    std::shared_ptr<LiteTableModel> getModel() const { return m_model; }
+    /**
+     * 内置行模型（未设置自定义模型时即为当前模型）
+     */
+    std::shared_ptr<LiteRowTableModel> getRowModel() const { return m_rowModel; }
 
     // 列管理
     void addColumn(const std::string& title, float width = 100.0f, TextAlign align = TextAlign::Left);
@@ -75,16 +82,63 @@ public:
     const TableColumn* getColumn(size_t index) const;
     void setColumnWidth(size_t index, float width);
 
-    // 行管理
+    /**
+     * 设置列的单元格渲染器（进度条、迷你折线图等），nullptr 恢复为文本绘制
+     */
+    void setColumnRenderer(size_t index, LiteCellRendererPtr renderer);
+
+    /**
+     * 冻结左侧 count 列：不随水平滚动，在独立的裁剪区域中绘制（与固定表头相同）
+     */
+    void setFrozenColumnCount(size_t count);
+    size_t getFrozenColumnCount() const { return m_frozenColumns; }
+
+    // 行管理（作用于内置模型；使用自定义模型时 addRow 等操作无效，getRow 返回 nullptr）
     void addRow(const std::vector<std::string>& cells);
     void insertRow(size_t index, const std::vector<std::string>& cells);
     void removeRow(size_t index);
     void clearRows();
-    size_t getRowCount() const { return m_rows.size(); }
+    size_t getRowCount() const { return m_model->getRowCount(); }
+
+    /**
+     * 用新的快照刷新内置模型（可移入）：按键与现有行对应，只插入、删除、移动新增/消失/
+     * 换位的行并更新文本变化的单元格；选中行、行高随行保留，视口内第一个选中行
+     * （没有时为顶部行）保持屏幕位置。见 LiteRowTableModel::setRows
+     */
+    void setRows(std::vector<std::vector<std::string>> rows, const LiteRowTableModel::RowKeyFunction& key);
+    void setRows(std::vector<std::vector<std::string>> rows, size_t keyColumn);
+
+    /**
+     * 流式写入：任意线程向队列 push 行（单元格文本），UI 线程在 update 中
+     * 每帧一次性取出并批量追加到内置模型（使用自定义模型时丢弃）
+     */
+    using RowQueue = LiteMpscQueue<std::vector<std::string>>;
+    std::shared_ptr<RowQueue> getRowQueue();
+
+    /**
+     * 内置模型最多保留的行数，超出时丢弃最旧的行；0 表示不限制
+     */
+    void setMaxRowCount(size_t count);
+    size_t getMaxRowCount() const { return m_maxRowCount; }
+
+    /**
+     * 从队列追加行时，如果已滚动到底部则保持在底部
+     */
+    void setAutoScrollToTail(bool enabled) { m_autoScrollToTail = enabled; }
+    bool isAutoScrollToTail() const { return m_autoScrollToTail; }
+
+    /**
+     * 后台并行加载 CSV/TSV 文件：替换为新的 LiteColumnarTableModel 并按表头重建列，
+     * 首块解析完成即开始显示，其余行在 update 中逐帧追加（数值列右对齐）
+     * @return 加载器（用于查询进度或取消）；无法打开文件时返回 nullptr，表格不变
+     */
+    std::shared_ptr<LiteCsvLoader> loadCsv(const std::string& path,
+                                           const CsvLoadOptions& options = CsvLoadOptions());
+
     TableRow* getRow(size_t index);
     const TableRow* getRow(size_t index) const;
 
-    // 单元格操作
+    // 单元格操作（getCellText 对任意模型有效）
     void setCellText(size_t row, size_t col, const std::string& text);
     std::string getCellText(size_t row, size_t col) const;
     void setCellColor(size_t row, size_t col, const Color& textColor, const Color& bgColor = Color::Transparent());
@@ -96,14 +150,106 @@ public:
     int getSelectedRow() const;
     std::vector<int> getSelectedRows() const;
     void clearSelection();
+    void selectAll();   // 仅多选模式；筛选时只选中可见行
+    /**
+     * 选择模型（按模型行号的区间保存），可直接监听按区间报告的选择变化
+     */
+    LiteSelectionModel& getSelectionModel() { return m_selection; }
+    const LiteSelectionModel& getSelectionModel() const { return m_selection; }
+
+    // 排序（在后台线程进行，完成前保持原有顺序）
+    void setSortingEnabled(bool enabled) { m_sortingEnabled = enabled; }
+    bool isSortingEnabled() const { return m_sortingEnabled; }
+    void sortByColumn(size_t column, bool ascending = true);
+    /**
+     * 设置多列排序键，第一个为主键；传入空列表取消排序
+     */
+    void setSortKeys(const std::vector<TableSortKey>& keys);
+    const std::vector<TableSortKey>& getSortKeys() const { return m_sortKeys; }
+    void clearSort() { setSortKeys({}); }
+    /**
+     * 是否有排序正在后台进行
+     */
+    bool isSortPending() const { return m_sortDirty || m_sorter.isBusy(); }
+    double getLastSortTime() const { return m_sorter.getLastSortTime(); }
+
+    // 筛选（在后台线程进行，完成前保持原有结果）
+    /**
+     * 快速搜索：只显示任意一列包含 text 的行，空字符串取消文本筛选
+     * 在上一次的文本后继续输入时只在上一次的结果中查找
+     */
+    void setFilterText(const std::string& text);
+    const std::string& getFilterText() const { return m_filterText; }
+    /**
+     * 参与搜索的模型列，为空表示全部列
+     */
+    void setFilterColumns(const std::vector<size_t>& columns);
+    void setFilterCaseSensitive(bool caseSensitive);
+    /**
+     * 行谓词，与文本筛选同时生效；在后台线程调用，见 LiteTableFilter::Predicate
+     */
+    void setFilterPredicate(LiteTableFilter::Predicate predicate);
+    void clearFilter();
+    bool isFiltered() const { return m_filterActive; }
+    bool isFilterPending() const { return m_filterDirty || m_filter.isBusy(); }
+    double getLastFilterTime() const { return m_filter.getLastFilterTime(); }
+
+    // 分组（组按键的自然顺序排列，主排序键为分组列且降序时倒序；组内保持排序顺序）
+    /**
+     * 按该列的单元格文本分组，-1 取消分组
+     */
+    void setGroupColumn(int column);
+    int getGroupColumn() const { return m_grouping.getKeyColumn(); }
+    /**
+     * 列的聚合方式，显示在组头行与页脚中；聚合值随模型变化增量维护，
+     * 小计按组内全部行计算，不受筛选影响
+     */
+    void setColumnAggregate(size_t index, TableAggregate aggregate);
+    TableAggregate getColumnAggregate(size_t index) const;
+    void setGroupExpanded(const std::string& key, bool expanded);
+    bool isGroupExpanded(const std::string& key) const;
+    void expandAllGroups();
+    void collapseAllGroups();
+    bool isGrouped() const { return m_grouping.getKeyColumn() >= 0; }
+    const LiteTableGrouping& getGrouping() const { return m_grouping; }
+
+    /**
+     * 在视口底部固定显示一行全表聚合值（与表头等高）
+     */
+    void setShowFooter(bool show);
+    bool isShowFooter() const { return m_showFooter; }
+
+    // 显示的行数（筛选后，分组时包括组头行）
+    size_t getVisibleRowCount() const;
+
+    // 视图行（显示位置）与模型行互相转换，被筛选掉的模型行返回 -1，组头行返回 SIZE_MAX
+    size_t getModelRow(size_t viewRow) const;
+    int getViewRow(size_t modelRow) const;
 
     // 样式设置
     void setHeaderHeight(float height) { m_headerHeight = height; markDirty(); }
     float getHeaderHeight() const { return m_headerHeight; }
 
-    void setRowHeight(float height) { m_rowHeight = height; markDirty(); }
+    // 默认行高，也是尚未测量的行的估计高度
+    void setRowHeight(float height);
     float getRowHeight() const { return m_rowHeight; }
 
+    /**
+     * 可变行高（按模型行），height <= 0 表示恢复为默认行高
+     */
+    void setRowHeightAt(size_t row, float height);
+    float getRowHeightAt(size_t row) const;
+
+    /**
+     * 行高测量回调（参数为模型行），行第一次进入视口时调用并缓存结果，
+     * 尚未测量的行按默认行高估计；行内容变化后重新测量
+     */
+    void setRowHeightProvider(std::function<float(size_t row)> provider);
+
+    // 丢弃已设置/测量的行高（如换行文本的列宽变化后），有测量回调时重新测量
+    void invalidateRowHeight(size_t row);
+    void invalidateRowHeights();
+
     void setHeaderBackgroundColor(const Color& color) { m_headerBgColor = color; markDirty(); }
     void setHeaderTextColor(const Color& color) { m_headerTextColor = color; markDirty(); }
 
@@ -111,16 +257,26 @@ public:
     void setHoverRowColor(const Color& color) { m_hoverRowColor = color; markDirty(); }
     void setAlternateRowColor(const Color& color) { m_alternateRowColor = color; markDirty(); }
 
+    void setGroupRowColor(const Color& color) { m_groupRowColor = color; markDirty(); }
     void setGridColor(const Color& color) { m_gridColor = color; markDirty(); }
     void setShowGrid(bool show) { m_showGrid = show; markDirty(); }
     void setShowHeader(bool show) { m_showHeader = show; markDirty(); }
     void setShowAlternateRows(bool show) { m_showAlternateRows = show; markDirty(); }
 
+    // 后台预取即将滚入视口的行的文本整形结果
+    void setPrefetchEnabled(bool enabled) { m_prefetcher.setEnabled(enabled); }
+    bool isPrefetchEnabled() const { return m_prefetcher.isEnabled(); }
+
     // 回调
     void setOnSelectionChanged(SelectionChangedCallback callback);
     void setOnRowClicked(std::function<void(int)> callback);
     void setOnRowDoubleClicked(std::function<void(int)> callback);
     void setOnCellClicked(std::function<void(int, int)> callback);
+    void setOnSortChanged(std::function<void()> callback);
+    void setOnFilterChanged(std::function<void()> callback);
+
+    // 取出流式写入的行，取回后台排序/筛选结果
+    void update() override;
 
     // 重写渲染
     void render(SkCanvas* canvas) override;
@@ -142,15 +298,181 @@ private:
     int getRowIndexAtY(float y) const;
     int getColumnIndexAtX(float x) const;
     float getTotalColumnWidth() const;
-    void drawHeader(SkCanvas* canvas);
-    void drawRow(SkCanvas* canvas, size_t index, float y);
-    void drawCell(SkCanvas* canvas, const TableCell& cell, float x, float y, float width, float height, TextAlign align);
-    void drawGrid(SkCanvas* canvas);
+    // 列左边界的前缀和，共 列数 + 1 项，最后一项为总宽度
+    const std::vector<float>& columnOffsets() const;
+    /**
+     * 与内容坐标区间 [left, right) 相交的列范围
+     * @return 没有相交的列时返回 false
+     */
+    bool getVisibleColumns(float left, float right, size_t& first, size_t& last) const;
+    // 实际冻结的列数与冻结区宽度（不超过列数与视口宽度）
+    size_t frozenColumnCount() const;
+    float frozenWidth() const;
+    // 视口内的 x（相对内容区域左侧）转换为内容坐标，冻结区不加水平滚动偏移
+    float viewportXToContentX(float x) const;
+    // 表头与页脚之间的行区域高度
+    float bodyHeight() const;
+    float footerHeight() const { return m_showFooter ? m_headerHeight : 0; }
+    // 可见行范围（闭区间），同时测量其中尚未测量的行
+    bool getVisibleRows(size_t& first, size_t& last);
+    void drawHeader(SkCanvas* canvas, size_t firstColumn, size_t lastColumn);
+    void drawBody(SkCanvas* canvas, size_t firstRow, size_t lastRow, size_t firstColumn, size_t lastColumn);
+    void drawRow(SkCanvas* canvas, size_t index, float y, float height, size_t firstColumn, size_t lastColumn);
+    void drawGroupRow(SkCanvas* canvas, size_t group, float y, float height, size_t firstColumn, size_t lastColumn);
+    void drawFooter(SkCanvas* canvas, size_t firstColumn, size_t lastColumn);
+    // 在单元格中右对齐绘制列的聚合值
+    void drawAggregate(SkCanvas* canvas, size_t col, const TableAggregateValue& value, const Color& color,
+                       float x, float y, float width, float height);
+    void drawCell(SkCanvas* canvas, const std::string& text, const TableCellStyle& style,
+                  float x, float y, float width, float height, TextAlign align);
+    void drawRendererCell(SkCanvas* canvas, LiteCellRenderer& renderer, size_t modelRow, size_t col,
+                          float x, float y, float width, float height, TextAlign align);
+    bool usesShapedText(size_t col) const;   // 该列是否需要文本整形（行预取只整形这些列）
+    void drawGrid(SkCanvas* canvas, size_t firstRow, size_t lastRow, size_t firstColumn, size_t lastColumn);
+    void drawSortIndicator(SkCanvas* canvas, size_t column, float x, float width);
+
+    // 排序
+    int findSortKey(size_t column) const;
+    void onHeaderClicked(size_t column, bool additive);
+    void requestSort();
+    void applySortResult(LiteTableSorter::Permutation permutation);
+    // 把 revision 时的排序排列（permutation 为 true）或筛选结果按之后的变化日志映射到当前行号
+    // 日志不完整或期间模型被重置时返回 false
+    bool remapStaleRows(uint64_t revision, std::vector<uint32_t>& rows, bool permutation) const;
+    void resetSortOrder();
+
+    // 筛选
+    bool hasFilter() const { return !m_filterText.empty() || m_filterPredicate != nullptr; }
+    void requestFilter();
+    // complete 为 false 表示结果由过期结果映射而来，缺少期间新增的行
+    void applyFilterResult(LiteTableFilter::RowList rows, bool complete);
+
+    // 分组
+    // 按列的聚合方式重新配置并重建分组
+    void reconfigureGrouping(int keyColumn);
+    void buildGroupView();
+    // 视图行为组头行时返回组号，否则返回 -1
+    int getGroupAt(size_t viewRow) const;
+    // 模型变化后第一次标记分组视图待重建时记下悬停项
+    void captureGroupHover();
+    // 合并本帧的模型变化重建分组视图：保留预取与悬停项
+    void refreshGroupView();
+
+    // 视图行映射
+    // 重建显示顺序并丢弃与视图行号相关的悬停、预取状态
+    void rebuildView();
+    void buildView();
+    long long findScrollAnchor(float& offset) const;
+    // 选中视图行 [fromView, toView] 对应的模型行
+    void selectViewRange(size_t fromView, size_t toView);
+
+    // 按快照刷新：apply 修改模型期间跟踪滚动锚点
+    void refreshRows(const std::function<void()>& apply);
+
+    // 流式写入
+    void drainRowQueue();
+    // 为即将追加的 incoming 行腾出空间，返回删除的行数
+    size_t trimRows(size_t incoming);
+    bool isAtBottom() const;
+
+    // 行高
+    // 按视图顺序排列的行高索引，显示顺序或行高变化后按需重建
+    const LiteRowHeights& rowHeights() const;
+    void storeRowHeight(size_t modelRow, float height);
+    // 测量从 firstView 开始、顶部在 bottom 之上的未测量行
+    void measureRows(size_t firstView, float bottom);
+    void restoreScrollAnchor(long long anchor, float offset);
+    const std::vector<uint32_t>& viewOrder() const;
+    const std::vector<uint32_t>& modelToView() const;
+
+    // 当前模型为内置模型时返回它，否则返回 nullptr
+    LiteRowTableModel* activeRowModel() const;
+    void attachModel();
+    void detachModel();
+    void onModelChanged(const TableModelChange& change);
 
     std::vector<TableColumn> m_columns;
-    std::vector<TableRow> m_rows;
+    mutable std::vector<float> m_columnOffsets;
+    mutable bool m_columnOffsetsDirty = true;
+    std::shared_ptr<LiteRowTableModel> m_rowModel;
+    std::shared_ptr<LiteTableModel> m_model;
+    size_t m_modelListener = 0;
+
+    // 选中的模型行号（与模型数据分离，行插入/删除时随之平移，重新排序时保持不变）
+    LiteSelectionModel m_selection;
     ListSelectionMode m_selectionMode = ListSelectionMode::Single;
-    int m_hoverRow = -1;
+    int m_hoverRow = -1;   // 视图行
+
+    // 排序状态
+    std::vector<TableSortKey> m_sortKeys;
+    std::vector<uint32_t> m_sortOrder;             // 全部模型行的排序结果，为空表示模型顺序
+    bool m_sortingEnabled = true;
+    bool m_sortDirty = false;
+    uint64_t m_modelRevision = 0;
+    LiteTableSorter m_sorter;
+    std::map<size_t, LiteTableSorter::ColumnSnapshot> m_sortSnapshots;   // 排序键列的增量快照
+
+    // 模型变化日志：排序、筛选结果返回时模型已变化，按日志把结果映射到当前行号
+    struct LoggedChange {
+        uint64_t revision;
+        TableModelChange::Type type;
+        size_t first;
+        size_t count;
+        std::shared_ptr<const std::vector<uint32_t>> sources;   // RowsRemapped 的新行 -> 旧行
+    };
+    std::deque<LoggedChange> m_changeLog;
+    uint64_t m_changeLogStart = 0;   // 日志包含此版本之后的全部变化
+
+    // 筛选状态
+    std::string m_filterText;
+    std::vector<size_t> m_filterColumns;
+    bool m_filterCaseSensitive = false;
+    LiteTableFilter::Predicate m_filterPredicate;
+    uint64_t m_filterPredicateId = 0;               // 每次设置谓词递增
+    bool m_filterDirty = false;
+    bool m_filterActive = false;                    // 为 true 时只显示 m_filterRows
+    std::vector<uint32_t> m_filterRows;             // 通过筛选的模型行（升序）
+    // 参与搜索的列及其增量快照，模型变化后只重新复制变化的行
+    std::vector<size_t> m_filterSnapshotColumns;
+    std::vector<LiteTableFilter::ColumnSnapshot> m_filterSnapshots;
+    std::string m_requestedFilterText;
+    uint64_t m_requestedPredicateId = 0;
+    // 当前结果对应的查询，用于判断能否增量细化
+    std::string m_appliedFilterText;
+    uint64_t m_appliedPredicateId = 0;
+    uint64_t m_appliedFilterRevision = 0;
+    bool m_appliedFilterValid = false;
+    LiteTableFilter m_filter;
+
+    // 分组状态
+    LiteTableGrouping m_grouping;
+    std::unordered_set<std::string> m_collapsedGroups;   // 按组键记录，重新分组后保持
+    bool m_groupViewDirty = false;                        // 模型变化后在 update 中重新分组
+    // 分组视图待重建期间的悬停项：数据行按模型行跟踪，组头按组键
+    long long m_groupHoverRow = -1;
+    bool m_groupHoverHeader = false;
+    std::string m_groupHoverKey;
+    bool m_showFooter = false;
+
+    // 显示顺序：筛选时为通过筛选的行按排序顺序排列，否则直接使用 m_sortOrder；
+    // 分组时按组重排并插入组头项（kGroupRowFlag | 组号）
+    std::vector<uint32_t> m_viewToModel;
+    mutable std::vector<uint32_t> m_modelToView;   // 由显示顺序按需重建，被筛选掉的行为 UINT32_MAX
+    mutable bool m_modelToViewDirty = true;
+
+    // 流式写入
+    std::shared_ptr<RowQueue> m_rowQueue;
+    size_t m_maxRowCount = 0;
+    bool m_autoScrollToTail = true;
+    std::shared_ptr<LiteCsvLoader> m_csvLoader;   // 正在进行的 CSV 加载
+    long long m_trackedAnchor = -1;               // setRows 期间的滚动锚点（模型行），随行变化平移
+
+    // 行高：m_modelRowHeights 按模型行保存，0 表示未设置，为空表示全部为默认行高
+    // 用 deque 保存，流式写入从头部删除行时不移动其余行高
+    std::deque<float> m_modelRowHeights;
+    std::function<float(size_t)> m_rowHeightProvider;
+    mutable LiteRowHeights m_rowHeights;
+    mutable bool m_rowHeightsDirty = true;
 
     // 样式
     float m_headerHeight = 36.0f;
@@ -162,17 +484,23 @@ private:
     Color m_selectedRowColor = Color::fromRGB(66, 133, 244, 80);
     Color m_hoverRowColor = Color::fromRGB(200, 200, 200, 100);
     Color m_alternateRowColor = Color::fromRGB(250, 250, 250);
+    Color m_groupRowColor = Color::fromRGB(236, 240, 246);
     Color m_gridColor = Color::fromRGB(220, 220, 220);
 
     bool m_showGrid = true;
     bool m_showHeader = true;
+    size_t m_frozenColumns = 0;
     bool m_showAlternateRows = true;
 
+    LiteRowPrefetcher m_prefetcher;
+
     // 回调
     SelectionChangedCallback m_onSelectionChanged;
     std::function<void(int)> m_onRowClicked;
     std::function<void(int)> m_onRowDoubleClicked;
     std::function<void(int, int)> m_onCellClicked;
+    std::function<void()> m_onSortChanged;
+    std::function<void()> m_onFilterChanged;
 };
 
 } // namespace liteDui
@@ -0,0 +1,129 @@
+/**
+ * lite_table_filter.h - 表格后台筛选
+ *
+ * 根据快速搜索字符串和/或行谓词得到通过筛选的模型行列表：
+ * - 搜索在文本快照上进行，快照按行块把单元格连续存放，子串查找使用 SSE2
+ * - 快照按列增量维护，模型变化后 UI 线程只复制变化的行块
+ * - 字典编码的列只搜索块内用到的字典项，再按编号映射到行
+ * - 查询在上一次结果的基础上扩展时（新查询包含旧查询），只在旧结果中继续筛选
+ * - 在 LiteTaskPool 中执行，新请求会取消尚未完成的旧请求
+ */
+
+#pragma once
+
+#include "lite_table_model.h"
+#include "lite_table_snapshot.h"
+#include "lite_task_pool.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * LiteTableFilter - 表格后台筛选器
+ */
+class LiteTableFilter {
+public:
+    // 按升序排列的模型行号
+    using RowList = std::vector<uint32_t>;
+
+    /**
+     * 行谓词，在筛选线程中调用
+     * 只能读取调用方保证在筛选期间不变的数据（模型只能在 UI 线程访问）
+     */
+    using Predicate = std::function<bool(size_t row)>;
+
+    /**
+     * 一列中一段连续行的文本快照
+     * Text：text 为各行依次拼接（以 '\0' 分隔），offsets[i] 为第 i 行起点，共行数 + 1 项
+     * Dictionary：text / offsets 存放这些行用到的字典项，codes 为每行的字典编号（null 为 UINT32_MAX）
+     */
+    struct TextColumn {
+        std::string text;
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> codes;
+        bool dictionary = false;
+    };
+
+    // 按行块增量维护的列快照
+    using ColumnSnapshot = LiteTableSnapshot<TextColumn>;
+    using ColumnData = std::shared_ptr<const ColumnSnapshot::Data>;
+
+    /**
+     * 搜索用快照，在 UI 线程发布后只读共享
+     */
+    struct Snapshot {
+        size_t rowCount = 0;
+        bool caseSensitive = false;   // 为 false 时文本已转换为小写（仅 ASCII）
+        std::vector<ColumnData> columns;
+    };
+
+    /**
+     * 筛选请求
+     */
+    struct Query {
+        std::string text;                           // 为空表示不按文本筛选
+        std::shared_ptr<const Snapshot> snapshot;   // text 非空时必须提供
+        Predicate predicate;
+        size_t rowCount = 0;
+        std::shared_ptr<const RowList> candidates;  // 非空时只在这些行中筛选
+    };
+
+    LiteTableFilter() = default;
+
+    LiteTableFilter(const LiteTableFilter&) = delete;
+    LiteTableFilter& operator=(const LiteTableFilter&) = delete;
+
+    /**
+     * 生成第 col 列中 [first, first + count) 行的文本快照（供 ColumnSnapshot::publish 使用）
+     */
+    static std::shared_ptr<TextColumn> makeColumn(const LiteTableModel& model, size_t col, size_t first,
+                                                  size_t count, bool caseSensitive);
+
+    /**
+     * 一次性生成全部行的快照
+     * @param columns 参与搜索的模型列，为空表示全部列
+     */
+    static std::shared_ptr<Snapshot> makeSnapshot(const LiteTableModel& model,
+                                                  const std::vector<size_t>& columns,
+                                                  bool caseSensitive);
+
+    /**
+     * 提交筛选请求，取代尚未完成的请求
+     * @param revision 调用方的数据版本，随结果原样返回
+     */
+    void request(uint64_t revision, Query query);
+    void cancel();
+    bool isBusy() const { return m_task.isBusy(); }
+
+    /**
+     * 取走已完成的结果（UI 线程调用）
+     */
+    bool takeResult(RowList& rows, uint64_t& revision) { return m_task.takeResult(rows, revision); }
+
+    double getLastFilterTime() const { return m_task.getLastTime(); }
+
+    /**
+     * 同步筛选；cancel 被置位时返回 false
+     */
+    static bool filter(const Query& query, RowList& rows, const std::atomic<bool>* cancel = nullptr);
+
+    /**
+     * 在 haystack 中查找 needle，返回位置，找不到返回 SIZE_MAX
+     */
+    static size_t find(const char* haystack, size_t length, const char* needle, size_t needleLength);
+
+    /**
+     * ASCII 小写转换（与快照的大小写折叠一致）
+     */
+    static void foldCase(std::string& text);
+
+private:
+    LiteLatestTask<RowList> m_task;
+};
+
+} // namespace liteDui
@@ -0,0 +1,141 @@
+/**
+ * lite_table_grouping.h - 表格分组与聚合
+ *
+ * 按键列的单元格文本把模型行分组，并为指定的数值列维护每组和全表的聚合值
+ * （计数、求和、最小、最大、平均）：
+ * - 每行的组号与参与聚合的数值按列缓存，删除行时无需再读取模型
+ * - 行插入、删除、修改只增量更新受影响的组；去掉的恰好是最小/最大值时
+ *   只把该聚合标记为失效，查询时一次扫描重算所有失效的组
+ * - 全表聚合在连续的数值数组上计算（SSE2 下每次处理 2 个 double）
+ *
+ * 只在 UI 线程使用。
+ */
+
+#pragma once
+
+#include "lite_table_model.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * 聚合方式
+ */
+enum class TableAggregate {
+    None,
+    Count,     // 非空数值个数
+    Sum,
+    Min,
+    Max,
+    Average
+};
+
+/**
+ * 一组数值的聚合结果（空值与非数值不参与）
+ */
+struct TableAggregateValue {
+    size_t count = 0;
+    double sum = 0.0;
+    double min = 0.0;   // count 为 0 时无意义
+    double max = 0.0;
+
+    /**
+     * 按聚合方式取值；count 为 0 时 Min / Max / Average 返回 false
+     */
+    bool get(TableAggregate aggregate, double& value) const;
+};
+
+/**
+ * LiteTableGrouping - 分组与增量聚合
+ */
+class LiteTableGrouping {
+public:
+    static constexpr uint32_t kNoGroup = UINT32_MAX;
+
+    /**
+     * 设置键列（-1 表示不分组，只维护全表聚合）与参与聚合的列，之后需调用 rebuild
+     */
+    void configure(int keyColumn, std::vector<size_t> valueColumns);
+    int getKeyColumn() const { return m_keyColumn; }
+    const std::vector<size_t>& getValueColumns() const { return m_valueColumns; }
+
+    /**
+     * 列在 getValueColumns 中的下标，不参与聚合时返回 SIZE_MAX
+     */
+    size_t getValueIndex(size_t column) const;
+
+    /**
+     * 是否需要跟随模型变化（分组或有聚合列）
+     */
+    bool isEnabled() const { return m_keyColumn >= 0 || !m_valueColumns.empty(); }
+
+    // 模型变化（行号为变化后的模型行号，删除时为删除前的行号）
+    void rebuild(const LiteTableModel& model);
+    void rowsInserted(const LiteTableModel& model, size_t first, size_t count);
+    void rowsRemoved(size_t first, size_t count);
+    void rowsChanged(const LiteTableModel& model, size_t first, size_t count);
+    // sources 为每个新行对应的旧行（UINT32_MAX 为新插入），保留行不重新读取模型
+    void rowsRemapped(const LiteTableModel& model, const std::vector<uint32_t>& sources);
+
+    /**
+     * 行数为 0 的组多于有行的组的一半（且不少于 kMinCompactGroups）时丢弃它们并重新编号
+     * @return 是否重新编号；此后以前取得的组号失效
+     */
+    bool compact();
+
+    // 分组：组号在 rebuild 或 compact 之前保持稳定，行数为 0 的组保留到那时
+    size_t getGroupCount() const { return m_groups.size(); }
+    const std::string& getGroupKey(size_t group) const { return m_groups[group].key; }
+    size_t getGroupRowCount(size_t group) const { return m_groups[group].rowCount; }
+    uint32_t getRowGroup(size_t row) const { return row < m_rowGroups.size() ? m_rowGroups[row] : kNoGroup; }
+    int findGroup(const std::string& key) const;
+
+    // 聚合
+    const TableAggregateValue& getGroupValue(size_t group, size_t valueIndex) const;
+    const TableAggregateValue& getTotal(size_t valueIndex) const;
+
+    /**
+     * 计算连续数值的聚合（跳过 NaN）
+     */
+    static void aggregate(const double* values, size_t count, TableAggregateValue& out);
+
+private:
+    struct Group {
+        std::string key;
+        size_t rowCount = 0;
+    };
+
+    static constexpr size_t kMinCompactGroups = 64;
+
+    void reset();
+    size_t trackedRowCount() const;   // 已跟踪的行数
+    uint32_t groupFor(const std::string& key);
+    double readValue(const LiteTableModel& model, size_t row, size_t valueIndex) const;
+    void loadRows(const LiteTableModel& model, size_t first, size_t count);
+    void addRow(size_t row);
+    void subtractRow(size_t row);
+    void add(TableAggregateValue& target, double value);
+    void subtract(TableAggregateValue& target, double value, uint8_t& stale);
+    void resolve() const;
+
+    int m_keyColumn = -1;
+    std::vector<size_t> m_valueColumns;
+
+    std::vector<uint32_t> m_rowGroups;            // 每行的组号（不分组时为空）
+    std::vector<std::vector<double>> m_values;    // [聚合列][行]，空值为 NaN
+    std::vector<Group> m_groups;
+    std::unordered_map<std::string, uint32_t> m_groupIndex;
+    size_t m_emptyGroups = 0;                     // 行数为 0 的组数
+
+    // 聚合值：m_groupValues[group * 聚合列数 + 聚合列]；失效标记在查询时统一重算
+    mutable std::vector<TableAggregateValue> m_groupValues;
+    mutable std::vector<uint8_t> m_groupStale;
+    mutable std::vector<TableAggregateValue> m_totals;
+    mutable std::vector<uint8_t> m_totalStale;
+    mutable bool m_anyGroupStale = false;
+};
+
+} // namespace liteDui
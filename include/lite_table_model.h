@@ -0,0 +1,252 @@
+/**
+ * lite_table_model.h - 表格数据模型
+ *
+ * LiteTable 不直接持有数据，而是在绘制时按 (行, 列) 向模型查询可见单元格：
+ * - LiteTableModel 为抽象接口，百万行级别的数据可以按需生成或从外部存储读取
+ * - LiteRowTableModel 为内置实现，按行保存单元格（即原先 LiteTable 内部的存储方式）
+ *
+ * 模型变化通过监听器通知视图。模型只能在 UI 线程修改。
+ */
+
+#pragma once
+
+#include "lite_common.h"
+#include "lite_listener_list.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * 单元格样式，透明色表示使用表格默认值
+ */
+struct TableCellStyle {
+    Color textColor = Color::Transparent();
+    Color backgroundColor = Color::Transparent();
+};
+
+/**
+ * 模型变化描述
+ */
+struct TableModelChange {
+    enum class Type {
+        Reset,          // 整体替换，视图应丢弃所有与行号相关的状态
+        RowsInserted,   // 在 first 处插入 count 行
+        RowsRemoved,    // 删除 [first, first + count) 行
+        DataChanged,    // [first, first + count) 行的内容变化，行数不变
+        ColumnsChanged, // 列数变化
+        RowsRemapped    // 行被整体重排（含插入、删除），count 为变化前的行数，映射见 sources
+    };
+
+    Type type = Type::Reset;
+    size_t first = 0;
+    size_t count = 0;
+    // RowsRemapped：每个新行对应的旧行，UINT32_MAX 表示新插入；只在通知期间有效
+    const std::vector<uint32_t>* sources = nullptr;
+};
+
+/**
+ * 排序用的列数据快照
+ *
+ * 在 UI 线程生成，之后只由后台排序线程读取，排序期间模型仍可继续修改。
+ */
+struct TableSortColumn {
+    enum class Kind {
+        Text,        // strings 为每行文本
+        Int64,       // ints 为每行数值
+        Double,      // doubles 为每行数值
+        Dictionary   // codes 为每行的字典编号，strings 为字典（至少包含这些行用到的项）
+    };
+
+    Kind kind = Kind::Text;
+    std::vector<std::string> strings;
+    std::vector<int64_t> ints;
+    std::vector<double> doubles;
+    std::vector<uint32_t> codes;
+    std::vector<uint8_t> nulls;   // 为空表示没有 null；否则每行一个标记，1 表示 null（总是排在最后）
+};
+
+/**
+ * LiteTableModel - 表格数据模型接口
+ */
+class LiteTableModel {
+public:
+    using ChangeListener = std::function<void(const TableModelChange&)>;
+
+    virtual ~LiteTableModel() = default;
+
+    virtual size_t getRowCount() const = 0;
+    virtual size_t getColumnCount() const = 0;
+
+    /**
+     * 单元格文本（只会对可见单元格调用）
+     */
+    virtual std::string getCellText(size_t row, size_t col) const = 0;
+
+    /**
+     * 单元格样式，默认全部使用表格样式
+     */
+    virtual TableCellStyle getCellStyle(size_t /*row*/, size_t /*col*/) const { return TableCellStyle(); }
+
+    /**
+     * 生成第 col 列中 [first, first + count) 行的排序快照（按块增量复制时每次只取变化的行）
+     * 默认逐行调用 getCellText；带类型存储的模型应重写以提供数值或字典编码数据
+     */
+    virtual void getSortColumn(size_t col, size_t first, size_t count, TableSortColumn& out) const;
+
+    /**
+     * 生成第 col 列全部行的排序快照
+     */
+    void getSortColumn(size_t col, TableSortColumn& out) const { getSortColumn(col, 0, getRowCount(), out); }
+
+    /**
+     * 单元格数值（供数值类单元格渲染器使用，只会对可见单元格调用）
+     * 默认解析 getCellText；带类型存储的模型应重写以避免文本往返
+     * @return 单元格为空或不是数值时返回 false
+     */
+    virtual bool getCellNumber(size_t row, size_t col, double& value) const;
+
+    /**
+     * 单元格数值序列（供迷你折线图使用）
+     * 默认解析 getCellText 中以逗号、分号或空白分隔的数值
+     */
+    virtual bool getCellSeries(size_t row, size_t col, std::vector<double>& values) const;
+
+    /**
+     * 注册变化监听器
+     * @return 监听器 ID，用于 removeListener
+     */
+    size_t addListener(ChangeListener listener);
+    void removeListener(size_t id);
+
+protected:
+    void notify(const TableModelChange& change);
+    void notifyReset() { notify({TableModelChange::Type::Reset, 0, 0}); }
+    void notifyRowsInserted(size_t first, size_t count) { notify({TableModelChange::Type::RowsInserted, first, count}); }
+    void notifyRowsRemoved(size_t first, size_t count) { notify({TableModelChange::Type::RowsRemoved, first, count}); }
+    void notifyDataChanged(size_t first, size_t count) { notify({TableModelChange::Type::DataChanged, first, count}); }
+    void notifyColumnsChanged() { notify({TableModelChange::Type::ColumnsChanged, 0, 0}); }
+    void notifyRowsRemapped(size_t oldCount, const std::vector<uint32_t>& sources) {
+        notify({TableModelChange::Type::RowsRemapped, 0, oldCount, &sources});
+    }
+
+private:
+    LiteListenerList<const TableModelChange&> m_listeners;
+};
+
+/**
+ * 表格单元格（LiteRowTableModel 的存储单元）
+ */
+struct TableCell {
+    std::string text;
+    Color textColor = Color::Black();
+    Color backgroundColor = Color::Transparent();
+    void* userData = nullptr;
+
+    TableCell() = default;
+    TableCell(const std::string& t) : text(t) {}
+    TableCell(std::string&& t) : text(std::move(t)) {}
+};
+
+/**
+ * 表格行（LiteRowTableModel 的存储单元）
+ * 选择状态由 LiteTable 保存，不属于数据
+ */
+struct TableRow {
+    std::vector<TableCell> cells;
+    void* userData = nullptr;
+
+    TableRow() = default;
+    TableRow(const std::vector<std::string>& texts) {
+        cells.reserve(texts.size());
+        for (const auto& t : texts) {
+            cells.emplace_back(t);
+        }
+    }
+};
+
+/**
+ * LiteRowTableModel - 按行存储的内置表格模型
+ */
+class LiteRowTableModel : public LiteTableModel {
+public:
+    LiteRowTableModel() = default;
+    explicit LiteRowTableModel(size_t columnCount) : m_columnCount(columnCount) {}
+
+    size_t getRowCount() const override { return m_rows.size(); }
+    size_t getColumnCount() const override { return m_columnCount; }
+    std::string getCellText(size_t row, size_t col) const override;
+    TableCellStyle getCellStyle(size_t row, size_t col) const override;
+    using LiteTableModel::getSortColumn;
+    void getSortColumn(size_t col, size_t first, size_t count, TableSortColumn& out) const override;
+
+    /**
+     * 设置列数：新增行按列数补齐空单元格
+     */
+    void setColumnCount(size_t count);
+
+    // 行操作（cells 不足列数时补空，超出部分保留）
+    void addRow(const std::vector<std::string>& cells);
+    void insertRow(size_t index, const std::vector<std::string>& cells);
+    void removeRow(size_t index);
+    void clear();
+
+    /**
+     * 批量追加行，只发出一次变化通知
+     */
+    void addRows(std::vector<std::vector<std::string>> rows);
+
+    /**
+     * 删除 [first, first + count) 行，只发出一次变化通知
+     * 从头部删除（滚动保留最新的行）只移动被删除的行
+     */
+    void removeRows(size_t first, size_t count);
+
+    /**
+     * 用新的快照替换全部行：按键与现有行对应，保留行（含其颜色与 userData）只更新
+     * 文本变化的单元格，其余行插入或删除，视图因此能保留选择与行高。
+     * 没有行需要移动且变化区间较少时发出区间插入/删除通知，否则发出一次 RowsRemapped；
+     * 内容变化的行按连续区间发出 DataChanged。
+     * 键函数计算的键会缓存到下一次 setRows 作为旧行的键（其他修改会使缓存失效），
+     * 因此连续调用应使用同一个键函数
+     */
+    using RowKeyFunction = std::function<std::string(const std::vector<std::string>& cells)>;
+    void setRows(std::vector<std::vector<std::string>> rows, const RowKeyFunction& key);
+    // 以第 keyColumn 列的文本为键
+    void setRows(std::vector<std::vector<std::string>> rows, size_t keyColumn);
+
+    /**
+     * 删除所有行中第 col 列的单元格
+     */
+    void removeColumn(size_t col);
+
+    TableRow* getRow(size_t index);
+    const TableRow* getRow(size_t index) const;
+
+    // 单元格操作
+    void setCellText(size_t row, size_t col, const std::string& text);
+    void setCellColor(size_t row, size_t col, const Color& textColor, const Color& bgColor);
+
+    // 行按块存储，无需预分配；保留接口兼容
+    void reserve(size_t rows) { (void)rows; }
+
+private:
+    TableRow makeRow(const std::vector<std::string>& cells) const;
+    TableRow takeRow(std::vector<std::string>& cells) const;   // 移入单元格文本
+    void applyRows(std::vector<std::vector<std::string>> rows, const std::vector<std::string>& oldKeys,
+                   const std::vector<std::string>& newKeys);
+    TableCell* cellAt(size_t row, size_t col);
+    void invalidateRowKeys();
+
+    std::deque<TableRow> m_rows;
+    size_t m_columnCount = 0;
+    // 上一次 setRows(rows, key) 计算的各行键，m_rowKeysValid 为 false 时需重新计算
+    std::vector<std::string> m_rowKeys;
+    bool m_rowKeysValid = false;
+};
+
+} // namespace liteDui
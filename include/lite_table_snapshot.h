@@ -0,0 +1,192 @@
+/**
+ * lite_table_snapshot.h - 按行块增量维护的列快照
+ *
+ * 后台排序、筛选需要读取整列数据，而模型只能在 UI 线程访问。LiteTableSnapshot
+ * 把一列按行块复制为只读块（块的内容由调用方在 publish 时生成），块以 shared_ptr 共享：
+ * - 模型变化时只标记受影响的行：尾部追加只复制新行，头部删除只丢弃整块或移动块内起点，
+ *   中间的插入、删除、修改只重新复制这些行
+ * - publish 只复制块列表，后台线程读取发布的 Data，之后 UI 线程的修改不影响它
+ * - 连续追加产生的小块按二进制进位的方式合并，每行平均只被重新复制 O(log kBlockRows) 次
+ *
+ * 只能在 UI 线程调用；发布的 Data 可在任意线程只读访问。
+ */
+
+#pragma once
+
+#include "lite_table_model.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * LiteTableSnapshot - 一列的增量快照
+ * Block 为一段连续行的只读副本
+ */
+template <typename Block>
+class LiteTableSnapshot {
+public:
+    static constexpr size_t kBlockRows = 4096;
+
+    /**
+     * 连续的一段行：对应 block 中的第 [offset, offset + count) 项
+     */
+    struct Part {
+        std::shared_ptr<const Block> block;   // 为空表示尚未复制
+        size_t first = 0;                     // 第一行的行号（仅在发布的 Data 中有效）
+        size_t offset = 0;
+        size_t count = 0;
+    };
+
+    /**
+     * 发布给后台线程的只读快照，parts 按行号顺序覆盖全部 rowCount 行
+     */
+    struct Data {
+        size_t rowCount = 0;
+        std::vector<Part> parts;
+    };
+
+    /**
+     * 按模型变化标记需要重新复制的行（在模型变化通知中调用）
+     */
+    void onModelChanged(const TableModelChange& change) {
+        switch (change.type) {
+            case TableModelChange::Type::RowsInserted:
+                replace(change.first, 0, change.count);
+                break;
+            case TableModelChange::Type::RowsRemoved:
+                replace(change.first, change.count, 0);
+                break;
+            case TableModelChange::Type::DataChanged:
+                replace(change.first, change.count, change.count);
+                break;
+            case TableModelChange::Type::Reset:
+            case TableModelChange::Type::ColumnsChanged:
+            case TableModelChange::Type::RowsRemapped:
+                clear();
+                break;
+        }
+    }
+
+    /**
+     * 丢弃全部块，下一次 publish 时重新复制全部行
+     */
+    void clear() {
+        m_parts.clear();
+        m_rowCount = 0;
+        m_valid = false;
+        m_published.reset();
+    }
+
+    /**
+     * 复制尚未复制的行并发布；没有变化时返回上一次发布的快照
+     * @param rowCount 模型当前行数
+     * @param build 复制 [first, first + count) 行：std::shared_ptr<const Block>(size_t first, size_t count)
+     */
+    template <typename Build>
+    std::shared_ptr<const Data> publish(size_t rowCount, Build&& build) {
+        if (!m_valid || m_rowCount != rowCount) {
+            m_parts.clear();
+            if (rowCount > 0) m_parts.push_back(Part{nullptr, 0, 0, rowCount});
+            m_rowCount = rowCount;
+            m_valid = true;
+            m_published.reset();
+        }
+        if (m_published) return m_published;
+
+        std::vector<Part> parts;
+        parts.reserve(m_parts.size() + 1);
+        size_t row = 0;
+        for (size_t i = 0; i < m_parts.size(); ++i) {
+            if (m_parts[i].block) {
+                parts.push_back(m_parts[i]);
+                parts.back().first = row;
+                row += m_parts[i].count;
+                continue;
+            }
+
+            // 相邻的待复制段合并，再并入前面不大于它的小块（二进制进位）
+            size_t first = row;
+            size_t count = m_parts[i].count;
+            while (i + 1 < m_parts.size() && !m_parts[i + 1].block) {
+                count += m_parts[++i].count;
+            }
+            row += count;
+            while (!parts.empty() && parts.back().count <= count && parts.back().count + count <= kBlockRows) {
+                first -= parts.back().count;
+                count += parts.back().count;
+                parts.pop_back();
+            }
+            for (size_t done = 0; done < count;) {
+                size_t piece = std::min(kBlockRows, count - done);
+                parts.push_back(Part{build(first + done, piece), first + done, 0, piece});
+                done += piece;
+            }
+        }
+        m_parts = parts;
+
+        auto data = std::make_shared<Data>();
+        data->rowCount = rowCount;
+        data->parts = std::move(parts);
+        m_published = data;
+        return m_published;
+    }
+
+private:
+    // 在 row 处切分，返回从 row 开始的段的下标
+    size_t split(size_t row) {
+        size_t start = 0;
+        for (size_t i = 0; i < m_parts.size(); ++i) {
+            Part& part = m_parts[i];
+            if (row == start) return i;
+            if (row < start + part.count) {
+                Part tail = part;
+                size_t head = row - start;
+                part.count = head;
+                tail.offset += head;
+                tail.count -= head;
+                m_parts.insert(m_parts.begin() + static_cast<std::ptrdiff_t>(i) + 1, tail);
+                return i + 1;
+            }
+            start += part.count;
+        }
+        return m_parts.size();
+    }
+
+    // 把 [first, first + removeCount) 行替换为 insertCount 个待复制的行
+    void replace(size_t first, size_t removeCount, size_t insertCount) {
+        if (!m_valid) return;
+        if (first > m_rowCount) {
+            clear();
+            return;
+        }
+        removeCount = std::min(removeCount, m_rowCount - first);
+        size_t begin = split(first);
+        size_t end = split(first + removeCount);
+        m_parts.erase(m_parts.begin() + static_cast<std::ptrdiff_t>(begin),
+                      m_parts.begin() + static_cast<std::ptrdiff_t>(end));
+        m_rowCount -= removeCount;
+
+        if (insertCount > 0) {
+            if (begin > 0 && !m_parts[begin - 1].block) {
+                m_parts[begin - 1].count += insertCount;
+            } else if (begin < m_parts.size() && !m_parts[begin].block) {
+                m_parts[begin].count += insertCount;
+            } else {
+                m_parts.insert(m_parts.begin() + static_cast<std::ptrdiff_t>(begin),
+                               Part{nullptr, 0, 0, insertCount});
+            }
+            m_rowCount += insertCount;
+        }
+        m_published.reset();
+    }
+
+    std::vector<Part> m_parts;   // 按行号顺序覆盖全部行
+    size_t m_rowCount = 0;
+    bool m_valid = false;        // 为 false 时下一次 publish 重新复制全部行
+    std::shared_ptr<const Data> m_published;
+};
+
+} // namespace liteDui
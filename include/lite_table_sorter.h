@@ -0,0 +1,113 @@
+/**
+ * lite_table_sorter.h - 表格后台排序
+ *
+ * 对行号排列（视图行 -> 模型行）排序，而不是移动行数据：
+ * - 支持多列排序键，每个键可指定升降序与比较方式
+ * - 文本键先在去重后的取值上排序得到整数名次，最终排序只比较整数
+ * - 行数较多时分块并行排序再归并
+ * - 在 LiteTaskPool 中执行，新请求会取消尚未完成的旧请求，不阻塞 UI 线程
+ * - 列数据由调用方按块增量维护（LiteTableSnapshot），在排序线程中拼接为整列
+ */
+
+#pragma once
+
+#include "lite_table_model.h"
+#include "lite_table_snapshot.h"
+#include "lite_task_pool.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * 列比较方式
+ */
+enum class TableSortType {
+    Auto,      // 数值列按数值，文本列按自然顺序
+    Numeric,   // 按数值比较，文本列解析为数字，无法解析的视为 null
+    Text,      // 按字节比较
+    Natural,   // 自然顺序：忽略大小写，连续数字按数值比较（"file2" < "file10"）
+    Locale     // 按当前系统区域设置的排序规则比较
+};
+
+/**
+ * 排序键
+ */
+struct TableSortKey {
+    size_t column = 0;
+    bool ascending = true;
+    TableSortType type = TableSortType::Auto;
+
+    TableSortKey() = default;
+    TableSortKey(size_t c, bool asc = true, TableSortType t = TableSortType::Auto)
+        : column(c), ascending(asc), type(t) {}
+};
+
+/**
+ * LiteTableSorter - 表格后台排序器
+ */
+class LiteTableSorter {
+public:
+    using Permutation = std::vector<uint32_t>;
+    // 一个排序键列的增量快照
+    using ColumnSnapshot = LiteTableSnapshot<TableSortColumn>;
+    using ColumnData = std::shared_ptr<const ColumnSnapshot::Data>;
+
+    LiteTableSorter() = default;
+
+    LiteTableSorter(const LiteTableSorter&) = delete;
+    LiteTableSorter& operator=(const LiteTableSorter&) = delete;
+
+    /**
+     * 提交排序请求，取代尚未完成的请求
+     * @param revision 调用方的数据版本，随结果原样返回，用于映射或丢弃过期结果
+     * @param columns 与 keys 一一对应的列快照
+     */
+    void request(uint64_t revision, std::vector<TableSortKey> keys, std::vector<ColumnData> columns);
+
+    /**
+     * 取消尚未完成的请求并丢弃未取走的结果
+     */
+    void cancel();
+
+    /**
+     * 是否有请求正在排队或执行
+     */
+    bool isBusy() const { return m_task.isBusy(); }
+
+    /**
+     * 取走已完成的结果（UI 线程调用）
+     * @return 没有新结果时返回 false
+     */
+    bool takeResult(Permutation& permutation, uint64_t& revision) { return m_task.takeResult(permutation, revision); }
+
+    /**
+     * 最近一次完成的排序耗时（毫秒）
+     */
+    double getLastSortTime() const { return m_task.getLastTime(); }
+
+    /**
+     * 同步排序，返回视图行 -> 模型行的排列
+     * 相等的行保持模型顺序；cancel 被置位时提前返回空排列
+     */
+    static Permutation sort(size_t rowCount, const std::vector<TableSortKey>& keys,
+                            std::vector<TableSortColumn>& columns,
+                            const std::atomic<bool>* cancel = nullptr);
+
+    /**
+     * 把列快照的各段拼接为整列，字典编码的列合并各块的字典
+     */
+    static void gather(const ColumnSnapshot::Data& data, TableSortColumn& out);
+
+    /**
+     * 自然顺序比较，返回负数、0 或正数
+     */
+    static int compareNatural(const std::string& a, const std::string& b);
+
+private:
+    LiteLatestTask<Permutation> m_task;
+};
+
+} // namespace liteDui
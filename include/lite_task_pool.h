@@ -0,0 +1,212 @@
+/**
+ * lite_task_pool.h - 后台任务线程池
+ *
+ * 供整形预取、后台排序与筛选等可丢弃的后台工作使用的小型线程池：
+ * - 任务按提交顺序执行
+ * - 任务归属于一个分组，可以一次性丢弃分组中尚未开始的任务
+ * - 已开始的任务不会被中断，需要提前结束的任务应自行检查取消标记
+ *
+ * LiteLatestTask 在线程池之上实现"新请求取代旧请求"的后台任务。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace liteDui {
+
+/**
+ * LiteTaskPool - 后台任务线程池单例
+ */
+class LiteTaskPool {
+public:
+    using Task = std::function<void()>;
+
+    static LiteTaskPool& getInstance();
+
+    LiteTaskPool(const LiteTaskPool&) = delete;
+    LiteTaskPool& operator=(const LiteTaskPool&) = delete;
+
+    /**
+     * 分配一个新的任务分组 ID
+     */
+    uint64_t createGroup() { return m_nextGroup.fetch_add(1); }
+
+    /**
+     * 提交任务
+     * @param group 任务分组（用于 cancel）
+     */
+    void submit(uint64_t group, Task task);
+
+    /**
+     * 丢弃分组中尚未开始执行的任务
+     * @return 丢弃的任务数
+     */
+    size_t cancel(uint64_t group);
+
+    size_t getThreadCount() const { return m_workers.size(); }
+    size_t getPendingCount() const;
+
+private:
+    LiteTaskPool();
+    ~LiteTaskPool();
+
+    void workerLoop();
+
+    struct Entry {
+        uint64_t group;
+        Task task;
+    };
+
+    std::vector<std::thread> m_workers;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Entry> m_queue;
+    bool m_stop = false;
+    std::atomic<uint64_t> m_nextGroup{1};
+};
+
+/**
+ * LiteLatestTask - 只保留最新请求的后台任务
+ *
+ * - submit 取代尚未完成的旧任务：未开始的直接丢弃，已开始的由任务检查取消标记后放弃
+ * - 只保留最新任务的结果，由 UI 线程通过 takeResult 取走
+ * - 销毁时取消并等待正在执行的任务结束，任务可以安全引用调用方在此期间不变的数据
+ */
+template <typename Result>
+class LiteLatestTask {
+public:
+    /**
+     * 任务函数，在线程池中执行
+     * @return 被取消（cancel 被置位）时返回 false，结果作废
+     */
+    using Work = std::function<bool(const std::atomic<bool>& cancel, Result& result)>;
+
+    LiteLatestTask() : m_group(LiteTaskPool::getInstance().createGroup()), m_state(std::make_shared<State>()) {}
+
+    ~LiteLatestTask() {
+        cancel();
+        std::unique_lock<std::mutex> lock(m_state->mutex);
+        m_state->idle.wait(lock, [this] { return m_state->running == 0; });
+    }
+
+    LiteLatestTask(const LiteLatestTask&) = delete;
+    LiteLatestTask& operator=(const LiteLatestTask&) = delete;
+
+    /**
+     * 提交任务，取代尚未完成的任务
+     * @param revision 调用方的数据版本，随结果原样返回
+     */
+    void submit(uint64_t revision, Work work) {
+        auto job = std::make_shared<Job>();
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            if (m_state->current) m_state->current->cancel = true;
+            m_state->current = job;
+            m_state->hasResult = false;
+            m_state->result = Result();
+        }
+        auto& pool = LiteTaskPool::getInstance();
+        pool.cancel(m_group);
+        pool.submit(m_group, [state = m_state, job, revision, work = std::move(work)] {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (job->cancel.load()) return;
+                ++state->running;
+            }
+            auto start = std::chrono::steady_clock::now();
+            Result result;
+            bool completed = work(job->cancel, result);
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->current == job) {
+                state->current.reset();
+                if (completed && !job->cancel.load()) {
+                    state->result = std::move(result);
+                    state->resultRevision = revision;
+                    state->hasResult = true;
+                    state->lastMs = elapsed;
+                }
+            }
+            --state->running;
+            state->idle.notify_all();
+        });
+    }
+
+    /**
+     * 取消尚未完成的任务并丢弃未取走的结果
+     */
+    void cancel() {
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            if (m_state->current) m_state->current->cancel = true;
+            m_state->current.reset();
+            m_state->hasResult = false;
+            m_state->result = Result();
+        }
+        LiteTaskPool::getInstance().cancel(m_group);
+    }
+
+    /**
+     * 是否有任务正在排队或执行
+     */
+    bool isBusy() const {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->current != nullptr;
+    }
+
+    /**
+     * 取走已完成的结果（UI 线程调用）
+     * @return 没有新结果时返回 false
+     */
+    bool takeResult(Result& result, uint64_t& revision) {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (!m_state->hasResult) return false;
+        result = std::move(m_state->result);
+        revision = m_state->resultRevision;
+        m_state->result = Result();
+        m_state->hasResult = false;
+        return true;
+    }
+
+    /**
+     * 最近一次完成的任务耗时（毫秒）
+     */
+    double getLastTime() const {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->lastMs;
+    }
+
+private:
+    struct Job {
+        std::atomic<bool> cancel{false};
+    };
+
+    // 与线程池中的任务共享
+    struct State {
+        std::mutex mutex;
+        std::condition_variable idle;
+        std::shared_ptr<Job> current;   // 最新的未完成任务
+        size_t running = 0;
+        bool hasResult = false;
+        Result result;
+        uint64_t resultRevision = 0;
+        double lastMs = 0.0;
+    };
+
+    uint64_t m_group;
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace liteDui
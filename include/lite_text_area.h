@@ -0,0 +1,166 @@
+/**
+ * lite_text_area.h - 多行文本编辑控件
+ *
+ * 基于 LiteScrollView 的虚拟化多行编辑器：
+ * - 文本保存在 LitePieceTable 中，插入/删除不移动整段文本，按行号定位为二分查找
+ * - 每行对应一个 LiteTextLine（分段整形），按行号缓存，只为可见行构建
+ * - 编辑只失效受影响的行：行内编辑增量整形，跨行编辑丢弃被改动的行并平移后续行缓存
+ * - 固定行高、不自动换行，长行通过水平滚动查看
+ *
+ * 光标与选择的语义与 LiteInput 保持一致（字节偏移，Shift 扩展选择）。
+ */
+
+#pragma once
+
+#include "lite_scroll_view.h"
+#include "lite_piece_table.h"
+#include "lite_text_line.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+
+namespace liteDui {
+
+class LiteTextArea;
+using LiteTextAreaPtr = std::shared_ptr<LiteTextArea>;
+
+/**
+ * LiteTextArea - 多行文本编辑控件
+ */
+class LiteTextArea : public LiteScrollView {
+public:
+    LiteTextArea();
+    explicit LiteTextArea(const std::string& placeholder);
+    ~LiteTextArea() override = default;
+
+    // 文本内容（"\r\n" 与单独的 "\r" 统一转换为 "\n"）
+    void setValue(const std::string& value);
+    std::string getValue() const { return m_buffer.getText(); }
+    size_t getLength() const { return m_buffer.length(); }
+    size_t getLineCount() const { return m_buffer.getLineCount(); }
+    std::string getLine(size_t line) const { return m_buffer.getLine(line); }
+
+    // 基本属性
+    void setPlaceholder(const std::string& placeholder);
+    const std::string& getPlaceholder() const { return m_placeholder; }
+    void setReadOnly(bool readOnly) { m_readOnly = readOnly; }
+    bool isReadOnly() const { return m_readOnly; }
+    void setDisabled(bool disabled);
+    bool isDisabled() const { return m_state == ControlState::Disabled; }
+
+    // 光标和选择
+    void setCursorPosition(size_t pos);
+    size_t getCursorPosition() const { return m_cursorPos; }
+    void selectAll();
+    void clearSelection();
+    bool hasSelection() const;
+    std::string getSelectedText() const;
+
+    // 样式
+    void setPlaceholderColor(const Color& color) { m_placeholderColor = color; markDirty(); }
+    void setCursorColor(const Color& color) { m_cursorColor = color; markDirty(); }
+    void setSelectionColor(const Color& color) { m_selectionColor = color; markDirty(); }
+
+    /**
+     * 行布局缓存上限（行数），超出时淘汰不可见行
+     */
+    void setMaxCachedLines(size_t count) { m_maxCachedLines = std::max<size_t>(count, 1); }
+    size_t getMaxCachedLines() const { return m_maxCachedLines; }
+
+    // 回调（每次编辑都会拼接完整文本，大文本场景下应尽量轻量）
+    void setOnTextChanged(TextChangedCallback callback) { m_onTextChanged = callback; }
+    void setOnFocusChanged(FocusChangedCallback callback) { m_onFocusChanged = callback; }
+
+    // 操作
+    void clear();
+    void insertText(const std::string& text);
+
+    // 内容尺寸：行数 × 行高，宽度为已排版行的最大宽度
+    float getContentWidth() const override;
+    float getContentHeight() const override;
+
+    void update() override;
+
+    // 事件处理
+    void onMousePressed(const MouseEvent& event) override;
+    void onMouseReleased(const MouseEvent& event) override;
+    void onMouseMoved(const MouseEvent& event) override;
+    void onKeyPressed(const KeyEvent& event) override;
+    void onCharInput(unsigned int codepoint) override;
+    void onFocusGained() override;
+    void onFocusLost() override;
+
+protected:
+    /**
+     * 只绘制与视口相交的行
+     */
+    void renderContent(SkCanvas* canvas) override;
+
+private:
+    void setState(ControlState state);
+    void updateAppearance();
+    void handleSpecialKey(const KeyEvent& event);
+    void deleteSelected();
+    void notifyTextChanged();
+    void updateCursorBlink();
+    void resetCursorBlink();
+
+    // 所有文本修改的统一入口：把 [start, end) 替换为 text，并只失效受影响的行
+    void replaceText(size_t start, size_t end, const std::string& text);
+
+    // 字体变化时清空行缓存并重新计算行高
+    void syncFont();
+    // 获取（必要时构建）某一行的布局
+    const LiteTextLine& lineLayout(size_t line);
+    // 淘汰 [firstKeep, lastKeep] 之外的行，直到缓存不超过上限
+    void trimLineCache(size_t firstKeep, size_t lastKeep);
+
+    // 光标移动辅助
+    size_t prevCharPos(size_t pos);
+    size_t nextCharPos(size_t pos);
+    size_t offsetForPoint(float x, float y);
+    float cursorXForOffset(size_t pos);
+    size_t verticalMove(size_t pos, long lineDelta);
+    void moveCursor(size_t pos, bool extendSelection);
+    void ensureCursorVisible();
+
+    LitePieceTable m_buffer;
+    std::map<size_t, std::unique_ptr<LiteTextLine>> m_lineCache;
+    size_t m_maxCachedLines = 1024;
+    FontSpec m_fontSpec;
+    float m_lineHeight = 0.0f;
+    float m_maxLineWidth = 0.0f;     // 已排版行的最大宽度（只增不减，setValue/字体变化时重置）
+
+    ControlState m_state = ControlState::Normal;
+    std::string m_placeholder;
+    bool m_readOnly = false;
+
+    // 光标（字节偏移），选择端点为 kNoSelection 表示无选择
+    static constexpr size_t kNoSelection = static_cast<size_t>(-1);
+    size_t m_cursorPos = 0;
+    size_t m_selectionStart = kNoSelection;
+    size_t m_selectionEnd = kNoSelection;
+    float m_preferredX = -1.0f;      // 上下移动时保持的列位置
+    bool m_cursorVisible = true;
+    bool m_isDragging = false;
+    std::chrono::steady_clock::time_point m_lastBlinkTime;
+
+    // 样式
+    Color m_placeholderColor = Color(0.6f, 0.6f, 0.6f, 1.0f);
+    Color m_cursorColor = Color::Black();
+    Color m_selectionColor = Color(0.2f, 0.6f, 1.0f, 0.3f);
+
+    // 状态颜色
+    Color m_normalBgColor = Color::White();
+    Color m_disabledBgColor = Color(0.95f, 0.95f, 0.95f, 1.0f);
+    Color m_normalBorderColor = Color::LightGray();
+    Color m_focusedBorderColor = Color(0.2f, 0.6f, 1.0f, 1.0f);
+    Color m_disabledBorderColor = Color(0.8f, 0.8f, 0.8f, 1.0f);
+
+    // 回调
+    TextChangedCallback m_onTextChanged;
+    FocusChangedCallback m_onFocusChanged;
+};
+
+} // namespace liteDui
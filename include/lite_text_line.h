@@ -0,0 +1,122 @@
+/**
+ * lite_text_line.h - 可编辑单行文本布局
+ *
+ * 输入框等可编辑控件需要在每次按键后重新确定光标位置、选择区域和命中位置。
+ * LiteTextLine 把整行文本按单词/长度切成若干片段，每个片段单独整形
+ * （复用 LiteTextRenderer 的整形缓存），并维护片段起点的 x 前缀和：
+ * - 一次编辑只重新整形受影响的 1~3 个片段
+ * - 字节偏移 -> x、x -> 字节偏移 都是两次二分查找
+ * - 绘制只提交与可见区域相交的片段
+ *
+ * 含双向/复杂文字的文本无法安全分段，退化为每个编辑版本构建一次段落。
+ */
+
+#pragma once
+
+#include "lite_common.h"
+#include "lite_font_manager.h"
+#include "lite_text_renderer.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class SkCanvas;
+namespace skia::textlayout {
+    class Paragraph;
+}
+
+namespace liteDui {
+
+/**
+ * LiteTextLine - 分段整形的单行文本
+ */
+class LiteTextLine {
+public:
+    LiteTextLine();
+    ~LiteTextLine();
+
+    LiteTextLine(const LiteTextLine&) = delete;
+    LiteTextLine& operator=(const LiteTextLine&) = delete;
+
+    /**
+     * 设置字体（变化时整体重建）
+     */
+    void setFont(const FontSpec& font);
+    const FontSpec& getFont() const { return m_font; }
+
+    /**
+     * 整体替换文本
+     */
+    void setText(const std::string& text);
+    const std::string& getText() const { return m_text; }
+
+    /**
+     * 增量编辑：把 [start, end) 字节范围替换为 replacement
+     * 偏移必须位于 UTF-8 字符边界
+     */
+    void replace(size_t start, size_t end, const std::string& replacement);
+
+    /**
+     * 编辑版本号，每次文本或字体变化后递增
+     */
+    uint64_t getGeneration() const { return m_generation; }
+
+    float getWidth() const { return m_width; }
+    float getHeight() const { return m_descent - m_ascent; }
+    float getBaseline() const { return -m_ascent; }
+
+    /**
+     * 字节偏移处的光标 x 坐标
+     */
+    float getXForOffset(size_t byteOffset) const;
+
+    /**
+     * 离 x 最近的字符边界（字节偏移）
+     */
+    size_t getOffsetForX(float x) const;
+
+    /**
+     * 绘制文本
+     * @param x, top 行左上角
+     * @param visibleLeft, visibleRight 行坐标系下的可见范围，用于剔除不可见片段
+     */
+    void draw(SkCanvas* canvas, float x, float top, const Color& color,
+              float visibleLeft, float visibleRight) const;
+
+private:
+    struct Segment {
+        size_t begin = 0;
+        size_t length = 0;
+        LiteShapedTextPtr shaped;
+    };
+
+    // 把 [from, to) 切分为片段并整形，追加到 out
+    void buildSegments(size_t from, size_t to, std::vector<Segment>& out) const;
+    // 找到包含 offset 的片段下标
+    size_t segmentIndexAt(size_t offset) const;
+    void rebuild();
+    void updateMetrics();
+
+    // 复杂文本回退：段落与位置表按编辑版本惰性构建
+    // color 为空时只需要位置信息，沿用上一次绘制的颜色
+    void ensureParagraph(const Color* color) const;
+
+    std::string m_text;
+    FontSpec m_font;
+    uint64_t m_generation = 0;
+    bool m_complex = false;
+
+    std::vector<Segment> m_segments;
+    std::vector<float> m_segmentX;   // 片段起点 x 前缀和，比片段数多一项（总宽度）
+    float m_width = 0.0f;
+    float m_ascent = 0.0f;
+    float m_descent = 0.0f;
+
+    mutable std::unique_ptr<skia::textlayout::Paragraph> m_paragraph;
+    mutable uint64_t m_paragraphGeneration = UINT64_MAX;
+    mutable Color m_paragraphColor = Color::Black();
+    mutable std::vector<std::pair<uint32_t, float>> m_paragraphClusterX;
+};
+
+} // namespace liteDui
@@ -0,0 +1,197 @@
+/**
+ * lite_text_renderer.h - 单行文本快速绘制
+ *
+ * 表格单元格、列表项、标签页标题、按钮文字等绝大多数文本都是
+ * 单行、单一样式的短文本。对这类文本完整走 skparagraph 的
+ * 构建/断行/布局流程开销较大，这里直接用 SkShaper (HarfBuzz) 整形，
+ * 结果缓存为 SkTextBlob，后续绘制只需一次 drawTextBlob。
+ *
+ * 含换行、双向文本或复杂文字（阿拉伯文、天城文等）的文本
+ * 仍然走 skparagraph，调用方无需关心具体路径。
+ */
+
+#pragma once
+
+#include "lite_common.h"
+#include "lite_font_manager.h"
+#include "include/core/SkTextBlob.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SkCanvas;
+
+namespace liteDui {
+
+/**
+ * 单行文本溢出处理方式
+ */
+enum class LineOverflow {
+    Clip,       // 超出部分按字形簇截断
+    Ellipsis,   // 超出部分截断并追加省略号
+    Reject      // 超出时不绘制，返回 false 由调用方回退到段落排版
+};
+
+/**
+ * LiteShapedText - 单行文本整形结果（不可变，可跨线程共享）
+ */
+class LiteShapedText {
+public:
+    // 一个整形 run：同一字体下的连续字形
+    struct Run {
+        SkFont font;
+        std::vector<SkGlyphID> glyphs;
+        std::vector<SkPoint> positions;   // 相对行起点的字形位置（基线 y = 0）
+        std::vector<uint32_t> clusters;   // 字形对应的 UTF-8 字节偏移
+    };
+
+    float getWidth() const { return m_width; }
+    float getHeight() const { return m_descent - m_ascent; }
+    /** 基线到行顶的距离 */
+    float getBaseline() const { return -m_ascent; }
+    /** 原始文本的 UTF-8 字节数 */
+    size_t getTextLength() const { return m_textLength; }
+
+    const std::vector<Run>& getRuns() const { return m_runs; }
+    const sk_sp<SkTextBlob>& getBlob() const { return m_blob; }
+
+    /**
+     * 获取某个 UTF-8 字节偏移处的 x 坐标（偏移落在字形簇内部时取簇起点）
+     */
+    float getXForOffset(size_t byteOffset) const;
+
+    /**
+     * 获取离 x 最近的字形簇边界（UTF-8 字节偏移），用于命中测试
+     */
+    size_t getOffsetForX(float x) const;
+
+    /**
+     * 构建宽度不超过 maxWidth 的截断版本（不会切开字形簇），整行放得下时返回完整的 blob
+     * @param ellipsis 是否在末尾追加省略号（为 false 时保留所有放得下的字形）
+     * @param outWidth 返回截断后的实际宽度
+     */
+    sk_sp<SkTextBlob> makeTruncatedBlob(float maxWidth, bool ellipsis, float* outWidth) const;
+
+private:
+    friend class LiteTextRenderer;
+    friend class ShapedTextRunHandler;
+
+    void finish();
+
+    std::vector<Run> m_runs;
+    sk_sp<SkTextBlob> m_blob;
+    float m_width = 0.0f;
+    float m_ascent = 0.0f;    // 负值，含半个行间距
+    float m_descent = 0.0f;   // 正值，含半个行间距
+    size_t m_textLength = 0;
+
+    // 字形簇边界：起始字节偏移及其 x 坐标（按字节偏移递增）
+    std::vector<std::pair<uint32_t, float>> m_clusterX;
+
+    // 最近一次截断结果
+    struct TruncateMemo {
+        bool valid = false;
+        float maxWidth = 0.0f;
+        bool ellipsis = false;
+        float width = 0.0f;
+        sk_sp<SkTextBlob> blob;
+    };
+    mutable std::mutex m_truncateMutex;
+    mutable TruncateMemo m_truncate;
+};
+
+using LiteShapedTextPtr = std::shared_ptr<const LiteShapedText>;
+
+/**
+ * LiteTextRenderer - 单行文本渲染器单例
+ *
+ * 整形结果按 (文本, 字体) 做 LRU 缓存，可被渲染线程与后台线程共同访问。
+ */
+class LiteTextRenderer {
+public:
+    static LiteTextRenderer& getInstance();
+
+    LiteTextRenderer(const LiteTextRenderer&) = delete;
+    LiteTextRenderer& operator=(const LiteTextRenderer&) = delete;
+
+    /**
+     * 判断文本是否可以走快速路径：
+     * 不含换行/制表等控制字符、双向控制符、从右到左文字及需要复杂重排的文字
+     */
+    static bool isSimpleText(const std::string& text);
+
+    /**
+     * 创建整形与绘制使用的 SkFont（与 skparagraph 的字体设置保持一致）
+     */
+    static SkFont makeFont(const FontSpec& font);
+
+    /**
+     * 整形单行文本（带缓存）
+     * 对非简单文本同样可以调用，但结果不保证与段落排版一致
+     */
+    LiteShapedTextPtr shape(const std::string& text, const FontSpec& font);
+
+    /**
+     * 在指定位置绘制单行简单文本
+     * @param x, top 文本行左上角
+     * @param width 可用宽度
+     * @return 文本不是简单文本，或 overflow 为 Reject 且宽度不足时返回 false（未绘制）
+     */
+    bool drawLine(SkCanvas* canvas, const std::string& text, const FontSpec& font,
+                  const Color& color, float x, float top, float width,
+                  TextAlign align = TextAlign::Left,
+                  LineOverflow overflow = LineOverflow::Clip);
+
+    /**
+     * 在矩形内垂直居中绘制单行文本
+     * 简单文本走 SkTextBlob 快速路径，其余回退到 skparagraph（maxLines = 1）
+     */
+    void drawSingleLine(SkCanvas* canvas, const std::string& text, const FontSpec& font,
+                        const Color& color, float x, float y, float w, float h,
+                        TextAlign align = TextAlign::Left, bool ellipsis = true);
+
+    /**
+     * 缓存管理
+     */
+    void setCacheCapacity(size_t capacity);
+    size_t getCacheCapacity() const { return m_capacity; }
+    void clearCache();
+
+private:
+    LiteTextRenderer() = default;
+    ~LiteTextRenderer() = default;
+
+    LiteShapedTextPtr shapeUncached(const std::string& text, const FontSpec& font) const;
+    void evictLocked();
+
+    struct CacheKey {
+        std::string text;
+        FontSpec font;
+
+        bool operator==(const CacheKey& other) const {
+            return font == other.font && text == other.text;
+        }
+    };
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& key) const {
+            size_t h = std::hash<std::string>()(key.text);
+            return h ^ (FontSpecHash()(key.font) + 0x9e3779b9 + (h << 6) + (h >> 2));
+        }
+    };
+
+    struct CacheEntry {
+        LiteShapedTextPtr shaped;
+        std::list<CacheKey>::iterator lruIt;
+    };
+
+    mutable std::mutex m_mutex;
+    std::list<CacheKey> m_lru;    // 表头为最近使用
+    std::unordered_map<CacheKey, CacheEntry, CacheKeyHash> m_cache;
+    size_t m_capacity = 4096;
+};
+
+} // namespace liteDui
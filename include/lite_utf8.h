@@ -6,9 +6,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <cstdint>
 
 namespace liteDui {
 
@@ -20,6 +21,7 @@ namespace liteDui {
  * - 字节位置与码点索引之间的转换
  * - 字符边界检测（前一个/下一个字符位置）
  * - Unicode 码点转 UTF-8 字符串
+ * - 合法性校验、码点计数、UTF-16 长度计算（SSE2/AVX2 加速，其他平台回退到标量实现）
  */
 class Utf8Helper {
 public:
@@ -111,6 +113,94 @@ public:
      * @return 字节长度 (1-4)
      */
     static int getCharByteLength(unsigned char c);
+
+    /**
+     * 校验 UTF-8 编码是否合法（拒绝过长编码、代理区码点及超出 U+10FFFF 的码点）
+     * 连续的 ASCII 段按 16/32 字节一组快速跳过
+     * @param data UTF-8 数据
+     * @param length 字节数
+     * @return 合法返回 true
+     */
+    static bool validate(const char* data, size_t length);
+    static bool validate(const std::string& text) { return validate(text.data(), text.size()); }
+
+    /**
+     * 统计码点数（即非续字节的数量）
+     * @param data UTF-8 数据
+     * @param length 字节数
+     * @return 码点数
+     */
+    static size_t countCodePoints(const char* data, size_t length);
+
+    /**
+     * 计算转换为 UTF-16 后的代码单元数（4 字节字符计 2 个）
+     * @param data UTF-8 数据
+     * @param length 字节数
+     * @return UTF-16 代码单元数
+     */
+    static size_t utf16Length(const char* data, size_t length);
+};
+
+/**
+ * Utf8OffsetIndex - UTF-8 偏移索引
+ *
+ * 一次构建后，字节偏移 / 码点索引 / UTF-16 索引三者之间的互相转换均为 O(log n)。
+ * 只为非 ASCII 字符记录一项（ASCII 字符三种偏移相同，可直接推算），
+ * 纯 ASCII 文本不占用额外内存。重复调用 build 会复用已分配的内存。
+ *
+ * 偏移落在多字节字符（或代理对）内部时，按该字符的起点计算。
+ */
+class Utf8OffsetIndex {
+public:
+    Utf8OffsetIndex() = default;
+    explicit Utf8OffsetIndex(const std::string& text) { build(text); }
+
+    /**
+     * 为文本建立索引（不保存文本本身）
+     */
+    void build(const char* data, size_t length);
+    void build(const std::string& text) { build(text.data(), text.size()); }
+    void clear();
+
+    size_t byteLength() const { return m_byteLength; }
+    size_t codePointCount() const { return m_codePointCount; }
+    size_t utf16Length() const { return m_utf16Length; }
+
+    /**
+     * 字节偏移 -> 码点索引 / UTF-16 索引
+     */
+    size_t byteToCodePoint(size_t bytePos) const;
+    size_t byteToUtf16(size_t bytePos) const;
+
+    /**
+     * 码点索引 -> 字节偏移 / UTF-16 索引
+     */
+    size_t codePointToByte(size_t cpIndex) const;
+    size_t codePointToUtf16(size_t cpIndex) const;
+
+    /**
+     * UTF-16 索引 -> 字节偏移 / 码点索引
+     */
+    size_t utf16ToByte(size_t utf16Index) const;
+    size_t utf16ToCodePoint(size_t utf16Index) const;
+
+private:
+    // 一个非 ASCII 字符的三种起始偏移
+    struct Entry {
+        uint32_t byteOffset;
+        uint32_t cpIndex;
+        uint32_t utf16Index;
+        uint32_t byteLength;
+    };
+
+    // 把 From 坐标系下的偏移 key 转换到 To 坐标系（二分查找 key 所在或之前最近的非 ASCII 字符）
+    template <uint32_t Entry::*From, uint32_t Entry::*To>
+    size_t convert(size_t key) const;
+
+    std::vector<Entry> m_entries;
+    size_t m_byteLength = 0;
+    size_t m_codePointCount = 0;
+    size_t m_utf16Length = 0;
 };
 
 } // namespace liteDui
@@ -130,6 +130,9 @@ private:
     std::shared_ptr<liteDui::LiteTooltipOverlay> tooltipOverlay_;
     static constexpr int kTooltipDelayMs = 500;
 
+    // 空闲帧中字形预热每帧最多占用的时间
+    static constexpr double kIdleWarmUpBudgetMs = 4.0;
+
     /**
      * @brief 获取平台特定的窗口ID
      * @return 窗口ID（HWND、X11 Window或NSWindow）
@@ -0,0 +1,401 @@
+/**
+ * lite_cell_renderer.cpp - 表格单元格渲染器实现
+ */
+
+#include "lite_cell_renderer.h"
+#include "lite_text_renderer.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkFontMetrics.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTextBlob.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace liteDui {
+
+namespace {
+
+// ==================== ASCII 字形表 ====================
+
+constexpr int kFirstChar = 0x20;
+constexpr int kCharCount = 0x7F - kFirstChar;   // 可打印 ASCII
+
+struct GlyphTable {
+    SkFont font;
+    SkGlyphID glyphs[kCharCount];
+    SkScalar advances[kCharCount];
+    float ascent = 0;       // 与 LiteShapedText 相同：上下各分摊一半 leading
+    float lineHeight = 0;
+};
+
+std::mutex g_glyphMutex;
+std::unordered_map<FontSpec, std::shared_ptr<GlyphTable>, FontSpecHash> g_glyphTables;
+uint64_t g_glyphGeneration = 0;   // 字形表对应的字体版本
+
+// 字形表以 shared_ptr 返回，字体版本变化清空表时正在绘制的调用方不受影响
+std::shared_ptr<const GlyphTable> glyphTable(const FontSpec& spec) {
+    uint64_t generation = LiteFontManager::getInstance().getFontGeneration();
+    std::lock_guard<std::mutex> lock(g_glyphMutex);
+    if (generation != g_glyphGeneration) {
+        g_glyphTables.clear();
+        g_glyphGeneration = generation;
+    }
+    auto& table = g_glyphTables[spec];
+    if (!table) {
+        table = std::make_shared<GlyphTable>();
+        table->font = LiteTextRenderer::makeFont(spec);
+
+        SkUnichar chars[kCharCount];
+        for (int i = 0; i < kCharCount; ++i) {
+            chars[i] = kFirstChar + i;
+        }
+        table->font.unicharsToGlyphs(SkSpan<const SkUnichar>(chars, kCharCount),
+                                     SkSpan<SkGlyphID>(table->glyphs, kCharCount));
+        table->font.getWidths(SkSpan<const SkGlyphID>(table->glyphs, kCharCount),
+                              SkSpan<SkScalar>(table->advances, kCharCount));
+
+        SkFontMetrics metrics;
+        table->font.getMetrics(&metrics);
+        table->ascent = metrics.fAscent - metrics.fLeading / 2;
+        table->lineHeight = (metrics.fDescent + metrics.fLeading / 2) - table->ascent;
+    }
+    return table;
+}
+
+// 查表测量；含表外字符时返回 false
+bool measureGlyphs(const GlyphTable& table, const char* text, size_t length, float& width) {
+    width = 0;
+    for (size_t i = 0; i < length; ++i) {
+        int index = static_cast<unsigned char>(text[i]) - kFirstChar;
+        if (index < 0 || index >= kCharCount || table.glyphs[index] == 0) return false;
+        width += table.advances[index];
+    }
+    return true;
+}
+
+// ==================== 数值格式化 ====================
+
+constexpr int kMaxDecimals = 9;
+constexpr uint64_t kPow10[kMaxDecimals + 1] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull,
+    1000000ull, 10000000ull, 100000000ull, 1000000000ull
+};
+
+// 无符号整数转十进制，返回位数（buffer 至少 20 字节）
+size_t writeDigits(uint64_t value, char* buffer) {
+    char reversed[20];
+    size_t count = 0;
+    do {
+        reversed[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    for (size_t i = 0; i < count; ++i) {
+        buffer[i] = reversed[count - 1 - i];
+    }
+    return count;
+}
+
+class BufferWriter {
+public:
+    BufferWriter(char* buffer, size_t size) : m_buffer(buffer), m_size(size) {}
+
+    void put(char c) {
+        if (m_length + 1 < m_size) m_buffer[m_length++] = c;
+    }
+    void put(const char* text, size_t length) {
+        for (size_t i = 0; i < length; ++i) put(text[i]);
+    }
+    size_t finish() {
+        m_buffer[m_length] = '\0';
+        return m_length;
+    }
+
+private:
+    char* m_buffer;
+    size_t m_size;
+    size_t m_length = 0;
+};
+
+} // namespace
+
+// ==================== LiteNumericText ====================
+
+bool LiteNumericText::measure(const char* text, size_t length, const FontSpec& font, float& width) {
+    return measureGlyphs(*glyphTable(font), text, length, width);
+}
+
+bool LiteNumericText::draw(SkCanvas* canvas, const char* text, size_t length, const FontSpec& font,
+                           const Color& color, float x, float y, float width, float height,
+                           TextAlign align) {
+    if (length == 0) return true;
+
+    auto table = glyphTable(font);
+    float textWidth = 0;
+    if (!measureGlyphs(*table, text, length, textWidth)) return false;
+    // 与 LiteTextRenderer 相同留半像素容差；数值不截断，放不下时交给调用方
+    if (textWidth > width + 0.5f) return false;
+
+    float pen = x;
+    if (align == TextAlign::Center) {
+        pen += std::max(0.0f, (width - textWidth) / 2);
+    } else if (align == TextAlign::Right) {
+        pen += std::max(0.0f, width - textWidth);
+    }
+    float baseline = y + (height - table->lineHeight) / 2 - table->ascent;
+
+    SkTextBlobBuilder builder;
+    const auto& run = builder.allocRunPosH(table->font, static_cast<int>(length), baseline);
+    for (size_t i = 0; i < length; ++i) {
+        int index = static_cast<unsigned char>(text[i]) - kFirstChar;
+        run.glyphs[i] = table->glyphs[index];
+        run.pos[i] = pen;
+        pen += table->advances[index];
+    }
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(color.toARGB());
+    canvas->drawTextBlob(builder.make(), 0, 0, paint);
+    return true;
+}
+
+void LiteNumericText::clearCache() {
+    std::lock_guard<std::mutex> lock(g_glyphMutex);
+    g_glyphTables.clear();
+}
+
+// ==================== LiteNumberCellRenderer ====================
+
+size_t LiteNumberCellRenderer::format(double value, const Format& format, char* buffer, size_t size) {
+    if (!buffer || size == 0) return 0;
+    BufferWriter out(buffer, size);
+    value *= format.scale;
+
+    int decimals = std::max(0, std::min(format.decimals, kMaxDecimals));
+    double scaled = std::fabs(value) * static_cast<double>(kPow10[decimals]);
+    out.put(format.prefix.data(), format.prefix.size());
+
+    if (std::isnan(value)) {
+        // 与其他数值一样带前后缀
+        out.put("NaN", 3);
+    } else if (!std::isfinite(value) || scaled >= 9.0e18) {
+        // 超出整数快速路径的范围：科学计数法
+        char text[64];
+        int length = std::snprintf(text, sizeof(text), "%.*e", decimals, value);
+        out.put(text, static_cast<size_t>(std::max(0, std::min(length, static_cast<int>(sizeof(text)) - 1))));
+    } else {
+        // 按 10^decimals 放大后四舍五入为整数，再拆成整数与小数部分
+        uint64_t units = static_cast<uint64_t>(std::llround(scaled));
+        uint64_t integer = units / kPow10[decimals];
+        uint64_t fraction = units % kPow10[decimals];
+        if (value < 0 && units != 0) out.put('-');
+
+        char digits[20];
+        size_t count = writeDigits(integer, digits);
+        for (size_t i = 0; i < count; ++i) {
+            if (format.thousandsSeparator && i > 0 && (count - i) % 3 == 0) out.put(',');
+            out.put(digits[i]);
+        }
+        if (decimals > 0) {
+            out.put('.');
+            for (int i = decimals - 1; i >= 0; --i) {
+                out.put(static_cast<char>('0' + (fraction / kPow10[i]) % 10));
+            }
+        }
+    }
+
+    out.put(format.suffix.data(), format.suffix.size());
+    return out.finish();
+}
+
+void LiteNumberCellRenderer::draw(SkCanvas* canvas, const CellRenderContext& context) {
+    float x = context.x + context.padding;
+    float width = context.width - context.padding * 2;
+    if (width <= 0 || !context.model) return;
+
+    double value = 0;
+    if (!context.model->getCellNumber(context.row, context.col, value)) {
+        // 非数值单元格按普通文本绘制
+        std::string text = context.model->getCellText(context.row, context.col);
+        LiteTextRenderer::getInstance().drawSingleLine(canvas, text, context.font, context.textColor,
+                                                       x, context.y, width, context.height, context.align, true);
+        return;
+    }
+
+    char buffer[96];
+    size_t length = format(value, m_format, buffer, sizeof(buffer));
+    Color color = (value < 0 && m_format.negativeColor.a > 0) ? m_format.negativeColor : context.textColor;
+    if (!LiteNumericText::draw(canvas, buffer, length, context.font, color, x, context.y, width, context.height,
+                               context.align)) {
+        LiteTextRenderer::getInstance().drawSingleLine(canvas, std::string(buffer, length), context.font, color,
+                                                       x, context.y, width, context.height, context.align, true);
+    }
+}
+
+// ==================== LiteProgressBarCellRenderer ====================
+
+void LiteProgressBarCellRenderer::draw(SkCanvas* canvas, const CellRenderContext& context) {
+    float left = context.x + context.padding;
+    float width = context.width - context.padding * 2;
+    if (width <= 0 || !context.model) return;
+
+    double value = 0;
+    if (!context.model->getCellNumber(context.row, context.col, value)) return;
+
+    double range = m_maximum - m_minimum;
+    float ratio = range > 0 ? static_cast<float>((value - m_minimum) / range) : 0.0f;
+    ratio = std::max(0.0f, std::min(1.0f, ratio));
+
+    float barHeight = m_barHeight > 0 ? m_barHeight : std::max(4.0f, context.height * 0.45f);
+    barHeight = std::min(barHeight, std::max(0.0f, context.height - 2));
+    float top = context.y + (context.height - barHeight) / 2;
+    float radius = std::min(4.0f, barHeight / 2);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setStyle(SkPaint::kFill_Style);
+
+    // 轨道
+    paint.setColor(m_trackColor.toARGB());
+    canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(left, top, width, barHeight), radius, radius), paint);
+
+    // 进度
+    if (ratio > 0) {
+        paint.setColor(m_barColor.toARGB());
+        canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(left, top, width * ratio, barHeight), radius, radius),
+                          paint);
+    }
+
+    // 百分比标签，放不下时不显示
+    if (m_showLabel) {
+        LiteNumberCellRenderer::Format format;
+        format.decimals = 0;
+        format.suffix = "%";
+        char buffer[32];
+        size_t length = LiteNumberCellRenderer::format(ratio * 100.0, format, buffer, sizeof(buffer));
+        LiteNumericText::draw(canvas, buffer, length, context.font, context.textColor,
+                              left, context.y, width, context.height, TextAlign::Center);
+    }
+}
+
+// ==================== LiteSparklineCellRenderer ====================
+
+void LiteSparklineCellRenderer::draw(SkCanvas* canvas, const CellRenderContext& context) {
+    float left = context.x + context.padding;
+    float right = context.x + context.width - context.padding;
+    float inset = std::max(2.0f, context.height * 0.15f);
+    float top = context.y + inset;
+    float bottom = context.y + context.height - inset;
+    if (right <= left || bottom <= top || !context.model) return;
+
+    if (!context.model->getCellSeries(context.row, context.col, m_series) || m_series.empty()) return;
+
+    auto range = std::minmax_element(m_series.begin(), m_series.end());
+    double minimum = *range.first;
+    double span = *range.second - minimum;
+    auto yOf = [&](double value) {
+        if (span <= 0) return (top + bottom) / 2;
+        return bottom - static_cast<float>((value - minimum) / span) * (bottom - top);
+    };
+
+    // 点数多于像素列时，每列只保留最小/最大值（按出现顺序）
+    size_t count = m_series.size();
+    float width = right - left;
+    size_t columns = static_cast<size_t>(width);
+    std::vector<SkPoint> points;
+    if (count == 1) {
+        points.push_back(SkPoint::Make(right, yOf(m_series[0])));
+    } else if (columns < 2 || count <= columns * 2) {
+        points.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            float x = left + width * static_cast<float>(i) / static_cast<float>(count - 1);
+            points.push_back(SkPoint::Make(x, yOf(m_series[i])));
+        }
+    } else {
+        points.reserve(columns * 2);
+        for (size_t c = 0; c < columns; ++c) {
+            size_t begin = c * count / columns;
+            size_t end = std::max(begin + 1, (c + 1) * count / columns);
+            auto bucket = std::minmax_element(m_series.begin() + begin, m_series.begin() + end);
+            float x = left + width * static_cast<float>(c) / static_cast<float>(columns - 1);
+            bool minFirst = bucket.first < bucket.second;
+            points.push_back(SkPoint::Make(x, yOf(minFirst ? *bucket.first : *bucket.second)));
+            if (bucket.first != bucket.second) {
+                points.push_back(SkPoint::Make(x, yOf(minFirst ? *bucket.second : *bucket.first)));
+            }
+        }
+    }
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    if (points.size() >= 2) {
+        if (m_fillColor.a > 0) {
+            SkPathBuilder area;
+            area.incReserve(static_cast<int>(points.size()) + 3);
+            area.moveTo(points.front().fX, bottom);
+            for (const auto& point : points) area.lineTo(point);
+            area.lineTo(points.back().fX, bottom);
+            area.close();
+            paint.setStyle(SkPaint::kFill_Style);
+            paint.setColor(m_fillColor.toARGB());
+            canvas->drawPath(area.detach(), paint);
+        }
+
+        SkPathBuilder line;
+        line.incReserve(static_cast<int>(points.size()));
+        line.moveTo(points.front());
+        for (size_t i = 1; i < points.size(); ++i) line.lineTo(points[i]);
+        paint.setStyle(SkPaint::kStroke_Style);
+        paint.setStrokeWidth(m_lineWidth);
+        paint.setStrokeCap(SkPaint::kRound_Cap);
+        paint.setColor(m_lineColor.toARGB());
+        canvas->drawPath(line.detach(), paint);
+    }
+
+    if (m_showLastPoint) {
+        paint.setStyle(SkPaint::kFill_Style);
+        paint.setColor(m_lineColor.toARGB());
+        canvas->drawCircle(points.back().fX, points.back().fY, m_lineWidth + 1.0f, paint);
+    }
+}
+
+// ==================== LiteStatusDotCellRenderer ====================
+
+void LiteStatusDotCellRenderer::draw(SkCanvas* canvas, const CellRenderContext& context) {
+    if (!context.model) return;
+    std::string status = context.model->getCellText(context.row, context.col);
+    if (status.empty()) return;
+
+    auto it = m_colors.find(status);
+    const Color& color = it != m_colors.end() ? it->second : m_defaultColor;
+
+    float centerX = context.x + context.padding + m_radius;
+    float centerY = context.y + context.height / 2;
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setStyle(SkPaint::kFill_Style);
+    paint.setColor(color.toARGB());
+    canvas->drawCircle(centerX, centerY, m_radius, paint);
+
+    // 状态值种类很少，文本整形缓存总能命中
+    if (m_showText) {
+        float textX = centerX + m_radius + 6.0f;
+        float textWidth = context.x + context.width - context.padding - textX;
+        if (textWidth > 0) {
+            LiteTextRenderer::getInstance().drawSingleLine(canvas, status, context.font, context.textColor,
+                                                           textX, context.y, textWidth, context.height,
+                                                           TextAlign::Left, true);
+        }
+    }
+}
+
+} // namespace liteDui
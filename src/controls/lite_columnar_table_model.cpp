@@ -0,0 +1,474 @@
+/**
+ * lite_columnar_table_model.cpp - 列式表格模型实现
+ */
+
+#include "lite_columnar_table_model.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+namespace liteDui {
+
+// ==================== 格式化 ====================
+
+std::string LiteColumnarTableModel::formatDefault(const ColumnValue& value) {
+    if (value.isNull) return std::string();
+
+    char buffer[64];
+    switch (value.type) {
+        case ColumnType::Int64:
+            return std::to_string(value.intValue);
+
+        case ColumnType::Double:
+            std::snprintf(buffer, sizeof(buffer), "%.6g", value.doubleValue);
+            return buffer;
+
+        case ColumnType::Timestamp: {
+            int64_t millis = value.intValue;
+            std::time_t seconds = static_cast<std::time_t>(millis >= 0 ? millis / 1000 : (millis - 999) / 1000);
+            std::tm tm{};
+#ifdef _WIN32
+            localtime_s(&tm, &seconds);
+#else
+            localtime_r(&seconds, &tm);
+#endif
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+            return buffer;
+        }
+
+        case ColumnType::String:
+            return value.stringValue ? *value.stringValue : std::string();
+    }
+    return std::string();
+}
+
+std::string LiteColumnarTableModel::getCellText(size_t row, size_t col) const {
+    if (row >= m_rowCount || col >= m_columns.size()) return std::string();
+    ColumnValue value = getValue(row, col);
+    const Formatter& formatter = m_columns[col].formatter;
+    return formatter ? formatter(value) : formatDefault(value);
+}
+
+TableCellStyle LiteColumnarTableModel::getCellStyle(size_t row, size_t col) const {
+    if (m_styles.empty()) return TableCellStyle();
+    auto it = m_styles.find(styleKey(row, col));
+    return it != m_styles.end() ? it->second : TableCellStyle();
+}
+
+void LiteColumnarTableModel::getSortColumn(size_t col, size_t first, size_t count, TableSortColumn& out) const {
+    if (col >= m_columns.size()) {
+        LiteTableModel::getSortColumn(col, first, count, out);
+        return;
+    }
+
+    first = std::min(first, m_rowCount);
+    size_t end = first + std::min(count, m_rowCount - first);
+    const Column& column = m_columns[col];
+    switch (column.type) {
+        case ColumnType::Int64:
+        case ColumnType::Timestamp:
+            out.kind = TableSortColumn::Kind::Int64;
+            out.ints.assign(column.ints.begin() + first, column.ints.begin() + end);
+            break;
+        case ColumnType::Double:
+            out.kind = TableSortColumn::Kind::Double;
+            out.doubles.assign(column.doubles.begin() + first, column.doubles.begin() + end);
+            break;
+        case ColumnType::String:
+            out.kind = TableSortColumn::Kind::Dictionary;
+            out.strings.clear();
+            if (first == 0 && end == m_rowCount) {
+                out.codes.assign(column.codes.begin(), column.codes.begin() + end);
+                out.strings.assign(column.dictionary.begin(), column.dictionary.end());
+            } else {
+                // 部分行只带出用到的字典项，不拷贝整个字典
+                std::unordered_map<uint32_t, uint32_t> local;
+                out.codes.clear();
+                out.codes.reserve(end - first);
+                for (size_t row = first; row < end; ++row) {
+                    uint32_t code = column.codes[row];
+                    auto result = local.emplace(code, static_cast<uint32_t>(out.strings.size()));
+                    if (result.second) {
+                        out.strings.push_back(code < column.dictionary.size() ? column.dictionary[code] : std::string());
+                    }
+                    out.codes.push_back(result.first->second);
+                }
+            }
+            break;
+    }
+
+    out.nulls.clear();
+    for (size_t row = first; row < end;) {
+        size_t bit = row & 63;
+        size_t bits = std::min<size_t>(64 - bit, end - row);
+        uint64_t mask = (bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1) << bit;
+        if ((column.presentBits[row >> 6] & mask) != mask) {
+            // 存在 null 时才生成逐行标记
+            out.nulls.assign(end - first, 0);
+            for (size_t r = row; r < end; ++r) {
+                out.nulls[r - first] = isNull(r, col) ? 1 : 0;
+            }
+            break;
+        }
+        row += bits;
+    }
+}
+
+// ==================== 列 ====================
+
+size_t LiteColumnarTableModel::addColumn(const std::string& name, ColumnType type) {
+    Column column;
+    column.name = name;
+    column.type = type;
+    resizeColumn(column, m_rowCount);
+    m_columns.push_back(std::move(column));
+    notifyColumnsChanged();
+    return m_columns.size() - 1;
+}
+
+void LiteColumnarTableModel::setFormatter(size_t col, Formatter formatter) {
+    if (col >= m_columns.size()) return;
+    m_columns[col].formatter = std::move(formatter);
+    rowsChanged(0, m_rowCount);
+}
+
+void LiteColumnarTableModel::resizeColumn(Column& column, size_t rows) {
+    switch (column.type) {
+        case ColumnType::Int64:
+        case ColumnType::Timestamp:
+            column.ints.resize(rows, 0);
+            break;
+        case ColumnType::Double:
+            column.doubles.resize(rows, 0.0);
+            break;
+        case ColumnType::String:
+            column.codes.resize(rows, 0);
+            break;
+    }
+    column.presentBits.resize((rows + 63) / 64, 0);
+}
+
+// ==================== 行与单元格 ====================
+
+void LiteColumnarTableModel::reserve(size_t rows) {
+    for (auto& column : m_columns) {
+        switch (column.type) {
+            case ColumnType::Int64:
+            case ColumnType::Timestamp:
+                column.ints.reserve(rows);
+                break;
+            case ColumnType::Double:
+                column.doubles.reserve(rows);
+                break;
+            case ColumnType::String:
+                column.codes.reserve(rows);
+                break;
+        }
+        column.presentBits.reserve((rows + 63) / 64);
+    }
+}
+
+size_t LiteColumnarTableModel::appendRow() {
+    size_t row = m_rowCount++;
+    for (auto& column : m_columns) {
+        resizeColumn(column, m_rowCount);
+        // 复用的位图字可能残留 clear() 之前的数据
+        setPresent(column, row, false);
+    }
+
+    if (m_updateDepth > 0) {
+        if (m_pendingInsertCount == 0) {
+            m_pendingInsertFirst = row;
+        }
+        ++m_pendingInsertCount;
+    } else {
+        notifyRowsInserted(row, 1);
+    }
+    return row;
+}
+
+size_t LiteColumnarTableModel::appendBlock(std::vector<ColumnBlock> blocks, size_t rowCount) {
+    size_t first = m_rowCount;
+    if (rowCount == 0) return first;
+    m_rowCount += rowCount;
+
+    std::vector<uint32_t> remap;
+    for (size_t col = 0; col < m_columns.size(); ++col) {
+        Column& column = m_columns[col];
+        resizeColumn(column, m_rowCount);
+        ColumnBlock* block = col < blocks.size() ? &blocks[col] : nullptr;
+        bool hasValues = false;
+        size_t codeLimit = 0;   // 不小于该值的编号按 null 处理
+        if (block) {
+            switch (column.type) {
+                case ColumnType::Int64:
+                case ColumnType::Timestamp:
+                    hasValues = block->ints.size() >= rowCount;
+                    if (hasValues) std::copy_n(block->ints.begin(), rowCount, column.ints.begin() + first);
+                    break;
+                case ColumnType::Double:
+                    hasValues = block->doubles.size() >= rowCount;
+                    if (hasValues) std::copy_n(block->doubles.begin(), rowCount, column.doubles.begin() + first);
+                    break;
+                case ColumnType::String:
+                    hasValues = block->codes.size() >= rowCount;
+                    if (hasValues && block->globalCodes) {
+                        // 已是列字典编号：按编号顺序移入新增项，索引留到 intern 时补建
+                        if (block->dictionaryBase == column.dictionary.size()) {
+                            for (auto& entry : block->dictionary) {
+                                column.dictionary.push_back(std::move(entry));
+                            }
+                        }
+                        codeLimit = column.dictionary.size();
+                        std::copy_n(block->codes.begin(), rowCount, column.codes.begin() + first);
+                    } else if (hasValues) {
+                        remap.resize(block->dictionary.size());
+                        for (size_t i = 0; i < block->dictionary.size(); ++i) {
+                            remap[i] = intern(column, block->dictionary[i]);
+                        }
+                        for (size_t i = 0; i < rowCount; ++i) {
+                            uint32_t code = block->codes[i];
+                            column.codes[first + i] = code < remap.size() ? remap[code] : 0;   // 越界编号按 null 处理
+                        }
+                        codeLimit = remap.size();
+                    }
+                    break;
+            }
+        }
+        bool hasPresent = hasValues && block->present.size() >= rowCount;
+        bool checkCodes = column.type == ColumnType::String;
+        for (size_t i = 0; i < rowCount; ++i) {
+            bool present = hasPresent && block->present[i] != 0 &&
+                           (!checkCodes || block->codes[i] < codeLimit);
+            setPresent(column, first + i, present);
+        }
+    }
+
+    if (m_updateDepth > 0) {
+        if (m_pendingInsertCount == 0) {
+            m_pendingInsertFirst = first;
+        }
+        m_pendingInsertCount += rowCount;
+    } else {
+        notifyRowsInserted(first, rowCount);
+    }
+    return first;
+}
+
+void LiteColumnarTableModel::clear() {
+    m_rowCount = 0;
+    for (auto& column : m_columns) {
+        resizeColumn(column, 0);
+        // 不再被任何行引用的字典项一并释放
+        std::unordered_map<std::string_view, uint32_t>().swap(column.dictionaryIndex);
+        std::deque<std::string>().swap(column.dictionary);
+        column.indexed = 0;
+    }
+    m_styles.clear();
+
+    if (m_updateDepth > 0) {
+        m_pendingReset = true;
+    } else {
+        notifyReset();
+    }
+}
+
+LiteColumnarTableModel::Column* LiteColumnarTableModel::columnFor(size_t row, size_t col, ColumnType type) {
+    if (row >= m_rowCount || col >= m_columns.size()) return nullptr;
+    Column& column = m_columns[col];
+    // Timestamp 与 Int64 共用存储，可互相写入
+    bool intLike = type == ColumnType::Int64 || type == ColumnType::Timestamp;
+    bool columnIntLike = column.type == ColumnType::Int64 || column.type == ColumnType::Timestamp;
+    if (column.type != type && !(intLike && columnIntLike)) return nullptr;
+    return &column;
+}
+
+void LiteColumnarTableModel::setPresent(Column& column, size_t row, bool present) {
+    uint64_t mask = uint64_t(1) << (row & 63);
+    if (present) {
+        column.presentBits[row >> 6] |= mask;
+    } else {
+        column.presentBits[row >> 6] &= ~mask;
+    }
+}
+
+uint32_t LiteColumnarTableModel::intern(Column& column, const std::string& value) {
+    // appendBlock 按编号直接追加的项在这里补建索引
+    for (; column.indexed < column.dictionary.size(); ++column.indexed) {
+        column.dictionaryIndex.emplace(column.dictionary[column.indexed], static_cast<uint32_t>(column.indexed));
+    }
+    auto it = column.dictionaryIndex.find(value);
+    if (it != column.dictionaryIndex.end()) return it->second;
+    uint32_t code = static_cast<uint32_t>(column.dictionary.size());
+    column.dictionary.push_back(value);
+    column.dictionaryIndex.emplace(column.dictionary.back(), code);
+    column.indexed = column.dictionary.size();
+    return code;
+}
+
+void LiteColumnarTableModel::setInt64(size_t row, size_t col, int64_t value) {
+    Column* column = columnFor(row, col, ColumnType::Int64);
+    if (!column) return;
+    column->ints[row] = value;
+    setPresent(*column, row, true);
+    rowsChanged(row, 1);
+}
+
+void LiteColumnarTableModel::setDouble(size_t row, size_t col, double value) {
+    Column* column = columnFor(row, col, ColumnType::Double);
+    if (!column) return;
+    column->doubles[row] = value;
+    setPresent(*column, row, true);
+    rowsChanged(row, 1);
+}
+
+void LiteColumnarTableModel::setTimestamp(size_t row, size_t col, int64_t millis) {
+    Column* column = columnFor(row, col, ColumnType::Timestamp);
+    if (!column) return;
+    column->ints[row] = millis;
+    setPresent(*column, row, true);
+    rowsChanged(row, 1);
+}
+
+void LiteColumnarTableModel::setString(size_t row, size_t col, const std::string& value) {
+    Column* column = columnFor(row, col, ColumnType::String);
+    if (!column) return;
+    column->codes[row] = intern(*column, value);
+    setPresent(*column, row, true);
+    rowsChanged(row, 1);
+}
+
+void LiteColumnarTableModel::setNull(size_t row, size_t col) {
+    if (row >= m_rowCount || col >= m_columns.size()) return;
+    setPresent(m_columns[col], row, false);
+    rowsChanged(row, 1);
+}
+
+bool LiteColumnarTableModel::isNull(size_t row, size_t col) const {
+    if (row >= m_rowCount || col >= m_columns.size()) return true;
+    return (m_columns[col].presentBits[row >> 6] & (uint64_t(1) << (row & 63))) == 0;
+}
+
+ColumnValue LiteColumnarTableModel::getValue(size_t row, size_t col) const {
+    ColumnValue value;
+    if (col >= m_columns.size()) {
+        value.isNull = true;
+        return value;
+    }
+    const Column& column = m_columns[col];
+    value.type = column.type;
+    value.isNull = isNull(row, col);
+    if (value.isNull) return value;
+
+    switch (column.type) {
+        case ColumnType::Int64:
+        case ColumnType::Timestamp:
+            value.intValue = column.ints[row];
+            break;
+        case ColumnType::Double:
+            value.doubleValue = column.doubles[row];
+            break;
+        case ColumnType::String:
+            value.stringValue = &column.dictionary[column.codes[row]];
+            break;
+    }
+    return value;
+}
+
+bool LiteColumnarTableModel::getCellNumber(size_t row, size_t col, double& value) const {
+    if (row >= m_rowCount || col >= m_columns.size()) return false;
+    const Column& column = m_columns[col];
+    if (column.type == ColumnType::String) {
+        return LiteTableModel::getCellNumber(row, col, value);
+    }
+    if (isNull(row, col)) return false;
+    value = column.type == ColumnType::Double ? column.doubles[row] : static_cast<double>(column.ints[row]);
+    return true;
+}
+
+// ==================== 批量修改 ====================
+
+void LiteColumnarTableModel::rowsChanged(size_t first, size_t count) {
+    if (count == 0) return;
+    if (m_updateDepth > 0) {
+        size_t last = first + count - 1;
+        // 批量期间新追加的行会随插入通知一起刷新
+        if (m_pendingInsertCount > 0 && last >= m_pendingInsertFirst) {
+            if (first >= m_pendingInsertFirst) return;
+            last = m_pendingInsertFirst - 1;
+        }
+        m_pendingChangeFirst = std::min(m_pendingChangeFirst, first);
+        m_pendingChangeLast = std::max(m_pendingChangeLast, last);
+        return;
+    }
+    notifyDataChanged(first, count);
+}
+
+void LiteColumnarTableModel::beginUpdate() {
+    ++m_updateDepth;
+}
+
+void LiteColumnarTableModel::endUpdate() {
+    if (m_updateDepth == 0 || --m_updateDepth > 0) return;
+
+    bool reset = m_pendingReset;
+    size_t insertFirst = m_pendingInsertFirst;
+    size_t insertCount = m_pendingInsertCount;
+    size_t changeFirst = m_pendingChangeFirst;
+    size_t changeLast = m_pendingChangeLast;
+    m_pendingReset = false;
+    m_pendingInsertCount = 0;
+    m_pendingChangeFirst = SIZE_MAX;
+    m_pendingChangeLast = 0;
+
+    if (reset) {
+        notifyReset();
+        return;
+    }
+    if (changeFirst != SIZE_MAX && changeFirst < m_rowCount) {
+        notifyDataChanged(changeFirst, std::min(changeLast + 1, m_rowCount) - changeFirst);
+    }
+    if (insertCount > 0) {
+        notifyRowsInserted(insertFirst, insertCount);
+    }
+}
+
+// ==================== 稀疏样式覆盖 ====================
+
+void LiteColumnarTableModel::setCellStyle(size_t row, size_t col, const TableCellStyle& style) {
+    if (row >= m_rowCount || col >= m_columns.size()) return;
+    m_styles[styleKey(row, col)] = style;
+    rowsChanged(row, 1);
+}
+
+void LiteColumnarTableModel::clearCellStyle(size_t row, size_t col) {
+    if (m_styles.erase(styleKey(row, col))) {
+        rowsChanged(row, 1);
+    }
+}
+
+void LiteColumnarTableModel::clearCellStyles() {
+    if (m_styles.empty()) return;
+    m_styles.clear();
+    rowsChanged(0, m_rowCount);
+}
+
+size_t LiteColumnarTableModel::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& column : m_columns) {
+        bytes += column.ints.size() * sizeof(int64_t);
+        bytes += column.doubles.size() * sizeof(double);
+        bytes += column.codes.size() * sizeof(uint32_t);
+        bytes += column.presentBits.size() * sizeof(uint64_t);
+        for (const auto& str : column.dictionary) {
+            bytes += sizeof(std::string) + str.capacity();
+        }
+        // 索引项只引用字典中的字符串：键、编号与节点的两个指针
+        bytes += column.dictionaryIndex.size() *
+                 (sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*));
+    }
+    bytes += m_styles.size() * (sizeof(uint64_t) + sizeof(TableCellStyle));
+    return bytes;
+}
+
+} // namespace liteDui
@@ -0,0 +1,867 @@
+/**
+ * lite_csv_loader.cpp - CSV/TSV 并行加载实现
+ */
+
+#include "lite_csv_loader.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+
+namespace liteDui {
+
+namespace {
+
+// 每解析这么多行检查一次取消标记
+constexpr size_t kCancelCheckRows = 4096;
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+void trim(const char*& text, size_t& length) {
+    while (length > 0 && isBlank(text[0])) {
+        ++text;
+        --length;
+    }
+    while (length > 0 && isBlank(text[length - 1])) {
+        --length;
+    }
+}
+
+// ==================== 字段解析 ====================
+
+/**
+ * 一个字段：未转义的字段直接指向映射内存，含 "" 转义的字段指向记录缓冲区
+ */
+struct Field {
+    const char* data = nullptr;
+    size_t length = 0;
+    size_t bufferOffset = 0;
+    bool buffered = false;
+};
+
+/**
+ * 读取从 p 开始的一条记录，返回下一条记录的起点
+ * 带引号字段中的换行属于字段内容；行尾的 '\r' 被去掉
+ */
+const char* readRecord(const char* p, const char* end, char delimiter,
+                       std::vector<Field>& fields, std::string& buffer, bool* unterminated = nullptr) {
+    fields.clear();
+    buffer.clear();
+
+    for (;;) {
+        Field field;
+        if (p < end && *p == '"') {
+            const char* start = ++p;
+            for (;;) {
+                const char* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+                if (!quote) {
+                    // 未闭合的引号：剩余内容全部属于该字段
+                    quote = end;
+                    if (unterminated) *unterminated = true;
+                }
+                if (quote + 1 < end && quote[1] == '"') {
+                    // "" 转义：切换到缓冲区
+                    if (!field.buffered) {
+                        field.buffered = true;
+                        field.bufferOffset = buffer.size();
+                        buffer.append(start, p - start);
+                    }
+                    buffer.append(p, quote + 1 - p);
+                    p = quote + 2;
+                    continue;
+                }
+                if (field.buffered) {
+                    buffer.append(p, quote - p);
+                } else {
+                    field.data = start;
+                    field.length = quote - start;
+                }
+                p = quote < end ? quote + 1 : end;
+                break;
+            }
+            // 闭合引号之后到分隔符之前的内容原样追加
+            const char* rest = p;
+            while (p < end && *p != delimiter && *p != '\n') ++p;
+            size_t restLength = p - rest;
+            if (restLength > 0 && p < end && *p == '\n' && rest[restLength - 1] == '\r') --restLength;
+            if (restLength > 0) {
+                if (!field.buffered) {
+                    field.buffered = true;
+                    field.bufferOffset = buffer.size();
+                    buffer.append(field.data, field.length);
+                }
+                buffer.append(rest, restLength);
+            }
+            if (field.buffered) {
+                field.length = buffer.size() - field.bufferOffset;
+            }
+        } else {
+            const char* start = p;
+            while (p < end && *p != delimiter && *p != '\n') ++p;
+            field.data = start;
+            field.length = p - start;
+            if (field.length > 0 && (p == end || *p == '\n') && start[field.length - 1] == '\r') {
+                --field.length;
+            }
+        }
+        fields.push_back(field);
+
+        if (p < end && *p == delimiter) {
+            ++p;
+            continue;
+        }
+        return p < end ? p + 1 : end;
+    }
+}
+
+const char* fieldData(const Field& field, const std::string& buffer) {
+    return field.buffered ? buffer.data() + field.bufferOffset : field.data;
+}
+
+bool isEmptyRecord(const std::vector<Field>& fields) {
+    return fields.size() == 1 && fields[0].length == 0 && !fields[0].buffered;
+}
+
+// ==================== 块边界扫描 ====================
+
+/**
+ * 与 readRecord 一致的词法状态：引号只在字段开头有特殊含义
+ */
+enum LexState : uint8_t {
+    kFieldStart = 0,   // 字段开头（记录开头或分隔符之后）
+    kUnquoted = 1,     // 未加引号的字段中，引号是普通字符
+    kQuoted = 2,       // 带引号字段中，分隔符与换行是普通字符
+    kQuoteSeen = 3     // 带引号字段中遇到引号：再一个引号为转义，否则引号已闭合
+};
+
+enum CharClass : uint8_t { kOther = 0, kQuote = 1, kDelimiter = 2, kNewline = 3 };
+
+constexpr uint8_t kLexNext[4][4] = {
+    //             其它         引号        分隔符        换行
+    /* 字段开头 */ {kUnquoted, kQuoted, kFieldStart, kFieldStart},
+    /* 未加引号 */ {kUnquoted, kUnquoted, kFieldStart, kFieldStart},
+    /* 引号内 */   {kQuoted, kQuoteSeen, kQuoted, kQuoted},
+    /* 遇到引号 */ {kUnquoted, kQuoted, kFieldStart, kFieldStart},
+};
+
+// 4 个起点状态各自保持原样的映射（每个状态占 2 位）
+constexpr uint8_t kIdentityLanes = 0xE4;
+
+// ==================== 数值与时间解析 ====================
+
+bool parseInt64(const char* text, size_t length, int64_t& value) {
+    trim(text, length);
+    if (length == 0) return false;
+    size_t i = 0;
+    bool negative = false;
+    if (text[0] == '-' || text[0] == '+') {
+        negative = text[0] == '-';
+        ++i;
+    }
+    if (i == length || length - i > 19) return false;
+    uint64_t magnitude = 0;
+    for (; i < length; ++i) {
+        unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+        if (digit > 9) return false;
+        magnitude = magnitude * 10 + digit;
+    }
+    if (magnitude > static_cast<uint64_t>(INT64_MAX) + (negative ? 1 : 0)) return false;
+    value = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+bool parseDoubleSlow(const char* text, size_t length, double& value) {
+    char stack[64];
+    std::string heap;
+    char* copy = stack;
+    if (length >= sizeof(stack)) {
+        heap.assign(text, length);
+        copy = &heap[0];
+    } else {
+        std::memcpy(stack, text, length);
+        stack[length] = '\0';
+    }
+    char* end = nullptr;
+    value = std::strtod(copy, &end);
+    return end == copy + length;
+}
+
+/**
+ * 十进制浮点数解析：有效数字不超过 15 位且指数不超过 22 时乘除一次 10 的幂即精确，
+ * 其余情况交给 strtod（不接受 inf/nan 等非数字写法，避免把文本列推断为数值列）
+ */
+bool parseDouble(const char* text, size_t length, double& value) {
+    static const double kPow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    trim(text, length);
+    if (length == 0) return false;
+    size_t i = 0;
+    bool negative = false;
+    if (text[0] == '-' || text[0] == '+') {
+        negative = text[0] == '-';
+        ++i;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;         // 有效数字位数（不含前导零）
+    int exponent = 0;
+    bool anyDigit = false;
+    for (; i < length && text[i] >= '0' && text[i] <= '9'; ++i) {
+        anyDigit = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (text[i] - '0');
+            if (mantissa != 0) ++digits;
+        } else {
+            ++exponent;
+            ++digits;
+        }
+    }
+    if (i < length && text[i] == '.') {
+        for (++i; i < length && text[i] >= '0' && text[i] <= '9'; ++i) {
+            anyDigit = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (text[i] - '0');
+                if (mantissa != 0) ++digits;
+                --exponent;
+            } else {
+                ++digits;
+            }
+        }
+    }
+    if (!anyDigit) return false;
+
+    if (i < length && (text[i] == 'e' || text[i] == 'E')) {
+        ++i;
+        bool expNegative = false;
+        if (i < length && (text[i] == '-' || text[i] == '+')) {
+            expNegative = text[i] == '-';
+            ++i;
+        }
+        if (i == length) return false;
+        int exp = 0;
+        for (; i < length && text[i] >= '0' && text[i] <= '9'; ++i) {
+            if (exp < 100000) exp = exp * 10 + (text[i] - '0');
+        }
+        exponent += expNegative ? -exp : exp;
+    }
+    if (i != length) return false;
+
+    if (digits > 15 || exponent < -22 || exponent > 22) {
+        return parseDoubleSlow(text, length, value);
+    }
+    double result = static_cast<double>(mantissa);
+    result = exponent < 0 ? result / kPow10[-exponent] : result * kPow10[exponent];
+    value = negative ? -result : result;
+    return true;
+}
+
+// 公历日期 -> 自 1970-01-01 起的天数
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+/**
+ * 本地时区在 utcSeconds 附近的偏移（秒），按小时缓存
+ * 与 LiteColumnarTableModel 显示时使用的 localtime 一致
+ */
+int64_t localOffsetSeconds(int64_t utcSeconds) {
+    thread_local int64_t cachedHour = INT64_MIN;
+    thread_local int64_t cachedOffset = 0;
+    int64_t hour = utcSeconds >= 0 ? utcSeconds / 3600 : (utcSeconds - 3599) / 3600;
+    if (hour != cachedHour) {
+        std::time_t t = static_cast<std::time_t>(hour * 3600);
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        int64_t local = daysFromCivil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * 86400 +
+                        tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+        cachedOffset = local - hour * 3600;
+        cachedHour = hour;
+    }
+    return cachedOffset;
+}
+
+bool readDigits(const char* text, size_t length, size_t& pos, size_t count, int& value) {
+    if (pos + count > length) return false;
+    value = 0;
+    for (size_t i = 0; i < count; ++i) {
+        unsigned digit = static_cast<unsigned char>(text[pos + i]) - '0';
+        if (digit > 9) return false;
+        value = value * 10 + static_cast<int>(digit);
+    }
+    pos += count;
+    return true;
+}
+
+/**
+ * 解析 ISO 8601 风格的时间：YYYY-MM-DD[( |T)HH:MM[:SS[.fff]]][Z|±HH[:]MM]
+ * 不带时区时按本地时间解释
+ */
+bool parseTimestamp(const char* text, size_t length, int64_t& millis) {
+    trim(text, length);
+    size_t pos = 0;
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0, fraction = 0;
+    if (!readDigits(text, length, pos, 4, year) || pos >= length || text[pos++] != '-') return false;
+    if (!readDigits(text, length, pos, 2, month) || pos >= length || text[pos++] != '-') return false;
+    if (!readDigits(text, length, pos, 2, day)) return false;
+    if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+
+    if (pos < length && (text[pos] == ' ' || text[pos] == 'T')) {
+        ++pos;
+        if (!readDigits(text, length, pos, 2, hour) || pos >= length || text[pos++] != ':') return false;
+        if (!readDigits(text, length, pos, 2, minute)) return false;
+        if (pos < length && text[pos] == ':') {
+            ++pos;
+            if (!readDigits(text, length, pos, 2, second)) return false;
+            if (pos < length && (text[pos] == '.' || text[pos] == ',')) {
+                ++pos;
+                int scale = 100;
+                size_t start = pos;
+                for (; pos < length && text[pos] >= '0' && text[pos] <= '9'; ++pos) {
+                    fraction += (text[pos] - '0') * scale;
+                    scale /= 10;
+                }
+                if (pos == start) return false;
+            }
+        }
+        if (hour > 23 || minute > 59 || second > 60) return false;
+    }
+
+    int64_t seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    if (pos == length) {
+        seconds -= localOffsetSeconds(seconds - localOffsetSeconds(seconds));
+    } else if (text[pos] == 'Z' && pos + 1 == length) {
+        // UTC
+    } else if (text[pos] == '+' || text[pos] == '-') {
+        int sign = text[pos++] == '-' ? -1 : 1;
+        int offsetHour = 0, offsetMinute = 0;
+        if (!readDigits(text, length, pos, 2, offsetHour)) return false;
+        if (pos < length && text[pos] == ':') ++pos;
+        if (pos < length && !readDigits(text, length, pos, 2, offsetMinute)) return false;
+        if (pos != length) return false;
+        seconds -= sign * (offsetHour * 3600 + offsetMinute * 60);
+    } else {
+        return false;
+    }
+    millis = seconds * 1000 + fraction;
+    return true;
+}
+
+// 类型合并：Int64 与 Double 合并为 Double，其余不同类型合并为 String
+ColumnType mergeType(ColumnType a, ColumnType b) {
+    if (a == b) return a;
+    if ((a == ColumnType::Int64 && b == ColumnType::Double) ||
+        (a == ColumnType::Double && b == ColumnType::Int64)) {
+        return ColumnType::Double;
+    }
+    return ColumnType::String;
+}
+
+char detectDelimiter(const std::string& path, const char* data, const char* end) {
+    size_t dot = path.find_last_of('.');
+    if (dot != std::string::npos) {
+        std::string ext = path.substr(dot + 1);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (ext == "tsv" || ext == "tab") return '\t';
+    }
+
+    // 统计首行中不在引号内的候选分隔符
+    const char candidates[] = {',', '\t', ';', '|'};
+    size_t counts[4] = {0, 0, 0, 0};
+    bool quoted = false;
+    for (const char* p = data; p < end; ++p) {
+        if (*p == '"') {
+            quoted = !quoted;
+        } else if (!quoted) {
+            if (*p == '\n') break;
+            for (int i = 0; i < 4; ++i) {
+                if (*p == candidates[i]) ++counts[i];
+            }
+        }
+    }
+    int best = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (counts[i] > counts[best]) best = i;
+    }
+    return candidates[best];
+}
+
+} // namespace
+
+/**
+ * 一块的解析结果
+ */
+struct LiteCsvLoader::Chunk {
+    size_t rowCount = 0;
+    uint64_t bytes = 0;
+    size_t mismatches = 0;
+    size_t malformedRows = 0;
+    bool unterminatedQuote = false;
+    std::vector<ColumnBlock> blocks;         // 与模型列一一对应
+    std::vector<uint32_t> dictionaryEnds;    // 每个加载列用到的最大全局编号 + 1
+};
+
+/**
+ * 一个 String 列的共享字典：全局编号即模型列字典的编号
+ * 工作线程把批内字典并入 entries 并为新增项复制一份到 pending，
+ * UI 线程按块的文件顺序从 pending 取出（移动）到模型，编号 committed 之前的项已交给模型
+ */
+struct LiteCsvLoader::SharedDictionary {
+    std::mutex mutex;
+    std::deque<std::string> entries;   // deque 追加时地址不变，可作为索引的键
+    std::unordered_map<std::string_view, uint32_t> index;
+    std::deque<std::string> pending;   // 编号从 committed 开始
+    uint32_t committed = 0;
+};
+
+// ==================== LiteCsvLoader ====================
+
+LiteCsvLoader::LiteCsvLoader() = default;
+
+LiteCsvLoader::~LiteCsvLoader() {
+    stop();
+}
+
+bool LiteCsvLoader::inferFieldType(const char* text, size_t length, ColumnType& type) {
+    trim(text, length);
+    if (length == 0) return false;
+    int64_t intValue = 0;
+    double doubleValue = 0;
+    if (parseInt64(text, length, intValue)) {
+        type = ColumnType::Int64;
+    } else if (parseDouble(text, length, doubleValue)) {
+        type = ColumnType::Double;
+    } else if (parseTimestamp(text, length, intValue)) {
+        type = ColumnType::Timestamp;
+    } else {
+        type = ColumnType::String;
+    }
+    return true;
+}
+
+bool LiteCsvLoader::open(const std::string& path, std::shared_ptr<LiteColumnarTableModel> model,
+                         const Options& options) {
+    if (!model) return false;
+    stop();
+
+    auto file = LiteFileHandle::mapFile(path);
+    if (!file) return false;
+    // 各块按顺序扫描，提示内核预读
+    file->adviseSequential();
+
+    m_file = std::move(file);
+    m_model = std::move(model);
+    m_columnNames.clear();
+    m_columnTypes.clear();
+    m_done.clear();
+    m_nextCommit = 0;
+    m_progress = Progress();
+    m_progress.totalBytes = m_file->size;
+
+    const char* data = m_file->data;
+    const char* end = data + m_file->size;
+    const char* begin = data;
+    if (m_file->size >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0) {
+        begin += 3;   // UTF-8 BOM
+    }
+    m_delimiter = options.delimiter ? options.delimiter : detectDelimiter(path, begin, end);
+
+    // 表头
+    std::vector<Field> fields;
+    std::string buffer;
+    const char* dataStart = begin;
+    if (options.hasHeader && begin < end) {
+        dataStart = readRecord(begin, end, m_delimiter, fields, buffer);
+        for (const auto& field : fields) {
+            const char* text = fieldData(field, buffer);
+            size_t length = field.length;
+            trim(text, length);
+            m_columnNames.emplace_back(text, length);
+        }
+    }
+
+    // 采样推断列类型（未知类型记为 -1）
+    std::vector<int> sampled(m_columnNames.size(), -1);
+    const char* p = dataStart;
+    for (size_t row = 0; row < options.sampleRows && p < end; ) {
+        p = readRecord(p, end, m_delimiter, fields, buffer);
+        if (isEmptyRecord(fields)) continue;
+        if (fields.size() > sampled.size() && (!options.hasHeader || m_columnNames.empty())) {
+            sampled.resize(fields.size(), -1);
+        }
+        for (size_t col = 0; col < fields.size() && col < sampled.size(); ++col) {
+            ColumnType type;
+            if (!options.inferTypes ||
+                !inferFieldType(fieldData(fields[col], buffer), fields[col].length, type)) {
+                continue;
+            }
+            sampled[col] = sampled[col] < 0 ? static_cast<int>(type)
+                                            : static_cast<int>(mergeType(static_cast<ColumnType>(sampled[col]), type));
+        }
+        ++row;
+    }
+    for (size_t col = 0; col < sampled.size(); ++col) {
+        m_columnTypes.push_back(sampled[col] < 0 ? ColumnType::String : static_cast<ColumnType>(sampled[col]));
+        if (col >= m_columnNames.size()) {
+            m_columnNames.push_back("Column " + std::to_string(col + 1));
+        }
+    }
+
+    // 重建模型列；String 列的共享字典从空开始，与新建的模型列字典编号一致
+    m_model->clear();
+    m_firstColumn = m_model->getColumnCount();
+    m_dictionaries.clear();
+    for (size_t col = 0; col < m_columnNames.size(); ++col) {
+        m_model->addColumn(m_columnNames[col], m_columnTypes[col]);
+        m_dictionaries.push_back(m_columnTypes[col] == ColumnType::String ? std::make_unique<SharedDictionary>()
+                                                                          : nullptr);
+    }
+
+    // 划分块：首块较小，尽快显示首屏
+    uint64_t chunkBytes = std::max<uint64_t>(options.chunkBytes, 64 * 1024);
+    m_chunkStarts.clear();
+    uint64_t offset = static_cast<uint64_t>(dataStart - data);
+    uint64_t step = chunkBytes / 8;
+    while (offset < m_file->size) {
+        m_chunkStarts.push_back(offset);
+        offset += step;
+        step = chunkBytes;
+    }
+    m_chunkStarts.push_back(m_file->size);
+
+    // 扫描表：一次查表同时推进从 4 个起点状态出发的扫描
+    m_charClasses.assign(256, kOther);
+    m_charClasses[static_cast<uint8_t>('"')] = kQuote;
+    m_charClasses[static_cast<uint8_t>('\n')] = kNewline;
+    m_charClasses[static_cast<uint8_t>(m_delimiter)] = kDelimiter;
+    m_scanTable.resize(256 * 256);
+    for (unsigned lanes = 0; lanes < 256; ++lanes) {
+        for (unsigned c = 0; c < 256; ++c) {
+            uint8_t cls = m_charClasses[c];
+            unsigned next = 0;
+            for (unsigned lane = 0; lane < 4; ++lane) {
+                next |= static_cast<unsigned>(kLexNext[(lanes >> (lane * 2)) & 3][cls]) << (lane * 2);
+            }
+            m_scanTable[(lanes << 8) | c] = static_cast<uint8_t>(next);
+        }
+    }
+
+    size_t chunkCount = m_chunkStarts.size() - 1;
+    m_transitions.assign(chunkCount, UINT16_MAX);
+    m_startStates.assign(chunkCount, kFieldStart);
+    m_stateKnown = chunkCount > 0 ? 1 : 0;
+    m_nextScan = 0;
+    m_nextParse = 0;
+    m_cancel = false;
+
+    size_t threads = options.threadCount;
+    if (threads == 0) {
+        threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::min(threads, chunkCount);
+    for (size_t i = 0; i < threads; ++i) {
+        m_workers.emplace_back(&LiteCsvLoader::workerLoop, this);
+    }
+    return true;
+}
+
+void LiteCsvLoader::workerLoop() {
+    size_t chunkCount = m_chunkStarts.size() - 1;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        // 起点状态已知的块优先解析，其余时间扫描后续块的状态映射
+        m_cv.wait(lock, [&] {
+            return m_cancel.load() || m_nextParse >= chunkCount || m_nextParse < m_stateKnown ||
+                   m_nextScan + 1 < chunkCount;
+        });
+        if (m_cancel.load() || m_nextParse >= chunkCount) return;
+
+        if (m_nextParse < m_stateKnown) {
+            size_t chunk = m_nextParse++;
+            uint8_t startState = m_startStates[chunk];
+            lock.unlock();
+            auto result = parseChunk(chunk, startState);
+            lock.lock();
+            if (result) {
+                m_done[chunk] = std::move(result);
+            }
+        } else {
+            // 最后一块的映射不影响任何块的起点
+            size_t chunk = m_nextScan++;
+            lock.unlock();
+            uint8_t transition = scanChunk(chunk);
+            lock.lock();
+            m_transitions[chunk] = transition;
+            while (m_stateKnown < chunkCount && m_transitions[m_stateKnown - 1] != UINT16_MAX) {
+                uint8_t lanes = static_cast<uint8_t>(m_transitions[m_stateKnown - 1]);
+                m_startStates[m_stateKnown] = (lanes >> (m_startStates[m_stateKnown - 1] * 2)) & 3;
+                ++m_stateKnown;
+            }
+            m_cv.notify_all();
+        }
+    }
+}
+
+uint8_t LiteCsvLoader::scanChunk(size_t chunk) const {
+    const auto* p = reinterpret_cast<const uint8_t*>(m_file->data + m_chunkStarts[chunk]);
+    const auto* end = reinterpret_cast<const uint8_t*>(m_file->data + m_chunkStarts[chunk + 1]);
+    const uint8_t* table = m_scanTable.data();
+    unsigned lanes = kIdentityLanes;
+    for (; p < end; ++p) {
+        lanes = table[(lanes << 8) | *p];
+    }
+    return static_cast<uint8_t>(lanes);
+}
+
+std::unique_ptr<LiteCsvLoader::Chunk> LiteCsvLoader::parseChunk(size_t chunk, uint8_t startState) const {
+    const char* data = m_file->data;
+    const char* fileEnd = data + m_file->size;
+    const char* rawStart = data + m_chunkStarts[chunk];
+    const char* rawEnd = data + m_chunkStarts[chunk + 1];
+
+    // 块内第一条记录的起点：第一个结束记录的换行符之后（首块从数据起点开始）
+    const char* p = rawStart;
+    if (chunk > 0 && !(startState == kFieldStart && rawStart[-1] == '\n')) {
+        uint8_t state = startState;
+        while (p < rawEnd) {
+            uint8_t cls = m_charClasses[static_cast<uint8_t>(*p++)];
+            state = kLexNext[state][cls];
+            if (cls == kNewline && state == kFieldStart) break;
+        }
+    }
+
+    auto result = std::make_unique<Chunk>();
+    result->bytes = m_chunkStarts[chunk + 1] - m_chunkStarts[chunk];
+    size_t columnCount = m_columnTypes.size();
+    result->blocks.resize(m_firstColumn + columnCount);
+
+    // 按采样的平均行长预估行数
+    size_t estimatedRows = static_cast<size_t>((rawEnd - p) / 64 + 16);
+    std::vector<std::unordered_map<std::string_view, uint32_t>> indexes(columnCount);
+    std::vector<std::deque<std::string>> dictionaries(columnCount);
+    for (size_t col = 0; col < columnCount; ++col) {
+        ColumnBlock& block = result->blocks[m_firstColumn + col];
+        block.present.reserve(estimatedRows);
+        switch (m_columnTypes[col]) {
+            case ColumnType::Int64:
+            case ColumnType::Timestamp:
+                block.ints.reserve(estimatedRows);
+                break;
+            case ColumnType::Double:
+                block.doubles.reserve(estimatedRows);
+                break;
+            case ColumnType::String:
+                block.codes.reserve(estimatedRows);
+                break;
+        }
+    }
+
+    std::vector<Field> fields;
+    std::string buffer;
+    size_t rows = 0;
+    while (p < rawEnd && p < fileEnd) {
+        p = readRecord(p, fileEnd, m_delimiter, fields, buffer, &result->unterminatedQuote);
+        if (isEmptyRecord(fields)) continue;
+        if (fields.size() != columnCount) ++result->malformedRows;
+
+        for (size_t col = 0; col < columnCount; ++col) {
+            ColumnBlock& block = result->blocks[m_firstColumn + col];
+            const char* text = nullptr;
+            size_t length = 0;
+            if (col < fields.size()) {
+                text = fieldData(fields[col], buffer);
+                length = fields[col].length;
+            }
+
+            bool present = false;
+            switch (m_columnTypes[col]) {
+                case ColumnType::Int64:
+                case ColumnType::Timestamp: {
+                    int64_t value = 0;
+                    if (length > 0) {
+                        present = m_columnTypes[col] == ColumnType::Int64 ? parseInt64(text, length, value)
+                                                                          : parseTimestamp(text, length, value);
+                    }
+                    block.ints.push_back(value);
+                    break;
+                }
+                case ColumnType::Double: {
+                    double value = 0;
+                    present = length > 0 && parseDouble(text, length, value);
+                    block.doubles.push_back(value);
+                    break;
+                }
+                case ColumnType::String: {
+                    uint32_t code = 0;
+                    if (text) {
+                        std::string_view key(text, length);
+                        auto it = indexes[col].find(key);
+                        if (it != indexes[col].end()) {
+                            code = it->second;
+                        } else {
+                            // 字典项存放在 deque 中，地址不随追加变化，可作为索引的键
+                            code = static_cast<uint32_t>(dictionaries[col].size());
+                            dictionaries[col].emplace_back(text, length);
+                            indexes[col].emplace(dictionaries[col].back(), code);
+                        }
+                        present = true;
+                    }
+                    block.codes.push_back(code);
+                    break;
+                }
+            }
+            if (!present && length > 0 && m_columnTypes[col] != ColumnType::String) {
+                const char* trimmed = text;
+                size_t trimmedLength = length;
+                trim(trimmed, trimmedLength);
+                if (trimmedLength > 0) ++result->mismatches;
+            }
+            block.present.push_back(present ? 1 : 0);
+        }
+
+        if (++rows % kCancelCheckRows == 0 && m_cancel.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+    }
+
+    // 批内字典并入共享字典，编号换成全局编号；查找与复制都在工作线程中完成
+    result->dictionaryEnds.assign(columnCount, 0);
+    std::vector<uint32_t> remap;
+    for (size_t col = 0; col < columnCount; ++col) {
+        if (!m_dictionaries[col]) continue;
+        SharedDictionary& shared = *m_dictionaries[col];
+        ColumnBlock& block = result->blocks[m_firstColumn + col];
+        remap.resize(dictionaries[col].size());
+        uint32_t end = 0;
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            for (size_t i = 0; i < dictionaries[col].size(); ++i) {
+                std::string& entry = dictionaries[col][i];
+                auto it = shared.index.find(entry);
+                if (it != shared.index.end()) {
+                    remap[i] = it->second;
+                } else {
+                    remap[i] = static_cast<uint32_t>(shared.entries.size());
+                    shared.pending.push_back(entry);
+                    shared.entries.push_back(std::move(entry));
+                    shared.index.emplace(shared.entries.back(), remap[i]);
+                }
+                end = std::max(end, remap[i] + 1);
+            }
+        }
+        for (size_t row = 0; row < rows; ++row) {
+            if (block.present[row]) block.codes[row] = remap[block.codes[row]];
+        }
+        block.globalCodes = true;
+        result->dictionaryEnds[col] = end;
+    }
+    result->rowCount = rows;
+    return result;
+}
+
+bool LiteCsvLoader::poll() {
+    if (!m_model || m_progress.finished) return false;
+
+    std::vector<std::unique_ptr<Chunk>> ready;
+    size_t chunkCount = m_chunkStarts.empty() ? 0 : m_chunkStarts.size() - 1;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_done.find(m_nextCommit); it != m_done.end(); it = m_done.find(m_nextCommit)) {
+            ready.push_back(std::move(it->second));
+            m_done.erase(it);
+            ++m_nextCommit;
+        }
+    }
+
+    if (!ready.empty()) {
+        // 多块合并为一次插入通知
+        m_model->beginUpdate();
+        for (const auto& chunk : ready) {
+            takeDictionaryEntries(*chunk);
+            m_model->appendBlock(std::move(chunk->blocks), chunk->rowCount);
+            m_progress.rowCount += chunk->rowCount;
+            m_progress.bytesLoaded += chunk->bytes;
+            m_progress.mismatchCount += chunk->mismatches;
+            m_progress.malformedRowCount += chunk->malformedRows;
+            m_progress.unterminatedQuote = m_progress.unterminatedQuote || chunk->unterminatedQuote;
+        }
+        m_model->endUpdate();
+    }
+
+    bool finished = m_nextCommit >= chunkCount;
+    if (finished) {
+        m_progress.bytesLoaded = m_progress.totalBytes;
+        finish(false);
+        return true;
+    }
+    if (!ready.empty() && m_progressCallback) {
+        m_progressCallback(m_progress);
+    }
+    return !ready.empty();
+}
+
+void LiteCsvLoader::takeDictionaryEntries(Chunk& chunk) {
+    // 块内编号可能引用后面的块先解析出的项：取出 committed 到 dictionaryEnds 之间的全部项
+    for (size_t col = 0; col < m_dictionaries.size(); ++col) {
+        if (!m_dictionaries[col] || col >= chunk.dictionaryEnds.size()) continue;
+        SharedDictionary& shared = *m_dictionaries[col];
+        ColumnBlock& block = chunk.blocks[m_firstColumn + col];
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        block.dictionaryBase = shared.committed;
+        block.dictionary.clear();
+        while (shared.committed < chunk.dictionaryEnds[col] && !shared.pending.empty()) {
+            block.dictionary.push_back(std::move(shared.pending.front()));
+            shared.pending.pop_front();
+            ++shared.committed;
+        }
+    }
+}
+
+void LiteCsvLoader::cancel() {
+    if (!m_model || m_progress.finished) return;
+    finish(true);
+}
+
+void LiteCsvLoader::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cancel = true;
+    }
+    m_cv.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_done.clear();
+}
+
+void LiteCsvLoader::finish(bool cancelled) {
+    stop();
+    m_file.reset();
+    m_dictionaries.clear();
+    m_progress.finished = true;
+    m_progress.cancelled = cancelled;
+    if (m_progressCallback) {
+        m_progressCallback(m_progress);
+    }
+}
+
+} // namespace liteDui
@@ -43,20 +43,8 @@ void LiteGroupBox::setContentPadding(const EdgeInsets& padding) {
 float LiteGroupBox::measureTitleWidth() const {
     if (m_title.empty()) return 0;
 
-    auto& fontMgr = getFontManager();
-    auto fontCollection = fontMgr.getFontCollection();
-
-    ParagraphStyle paraStyle;
-    auto textStyle = fontMgr.createTextStyle(m_titleColor, m_titleFontSize, getFontFamily());
-
-    auto builder = ParagraphBuilder::make(paraStyle, fontCollection);
-    builder->pushStyle(textStyle);
-    builder->addText(m_title.c_str());
-
-    auto paragraph = builder->Build();
-    paragraph->layout(10000);  // 足够大的宽度
-
-    return paragraph->getMaxIntrinsicWidth();
+    FontSpec titleFont{m_titleFontSize, getFontFamily()};
+    return getFontManager().measureText(m_title, titleFont).width;
 }
 
 void LiteGroupBox::render(SkCanvas* canvas) {
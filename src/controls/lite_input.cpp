@@ -1,21 +1,18 @@
 /**
  * lite_input.cpp - 输入框控件实现
- * 使用 skparagraph 实现精确文本测量和选择
+ * 使用 LiteTextLine 分段整形，编辑时只重新整形受影响的片段
  */
 
 #include "lite_input.h"
 #include "lite_utf8.h"
+#include "lite_text_renderer.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkRect.h"
-#include "modules/skparagraph/include/ParagraphBuilder.h"
-#include "modules/skparagraph/include/Paragraph.h"
 #include <algorithm>
 #include <cctype>
 #include <cstdio>
 
-using namespace skia::textlayout;
-
 namespace liteDui {
 
 LiteInput::LiteInput() {
@@ -59,11 +56,8 @@ void LiteInput::setMaxLength(int maxLength) {
     m_maxLength = maxLength;
     if (maxLength > 0 && Utf8Helper::getCharCount(getText()) > maxLength) {
         // 按字符数截断
-        auto codePoints = Utf8Helper::toCodePoints(getText());
-        if (static_cast<int>(codePoints.size()) > maxLength) {
-            int bytePos = Utf8Helper::codePointIndexToByte(codePoints, maxLength, static_cast<int>(getText().length()));
-            setText(getText().substr(0, bytePos));
-        }
+        Utf8OffsetIndex index(getText());
+        setText(getText().substr(0, index.codePointToByte(maxLength)));
         m_cursorPos = std::min(m_cursorPos, static_cast<int>(getText().length()));
     }
 }
@@ -124,31 +118,25 @@ void LiteInput::insertText(const std::string& text) {
     if (text.empty() || m_readOnly) return;
     
     deleteSelected();
+    syncTextLine();
     
-    std::string current = getText();
-    
-    // 检查最大长度限制（按字符数）
+    // 检查最大长度限制（按字符数，当前字符数增量维护，无需重新统计）
     if (m_maxLength > 0) {
-        int currentCharCount = Utf8Helper::getCharCount(current);
         int insertCharCount = Utf8Helper::getCharCount(text);
-        int available = m_maxLength - currentCharCount;
+        int available = m_maxLength - m_charCount;
         
         if (available <= 0) return;
         
         std::string toInsert = text;
         if (insertCharCount > available) {
             // 按字符数截断要插入的文本
-            auto codePoints = Utf8Helper::toCodePoints(text);
-            int bytePos = Utf8Helper::codePointIndexToByte(codePoints, available, static_cast<int>(text.length()));
-            toInsert = text.substr(0, bytePos);
+            toInsert = text.substr(0, Utf8OffsetIndex(text).codePointToByte(available));
         }
         
-        std::string newText = current.substr(0, m_cursorPos) + toInsert + current.substr(m_cursorPos);
-        setText(newText);
+        replaceText(m_cursorPos, m_cursorPos, toInsert);
         m_cursorPos += static_cast<int>(toInsert.length());
     } else {
-        std::string newText = current.substr(0, m_cursorPos) + text + current.substr(m_cursorPos);
-        setText(newText);
+        replaceText(m_cursorPos, m_cursorPos, text);
         m_cursorPos += static_cast<int>(text.length());
     }
     
@@ -203,106 +191,73 @@ void LiteInput::updateAppearance() {
 std::string LiteInput::getDisplayText() const {
     if (m_inputType == InputType::Password) {
         // 密码模式：每个字符显示为 *
-        int charCount = Utf8Helper::getCharCount(getText());
-        return std::string(charCount, '*');
+        return std::string(m_charCount, '*');
     }
     return getText();
 }
 
-// 使用 skparagraph 构建段落
-std::unique_ptr<Paragraph> LiteInput::buildParagraph(
-    const std::string& text, const Color& color, float maxWidth) const {
-    
-    auto& fontMgr = getFontManager();
-    auto fontCollection = fontMgr.getFontCollection();
-    
-    ParagraphStyle paraStyle;
-    paraStyle.setTextAlign(skia::textlayout::TextAlign::kLeft);
-    
-    auto textStyle = fontMgr.createTextStyle(color, getFontSize(), getFontFamily());
-    
-    auto builder = ParagraphBuilder::make(paraStyle, fontCollection);
-    builder->pushStyle(textStyle);
-    builder->addText(text.c_str());
-    
-    auto paragraph = builder->Build();
-    paragraph->layout(maxWidth > 0 ? maxWidth : 10000.0f);
-    
-    return paragraph;
-}
+void LiteInput::replaceText(int start, int end, const std::string& text) {
+    syncTextLine();
 
-// 计算每个字符位置的 X 坐标
-std::vector<float> LiteInput::getCharPositions(const std::string& text, float maxWidth) const {
-    std::vector<float> positions(text.length() + 1, 0);
-    
-    if (text.empty()) return positions;
-    
-    auto paragraph = buildParagraph(text, getTextColor(), maxWidth);
-    auto codePoints = Utf8Helper::toCodePoints(text);
-    
-    // 遍历每个码点，获取其结束位置
-    for (size_t i = 0; i < codePoints.size(); ++i) {
-        const auto& cp = codePoints[i];
-        int endByte = cp.byteOffset + cp.byteLength;
-        
-        // 将 UTF-8 字节偏移转换为 UTF-16 代码单元索引
-        // Skia 的 getRectsForRange API 使用 UTF-16 索引
-        int utf16End = Utf8Helper::utf8ByteToUtf16Index(text, endByte);
-        
-        // 使用 getRectsForRange 获取从开始到当前字符结束的边界框
-        auto rects = paragraph->getRectsForRange(
-            0, utf16End,
-            RectHeightStyle::kTight,
-            RectWidthStyle::kTight);
-        
-        float width = 0;
-        if (!rects.empty()) {
-            width = rects.back().rect.fRight;
-        }
-        
-        // 填充该字符所有字节位置为相同宽度
-        for (int j = cp.byteOffset + 1; j <= endByte && j <= static_cast<int>(text.length()); ++j) {
-            positions[j] = width;
-        }
+    // 显示偏移需要在修改前按旧文本计算
+    int displayStart = toDisplayOffset(start);
+    int displayEnd = toDisplayOffset(end);
+    int removedChars = static_cast<int>(Utf8Helper::countCodePoints(m_text.data() + start, end - start));
+    int insertedChars = Utf8Helper::getCharCount(text);
+
+    m_text.replace(start, end - start, text);
+    m_layoutTextVersion = ++m_textVersion;
+    m_charCount += insertedChars - removedChars;
+    markDirty();
+
+    if (m_inputType == InputType::Password) {
+        m_offsetIndex.build(m_text);
+        m_textLine.replace(displayStart, displayEnd, std::string(insertedChars, '*'));
+    } else {
+        m_textLine.replace(displayStart, displayEnd, text);
     }
-    
-    return positions;
 }
 
-// 根据 X 坐标找到最近的字符边界位置
-int LiteInput::xToCharIndex(const std::string& text, float x, float maxWidth) const {
-    if (text.empty()) return 0;
-    
-    auto codePoints = Utf8Helper::toCodePoints(text);
-    if (codePoints.empty()) return 0;
-    
-    auto positions = getCharPositions(text, maxWidth);
-    
-    // 遍历每个字符边界，找到最接近 x 的位置
-    for (size_t i = 0; i < codePoints.size(); ++i) {
-        const auto& cp = codePoints[i];
-        int startByte = cp.byteOffset;
-        int endByte = cp.byteOffset + cp.byteLength;
-        
-        float startX = positions[startByte];
-        float endX = positions[endByte];
-        float mid = (startX + endX) / 2;
-        
-        if (x < mid) {
-            return startByte;
+void LiteInput::syncTextLine() {
+    m_textLine.setFont(getFontSpec());
+    if (m_layoutTextVersion != m_textVersion || m_layoutInputType != m_inputType) {
+        // 文本被整体替换（setValue/setText 等），重建布局
+        m_layoutTextVersion = m_textVersion;
+        m_layoutInputType = m_inputType;
+        m_charCount = Utf8Helper::getCharCount(m_text);
+        if (m_inputType == InputType::Password) {
+            m_offsetIndex.build(m_text);
+        } else {
+            m_offsetIndex.clear();
         }
+        m_textLine.setText(getDisplayText());
     }
-    
-    return static_cast<int>(text.length());
+}
+
+// 原始文本字节偏移 -> 显示文本字节偏移（仅密码模式不同，每个字符显示为一个 *）
+int LiteInput::toDisplayOffset(int bytePos) const {
+    if (m_inputType != InputType::Password) return bytePos;
+    return static_cast<int>(m_offsetIndex.byteToCodePoint(static_cast<size_t>(std::max(bytePos, 0))));
+}
+
+int LiteInput::fromDisplayOffset(int displayPos) const {
+    if (m_inputType != InputType::Password) return displayPos;
+    return static_cast<int>(m_offsetIndex.codePointToByte(static_cast<size_t>(std::max(displayPos, 0))));
+}
+
+float LiteInput::cursorXForOffset(int bytePos) {
+    syncTextLine();
+    return m_textLine.getXForOffset(toDisplayOffset(bytePos));
+}
+
+int LiteInput::offsetForX(float x) {
+    syncTextLine();
+    return fromDisplayOffset(static_cast<int>(m_textLine.getOffsetForX(x)));
 }
 
 // 确保光标可见，调整滚动偏移
 void LiteInput::ensureCursorVisible(float visibleWidth) {
-    std::string displayText = getDisplayText();
-    auto positions = getCharPositions(displayText, visibleWidth + m_scrollOffset + 100);
-    
-    float cursorX = (m_cursorPos < static_cast<int>(positions.size())) 
-                    ? positions[m_cursorPos] : positions.back();
+    float cursorX = cursorXForOffset(m_cursorPos);
     
     if (cursorX - m_scrollOffset < 0) {
         m_scrollOffset = cursorX;
@@ -329,7 +284,7 @@ void LiteInput::handleSpecialKey(const KeyEvent& event) {
     if (!event.pressed) return;
     
     bool shift = event.mods & 1;
-    std::string current = getText();
+    const std::string& current = getText();
     
     switch (event.keyCode) {
     case 259: // Backspace
@@ -337,7 +292,7 @@ void LiteInput::handleSpecialKey(const KeyEvent& event) {
             deleteSelected();
         } else if (m_cursorPos > 0) {
             int prevPos = Utf8Helper::getPrevCharPos(current, m_cursorPos);
-            setText(current.substr(0, prevPos) + current.substr(m_cursorPos));
+            replaceText(prevPos, m_cursorPos, std::string());
             m_cursorPos = prevPos;
             resetCursorBlink();
             if (m_onTextChanged) m_onTextChanged(getText());
@@ -349,7 +304,7 @@ void LiteInput::handleSpecialKey(const KeyEvent& event) {
             deleteSelected();
         } else if (m_cursorPos < static_cast<int>(current.length())) {
             int nextPos = Utf8Helper::getNextCharPos(current, m_cursorPos);
-            setText(current.substr(0, m_cursorPos) + current.substr(nextPos));
+            replaceText(m_cursorPos, nextPos, std::string());
             resetCursorBlink();
             if (m_onTextChanged) m_onTextChanged(getText());
         }
@@ -421,8 +376,7 @@ void LiteInput::deleteSelected() {
     
     int start = std::min(m_selectionStart, m_selectionEnd);
     int end = std::max(m_selectionStart, m_selectionEnd);
-    std::string current = getText();
-    setText(current.substr(0, start) + current.substr(end));
+    replaceText(start, end, std::string());
     m_cursorPos = start;
     clearSelection();
     resetCursorBlink();
@@ -476,64 +430,55 @@ void LiteInput::render(SkCanvas* canvas) {
     float textY = borderT + padT;
     float visibleWidth = w - borderL - borderR - padL - padR;
     
-    std::string displayText = getDisplayText();
-    bool showPlaceholder = displayText.empty() && !m_placeholder.empty();
+    syncTextLine();
+    bool showPlaceholder = m_text.empty() && !m_placeholder.empty();
     
     if (m_state == ControlState::Focused) {
         ensureCursorVisible(visibleWidth);
     }
     
-    canvas->save();
+    float lineHeight = m_textLine.getHeight();
     
-    auto positions = getCharPositions(displayText, visibleWidth + m_scrollOffset + 100);
+    canvas->save();
+    // 文本超出可见区域的部分不绘制到边框上
+    canvas->clipRect(SkRect::MakeXYWH(borderL, borderT, w - borderL - borderR,
+                                      h - borderT - getLayoutBorderBottom()));
     
     // 绘制选择高亮
-    if (hasSelection() && !displayText.empty()) {
+    if (hasSelection() && !m_text.empty()) {
         int selStart = std::min(m_selectionStart, m_selectionEnd);
         int selEnd = std::max(m_selectionStart, m_selectionEnd);
         
-        if (selStart < static_cast<int>(positions.size()) && selEnd < static_cast<int>(positions.size())) {
-            float startX = positions[selStart] - m_scrollOffset;
-            float endX = positions[selEnd] - m_scrollOffset;
-            
-            auto paragraph = buildParagraph(displayText, getTextColor(), visibleWidth + m_scrollOffset + 100);
-            float textHeight = paragraph->getHeight();
+        if (selStart <= static_cast<int>(m_text.length()) && selEnd <= static_cast<int>(m_text.length())) {
+            float startX = cursorXForOffset(selStart) - m_scrollOffset;
+            float endX = cursorXForOffset(selEnd) - m_scrollOffset;
             
             SkPaint selPaint;
             selPaint.setColor(m_selectionColor.toARGB());
-            canvas->drawRect(SkRect::MakeXYWH(textX + startX, textY, endX - startX, textHeight), selPaint);
+            canvas->drawRect(SkRect::MakeXYWH(textX + startX, textY, endX - startX, lineHeight), selPaint);
         }
     }
     
     // 绘制文本
     if (showPlaceholder) {
-        auto paragraph = buildParagraph(m_placeholder, m_placeholderColor, visibleWidth);
-        paragraph->paint(canvas, textX, textY);
-    } else if (!displayText.empty()) {
-        auto paragraph = buildParagraph(displayText, getTextColor(), visibleWidth + m_scrollOffset + 100);
-        paragraph->paint(canvas, textX - m_scrollOffset, textY);
+        LiteTextRenderer::getInstance().drawSingleLine(
+            canvas, m_placeholder, getFontSpec(), m_placeholderColor,
+            textX, textY, visibleWidth, lineHeight, TextAlign::Left, false);
+    } else if (!m_text.empty()) {
+        // 只绘制与可见区域相交的片段
+        m_textLine.draw(canvas, textX - m_scrollOffset, textY, getTextColor(),
+                        m_scrollOffset, m_scrollOffset + visibleWidth);
     }
     
     // 绘制光标
     if (m_state == ControlState::Focused && m_cursorVisible) {
-        float cursorX = textX;
-        if (m_cursorPos < static_cast<int>(positions.size())) {
-            cursorX += positions[m_cursorPos] - m_scrollOffset;
-        }
-
-        // printf("Cursor: %d => %.2f.  %.2f\r\n", m_cursorPos, positions[m_cursorPos], cursorX);
-        
-        float textHeight = getFontSize() * 1.2f;
-        if (!displayText.empty()) {
-            auto paragraph = buildParagraph(displayText, getTextColor(), visibleWidth + m_scrollOffset + 100);
-            textHeight = paragraph->getHeight();
-        }
+        float cursorX = textX + cursorXForOffset(m_cursorPos) - m_scrollOffset;
         
         SkPaint cursorPaint;
         cursorPaint.setColor(m_cursorColor.toARGB());
         cursorPaint.setStrokeWidth(1.5f);
         cursorPaint.setStyle(SkPaint::kStroke_Style);
-        canvas->drawLine(cursorX, textY, cursorX, textY + textHeight, cursorPaint);
+        canvas->drawLine(cursorX, textY, cursorX, textY + lineHeight, cursorPaint);
     }
     
     canvas->restore();
@@ -549,8 +494,7 @@ void LiteInput::onMousePressed(const MouseEvent& event) {
     float visibleWidth = getLayoutWidth() - getLayoutBorderLeft() - getLayoutBorderRight()
                         - getLayoutPaddingLeft() - getLayoutPaddingRight();
     
-    std::string displayText = getDisplayText();
-    m_cursorPos = xToCharIndex(displayText, x, visibleWidth + m_scrollOffset + 100);
+    m_cursorPos = offsetForX(x);
     
     m_selectionStart = m_cursorPos;
     m_selectionEnd = m_cursorPos;
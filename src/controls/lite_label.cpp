@@ -3,6 +3,7 @@
  */
 
 #include "lite_label.h"
+#include "lite_text_renderer.h"
 #include "include/core/SkCanvas.h"
 #include <modules/skparagraph/include/Paragraph.h>
 #include <modules/skparagraph/include/ParagraphBuilder.h>
@@ -65,6 +66,26 @@ void LiteLabel::render(SkCanvas* canvas) {
     // 设置文本颜色（链接使用链接颜色）
     Color textColor = m_url.empty() ? m_textColor : (m_isHovered ? Color::fromRGB(26, 13, 171) : m_linkColor);
 
+    // 非链接的单行简单文本走 SkTextBlob 快速路径
+    if (m_url.empty() && LiteTextRenderer::isSimpleText(m_text)) {
+        auto& renderer = LiteTextRenderer::getInstance();
+        FontSpec fontSpec = getFontSpec();
+        auto shaped = renderer.shape(m_text, fontSpec);
+        bool ellipsis = (m_displayMode == LabelDisplayMode::Ellipsis);
+        if (shaped && (ellipsis || shaped->getWidth() <= w)) {
+            float textY = 0;
+            if (m_verticalAlign == Align::Center) {
+                textY = (h - shaped->getHeight()) / 2;
+            } else if (m_verticalAlign == Align::FlexEnd) {
+                textY = h - shaped->getHeight();
+            }
+            if (renderer.drawLine(canvas, m_text, fontSpec, textColor, 0, textY, w, m_textAlign,
+                                  ellipsis ? LineOverflow::Ellipsis : LineOverflow::Reject)) {
+                return;
+            }
+        }
+    }
+
     auto& fontMgr = getFontManager();
     auto textStyle = getTextStyle();
     textStyle.setColor(SkColorSetARGB(
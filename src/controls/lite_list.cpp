@@ -5,15 +5,13 @@
  */
 
 #include "lite_list.h"
+#include "lite_keyed_diff.h"
+#include "lite_text_renderer.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkRect.h"
-#include "modules/skparagraph/include/ParagraphBuilder.h"
-#include "modules/skparagraph/include/Paragraph.h"
 #include <algorithm>
 
-using namespace skia::textlayout;
-
 namespace liteDui {
 
 LiteList::LiteList() {
@@ -23,10 +21,24 @@ LiteList::LiteList() {
     setBorderColor(Color::LightGray());
     setBorder(EdgeInsets::All(1.0f));
     setPadding(EdgeInsets::All(0));
+    m_itemHeights.setEstimatedHeight(m_itemHeight);
+
+    m_selection.addListener([this](const SelectionRange& changed) {
+        syncSelectedFlags(changed.first, changed.end());
+        markDirty();
+    });
+}
+
+void LiteList::syncSelectedFlags(size_t first, size_t end) {
+    end = std::min(end, m_items.size());
+    for (size_t i = first; i < end; ++i) {
+        m_items[i].selected = m_selection.isSelected(i);
+    }
 }
 
 void LiteList::addItem(const std::string& text, const std::string& id) {
     m_items.emplace_back(text, id);
+    m_itemHeights.insertRows(m_items.size() - 1, 1);
     markDirty();
 }
 
@@ -35,12 +47,18 @@ void LiteList::insertItem(size_t index, const std::string& text, const std::stri
         index = m_items.size();
     }
     m_items.insert(m_items.begin() + index, ListItem(text, id));
+    m_selection.insertItems(index, 1);
+    m_itemHeights.insertRows(index, 1);
+    m_prefetcher.cancel();
     markDirty();
 }
 
 void LiteList::removeItem(size_t index) {
     if (index >= m_items.size()) return;
     m_items.erase(m_items.begin() + index);
+    m_selection.removeItems(index, 1);
+    m_itemHeights.removeRows(index, 1);
+    m_prefetcher.cancel();
     
     // 如果删除的是悬停项，重置悬停索引
     if (static_cast<int>(index) == m_hoverIndex) {
@@ -54,7 +72,109 @@ void LiteList::removeItem(size_t index) {
 
 void LiteList::clearItems() {
     m_items.clear();
+    m_itemHeights.reset(0);
+    m_selection.clear();
+    m_selection.setAnchor(-1);
     m_hoverIndex = -1;
+    m_prefetcher.cancel();
+    markDirty();
+}
+
+void LiteList::setItems(std::vector<ListItem> items, const ItemKeyFunction& key) {
+    auto keyOf = [&key](const ListItem& item) {
+        if (key) return key(item);
+        return item.id.empty() ? item.text : item.id;
+    };
+    std::vector<std::string> oldKeys(m_items.size());
+    for (size_t i = 0; i < m_items.size(); ++i) {
+        oldKeys[i] = keyOf(m_items[i]);
+    }
+    std::vector<std::string> newKeys(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        newKeys[i] = keyOf(items[i]);
+    }
+    LiteKeyedDiff diff = LiteKeyedDiff::compute(oldKeys, newKeys);
+    std::vector<uint32_t> targets = diff.targets();
+
+    // 滚动锚点：视口内第一个选中项，没有时为顶部项
+    long long anchor = -1;
+    float anchorOffset = 0;
+    size_t first = m_itemHeights.getRowAt(std::max(0.0f, m_scrollY));
+    float y = m_itemHeights.getOffset(first) - m_scrollY;
+    for (size_t i = first; i < m_items.size() && y < getViewportHeight(); ++i) {
+        if (m_selection.isSelected(i)) {
+            anchor = static_cast<long long>(i);
+            anchorOffset = y;
+            break;
+        }
+        y += m_itemHeights.getHeight(i);
+    }
+    if (anchor < 0 && first < m_items.size()) {
+        anchor = static_cast<long long>(first);
+        anchorOffset = m_itemHeights.getOffset(first) - m_scrollY;
+    }
+
+    // 保留项沿用已测量的高度，文本变化且有测量回调时重新测量
+    bool changed = !diff.isIdentity();
+    std::vector<float> heights(items.size(), 0.0f);
+    for (size_t i = 0; i < items.size(); ++i) {
+        uint32_t source = diff.sources[i];
+        if (source == LiteKeyedDiff::kInserted) continue;
+        bool textChanged = m_items[source].text != items[i].text;
+        changed = changed || textChanged;
+        if (m_itemHeights.isMeasured(source) && !(textChanged && m_itemHeightProvider)) {
+            heights[i] = m_itemHeights.getHeight(source);
+        }
+    }
+    // 键与文本都未变化时其他字段（图标等）仍可能变化，总是重绘
+    m_items = std::move(items);
+    // 传入项的 selected 镜像不可信，按当前选择重新同步；项被重排时下面重建选择会再次同步
+    for (auto& item : m_items) {
+        item.selected = false;
+    }
+    for (const auto& range : m_selection.getRanges()) {
+        syncSelectedFlags(range.first, range.end());
+    }
+    if (!changed) {
+        markDirty();
+        return;
+    }
+
+    if (diff.isIdentity()) {
+        // 只有文本变化：逐项更新高度，无需重建索引
+        for (size_t i = 0; i < heights.size(); ++i) {
+            if (heights[i] == 0 && m_itemHeights.isMeasured(i)) m_itemHeights.setHeight(i, 0);
+        }
+    } else {
+        m_itemHeights.assign(std::move(heights));
+
+        auto target = [&targets](long long index) -> long long {
+            if (index < 0 || static_cast<size_t>(index) >= targets.size() ||
+                targets[index] == LiteKeyedDiff::kInserted) {
+                return -1;
+            }
+            return targets[index];
+        };
+        std::vector<size_t> selected;
+        selected.reserve(m_selection.getCount());
+        for (const auto& range : m_selection.getRanges()) {
+            for (size_t i = range.first; i < range.end() && i < targets.size(); ++i) {
+                if (targets[i] != LiteKeyedDiff::kInserted) selected.push_back(targets[i]);
+            }
+        }
+        long long selectionAnchor = target(m_selection.getAnchor());
+        m_selection.clear();
+        m_selection.selectIndices(std::move(selected));
+        m_selection.setAnchor(selectionAnchor);
+        m_hoverIndex = static_cast<int>(target(m_hoverIndex));
+        anchor = target(anchor);
+    }
+    m_prefetcher.cancel();
+
+    if (anchor >= 0) {
+        m_scrollY = m_itemHeights.getOffset(static_cast<size_t>(anchor)) - anchorOffset;
+    }
+    clampScroll();
     markDirty();
 }
 
@@ -74,16 +194,7 @@ void LiteList::setSelectionMode(ListSelectionMode mode) {
     
     // 如果切换到单选模式，只保留第一个选中项
     if (mode == ListSelectionMode::Single) {
-        bool foundSelected = false;
-        for (auto& item : m_items) {
-            if (item.selected) {
-                if (foundSelected) {
-                    item.selected = false;
-                } else {
-                    foundSelected = true;
-                }
-            }
-        }
+        m_selection.keepFirst();
     } else if (mode == ListSelectionMode::None) {
         clearSelection();
     }
@@ -94,15 +205,19 @@ void LiteList::setSelectionMode(ListSelectionMode mode) {
 void LiteList::setSelectedIndex(int index) {
     if (m_selectionMode == ListSelectionMode::None) return;
     
+    bool valid = index >= 0 && index < static_cast<int>(m_items.size());
     // 单选模式：清除其他选择
     if (m_selectionMode == ListSelectionMode::Single) {
-        for (auto& item : m_items) {
-            item.selected = false;
+        if (valid) {
+            m_selection.setSingle(static_cast<size_t>(index));
+        } else {
+            m_selection.clear();
         }
+    } else if (valid) {
+        m_selection.select(static_cast<size_t>(index));
     }
-    
-    if (index >= 0 && index < static_cast<int>(m_items.size())) {
-        m_items[index].selected = true;
+    if (valid) {
+        m_selection.setAnchor(index);
     }
     
     markDirty();
@@ -113,18 +228,14 @@ void LiteList::setSelectedIndex(int index) {
 }
 
 int LiteList::getSelectedIndex() const {
-    for (size_t i = 0; i < m_items.size(); ++i) {
-        if (m_items[i].selected) {
-            return static_cast<int>(i);
-        }
-    }
-    return -1;
+    return static_cast<int>(m_selection.getFirst());
 }
 
 std::vector<int> LiteList::getSelectedIndices() const {
     std::vector<int> indices;
-    for (size_t i = 0; i < m_items.size(); ++i) {
-        if (m_items[i].selected) {
+    indices.reserve(m_selection.getCount());
+    for (const auto& range : m_selection.getRanges()) {
+        for (size_t i = range.first; i < range.end(); ++i) {
             indices.push_back(static_cast<int>(i));
         }
     }
@@ -132,24 +243,45 @@ std::vector<int> LiteList::getSelectedIndices() const {
 }
 
 void LiteList::clearSelection() {
-    for (auto& item : m_items) {
-        item.selected = false;
-    }
+    m_selection.clear();
     markDirty();
 }
 
 void LiteList::selectAll() {
     if (m_selectionMode != ListSelectionMode::Multiple) return;
-    
-    for (auto& item : m_items) {
-        item.selected = true;
-    }
-    markDirty();
+    m_selection.selectAll(m_items.size());
 }
 
 void LiteList::setItemHeight(float height) {
     if (m_itemHeight == height) return;
     m_itemHeight = height;
+    m_itemHeights.setEstimatedHeight(height);
+    markDirty();
+}
+
+void LiteList::setItemHeightAt(size_t index, float height) {
+    if (index >= m_items.size()) return;
+    m_itemHeights.setHeight(index, height);
+    markDirty();
+}
+
+float LiteList::getItemHeightAt(size_t index) const {
+    return m_itemHeights.getHeight(index);
+}
+
+void LiteList::setItemHeightProvider(std::function<float(size_t index)> provider) {
+    m_itemHeightProvider = std::move(provider);
+    invalidateItemHeights();
+}
+
+void LiteList::invalidateItemHeight(size_t index) {
+    if (index >= m_items.size()) return;
+    m_itemHeights.setHeight(index, 0);
+    markDirty();
+}
+
+void LiteList::invalidateItemHeights() {
+    m_itemHeights.reset(m_items.size());
     markDirty();
 }
 
@@ -166,15 +298,15 @@ void LiteList::setOnItemDoubleClicked(std::function<void(int)> callback) {
 }
 
 float LiteList::getContentHeight() const {
-    // 列表的内容高度 = 项目数 × 项目高度
-    return m_items.size() * m_itemHeight;
+    // 列表的内容高度 = 各项目高度之和（未测量的项目按默认高度估计）
+    return m_itemHeights.getTotalHeight();
 }
 
 int LiteList::getItemIndexAtY(float y) const {
-    if (m_items.empty() || m_itemHeight <= 0) return -1;
+    if (m_items.empty() || y < 0) return -1;
     
     // y 是相对于内容区域的坐标（已经考虑了滚动偏移）
-    int index = static_cast<int>(y / m_itemHeight);
+    int index = static_cast<int>(m_itemHeights.getRowAt(y));
     
     if (index < 0 || index >= static_cast<int>(m_items.size())) {
         return -1;
@@ -191,21 +323,43 @@ void LiteList::renderContent(SkCanvas* canvas) {
     
     // 计算可见范围的项目索引
     // 注意：此时 canvas 已经应用了滚动偏移，所以我们需要基于滚动位置计算
-    int firstVisible = static_cast<int>(m_scrollY / m_itemHeight);
-    int lastVisible = static_cast<int>((m_scrollY + viewportH) / m_itemHeight);
+    int firstVisible = static_cast<int>(m_itemHeights.getRowAt(std::max(0.0f, m_scrollY)));
+    if (firstVisible >= static_cast<int>(m_items.size())) return;
+
+    // 先测量可见范围内尚未测量的项目
+    if (m_itemHeightProvider) {
+        float y = m_itemHeights.getOffset(firstVisible);
+        for (size_t i = firstVisible; i < m_items.size() && y < m_scrollY + viewportH; ++i) {
+            if (!m_itemHeights.isMeasured(i)) {
+                float height = m_itemHeightProvider(i);
+                m_itemHeights.setHeight(i, height > 0 ? height : m_itemHeight);
+            }
+            y += m_itemHeights.getHeight(i);
+        }
+    }
+    int lastVisible = static_cast<int>(m_itemHeights.getRowAt(m_scrollY + viewportH));
     
     // 确保索引在有效范围内
-    firstVisible = std::max(0, firstVisible);
     lastVisible = std::min(static_cast<int>(m_items.size()) - 1, lastVisible);
 
     // 只渲染可见的项目（虚拟化渲染，提高性能）
+    float itemY = m_itemHeights.getOffset(firstVisible);
     for (int i = firstVisible; i <= lastVisible; ++i) {
-        float itemY = i * m_itemHeight;
-        drawItem(canvas, i, itemY, viewportW);
+        float height = m_itemHeights.getHeight(i);
+        drawItem(canvas, i, itemY, viewportW, height);
+        itemY += height;
+    }
+
+    // 根据滚动速度在后台整形即将进入视口的项目
+    if (firstVisible <= lastVisible) {
+        m_prefetcher.update(m_scrollY, m_itemHeight, firstVisible, lastVisible, m_items.size(),
+                            getFontSpec(), [this](size_t row, std::vector<std::string>& texts) {
+                                texts.push_back(m_items[row].text);
+                            });
     }
 }
 
-void LiteList::drawItem(SkCanvas* canvas, size_t index, float y, float width) {
+void LiteList::drawItem(SkCanvas* canvas, size_t index, float y, float width, float height) {
     if (index >= m_items.size()) return;
 
     const ListItem& item = m_items[index];
@@ -213,50 +367,33 @@ void LiteList::drawItem(SkCanvas* canvas, size_t index, float y, float width) {
     paint.setAntiAlias(true);
 
     // 绘制背景
-    bool isSelected = item.selected;
+    bool isSelected = m_selection.isSelected(index);
     bool isHover = (static_cast<int>(index) == m_hoverIndex);
 
     if (isSelected) {
         // 选中状态背景
         paint.setColor(m_selectedColor.toARGB());
         paint.setStyle(SkPaint::kFill_Style);
-        canvas->drawRect(SkRect::MakeXYWH(0, y, width, m_itemHeight), paint);
+        canvas->drawRect(SkRect::MakeXYWH(0, y, width, height), paint);
     } else if (isHover) {
         // 悬停状态背景
         paint.setColor(m_hoverColor.toARGB());
         paint.setStyle(SkPaint::kFill_Style);
-        canvas->drawRect(SkRect::MakeXYWH(0, y, width, m_itemHeight), paint);
+        canvas->drawRect(SkRect::MakeXYWH(0, y, width, height), paint);
     } else if (m_showAlternateRows && index % 2 == 1) {
         // 交替行背景
         paint.setColor(m_alternateColor.toARGB());
         paint.setStyle(SkPaint::kFill_Style);
-        canvas->drawRect(SkRect::MakeXYWH(0, y, width, m_itemHeight), paint);
+        canvas->drawRect(SkRect::MakeXYWH(0, y, width, height), paint);
     }
 
     // 绘制文本
     if (!item.text.empty()) {
-        auto& fontMgr = getFontManager();
-        auto fontCollection = fontMgr.getFontCollection();
-
-        ParagraphStyle paraStyle;
-        paraStyle.setTextAlign(skia::textlayout::TextAlign::kLeft);
-        paraStyle.setMaxLines(1);
-        paraStyle.setEllipsis(u"\u2026"); // 省略号
-
-        auto textStyle = fontMgr.createTextStyle(getTextColor(), getFontSize(), getFontFamily());
-
-        auto builder = ParagraphBuilder::make(paraStyle, fontCollection);
-        builder->pushStyle(textStyle);
-        builder->addText(item.text.c_str());
-
-        auto paragraph = builder->Build();
-        paragraph->layout(width - m_itemPadding * 2);
-
-        // 垂直居中文本
-        float textHeight = paragraph->getHeight();
-        float textY = y + (m_itemHeight - textHeight) / 2;
-
-        paragraph->paint(canvas, m_itemPadding, textY);
+        // 单行垂直居中，超出部分显示省略号
+        LiteTextRenderer::getInstance().drawSingleLine(
+            canvas, item.text, getFontSpec(), getTextColor(),
+            m_itemPadding, y, width - m_itemPadding * 2, height,
+            TextAlign::Left, true);
     }
 }
 
@@ -296,9 +433,17 @@ void LiteList::onMousePressed(const MouseEvent& event) {
             // 单选模式
             setSelectedIndex(index);
         } else if (m_selectionMode == ListSelectionMode::Multiple) {
-            // 多选模式：切换选中状态
-            m_items[index].selected = !m_items[index].selected;
-            markDirty();
+            long long anchor = m_selection.getAnchor();
+            if ((event.mods & 1) && anchor >= 0 && anchor < static_cast<long long>(m_items.size())) {
+                // Shift + 点击：选中锚点到当前项
+                size_t first = static_cast<size_t>(std::min<long long>(anchor, index));
+                size_t last = static_cast<size_t>(std::max<long long>(anchor, index));
+                m_selection.selectRange(first, last - first + 1);
+            } else {
+                // 多选模式：切换选中状态
+                m_selection.toggle(static_cast<size_t>(index));
+                m_selection.setAnchor(index);
+            }
             
             if (m_onSelectionChanged) {
                 m_onSelectionChanged(index);
@@ -0,0 +1,575 @@
+/**
+ * lite_log_view.cpp - 流式日志查看控件实现
+ */
+
+#include "lite_log_view.h"
+#include "lite_text_renderer.h"
+#include "lite_utf8.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include <cmath>
+#include <cstring>
+
+namespace liteDui {
+
+namespace {
+
+// 后台索引每次处理的字节数，处理完一块即发布一次进度
+constexpr uint64_t kIndexChunkBytes = 4 * 1024 * 1024;
+
+// UI 线程查找换行时每次从文件读取的字节数
+constexpr size_t kReadBlockBytes = 256 * 1024;
+
+// 日志行显示前的清理：去掉行尾 '\r'，制表符展开为空格，其余控制字符替换为空格，
+// 按字节截断时去掉末尾不完整的 UTF-8 字符
+void sanitizeLine(std::string& line, bool truncated) {
+    if (truncated && !line.empty()) {
+        size_t lead = line.size() - 1;
+        while (lead > 0 && Utf8Helper::isContinuationByte(static_cast<unsigned char>(line[lead]))) {
+            --lead;
+        }
+        if (lead + Utf8Helper::getCharByteLength(static_cast<unsigned char>(line[lead])) > line.size()) {
+            line.resize(lead);
+        }
+    }
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+
+    bool hasControl = false;
+    for (char c : line) {
+        if (static_cast<unsigned char>(c) < 0x20) {
+            hasControl = true;
+            break;
+        }
+    }
+    if (!hasControl) return;
+
+    std::string cleaned;
+    cleaned.reserve(line.size() + 8);
+    for (char c : line) {
+        if (c == '\t') {
+            cleaned.append("    ");
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            cleaned.push_back(' ');
+        } else {
+            cleaned.push_back(c);
+        }
+    }
+    line.swap(cleaned);
+}
+
+} // namespace
+
+// ==================== LiteLogView ====================
+
+LiteLogView::LiteLogView() {
+    setScrollDirection(ScrollDirection::Both);
+    setPadding(EdgeInsets::All(4.0f));
+    syncFont();
+    resetIndexLocked(0);
+    m_lastPoll = std::chrono::steady_clock::now();
+}
+
+LiteLogView::~LiteLogView() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopIndexer = true;
+    }
+    m_indexCv.notify_all();
+    if (m_indexer.joinable()) {
+        m_indexer.join();
+    }
+}
+
+bool LiteLogView::openFile(const std::string& path) {
+    close();
+
+    auto file = std::make_shared<LiteFileHandle>();
+    if (!file->open(path)) return false;
+    uint64_t size = file->querySize();
+    file->adviseSequential();
+
+    m_filePath = path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_mode = SourceMode::File;
+        m_file = std::move(file);
+        m_fileSize = size;
+        m_truncated = false;
+        m_sourceGeneration++;
+        resetIndexLocked(0);
+        m_indexing = size > 0;
+        if (!m_indexer.joinable()) {
+            m_indexer = std::thread(&LiteLogView::indexLoop, this);
+        }
+    }
+    m_indexCv.notify_one();
+    m_lastPoll = std::chrono::steady_clock::now();
+    m_revision++;
+    return true;
+}
+
+void LiteLogView::setRingBuffer(size_t capacityBytes) {
+    close();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_mode = SourceMode::Ring;
+    m_ring.assign(std::max<size_t>(capacityBytes, 1), '\0');
+    m_sourceGeneration++;
+    resetIndexLocked(0);
+    m_revision++;
+}
+
+void LiteLogView::append(const std::string& text) {
+    if (text.empty()) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_mode != SourceMode::Ring || m_ring.empty()) return;
+
+    // 分块写入，每块写入前先丢弃最旧的整行腾出空间，保证被丢弃的数据仍完整可扫描
+    const uint64_t capacity = m_ring.size();
+    const size_t chunkMax = static_cast<size_t>(std::max<uint64_t>(capacity / 4, 1));
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t n = std::min(chunkMax, text.size() - pos);
+        dropRingLinesLocked(n);
+
+        size_t written = 0;
+        while (written < n) {
+            size_t phys = static_cast<size_t>((m_index.end + written) % capacity);
+            size_t span = std::min(n - written, static_cast<size_t>(capacity) - phys);
+            std::memcpy(&m_ring[phys], text.data() + pos + written, span);
+            written += span;
+        }
+
+        scanLineBreaks(text.data() + pos, n, m_index.end, m_index.newlines,
+                       m_index.lastLineStart, m_index.checkpoints);
+        m_index.end += n;
+        pos += n;
+    }
+    m_revision++;
+}
+
+void LiteLogView::appendLine(const std::string& line) {
+    append(line + "\n");
+}
+
+void LiteLogView::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_mode = SourceMode::None;
+        m_sourceGeneration++;
+        m_file.reset();
+        m_fileSize = 0;
+        m_ring.clear();
+        m_ring.shrink_to_fit();
+        resetIndexLocked(0);
+        m_indexing = false;
+    }
+    m_filePath.clear();
+    m_maxLineWidth = 0.0f;
+    m_revision++;
+}
+
+std::string LiteLogView::getLine(size_t line) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_mode == SourceMode::None || line >= lineCountLocked()) return std::string();
+
+    uint64_t start = lineStartLocked(m_index.firstLine + line);
+    uint64_t newline = findNewlineLocked(start, m_index.end);
+    std::string text = readBytesLocked(start, newline == kNotFound ? m_index.end : newline);
+    if (!text.empty() && text.back() == '\r') text.pop_back();
+    return text;
+}
+
+void LiteLogView::setFollowTail(bool follow) {
+    m_followTail = follow;
+    if (follow) scrollToBottom();
+}
+
+float LiteLogView::getContentWidth() const {
+    return m_maxLineWidth;
+}
+
+float LiteLogView::getContentHeight() const {
+    return static_cast<float>(m_lineCount) * m_lineHeight;
+}
+
+// ==================== 行索引 ====================
+
+void LiteLogView::scanLineBreaks(const char* data, size_t length, uint64_t baseOffset,
+                                 uint64_t& newlines, uint64_t& lastLineStart,
+                                 std::deque<Checkpoint>& checkpoints) {
+    const char* p = data;
+    const char* end = data + length;
+    while (p < end) {
+        const void* hit = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        if (!hit) break;
+        const char* nl = static_cast<const char*>(hit);
+        newlines++;
+        lastLineStart = baseOffset + static_cast<uint64_t>(nl - data) + 1;
+        if (newlines % kCheckpointInterval == 0) {
+            checkpoints.push_back({newlines, lastLineStart});
+        }
+        p = nl + 1;
+    }
+}
+
+void LiteLogView::resetIndexLocked(uint64_t startOffset) {
+    m_index = LineIndex();
+    m_index.firstLineStart = startOffset;
+    m_index.lastLineStart = startOffset;
+    m_index.end = startOffset;
+    m_index.checkpoints.push_back({0, startOffset});
+    m_readCache.clear();
+    m_readCacheOffset = 0;
+}
+
+void LiteLogView::indexLoop() {
+    // 读取缓冲区在各块之间复用，进程内存与文件大小无关
+    std::vector<char> buffer;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopIndexer) {
+        auto file = m_file;
+        if (m_mode != SourceMode::File || !file || m_truncated || m_index.end >= m_fileSize) {
+            m_indexing = false;
+            m_indexCv.wait(lock);
+            continue;
+        }
+
+        uint64_t generation = m_sourceGeneration;
+        uint64_t from = m_index.end;
+        uint64_t to = std::min(m_fileSize, from + kIndexChunkBytes);
+        uint64_t newlines = m_index.newlines;
+        uint64_t lastLineStart = m_index.lastLineStart;
+        lock.unlock();
+
+        // 读取与扫描在锁外进行，UI 线程可以继续读取已索引的部分
+        buffer.resize(static_cast<size_t>(to - from));
+        size_t got = file->read(from, buffer.data(), buffer.size());
+        std::deque<Checkpoint> checkpoints;
+        if (got == buffer.size()) {
+            scanLineBreaks(buffer.data(), got, from, newlines, lastLineStart, checkpoints);
+        }
+
+        lock.lock();
+        if (generation != m_sourceGeneration) continue;   // 数据源已切换，丢弃结果
+        if (got < buffer.size()) {
+            // 文件在索引期间被截断：停止索引，由 update 重新打开
+            m_truncated = true;
+            m_revision++;
+            continue;
+        }
+
+        m_index.newlines = newlines;
+        m_index.lastLineStart = lastLineStart;
+        m_index.end = to;
+        m_index.checkpoints.insert(m_index.checkpoints.end(), checkpoints.begin(), checkpoints.end());
+        m_revision++;
+    }
+}
+
+uint64_t LiteLogView::lineCountLocked() const {
+    return (m_index.newlines - m_index.firstLine) + (m_index.end > m_index.lastLineStart ? 1 : 0);
+}
+
+uint64_t LiteLogView::lineStartLocked(uint64_t line) const {
+    uint64_t start = m_index.firstLineStart;
+    uint64_t current = m_index.firstLine;
+
+    // 从不超过目标行的最近检查点开始，最多向后扫描 kCheckpointInterval 行
+    const auto& checkpoints = m_index.checkpoints;
+    if (!checkpoints.empty() && line >= checkpoints.front().line) {
+        size_t index = static_cast<size_t>((line - checkpoints.front().line) / kCheckpointInterval);
+        index = std::min(index, checkpoints.size() - 1);
+        start = checkpoints[index].offset;
+        current = checkpoints[index].line;
+    }
+
+    while (current < line) {
+        uint64_t newline = findNewlineLocked(start, m_index.end);
+        if (newline == kNotFound) return m_index.end;
+        start = newline + 1;
+        current++;
+    }
+    return start;
+}
+
+uint64_t LiteLogView::findNewlineLocked(uint64_t from, uint64_t to) const {
+    if (from >= to) return kNotFound;
+
+    if (m_mode == SourceMode::File) {
+        while (from < to) {
+            size_t length = static_cast<size_t>(std::min<uint64_t>(to - from, kReadBlockBytes));
+            const char* data = fileBytesLocked(from, length);
+            if (!data) return kNotFound;
+            const void* hit = std::memchr(data, '\n', length);
+            if (hit) return from + static_cast<uint64_t>(static_cast<const char*>(hit) - data);
+            from += length;
+        }
+        return kNotFound;
+    }
+
+    if (m_mode == SourceMode::Ring && !m_ring.empty()) {
+        // 环形缓冲区最多分两段扫描
+        const uint64_t capacity = m_ring.size();
+        while (from < to) {
+            size_t phys = static_cast<size_t>(from % capacity);
+            size_t span = static_cast<size_t>(std::min<uint64_t>(to - from, capacity - phys));
+            const void* hit = std::memchr(&m_ring[phys], '\n', span);
+            if (hit) {
+                return from + static_cast<uint64_t>(static_cast<const char*>(hit) - &m_ring[phys]);
+            }
+            from += span;
+        }
+    }
+    return kNotFound;
+}
+
+std::string LiteLogView::readBytesLocked(uint64_t from, uint64_t to) const {
+    std::string result;
+    if (from >= to) return result;
+
+    if (m_mode == SourceMode::File) {
+        if (!m_file) return result;
+        result.resize(static_cast<size_t>(to - from));
+        size_t got = m_file->read(from, &result[0], result.size());
+        if (got < result.size()) {
+            m_truncated = true;
+            result.resize(got);
+        }
+    } else if (m_mode == SourceMode::Ring && !m_ring.empty()) {
+        const uint64_t capacity = m_ring.size();
+        result.reserve(static_cast<size_t>(to - from));
+        while (from < to) {
+            size_t phys = static_cast<size_t>(from % capacity);
+            size_t span = static_cast<size_t>(std::min<uint64_t>(to - from, capacity - phys));
+            result.append(&m_ring[phys], span);
+            from += span;
+        }
+    }
+    return result;
+}
+
+const char* LiteLogView::fileBytesLocked(uint64_t from, size_t& length) const {
+    // 命中缓存块时直接返回；否则从 from 起读取一块（至少 length 字节）
+    uint64_t cacheEnd = m_readCacheOffset + m_readCache.size();
+    if (from < m_readCacheOffset || from >= cacheEnd) {
+        if (!m_file) return nullptr;
+        size_t block = std::max(length, kReadBlockBytes);
+        m_readCache.resize(block);
+        m_readCache.resize(m_file->read(from, m_readCache.data(), block));
+        m_readCacheOffset = from;
+        cacheEnd = from + m_readCache.size();
+    }
+    length = static_cast<size_t>(std::min<uint64_t>(length, cacheEnd - from));
+    if (length == 0) {
+        // 已索引的范围读不到数据：文件被截断
+        m_truncated = true;
+        return nullptr;
+    }
+    return m_readCache.data() + (from - m_readCacheOffset);
+}
+
+void LiteLogView::dropRingLinesLocked(size_t incoming) {
+    const uint64_t capacity = m_ring.size();
+    while (m_index.end - m_index.firstLineStart + incoming > capacity) {
+        uint64_t newline = findNewlineLocked(m_index.firstLineStart, m_index.end);
+        if (newline == kNotFound) {
+            // 整个缓冲区只剩一个未结束的超长行：截掉它的开头
+            m_index.firstLineStart = m_index.end + incoming - capacity;
+            break;
+        }
+        m_index.firstLineStart = newline + 1;
+        m_index.firstLine++;
+    }
+
+    auto& checkpoints = m_index.checkpoints;
+    while (!checkpoints.empty() && checkpoints.front().line < m_index.firstLine) {
+        checkpoints.pop_front();
+    }
+}
+
+std::vector<std::string> LiteLogView::collectLines(size_t first, size_t count) const {
+    std::vector<std::string> lines;
+    std::vector<bool> truncated;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_mode == SourceMode::None) return lines;
+
+        uint64_t total = lineCountLocked();
+        if (first >= total) return lines;
+        count = static_cast<size_t>(std::min<uint64_t>(count, total - first));
+        lines.reserve(count);
+        truncated.reserve(count);
+
+        uint64_t start = lineStartLocked(m_index.firstLine + first);
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t newline = findNewlineLocked(start, m_index.end);
+            uint64_t end = (newline == kNotFound) ? m_index.end : newline;
+            uint64_t cut = std::min<uint64_t>(end, start + m_maxLineBytes);
+            lines.push_back(readBytesLocked(start, cut));
+            truncated.push_back(cut < end);
+            if (newline == kNotFound) break;
+            start = newline + 1;
+        }
+    }
+
+    // 清理在锁外进行
+    for (size_t i = 0; i < lines.size(); ++i) {
+        sanitizeLine(lines[i], truncated[i]);
+    }
+    return lines;
+}
+
+// ==================== 更新与绘制 ====================
+
+void LiteLogView::syncFont() {
+    FontSpec spec = getFontSpec();
+    if (spec == m_fontSpec && m_lineHeight > 0) return;
+
+    m_fontSpec = spec;
+    m_maxLineWidth = 0.0f;
+    auto empty = LiteTextRenderer::getInstance().shape(std::string(), spec);
+    m_lineHeight = std::ceil(empty ? empty->getHeight() : spec.fontSize * 1.2f);
+}
+
+void LiteLogView::pollFileGrowth() {
+    if (m_mode != SourceMode::File || !m_file) return;
+
+    // 读取时已发现截断则立即重新打开，不等下一次检测
+    auto now = std::chrono::steady_clock::now();
+    if (!m_truncated && now - m_lastPoll < m_pollInterval) return;
+    m_lastPoll = now;
+
+    // m_file 与 m_fileSize 只在 UI 线程修改，这里读取无需加锁
+    uint64_t size = m_file->querySize();
+    if (m_truncated || size < m_fileSize) {
+        // 文件被截断，重新打开并从头索引
+        std::string path = m_filePath;
+        openFile(path);
+        return;
+    }
+    if (size == m_fileSize) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fileSize = size;
+        m_indexing = true;
+    }
+    m_indexCv.notify_one();
+}
+
+bool LiteLogView::isAtBottom() const {
+    return m_scrollY >= getContentHeight() - getViewportHeight() - 1.0f;
+}
+
+void LiteLogView::scrollToBottom() {
+    m_scrollY = getContentHeight();
+    clampScroll();
+    markDirty();
+}
+
+void LiteLogView::update() {
+    syncFont();
+    pollFileGrowth();
+
+    uint64_t revision = m_revision.load();
+    if (revision == m_seenRevision) return;
+    m_seenRevision = revision;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lineCount = static_cast<size_t>(lineCountLocked());
+    }
+
+    if (m_followTail) {
+        scrollToBottom();
+    } else {
+        clampScroll();
+        markDirty();
+    }
+}
+
+void LiteLogView::renderContent(SkCanvas* canvas) {
+    syncFont();
+    if (m_lineHeight <= 0 || m_lineCount == 0) return;
+
+    float viewportH = getViewportHeight();
+    size_t firstLine = static_cast<size_t>(std::max(0.0f, m_scrollY) / m_lineHeight);
+    size_t lastLine = static_cast<size_t>((m_scrollY + viewportH) / m_lineHeight);
+    if (firstLine >= m_lineCount) return;
+    lastLine = std::min(lastLine, m_lineCount - 1);
+
+    auto lines = collectLines(firstLine, lastLine - firstLine + 1);
+
+    auto& renderer = LiteTextRenderer::getInstance();
+    Color textColor = getTextColor();
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(textColor.toARGB());
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const std::string& text = lines[i];
+        if (text.empty()) continue;
+        float y = static_cast<float>(firstLine + i) * m_lineHeight;
+
+        if (LiteTextRenderer::isSimpleText(text)) {
+            auto shaped = renderer.shape(text, m_fontSpec);
+            if (!shaped || !shaped->getBlob()) continue;
+            m_maxLineWidth = std::max(m_maxLineWidth, shaped->getWidth());
+            float top = y + (m_lineHeight - shaped->getHeight()) * 0.5f;
+            canvas->drawTextBlob(shaped->getBlob(), 0, top + shaped->getBaseline(), paint);
+        } else {
+            float width = LiteFontManager::getInstance().measureText(text, m_fontSpec).width;
+            m_maxLineWidth = std::max(m_maxLineWidth, width);
+            renderer.drawSingleLine(canvas, text, m_fontSpec, textColor,
+                                    0, y, width + 1.0f, m_lineHeight, TextAlign::Left, false);
+        }
+    }
+}
+
+void LiteLogView::onScroll(const ScrollEvent& event) {
+    LiteScrollView::onScroll(event);
+    m_followTail = isAtBottom();
+}
+
+void LiteLogView::onMouseMoved(const MouseEvent& event) {
+    float scrollY = m_scrollY;
+    LiteScrollView::onMouseMoved(event);
+    if (m_scrollY != scrollY) {
+        // 拖动滚动条
+        m_followTail = isAtBottom();
+    }
+}
+
+void LiteLogView::onKeyPressed(const KeyEvent& event) {
+    if (!event.pressed) return;
+
+    float page = std::max(m_lineHeight, getViewportHeight() - m_lineHeight);
+    switch (event.keyCode) {
+    case 265: // Up
+        scrollBy(0, -m_lineHeight);
+        break;
+    case 264: // Down
+        scrollBy(0, m_lineHeight);
+        break;
+    case 266: // PageUp
+        scrollBy(0, -page);
+        break;
+    case 267: // PageDown
+        scrollBy(0, page);
+        break;
+    case 268: // Home
+        scrollTo(m_scrollX, 0);
+        break;
+    case 269: // End：回到尾部并继续跟随
+        setFollowTail(true);
+        return;
+    default:
+        return;
+    }
+    m_followTail = isAtBottom();
+}
+
+} // namespace liteDui
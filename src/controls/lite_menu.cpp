@@ -5,6 +5,7 @@
 #include "lite_menu.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPath.h"
+#include <algorithm>
 
 namespace liteDui {
 
@@ -14,12 +15,31 @@ MenuOverlay::MenuOverlay(LiteMenu* menu) : m_menu(menu) {
     setBackgroundColor(Color::Transparent());
 }
 
+float MenuOverlay::measureMenuWidth() const {
+    // 左侧 28px 勾选区域、右侧 12px 边距；快捷键与子菜单箭头额外留白
+    float menuWidth = kMinMenuWidth;
+    auto& fontMgr = getFontManager();
+    FontSpec font = getFontSpec();
+    for (auto* item : m_menu->m_items) {
+        if (item->getType() == MenuItemType::Separator) continue;
+        float itemWidth = 28 + fontMgr.measureText(item->getText(), font).width + 12;
+        if (!item->getShortcut().empty()) {
+            itemWidth += 24 + fontMgr.measureText(item->getShortcut(), font).width;
+        }
+        if (item->getType() == MenuItemType::Submenu) {
+            itemWidth += 16;
+        }
+        menuWidth = std::max(menuWidth, itemWidth);
+    }
+    return menuWidth;
+}
+
 void MenuOverlay::render(SkCanvas* canvas) {
     if (!m_menu || m_menu->m_items.empty()) return;
     
     float menuX = m_menu->m_menuX;
     float menuY = m_menu->m_menuY;
-    float menuWidth = 180.0f;
+    float menuWidth = measureMenuWidth();
     float menuHeight = 0;
     
     for (auto* item : m_menu->m_items) {
@@ -99,7 +119,7 @@ void MenuOverlay::onMousePressed(const MouseEvent& event) {
     
     float menuX = m_menu->m_menuX;
     float menuY = m_menu->m_menuY;
-    float menuWidth = 180.0f;
+    float menuWidth = measureMenuWidth();
     float menuHeight = 0;
     
     for (auto* item : m_menu->m_items) {
@@ -129,7 +149,7 @@ void MenuOverlay::onMouseMoved(const MouseEvent& event) {
     
     float menuX = m_menu->m_menuX;
     float menuY = m_menu->m_menuY;
-    float menuWidth = 180.0f;
+    float menuWidth = measureMenuWidth();
     
     int newHover = -1;
     if (event.x >= menuX && event.x < menuX + menuWidth) {
@@ -284,8 +304,7 @@ void LiteMenuBar::render(SkCanvas* canvas) {
         auto& info = m_menus[i];
         info.x = menuX;
         
-        SkFont font = getFont();
-        float textWidth = font.measureText(info.title.c_str(), info.title.size(), SkTextEncoding::kUTF8);
+        float textWidth = getFontManager().measureText(info.title, getFontSpec()).width;
         info.width = textWidth + 16;
 
         if (static_cast<int>(i) == m_hoverIndex) {
@@ -0,0 +1,260 @@
+/**
+ * lite_selection_model.cpp - 行选择模型实现
+ */
+
+#include "lite_selection_model.h"
+#include <algorithm>
+
+namespace liteDui {
+
+// ==================== 查询 ====================
+
+bool LiteSelectionModel::isSelected(size_t index) const {
+    // 最后一个 first <= index 的区间
+    auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), index,
+                               [](size_t value, const SelectionRange& range) { return value < range.first; });
+    if (it == m_ranges.begin()) return false;
+    --it;
+    return index < it->end();
+}
+
+std::vector<size_t> LiteSelectionModel::getSelectedIndices() const {
+    std::vector<size_t> indices;
+    indices.reserve(m_count);
+    for (const auto& range : m_ranges) {
+        for (size_t i = range.first; i < range.end(); ++i) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+// ==================== 区间操作 ====================
+
+size_t LiteSelectionModel::addRange(size_t first, size_t end) {
+    if (first >= end) return 0;
+
+    // 第一个与 [first, end) 相交或相邻的区间
+    auto begin = std::lower_bound(m_ranges.begin(), m_ranges.end(), first,
+                                  [](const SelectionRange& range, size_t value) { return range.end() < value; });
+    auto last = begin;
+    size_t mergedFirst = first;
+    size_t mergedEnd = end;
+    size_t covered = 0;
+    while (last != m_ranges.end() && last->first <= end) {
+        mergedFirst = std::min(mergedFirst, last->first);
+        mergedEnd = std::max(mergedEnd, last->end());
+        covered += last->count;
+        ++last;
+    }
+
+    size_t added = (mergedEnd - mergedFirst) - covered;
+    if (added == 0) return 0;
+
+    auto pos = m_ranges.erase(begin, last);
+    m_ranges.insert(pos, SelectionRange{mergedFirst, mergedEnd - mergedFirst});
+    m_count += added;
+    return added;
+}
+
+size_t LiteSelectionModel::removeRange(size_t first, size_t end) {
+    if (first >= end) return 0;
+
+    // 第一个与 [first, end) 相交的区间
+    auto begin = std::lower_bound(m_ranges.begin(), m_ranges.end(), first,
+                                  [](const SelectionRange& range, size_t value) { return range.end() <= value; });
+    auto last = begin;
+    std::vector<SelectionRange> pieces;
+    size_t removed = 0;
+    while (last != m_ranges.end() && last->first < end) {
+        if (last->first < first) {
+            pieces.push_back(SelectionRange{last->first, first - last->first});
+        }
+        if (last->end() > end) {
+            pieces.push_back(SelectionRange{end, last->end() - end});
+        }
+        removed += std::min(last->end(), end) - std::max(last->first, first);
+        ++last;
+    }
+    if (removed == 0) return 0;
+
+    auto pos = m_ranges.erase(begin, last);
+    m_ranges.insert(pos, pieces.begin(), pieces.end());
+    m_count -= removed;
+    return removed;
+}
+
+// ==================== 修改 ====================
+
+void LiteSelectionModel::toggle(size_t index) {
+    if (isSelected(index)) {
+        deselect(index);
+    } else {
+        select(index);
+    }
+}
+
+void LiteSelectionModel::selectRange(size_t first, size_t count) {
+    if (addRange(first, first + count) > 0) {
+        notify(first, first + count);
+    }
+}
+
+void LiteSelectionModel::deselectRange(size_t first, size_t count) {
+    if (removeRange(first, first + count) > 0) {
+        notify(first, first + count);
+    }
+}
+
+void LiteSelectionModel::selectIndices(std::vector<size_t> indices) {
+    if (indices.empty()) return;
+    std::sort(indices.begin(), indices.end());
+
+    // 连续的行合并为区间
+    std::vector<SelectionRange> runs;
+    for (size_t index : indices) {
+        if (!runs.empty() && index <= runs.back().end()) {
+            runs.back().count = std::max(runs.back().end(), index + 1) - runs.back().first;
+        } else {
+            runs.push_back(SelectionRange{index, 1});
+        }
+    }
+
+    // 与现有区间按 first 归并一次，相交或相邻的区间合并，避免逐段插入的 O(r²)
+    std::vector<SelectionRange> merged;
+    merged.reserve(m_ranges.size() + runs.size());
+    size_t count = 0;
+    auto append = [&](const SelectionRange& range) {
+        if (!merged.empty() && range.first <= merged.back().end()) {
+            size_t end = std::max(merged.back().end(), range.end());
+            count += end - merged.back().end();
+            merged.back().count = end - merged.back().first;
+        } else {
+            merged.push_back(range);
+            count += range.count;
+        }
+    };
+    size_t i = 0;
+    size_t j = 0;
+    while (i < m_ranges.size() || j < runs.size()) {
+        if (j == runs.size() || (i < m_ranges.size() && m_ranges[i].first <= runs[j].first)) {
+            append(m_ranges[i++]);
+        } else {
+            append(runs[j++]);
+        }
+    }
+
+    if (count == m_count) return;
+    m_ranges.swap(merged);
+    m_count = count;
+    notify(indices.front(), indices.back() + 1);
+}
+
+void LiteSelectionModel::setSingle(size_t index) {
+    if (m_count == 1 && m_ranges.front().first == index) return;
+
+    size_t changedFirst = index;
+    size_t changedEnd = index + 1;
+    if (!m_ranges.empty()) {
+        changedFirst = std::min(changedFirst, m_ranges.front().first);
+        changedEnd = std::max(changedEnd, m_ranges.back().end());
+    }
+
+    m_ranges.assign(1, SelectionRange{index, 1});
+    m_count = 1;
+    notify(changedFirst, changedEnd);
+}
+
+void LiteSelectionModel::selectAll(size_t itemCount) {
+    if (itemCount == 0 || m_count == itemCount) return;
+    m_ranges.assign(1, SelectionRange{0, itemCount});
+    m_count = itemCount;
+    notify(0, itemCount);
+}
+
+void LiteSelectionModel::clear() {
+    if (m_ranges.empty()) return;
+    size_t changedFirst = m_ranges.front().first;
+    size_t changedEnd = m_ranges.back().end();
+    m_ranges.clear();
+    m_count = 0;
+    notify(changedFirst, changedEnd);
+}
+
+void LiteSelectionModel::keepFirst() {
+    if (m_count <= 1) return;
+    size_t first = m_ranges.front().first;
+    size_t changedEnd = m_ranges.back().end();
+    m_ranges.assign(1, SelectionRange{first, 1});
+    m_count = 1;
+    notify(first + 1, changedEnd);
+}
+
+// ==================== 行变化 ====================
+
+void LiteSelectionModel::insertItems(size_t index, size_t count) {
+    if (count == 0) return;
+
+    // 插入点落在区间内部时把区间拆成两段，新行不选中
+    std::vector<SelectionRange> shifted;
+    shifted.reserve(m_ranges.size() + 1);
+    for (const auto& range : m_ranges) {
+        if (range.first >= index) {
+            shifted.push_back(SelectionRange{range.first + count, range.count});
+        } else if (range.end() > index) {
+            shifted.push_back(SelectionRange{range.first, index - range.first});
+            shifted.push_back(SelectionRange{index + count, range.end() - index});
+        } else {
+            shifted.push_back(range);
+        }
+    }
+    m_ranges.swap(shifted);
+
+    if (m_anchor >= static_cast<long long>(index)) {
+        m_anchor += static_cast<long long>(count);
+    }
+}
+
+void LiteSelectionModel::removeItems(size_t index, size_t count) {
+    if (count == 0) return;
+    size_t end = index + count;
+    removeRange(index, end);
+
+    // 后面的区间前移，与前一个区间相接时合并
+    std::vector<SelectionRange> shifted;
+    shifted.reserve(m_ranges.size());
+    for (auto range : m_ranges) {
+        if (range.first >= end) {
+            range.first -= count;
+        }
+        if (!shifted.empty() && shifted.back().end() == range.first) {
+            shifted.back().count += range.count;
+        } else {
+            shifted.push_back(range);
+        }
+    }
+    m_ranges.swap(shifted);
+
+    if (m_anchor >= static_cast<long long>(end)) {
+        m_anchor -= static_cast<long long>(count);
+    } else if (m_anchor >= static_cast<long long>(index)) {
+        m_anchor = -1;
+    }
+}
+
+// ==================== 监听 ====================
+
+size_t LiteSelectionModel::addListener(ChangeListener listener) {
+    return m_listeners.add(std::move(listener));
+}
+
+void LiteSelectionModel::removeListener(size_t id) {
+    m_listeners.remove(id);
+}
+
+void LiteSelectionModel::notify(size_t first, size_t end) {
+    if (m_listeners.empty()) return;
+    m_listeners.notify(SelectionRange{first, end - first});
+}
+
+} // namespace liteDui
@@ -3,16 +3,13 @@
  */
 
 #include "lite_tab_view.h"
+#include "lite_text_renderer.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRRect.h"
-#include "modules/skparagraph/include/ParagraphBuilder.h"
-#include "modules/skparagraph/include/Paragraph.h"
 #include <algorithm>
 
-using namespace skia::textlayout;
-
 namespace liteDui {
 
 LiteTabView::LiteTabView() {
@@ -155,20 +152,8 @@ void LiteTabView::setOnTabChanged(SelectionChangedCallback callback) {
 float LiteTabView::measureTabWidth(const std::string& title) const {
     if (title.empty()) return m_tabPadding * 2;
 
-    auto& fontMgr = getFontManager();
-    auto fontCollection = fontMgr.getFontCollection();
-
-    ParagraphStyle paraStyle;
-    auto textStyle = fontMgr.createTextStyle(m_normalTextColor, getFontSize(), getFontFamily());
-
-    auto builder = ParagraphBuilder::make(paraStyle, fontCollection);
-    builder->pushStyle(textStyle);
-    builder->addText(title.c_str());
-
-    auto paragraph = builder->Build();
-    paragraph->layout(10000);
-
-    return paragraph->getMaxIntrinsicWidth() + m_tabPadding * 2;
+    // 测量结果有缓存，鼠标移动时的命中测试不会重复整形
+    return getFontManager().measureText(title, getFontSpec()).width + m_tabPadding * 2;
 }
 
 int LiteTabView::getTabIndexAtX(float x) const {
@@ -309,28 +294,12 @@ void LiteTabView::drawTab(SkCanvas* canvas, size_t index, float x, float y, floa
 
     // 绘制标签文本
     if (!tab.title.empty()) {
-        auto& fontMgr = getFontManager();
-        auto fontCollection = fontMgr.getFontCollection();
-
         Color textColor = isEnabled ? (isSelected ? m_selectedTextColor : m_normalTextColor) 
                                     : Color::fromRGB(180, 180, 180);
 
-        ParagraphStyle paraStyle;
-        paraStyle.setTextAlign(skia::textlayout::TextAlign::kCenter);
-
-        auto textStyle = fontMgr.createTextStyle(textColor, getFontSize(), getFontFamily());
-
-        auto builder = ParagraphBuilder::make(paraStyle, fontCollection);
-        builder->pushStyle(textStyle);
-        builder->addText(tab.title.c_str());
-
-        auto paragraph = builder->Build();
-        paragraph->layout(width);
-
-        float textHeight = paragraph->getHeight();
-        float textY = y + (height - textHeight) / 2;
-
-        paragraph->paint(canvas, x, textY);
+        LiteTextRenderer::getInstance().drawSingleLine(
+            canvas, tab.title, getFontSpec(), textColor,
+            x, y, width, height, TextAlign::Center, false);
     }
 }
 
@@ -5,219 +5,1518 @@
  */
 
 #include "lite_table.h"
+#include "lite_text_renderer.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPathBuilder.h"
 #include "include/core/SkRect.h"
-#include "modules/skparagraph/include/ParagraphBuilder.h"
-#include "modules/skparagraph/include/Paragraph.h"
 #include <algorithm>
 
-using namespace skia::textlayout;
+namespace liteDui {
+
+namespace {
+
+// 表头排序指示器占用的宽度
+constexpr float kSortIndicatorWidth = 14.0f;
+
+// 分组时 m_viewToModel 中组头项的标记，低位为组号
+constexpr uint32_t kGroupRowFlag = 0x80000000u;
+
+// 变化日志的最大条数，超出后更早的结果不再映射
+constexpr size_t kMaxLoggedChanges = 4096;
+
+/**
+ * 一系列行插入、删除组成的行号映射（旧行号 -> 新行号）
+ * 按保留下来的连续段表示：每次变化 O(段数)，映射一行 O(log 段数)
+ */
+class RowShiftMap {
+public:
+    void insert(size_t first, size_t count) {
+        std::vector<Segment> result;
+        result.reserve(m_segments.size() + 1);
+        for (const auto& segment : m_segments) {
+            if (segment.target >= first) {
+                result.push_back({segment.source, segment.count, segment.target + count});
+            } else if (segment.target + segment.count > first) {
+                size_t head = first - segment.target;
+                result.push_back({segment.source, head, segment.target});
+                result.push_back({segment.source + head, segment.count - head, first + count});
+            } else {
+                result.push_back(segment);
+            }
+        }
+        m_segments.swap(result);
+    }
+
+    void remove(size_t first, size_t count) {
+        size_t end = first + count;
+        std::vector<Segment> result;
+        result.reserve(m_segments.size() + 1);
+        for (const auto& segment : m_segments) {
+            size_t segmentEnd = segment.target + segment.count;
+            if (segmentEnd <= first) {
+                result.push_back(segment);
+            } else if (segment.target >= end) {
+                result.push_back({segment.source, segment.count, segment.target - count});
+            } else {
+                if (segment.target < first) {
+                    result.push_back({segment.source, first - segment.target, segment.target});
+                }
+                if (segmentEnd > end) {
+                    result.push_back({segment.source + (end - segment.target), segmentEnd - end, first});
+                }
+            }
+        }
+        m_segments.swap(result);
+    }
+
+    // 被删除的行返回 UINT32_MAX
+    uint32_t map(uint32_t row) const {
+        auto it = std::upper_bound(m_segments.begin(), m_segments.end(), static_cast<size_t>(row),
+                                   [](size_t value, const Segment& segment) { return value < segment.source; });
+        if (it == m_segments.begin()) return UINT32_MAX;
+        --it;
+        if (row >= it->source + it->count) return UINT32_MAX;
+        return static_cast<uint32_t>(it->target + (row - it->source));
+    }
+
+private:
+    struct Segment {
+        size_t source;
+        size_t count;
+        size_t target;
+    };
+
+    std::vector<Segment> m_segments{{0, SIZE_MAX / 2, 0}};
+};
+
+} // namespace
+
+LiteTable::LiteTable()
+    : m_rowModel(std::make_shared<LiteRowTableModel>()) {
+    setScrollDirection(ScrollDirection::Both);
+    setBackgroundColor(Color::White());
+    setBorderColor(Color::LightGray());
+    setBorder(EdgeInsets::All(1.0f));
+    setPadding(EdgeInsets::All(0));
+    m_rowHeights.setEstimatedHeight(m_rowHeight);
+
+    m_model = m_rowModel;
+    attachModel();
+
+    m_selection.addListener([this](const SelectionRange&) {
+        markDirty();
+    });
+}
+
+LiteTable::~LiteTable() {
+    detachModel();
+}
+
+// 数据模型
+void LiteTable::setModel(std::shared_ptr<LiteTableModel> model) {
+    if (!model) {
+        model = m_rowModel;
+    }
+    if (model == m_model) return;
+
+    // 切换模型时停止仍在进行的 CSV 加载
+    if (m_csvLoader) {
+        m_csvLoader->cancel();
+        m_csvLoader.reset();
+    }
+    detachModel();
+    m_model = std::move(model);
+    attachModel();
+    onModelChanged({TableModelChange::Type::Reset, 0, 0});
+}
+
+void LiteTable::attachModel() {
+    m_modelListener = m_model->addListener([this](const TableModelChange& change) {
+        onModelChanged(change);
+    });
+}
+
+void LiteTable::detachModel() {
+    if (m_model && m_modelListener != 0) {
+        m_model->removeListener(m_modelListener);
+    }
+    m_modelListener = 0;
+}
+
+LiteRowTableModel* LiteTable::activeRowModel() const {
+    return m_model == m_rowModel ? m_rowModel.get() : nullptr;
+}
+
+void LiteTable::onModelChanged(const TableModelChange& change) {
+    size_t rowCount = m_model->getRowCount();
+    ++m_modelRevision;
+
+    // 记录变化，排序、筛选期间发生变化时把结果映射到当前行号
+    if (m_changeLog.size() >= kMaxLoggedChanges) {
+        m_changeLog.clear();
+        m_changeLogStart = m_modelRevision;
+    } else {
+        LoggedChange logged{m_modelRevision, change.type, change.first, change.count, nullptr};
+        if (change.type == TableModelChange::Type::RowsRemapped) {
+            logged.sources = std::make_shared<const std::vector<uint32_t>>(*change.sources);
+        }
+        m_changeLog.push_back(std::move(logged));
+    }
+    // 排序键列的快照只重新复制变化的行
+    for (auto& entry : m_sortSnapshots) {
+        entry.second.onModelChanged(change);
+    }
+    for (auto& snapshot : m_filterSnapshots) {
+        snapshot.onModelChanged(change);
+    }
+
+    // 聚合随模型增量更新，分组后的显示顺序在 update 中重建
+    if (isGrouped() && !m_groupViewDirty) {
+        captureGroupHover();
+    }
+    if (m_grouping.isEnabled()) {
+        switch (change.type) {
+            case TableModelChange::Type::Reset:
+            case TableModelChange::Type::ColumnsChanged:
+                m_grouping.rebuild(*m_model);
+                break;
+            case TableModelChange::Type::RowsInserted:
+                m_grouping.rowsInserted(*m_model, change.first, change.count);
+                break;
+            case TableModelChange::Type::RowsRemoved:
+                m_grouping.rowsRemoved(change.first, change.count);
+                break;
+            case TableModelChange::Type::DataChanged:
+                m_grouping.rowsChanged(*m_model, change.first, change.count);
+                break;
+            case TableModelChange::Type::RowsRemapped:
+                m_grouping.rowsRemapped(*m_model, *change.sources);
+                break;
+        }
+        if (isGrouped()) {
+            m_groupViewDirty = true;
+        }
+    }
+
+    switch (change.type) {
+        case TableModelChange::Type::Reset:
+            m_selection.clear();
+            m_selection.setAnchor(-1);
+            m_modelRowHeights.clear();
+            m_hoverRow = -1;
+            m_trackedAnchor = -1;
+            m_groupHoverRow = -1;
+            m_groupHoverHeader = false;
+            m_prefetcher.cancel();
+            resetSortOrder();
+            // 筛选保持生效，重新筛选完成前不显示任何行
+            m_filterRows.clear();
+            m_viewToModel.clear();
+            break;
+
+        case TableModelChange::Type::RowsInserted: {
+            // 插入点之后的选中行向后平移
+            m_selection.insertItems(change.first, change.count);
+            if (m_trackedAnchor >= static_cast<long long>(change.first)) {
+                m_trackedAnchor += static_cast<long long>(change.count);
+            }
+            if (m_groupHoverRow >= static_cast<long long>(change.first)) {
+                m_groupHoverRow += static_cast<long long>(change.count);
+            }
+            if (!m_modelRowHeights.empty()) {
+                size_t at = std::min(change.first, m_modelRowHeights.size());
+                m_modelRowHeights.insert(m_modelRowHeights.begin() + at, change.count, 0.0f);
+            }
+            // 按模型顺序显示时视图行即模型行，插入点之后的悬停行随之后移；
+            // 排序、筛选时新行不插入已有视图行之间，分组时在 update 重新分组时处理
+            if (m_sortOrder.empty() && !m_filterActive && !isGrouped() &&
+                m_hoverRow >= static_cast<int>(change.first)) {
+                m_hoverRow += static_cast<int>(change.count);
+            }
+            // 追加到末尾不影响已有行，无需取消预取；分组时在 update 重新分组时处理
+            bool appended = change.first + change.count >= rowCount;
+            if (!appended && !isGrouped()) {
+                m_prefetcher.cancel();
+            }
+            // 已排序时新行先显示在末尾，等待重新排序；筛选时新行在重新筛选前不显示
+            auto shift = [&](std::vector<uint32_t>& rows) {
+                for (auto& row : rows) {
+                    if (row >= change.first) row += static_cast<uint32_t>(change.count);
+                }
+            };
+            if (!m_sortOrder.empty()) {
+                if (!appended) shift(m_sortOrder);
+                for (size_t i = 0; i < change.count; ++i) {
+                    m_sortOrder.push_back(static_cast<uint32_t>(change.first + i));
+                }
+            }
+            if (m_filterActive && !appended) {
+                shift(m_filterRows);
+            }
+            if ((m_filterActive || isGrouped()) && !appended) {
+                // 筛选视图是模型行的有序子集，平移行号即可；分组视图的组头项不变，新行在重新分组前不显示
+                for (auto& entry : m_viewToModel) {
+                    if (!(entry & kGroupRowFlag) && entry >= change.first) entry += static_cast<uint32_t>(change.count);
+                }
+            }
+            m_modelToViewDirty = true;
+            break;
+        }
+
+        case TableModelChange::Type::RowsRemoved: {
+            size_t end = change.first + change.count;
+            m_selection.removeItems(change.first, change.count);
+            if (m_trackedAnchor >= static_cast<long long>(end)) {
+                m_trackedAnchor -= static_cast<long long>(change.count);
+            } else if (m_trackedAnchor >= static_cast<long long>(change.first)) {
+                m_trackedAnchor = -1;
+            }
+            if (m_groupHoverRow >= static_cast<long long>(end)) {
+                m_groupHoverRow -= static_cast<long long>(change.count);
+            } else if (m_groupHoverRow >= static_cast<long long>(change.first)) {
+                m_groupHoverRow = -1;
+            }
+            if (change.first < m_modelRowHeights.size()) {
+                size_t last = std::min(end, m_modelRowHeights.size());
+                m_modelRowHeights.erase(m_modelRowHeights.begin() + change.first, m_modelRowHeights.begin() + last);
+            }
+
+            // 按模型顺序显示时从头部删除（流式写入保留最新行）：其余行整体前移，
+            // 已提交的预取与悬停行随之前移，不必丢弃
+            bool headTrim = change.first == 0 && m_sortOrder.empty() && !m_filterActive && !isGrouped();
+            if (headTrim) {
+                m_prefetcher.shiftRows(change.count);
+                m_hoverRow = m_hoverRow >= static_cast<int>(change.count)
+                                 ? m_hoverRow - static_cast<int>(change.count) : -1;
+            } else if (!isGrouped()) {
+                // 分组时悬停项与预取在 update 重新分组时处理
+                m_hoverRow = -1;
+                m_prefetcher.cancel();
+            }
+
+            // 删除与平移一趟完成
+            auto removeRange = [&](std::vector<uint32_t>& rows) {
+                size_t out = 0;
+                for (uint32_t row : rows) {
+                    if (row < change.first) {
+                        rows[out++] = row;
+                    } else if (row >= end) {
+                        rows[out++] = row - static_cast<uint32_t>(change.count);
+                    }
+                }
+                rows.resize(out);
+            };
+            removeRange(m_sortOrder);
+            if (m_filterActive) {
+                removeRange(m_filterRows);
+            }
+            if (m_filterActive || isGrouped()) {
+                // 视图中的组头项保留，空组在重新分组时去掉
+                size_t out = 0;
+                for (uint32_t entry : m_viewToModel) {
+                    if ((entry & kGroupRowFlag) || entry < change.first) {
+                        m_viewToModel[out++] = entry;
+                    } else if (entry >= end) {
+                        m_viewToModel[out++] = entry - static_cast<uint32_t>(change.count);
+                    }
+                }
+                m_viewToModel.resize(out);
+            }
+            // 删除行不改变其余行的相对顺序与筛选结果，当前的排序与筛选仍然有效
+            if (m_appliedFilterRevision + 1 == m_modelRevision) {
+                m_appliedFilterRevision = m_modelRevision;
+            }
+            m_modelToViewDirty = true;
+            break;
+        }
+
+        case TableModelChange::Type::DataChanged:
+            // 内容变化的行重新测量
+            if (m_rowHeightProvider && change.first < m_modelRowHeights.size()) {
+                size_t last = std::min(change.first + change.count, m_modelRowHeights.size());
+                std::fill(m_modelRowHeights.begin() + change.first, m_modelRowHeights.begin() + last, 0.0f);
+            }
+            m_prefetcher.cancel();
+            break;
+
+        case TableModelChange::Type::ColumnsChanged:
+            m_prefetcher.cancel();
+            break;
+
+        case TableModelChange::Type::RowsRemapped: {
+            // 保留行的选择、行高与显示位置随行移动，新行的处理与插入相同
+            const auto& sources = *change.sources;
+            size_t oldCount = change.count;
+            std::vector<uint32_t> targets(oldCount, UINT32_MAX);
+            for (size_t row = 0; row < sources.size(); ++row) {
+                if (sources[row] < oldCount) targets[sources[row]] = static_cast<uint32_t>(row);
+            }
+            auto target = [&](long long row) -> long long {
+                if (row < 0 || static_cast<size_t>(row) >= oldCount || targets[row] == UINT32_MAX) return -1;
+                return targets[row];
+            };
+
+            std::vector<size_t> selected;
+            selected.reserve(m_selection.getCount());
+            for (const auto& range : m_selection.getRanges()) {
+                for (size_t row = range.first; row < range.end() && row < oldCount; ++row) {
+                    if (targets[row] != UINT32_MAX) selected.push_back(targets[row]);
+                }
+            }
+            long long anchor = target(m_selection.getAnchor());
+            m_selection.clear();
+            m_selection.selectIndices(std::move(selected));
+            m_selection.setAnchor(anchor);
+            m_trackedAnchor = target(m_trackedAnchor);
+            m_groupHoverRow = target(m_groupHoverRow);
+
+            if (!m_modelRowHeights.empty()) {
+                std::deque<float> heights(sources.size(), 0.0f);
+                for (size_t row = 0; row < sources.size(); ++row) {
+                    if (sources[row] < m_modelRowHeights.size()) heights[row] = m_modelRowHeights[sources[row]];
+                }
+                m_modelRowHeights.swap(heights);
+            }
+            m_hoverRow = -1;
+            m_prefetcher.cancel();
+
+            auto remap = [&](std::vector<uint32_t>& rows) {
+                size_t out = 0;
+                for (uint32_t row : rows) {
+                    if (row < oldCount && targets[row] != UINT32_MAX) rows[out++] = targets[row];
+                }
+                rows.resize(out);
+            };
+            if (!m_sortOrder.empty()) {
+                remap(m_sortOrder);
+                for (size_t row = 0; row < sources.size(); ++row) {
+                    if (sources[row] >= oldCount) m_sortOrder.push_back(static_cast<uint32_t>(row));
+                }
+            }
+            if (m_filterActive) {
+                remap(m_filterRows);
+                std::sort(m_filterRows.begin(), m_filterRows.end());
+                rebuildView();
+            }
+            m_modelToViewDirty = true;
+            break;
+        }
+    }
+    m_rowHeightsDirty = true;
+
+    // 数据变化后在 update 中重新排序、重新筛选；只删除行时结果仍然有效
+    bool removedOnly = change.type == TableModelChange::Type::RowsRemoved;
+    if (!m_sortKeys.empty() && !removedOnly) {
+        m_sortDirty = true;
+    }
+    if (hasFilter() && !removedOnly) {
+        m_filterDirty = true;
+    }
+    markDirty();
+}
+
+// 列管理
+void LiteTable::addColumn(const std::string& title, float width, TextAlign align) {
+    m_columns.emplace_back(title, width, align);
+    m_columnOffsetsDirty = true;
+    m_rowModel->setColumnCount(m_columns.size());
+    markDirty();
+}
+
+void LiteTable::insertColumn(size_t index, const std::string& title, float width) {
+    if (index > m_columns.size()) {
+        index = m_columns.size();
+    }
+    m_columns.insert(m_columns.begin() + index, TableColumn(title, width));
+    m_columnOffsetsDirty = true;
+    if (index < m_frozenColumns) {
+        ++m_frozenColumns;
+    }
+    m_rowModel->setColumnCount(m_columns.size());
+    if (m_grouping.isEnabled()) {
+        reconfigureGrouping(getGroupColumn());
+    }
+    markDirty();
+}
+
+void LiteTable::removeColumn(size_t index) {
+    if (index >= m_columns.size()) return;
+    m_columns.erase(m_columns.begin() + index);
+    m_columnOffsetsDirty = true;
+    if (index < m_frozenColumns) {
+        --m_frozenColumns;
+    }
+
+    // 移除该列的排序键，后面的列前移
+    if (!m_sortKeys.empty()) {
+        std::vector<TableSortKey> keys;
+        for (auto key : m_sortKeys) {
+            if (key.column == index) continue;
+            if (key.column > index) --key.column;
+            keys.push_back(key);
+        }
+        setSortKeys(keys);
+    }
+    
+    // 同时移除内置模型所有行中对应的单元格
+    m_rowModel->removeColumn(index);
+
+    // 分组列与聚合列随之前移
+    if (m_grouping.isEnabled()) {
+        int keyColumn = getGroupColumn();
+        if (keyColumn == static_cast<int>(index)) {
+            keyColumn = -1;
+        } else if (keyColumn > static_cast<int>(index)) {
+            --keyColumn;
+        }
+        reconfigureGrouping(keyColumn);
+    }
+    markDirty();
+}
+
+void LiteTable::clearColumns() {
+    if (!m_sortKeys.empty()) {
+        clearSort();
+    }
+    m_columns.clear();
+    m_columnOffsetsDirty = true;
+    m_frozenColumns = 0;
+    m_rowModel->clear();
+    m_rowModel->setColumnCount(0);
+    if (m_grouping.isEnabled()) {
+        reconfigureGrouping(-1);
+    }
+    markDirty();
+}
+
+TableColumn* LiteTable::getColumn(size_t index) {
+    if (index >= m_columns.size()) return nullptr;
+    // 调用方可能直接修改列宽
+    m_columnOffsetsDirty = true;
+    return &m_columns[index];
+}
+
+const TableColumn* LiteTable::getColumn(size_t index) const {
+    if (index >= m_columns.size()) return nullptr;
+    return &m_columns[index];
+}
+
+void LiteTable::setColumnWidth(size_t index, float width) {
+    if (index >= m_columns.size()) return;
+    m_columns[index].width = width;
+    m_columnOffsetsDirty = true;
+    markDirty();
+}
+
+void LiteTable::setColumnRenderer(size_t index, LiteCellRendererPtr renderer) {
+    if (index >= m_columns.size()) return;
+    m_columns[index].renderer = std::move(renderer);
+    markDirty();
+}
+
+void LiteTable::setFrozenColumnCount(size_t count) {
+    if (m_frozenColumns == count) return;
+    m_frozenColumns = count;
+    markDirty();
+}
+
+// 行管理
+void LiteTable::addRow(const std::vector<std::string>& cells) {
+    if (auto* model = activeRowModel()) {
+        model->addRow(cells);
+    }
+}
+
+void LiteTable::insertRow(size_t index, const std::vector<std::string>& cells) {
+    if (auto* model = activeRowModel()) {
+        model->insertRow(index, cells);
+    }
+}
+
+void LiteTable::removeRow(size_t index) {
+    if (auto* model = activeRowModel()) {
+        model->removeRow(index);
+    }
+}
+
+void LiteTable::clearRows() {
+    if (auto* model = activeRowModel()) {
+        model->clear();
+    }
+}
+
+void LiteTable::setRows(std::vector<std::vector<std::string>> rows, const LiteRowTableModel::RowKeyFunction& key) {
+    auto* model = activeRowModel();
+    if (!model) return;
+    refreshRows([&] { model->setRows(std::move(rows), key); });
+}
+
+void LiteTable::setRows(std::vector<std::vector<std::string>> rows, size_t keyColumn) {
+    auto* model = activeRowModel();
+    if (!model) return;
+    refreshRows([&] { model->setRows(std::move(rows), keyColumn); });
+}
+
+void LiteTable::refreshRows(const std::function<void()>& apply) {
+    // 锚点为视口内第一个选中行，没有时为顶部可见行
+    float offset = 0;
+    m_trackedAnchor = findScrollAnchor(offset);
+    size_t count = getVisibleRowCount();
+    if (m_trackedAnchor < 0 && count > 0) {
+        const auto& heights = rowHeights();
+        size_t view = heights.getRowAt(std::max(0.0f, m_scrollY));
+        size_t row = view < count ? getModelRow(view) : SIZE_MAX;
+        if (row < getRowCount()) {
+            offset = heights.getOffset(view) - m_scrollY;
+            m_trackedAnchor = static_cast<long long>(row);
+        }
+    }
+
+    apply();
+
+    long long anchor = m_trackedAnchor;
+    m_trackedAnchor = -1;
+    if (m_groupViewDirty) {
+        rebuildView();
+    }
+    restoreScrollAnchor(anchor, offset);
+}
+
+TableRow* LiteTable::getRow(size_t index) {
+    auto* model = activeRowModel();
+    return model ? model->getRow(index) : nullptr;
+}
+
+const TableRow* LiteTable::getRow(size_t index) const {
+    const auto* model = activeRowModel();
+    return model ? model->getRow(index) : nullptr;
+}
+
+// 单元格操作
+void LiteTable::setCellText(size_t row, size_t col, const std::string& text) {
+    if (col >= m_columns.size()) return;
+    if (auto* model = activeRowModel()) {
+        model->setCellText(row, col, text);
+    }
+}
+
+std::string LiteTable::getCellText(size_t row, size_t col) const {
+    if (row >= m_model->getRowCount() || col >= m_model->getColumnCount()) return "";
+    return m_model->getCellText(row, col);
+}
+
+void LiteTable::setCellColor(size_t row, size_t col, const Color& textColor, const Color& bgColor) {
+    if (col >= m_columns.size()) return;
+    if (auto* model = activeRowModel()) {
+        model->setCellColor(row, col, textColor, bgColor);
+    }
+}
+
+// 选择
+void LiteTable::setSelectionMode(ListSelectionMode mode) {
+    if (m_selectionMode == mode) return;
+    m_selectionMode = mode;
+    
+    if (mode == ListSelectionMode::Single) {
+        // 只保留第一个选中行
+        m_selection.keepFirst();
+    } else if (mode == ListSelectionMode::None) {
+        clearSelection();
+    }
+    markDirty();
+}
+
+void LiteTable::setSelectedRow(int index) {
+    if (m_selectionMode == ListSelectionMode::None) return;
+    
+    bool valid = index >= 0 && index < static_cast<int>(getRowCount());
+    if (m_selectionMode == ListSelectionMode::Single) {
+        if (valid) {
+            m_selection.setSingle(static_cast<size_t>(index));
+        } else {
+            m_selection.clear();
+        }
+    } else if (valid) {
+        m_selection.select(static_cast<size_t>(index));
+    }
+    if (valid) {
+        m_selection.setAnchor(index);
+    }
+    
+    markDirty();
+    
+    if (m_onSelectionChanged) {
+        m_onSelectionChanged(index);
+    }
+}
+
+int LiteTable::getSelectedRow() const {
+    return static_cast<int>(m_selection.getFirst());
+}
+
+std::vector<int> LiteTable::getSelectedRows() const {
+    std::vector<int> indices;
+    indices.reserve(m_selection.getCount());
+    for (const auto& range : m_selection.getRanges()) {
+        for (size_t row = range.first; row < range.end(); ++row) {
+            indices.push_back(static_cast<int>(row));
+        }
+    }
+    return indices;
+}
+
+void LiteTable::clearSelection() {
+    m_selection.clear();
+    markDirty();
+}
+
+void LiteTable::selectAll() {
+    if (m_selectionMode != ListSelectionMode::Multiple) return;
+    if (m_filterActive) {
+        // 筛选时只选中可见行
+        m_selection.selectIndices(std::vector<size_t>(m_filterRows.begin(), m_filterRows.end()));
+    } else {
+        m_selection.selectAll(getRowCount());
+    }
+}
+
+void LiteTable::selectViewRange(size_t fromView, size_t toView) {
+    if (fromView > toView) std::swap(fromView, toView);
+    size_t count = getVisibleRowCount();
+    if (count == 0) return;
+    toView = std::min(toView, count - 1);
+    if (fromView > toView) return;
+
+    const auto& order = viewOrder();
+    if (order.empty()) {
+        // 模型顺序：视图区间就是模型区间
+        m_selection.selectRange(fromView, toView - fromView + 1);
+        return;
+    }
+    if (isGrouped()) {
+        // 跳过组头行
+        std::vector<size_t> rows;
+        rows.reserve(toView - fromView + 1);
+        for (size_t view = fromView; view <= toView; ++view) {
+            if (!(order[view] & kGroupRowFlag)) rows.push_back(order[view]);
+        }
+        m_selection.selectIndices(std::move(rows));
+        return;
+    }
+    m_selection.selectIndices(std::vector<size_t>(order.begin() + fromView, order.begin() + toView + 1));
+}
+
+// 排序
+void LiteTable::sortByColumn(size_t column, bool ascending) {
+    TableSortType type = column < m_columns.size() ? m_columns[column].sortType : TableSortType::Auto;
+    setSortKeys({TableSortKey(column, ascending, type)});
+}
+
+void LiteTable::setSortKeys(const std::vector<TableSortKey>& keys) {
+    m_sortKeys = keys;
+    m_sorter.cancel();
+    if (m_sortKeys.empty()) {
+        // 恢复模型顺序
+        m_sortDirty = false;
+        applySortResult(LiteTableSorter::Permutation());
+    } else {
+        requestSort();
+    }
+    markDirty();
+}
+
+int LiteTable::findSortKey(size_t column) const {
+    for (size_t i = 0; i < m_sortKeys.size(); ++i) {
+        if (m_sortKeys[i].column == column) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void LiteTable::onHeaderClicked(size_t column, bool additive) {
+    if (!m_sortingEnabled || column >= m_columns.size() || !m_columns[column].sortable) return;
+
+    TableSortType type = m_columns[column].sortType;
+    std::vector<TableSortKey> keys = m_sortKeys;
+    int index = findSortKey(column);
+
+    if (additive) {
+        // Shift + 点击：追加次要键，已存在时依次切换为降序、移除
+        if (index < 0) {
+            keys.emplace_back(column, true, type);
+        } else if (keys[index].ascending) {
+            keys[index].ascending = false;
+        } else {
+            keys.erase(keys.begin() + index);
+        }
+    } else if (index == 0 && keys.size() == 1) {
+        // 升序 -> 降序 -> 取消排序
+        if (keys[0].ascending) {
+            keys[0].ascending = false;
+        } else {
+            keys.clear();
+        }
+    } else {
+        keys = {TableSortKey(column, true, type)};
+    }
+    setSortKeys(keys);
+}
+
+void LiteTable::requestSort() {
+    m_sortDirty = false;
+
+    // 不再是排序键的列不再维护快照
+    for (auto it = m_sortSnapshots.begin(); it != m_sortSnapshots.end();) {
+        bool used = std::any_of(m_sortKeys.begin(), m_sortKeys.end(),
+                                [&](const TableSortKey& key) { return key.column == it->first; });
+        it = used ? std::next(it) : m_sortSnapshots.erase(it);
+    }
+
+    // UI 线程只复制上次提交后变化的行，整列在排序线程中拼接，排序线程不访问模型
+    size_t columnCount = m_model->getColumnCount();
+    size_t rowCount = m_model->getRowCount();
+    std::vector<TableSortKey> keys;
+    std::vector<LiteTableSorter::ColumnData> columns;
+    for (const auto& key : m_sortKeys) {
+        if (key.column >= columnCount) continue;
+        keys.push_back(key);
+        columns.push_back(m_sortSnapshots[key.column].publish(rowCount, [&](size_t first, size_t count) {
+            auto block = std::make_shared<TableSortColumn>();
+            m_model->getSortColumn(key.column, first, count, *block);
+            return block;
+        }));
+    }
+
+    if (keys.empty()) {
+        m_sorter.cancel();
+        applySortResult(LiteTableSorter::Permutation());
+        return;
+    }
+    m_sorter.request(m_modelRevision, std::move(keys), std::move(columns));
+}
+
+bool LiteTable::remapStaleRows(uint64_t revision, std::vector<uint32_t>& rows, bool permutation) const {
+    if (revision < m_changeLogStart) return false;
+
+    // 连续的插入、删除合并为一次映射；RowsRemapped 按行逐一映射
+    RowShiftMap shifts;
+    bool shifted = false;
+    bool reordered = false;
+    auto flush = [&]() {
+        if (!shifted) return;
+        size_t out = 0;
+        for (uint32_t row : rows) {
+            uint32_t target = shifts.map(row);
+            if (target != UINT32_MAX) rows[out++] = target;
+        }
+        rows.resize(out);
+        shifts = RowShiftMap();
+        shifted = false;
+    };
+    for (const auto& entry : m_changeLog) {
+        if (entry.revision <= revision) continue;
+        switch (entry.type) {
+            case TableModelChange::Type::Reset:
+            case TableModelChange::Type::ColumnsChanged:
+                return false;
+            case TableModelChange::Type::RowsInserted:
+                shifts.insert(entry.first, entry.count);
+                shifted = true;
+                break;
+            case TableModelChange::Type::RowsRemoved:
+                shifts.remove(entry.first, entry.count);
+                shifted = true;
+                break;
+            case TableModelChange::Type::DataChanged:
+                break;
+            case TableModelChange::Type::RowsRemapped: {
+                flush();
+                const auto& sources = *entry.sources;
+                std::vector<uint32_t> targets(entry.count, UINT32_MAX);
+                for (size_t row = 0; row < sources.size(); ++row) {
+                    if (sources[row] < entry.count) targets[sources[row]] = static_cast<uint32_t>(row);
+                }
+                size_t out = 0;
+                for (uint32_t row : rows) {
+                    if (row < targets.size() && targets[row] != UINT32_MAX) rows[out++] = targets[row];
+                }
+                rows.resize(out);
+                reordered = true;
+                break;
+            }
+        }
+    }
+    flush();
+
+    if (!permutation) {
+        // 筛选结果保持升序；期间新增的行在重新筛选前不显示
+        if (reordered) std::sort(rows.begin(), rows.end());
+        return true;
+    }
+    // 排序结果必须包含全部行：期间新增的行先排在末尾，等待下一次排序
+    size_t rowCount = getRowCount();
+    std::vector<uint8_t> present(rowCount, 0);
+    for (uint32_t row : rows) {
+        if (row < rowCount) present[row] = 1;
+    }
+    for (size_t row = 0; row < rowCount; ++row) {
+        if (!present[row]) rows.push_back(static_cast<uint32_t>(row));
+    }
+    return rows.size() == rowCount;
+}
+
+void LiteTable::applySortResult(LiteTableSorter::Permutation permutation) {
+    float anchorOffset = 0;
+    long long anchor = findScrollAnchor(anchorOffset);
+
+    m_sortOrder = std::move(permutation);
+    rebuildView();
+    restoreScrollAnchor(anchor, anchorOffset);
+
+    if (m_onSortChanged) {
+        m_onSortChanged();
+    }
+}
+
+void LiteTable::resetSortOrder() {
+    m_sortOrder.clear();
+    m_modelToView.clear();
+    m_modelToViewDirty = true;
+    m_rowHeightsDirty = true;
+}
+
+// ==================== 筛选 ====================
+
+void LiteTable::setFilterText(const std::string& text) {
+    if (text == m_filterText && !m_filterDirty) return;
+    m_filterText = text;
+    requestFilter();
+}
+
+void LiteTable::setFilterColumns(const std::vector<size_t>& columns) {
+    m_filterColumns = columns;
+    m_filterSnapshots.clear();
+    m_appliedFilterValid = false;
+    if (hasFilter()) requestFilter();
+}
+
+void LiteTable::setFilterCaseSensitive(bool caseSensitive) {
+    if (m_filterCaseSensitive == caseSensitive) return;
+    m_filterCaseSensitive = caseSensitive;
+    m_filterSnapshots.clear();
+    m_appliedFilterValid = false;
+    if (hasFilter()) requestFilter();
+}
+
+void LiteTable::setFilterPredicate(LiteTableFilter::Predicate predicate) {
+    m_filterPredicate = std::move(predicate);
+    ++m_filterPredicateId;
+    requestFilter();
+}
+
+void LiteTable::clearFilter() {
+    m_filterText.clear();
+    m_filterPredicate = nullptr;
+    ++m_filterPredicateId;
+    requestFilter();
+}
+
+void LiteTable::requestFilter() {
+    m_filterDirty = false;
+
+    if (!hasFilter()) {
+        m_filter.cancel();
+        m_filterSnapshots.clear();
+        m_appliedFilterValid = false;
+        if (m_filterActive) {
+            float anchorOffset = 0;
+            long long anchor = findScrollAnchor(anchorOffset);
+            m_filterActive = false;
+            m_filterRows.clear();
+            rebuildView();
+            restoreScrollAnchor(anchor, anchorOffset);
+            if (m_onFilterChanged) m_onFilterChanged();
+        }
+        return;
+    }
+
+    LiteTableFilter::Query query;
+    query.text = m_filterText;
+    query.predicate = m_filterPredicate;
+    query.rowCount = m_model->getRowCount();
+
+    // 快照按列增量维护：连续输入时直接复用，数据变化后只复制变化的行
+    if (!m_filterText.empty()) {
+        size_t columnCount = m_model->getColumnCount();
+        std::vector<size_t> columns;
+        if (m_filterColumns.empty()) {
+            for (size_t col = 0; col < columnCount; ++col) columns.push_back(col);
+        } else {
+            for (size_t col : m_filterColumns) {
+                if (col < columnCount) columns.push_back(col);
+            }
+        }
+        if (columns != m_filterSnapshotColumns || m_filterSnapshots.size() != columns.size()) {
+            m_filterSnapshotColumns = columns;
+            m_filterSnapshots.clear();
+            m_filterSnapshots.resize(columns.size());
+        }
+
+        auto snapshot = std::make_shared<LiteTableFilter::Snapshot>();
+        snapshot->rowCount = query.rowCount;
+        snapshot->caseSensitive = m_filterCaseSensitive;
+        for (size_t i = 0; i < columns.size(); ++i) {
+            size_t col = columns[i];
+            snapshot->columns.push_back(m_filterSnapshots[i].publish(query.rowCount, [&](size_t first, size_t count) {
+                return LiteTableFilter::makeColumn(*m_model, col, first, count, m_filterCaseSensitive);
+            }));
+        }
+        query.snapshot = std::move(snapshot);
+    }
+
+    // 新查询包含上一次的查询时结果只会更少，只在上一次结果中继续筛选
+    if (m_filterActive && m_appliedFilterValid && m_appliedFilterRevision == m_modelRevision &&
+        m_appliedPredicateId == m_filterPredicateId &&
+        m_filterText.find(m_appliedFilterText) != std::string::npos) {
+        query.candidates = std::make_shared<LiteTableFilter::RowList>(m_filterRows);
+    }
+
+    m_requestedFilterText = m_filterText;
+    m_requestedPredicateId = m_filterPredicateId;
+    m_filter.request(m_modelRevision, std::move(query));
+}
+
+void LiteTable::applyFilterResult(LiteTableFilter::RowList rows, bool complete) {
+    float anchorOffset = 0;
+    long long anchor = findScrollAnchor(anchorOffset);
+
+    m_filterRows = std::move(rows);
+    m_filterActive = true;
+    m_appliedFilterText = m_requestedFilterText;
+    m_appliedPredicateId = m_requestedPredicateId;
+    // 映射过来的过期结果缺少期间新增的行，不能作为增量细化的候选
+    m_appliedFilterRevision = m_modelRevision;
+    m_appliedFilterValid = complete;
+
+    rebuildView();
+    restoreScrollAnchor(anchor, anchorOffset);
+
+    if (m_onFilterChanged) {
+        m_onFilterChanged();
+    }
+}
+
+// ==================== 分组 ====================
+
+void LiteTable::setGroupColumn(int column) {
+    if (column < 0) column = -1;
+    if (column == getGroupColumn()) return;
+    reconfigureGrouping(column);
+}
+
+void LiteTable::setColumnAggregate(size_t index, TableAggregate aggregate) {
+    if (index >= m_columns.size() || m_columns[index].aggregate == aggregate) return;
+    bool participates = m_grouping.getValueIndex(index) != SIZE_MAX;
+    m_columns[index].aggregate = aggregate;
+    // 只换聚合方式时已维护的值仍然有效
+    if (participates != (aggregate != TableAggregate::None)) {
+        reconfigureGrouping(getGroupColumn());
+    }
+    markDirty();
+}
+
+TableAggregate LiteTable::getColumnAggregate(size_t index) const {
+    return index < m_columns.size() ? m_columns[index].aggregate : TableAggregate::None;
+}
+
+void LiteTable::reconfigureGrouping(int keyColumn) {
+    float anchorOffset = 0;
+    long long anchor = findScrollAnchor(anchorOffset);
+    bool wasGrouped = isGrouped();
+
+    std::vector<size_t> valueColumns;
+    for (size_t col = 0; col < m_columns.size(); ++col) {
+        if (m_columns[col].aggregate != TableAggregate::None) valueColumns.push_back(col);
+    }
+    m_grouping.configure(keyColumn, std::move(valueColumns));
+    if (m_grouping.isEnabled()) {
+        m_grouping.rebuild(*m_model);
+    }
+
+    if (wasGrouped || isGrouped()) {
+        rebuildView();
+        restoreScrollAnchor(anchor, anchorOffset);
+    }
+    markDirty();
+}
+
+void LiteTable::setGroupExpanded(const std::string& key, bool expanded) {
+    bool changed = expanded ? m_collapsedGroups.erase(key) > 0 : m_collapsedGroups.insert(key).second;
+    if (changed && isGrouped()) {
+        rebuildView();
+        clampScroll();
+    }
+}
+
+bool LiteTable::isGroupExpanded(const std::string& key) const {
+    return m_collapsedGroups.count(key) == 0;
+}
+
+void LiteTable::expandAllGroups() {
+    if (m_collapsedGroups.empty()) return;
+    m_collapsedGroups.clear();
+    if (isGrouped()) {
+        rebuildView();
+        clampScroll();
+    }
+}
+
+void LiteTable::collapseAllGroups() {
+    for (size_t group = 0; group < m_grouping.getGroupCount(); ++group) {
+        m_collapsedGroups.insert(m_grouping.getGroupKey(group));
+    }
+    if (isGrouped()) {
+        rebuildView();
+        clampScroll();
+    }
+}
+
+void LiteTable::setShowFooter(bool show) {
+    if (m_showFooter == show) return;
+    m_showFooter = show;
+    clampScroll();
+    markDirty();
+}
+
+void LiteTable::buildGroupView() {
+    m_groupViewDirty = false;
+    // 空组过多时重新编号；视图中的组号随即在下面重建
+    m_grouping.compact();
+
+    // 基础顺序：筛选结果（已按排序顺序）、排序结果或模型顺序
+    std::vector<uint32_t> filtered;
+    if (m_filterActive) {
+        filtered.swap(m_viewToModel);
+    }
+    const std::vector<uint32_t>* order = m_filterActive ? &filtered
+                                       : (m_sortOrder.empty() ? nullptr : &m_sortOrder);
+    size_t count = order ? order->size() : m_model->getRowCount();
+    auto rowAt = [order](size_t i) { return order ? (*order)[i] : static_cast<uint32_t>(i); };
+
+    // 按组计数后分桶，组内保持基础顺序
+    size_t groupCount = m_grouping.getGroupCount();
+    std::vector<uint32_t> starts(groupCount + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t group = m_grouping.getRowGroup(rowAt(i));
+        if (group < groupCount) ++starts[group + 1];
+    }
+    for (size_t group = 0; group < groupCount; ++group) {
+        starts[group + 1] += starts[group];
+    }
+    std::vector<uint32_t> members(starts[groupCount]);
+    std::vector<uint32_t> next(starts.begin(), starts.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t row = rowAt(i);
+        uint32_t group = m_grouping.getRowGroup(row);
+        if (group < groupCount) members[next[group]++] = row;
+    }
+
+    // 只显示有可见行的组，按分组列为主排序键时的方向排列
+    std::vector<uint32_t> groups;
+    for (size_t group = 0; group < groupCount; ++group) {
+        if (starts[group + 1] > starts[group]) groups.push_back(static_cast<uint32_t>(group));
+    }
+    bool descending = !m_sortKeys.empty() && static_cast<int>(m_sortKeys[0].column) == getGroupColumn() &&
+                      !m_sortKeys[0].ascending;
+    std::sort(groups.begin(), groups.end(), [this, descending](uint32_t a, uint32_t b) {
+        int result = LiteTableSorter::compareNatural(m_grouping.getGroupKey(a), m_grouping.getGroupKey(b));
+        return descending ? result > 0 : result < 0;
+    });
+
+    m_viewToModel.clear();
+    m_viewToModel.reserve(groups.size() + members.size());
+    for (uint32_t group : groups) {
+        m_viewToModel.push_back(kGroupRowFlag | group);
+        if (m_collapsedGroups.count(m_grouping.getGroupKey(group))) continue;
+        m_viewToModel.insert(m_viewToModel.end(), members.begin() + starts[group], members.begin() + starts[group + 1]);
+    }
+}
+
+void LiteTable::captureGroupHover() {
+    m_groupHoverRow = -1;
+    m_groupHoverHeader = false;
+    m_groupHoverKey.clear();
+    if (m_hoverRow < 0 || static_cast<size_t>(m_hoverRow) >= m_viewToModel.size()) return;
+
+    int group = getGroupAt(static_cast<size_t>(m_hoverRow));
+    if (group >= 0) {
+        m_groupHoverHeader = true;
+        m_groupHoverKey = m_grouping.getGroupKey(static_cast<size_t>(group));
+    } else {
+        m_groupHoverRow = m_viewToModel[static_cast<size_t>(m_hoverRow)];
+    }
+}
+
+void LiteTable::refreshGroupView() {
+    // 预取只是提前整形文本，行的显示位置变化不影响已整形的结果，不必取消
+    buildView();
+
+    m_hoverRow = -1;
+    if (m_groupHoverHeader) {
+        int group = m_grouping.findGroup(m_groupHoverKey);
+        if (group >= 0) {
+            auto it = std::find(m_viewToModel.begin(), m_viewToModel.end(), kGroupRowFlag | static_cast<uint32_t>(group));
+            if (it != m_viewToModel.end()) m_hoverRow = static_cast<int>(it - m_viewToModel.begin());
+        }
+    } else if (m_groupHoverRow >= 0 && static_cast<size_t>(m_groupHoverRow) < getRowCount()) {
+        m_hoverRow = getViewRow(static_cast<size_t>(m_groupHoverRow));
+    }
+    m_groupHoverRow = -1;
+    m_groupHoverHeader = false;
+}
 
-namespace liteDui {
+int LiteTable::getGroupAt(size_t viewRow) const {
+    if (!isGrouped() || viewRow >= m_viewToModel.size()) return -1;
+    uint32_t entry = m_viewToModel[viewRow];
+    if (!(entry & kGroupRowFlag)) return -1;
+    uint32_t group = entry & ~kGroupRowFlag;
+    return group < m_grouping.getGroupCount() ? static_cast<int>(group) : -1;
+}
 
-LiteTable::LiteTable() {
-    setScrollDirection(ScrollDirection::Both);
-    setBackgroundColor(Color::White());
-    setBorderColor(Color::LightGray());
-    setBorder(EdgeInsets::All(1.0f));
-    setPadding(EdgeInsets::All(0));
+// ==================== 视图行映射 ====================
+
+void LiteTable::rebuildView() {
+    buildView();
+    m_hoverRow = -1;
+    m_prefetcher.cancel();
 }
 
-// 列管理
-void LiteTable::addColumn(const std::string& title, float width, TextAlign align) {
-    m_columns.emplace_back(title, width, align);
+void LiteTable::buildView() {
+    if (m_filterActive) {
+        if (m_sortOrder.empty()) {
+            m_viewToModel = m_filterRows;
+        } else {
+            // 按排序顺序保留通过筛选的行
+            std::vector<uint8_t> visible(m_model->getRowCount(), 0);
+            for (uint32_t row : m_filterRows) {
+                if (row < visible.size()) visible[row] = 1;
+            }
+            m_viewToModel.clear();
+            m_viewToModel.reserve(m_filterRows.size());
+            for (uint32_t row : m_sortOrder) {
+                if (row < visible.size() && visible[row]) m_viewToModel.push_back(row);
+            }
+        }
+    } else {
+        m_viewToModel.clear();
+    }
+    if (isGrouped()) {
+        buildGroupView();
+    }
+
+    m_modelToViewDirty = true;
+    m_rowHeightsDirty = true;
     markDirty();
 }
 
-void LiteTable::insertColumn(size_t index, const std::string& title, float width) {
-    if (index > m_columns.size()) {
-        index = m_columns.size();
+long long LiteTable::findScrollAnchor(float& offset) const {
+    // 视口内的第一个选中行在重新排序或筛选后保持相同的屏幕位置
+    float viewportH = bodyHeight();
+    // 只检查视口内的行，与选中行数无关
+    size_t count = getVisibleRowCount();
+    if (m_selection.isEmpty() || count == 0) return -1;
+    const auto& heights = rowHeights();
+    size_t first = heights.getRowAt(m_scrollY);
+    float y = heights.getOffset(first) - m_scrollY;
+    for (size_t view = first; view < count && y < viewportH; ++view) {
+        size_t row = getModelRow(view);
+        if (m_selection.isSelected(row)) {
+            offset = y;
+            return static_cast<long long>(row);
+        }
+        y += heights.getHeight(view);
     }
-    m_columns.insert(m_columns.begin() + index, TableColumn(title, width));
-    markDirty();
+    return -1;
 }
 
-void LiteTable::removeColumn(size_t index) {
-    if (index >= m_columns.size()) return;
-    m_columns.erase(m_columns.begin() + index);
-    
-    // 同时移除所有行中对应的单元格
-    for (auto& row : m_rows) {
-        if (index < row.cells.size()) {
-            row.cells.erase(row.cells.begin() + index);
+void LiteTable::restoreScrollAnchor(long long anchor, float offset) {
+    if (anchor >= 0) {
+        int view = getViewRow(static_cast<size_t>(anchor));
+        if (view >= 0) {
+            m_scrollY = rowHeights().getOffset(static_cast<size_t>(view)) - offset;
         }
     }
+    // 筛选后内容可能变短
+    clampScroll();
     markDirty();
 }
 
-void LiteTable::clearColumns() {
-    m_columns.clear();
-    m_rows.clear();
-    markDirty();
+const std::vector<uint32_t>& LiteTable::viewOrder() const {
+    return (m_filterActive || isGrouped()) ? m_viewToModel : m_sortOrder;
 }
 
-TableColumn* LiteTable::getColumn(size_t index) {
-    if (index >= m_columns.size()) return nullptr;
-    return &m_columns[index];
+const std::vector<uint32_t>& LiteTable::modelToView() const {
+    if (m_modelToViewDirty) {
+        const auto& order = viewOrder();
+        m_modelToView.assign(m_model->getRowCount(), UINT32_MAX);
+        for (size_t view = 0; view < order.size(); ++view) {
+            if (order[view] < m_modelToView.size()) {
+                m_modelToView[order[view]] = static_cast<uint32_t>(view);
+            }
+        }
+        m_modelToViewDirty = false;
+    }
+    return m_modelToView;
 }
 
-const TableColumn* LiteTable::getColumn(size_t index) const {
-    if (index >= m_columns.size()) return nullptr;
-    return &m_columns[index];
+size_t LiteTable::getVisibleRowCount() const {
+    return (m_filterActive || isGrouped()) ? m_viewToModel.size() : m_model->getRowCount();
 }
 
-void LiteTable::setColumnWidth(size_t index, float width) {
-    if (index >= m_columns.size()) return;
-    m_columns[index].width = width;
+size_t LiteTable::getModelRow(size_t viewRow) const {
+    const auto& order = viewOrder();
+    if (viewRow >= order.size()) return viewRow;
+    if (isGrouped() && (order[viewRow] & kGroupRowFlag)) return SIZE_MAX;
+    return order[viewRow];
+}
+
+int LiteTable::getViewRow(size_t modelRow) const {
+    if (modelRow >= getRowCount()) return -1;
+    if (!m_filterActive && !isGrouped() && m_sortOrder.empty()) return static_cast<int>(modelRow);
+    const auto& inverse = modelToView();
+    if (modelRow >= inverse.size() || inverse[modelRow] == UINT32_MAX) return -1;
+    return static_cast<int>(inverse[modelRow]);
+}
+
+// ==================== 行高 ====================
+
+void LiteTable::setRowHeight(float height) {
+    m_rowHeight = height;
+    m_rowHeights.setEstimatedHeight(height);
     markDirty();
 }
 
-// 行管理
-void LiteTable::addRow(const std::vector<std::string>& cells) {
-    TableRow row;
-    for (size_t i = 0; i < m_columns.size(); ++i) {
-        if (i < cells.size()) {
-            row.cells.emplace_back(cells[i]);
-        } else {
-            row.cells.emplace_back("");
-        }
-    }
-    m_rows.push_back(row);
+void LiteTable::setRowHeightAt(size_t row, float height) {
+    if (row >= getRowCount()) return;
+    storeRowHeight(row, height);
     markDirty();
 }
 
-void LiteTable::insertRow(size_t index, const std::vector<std::string>& cells) {
-    if (index > m_rows.size()) {
-        index = m_rows.size();
-    }
-    TableRow row;
-    for (size_t i = 0; i < m_columns.size(); ++i) {
-        if (i < cells.size()) {
-            row.cells.emplace_back(cells[i]);
-        } else {
-            row.cells.emplace_back("");
-        }
+float LiteTable::getRowHeightAt(size_t row) const {
+    if (row < m_modelRowHeights.size() && m_modelRowHeights[row] > 0) {
+        return m_modelRowHeights[row];
     }
-    m_rows.insert(m_rows.begin() + index, row);
-    markDirty();
+    return m_rowHeight;
 }
 
-void LiteTable::removeRow(size_t index) {
-    if (index >= m_rows.size()) return;
-    m_rows.erase(m_rows.begin() + index);
-    markDirty();
+void LiteTable::setRowHeightProvider(std::function<float(size_t row)> provider) {
+    m_rowHeightProvider = std::move(provider);
+    invalidateRowHeights();
 }
 
-void LiteTable::clearRows() {
-    m_rows.clear();
-    m_hoverRow = -1;
+void LiteTable::invalidateRowHeight(size_t row) {
+    if (row >= m_modelRowHeights.size()) return;
+    storeRowHeight(row, 0);
     markDirty();
 }
 
-TableRow* LiteTable::getRow(size_t index) {
-    if (index >= m_rows.size()) return nullptr;
-    return &m_rows[index];
+void LiteTable::invalidateRowHeights() {
+    m_modelRowHeights.clear();
+    m_rowHeightsDirty = true;
+    markDirty();
 }
 
-const TableRow* LiteTable::getRow(size_t index) const {
-    if (index >= m_rows.size()) return nullptr;
-    return &m_rows[index];
+const LiteRowHeights& LiteTable::rowHeights() const {
+    size_t count = getVisibleRowCount();
+    if (m_rowHeightsDirty || m_rowHeights.getCount() != count) {
+        if (m_modelRowHeights.empty()) {
+            m_rowHeights.reset(count);
+        } else {
+            // 按显示顺序收集模型行高
+            std::vector<float> heights(count, 0.0f);
+            for (size_t view = 0; view < count; ++view) {
+                size_t row = getModelRow(view);
+                if (row < m_modelRowHeights.size()) heights[view] = m_modelRowHeights[row];
+            }
+            m_rowHeights.assign(std::move(heights));
+        }
+        m_rowHeightsDirty = false;
+    }
+    return m_rowHeights;
 }
 
-// 单元格操作
-void LiteTable::setCellText(size_t row, size_t col, const std::string& text) {
-    if (row >= m_rows.size() || col >= m_columns.size()) return;
-    if (col >= m_rows[row].cells.size()) {
-        m_rows[row].cells.resize(m_columns.size());
+void LiteTable::storeRowHeight(size_t modelRow, float height) {
+    if (height < 0) height = 0;
+    if (m_modelRowHeights.empty()) {
+        if (height == 0) return;
+        m_modelRowHeights.assign(getRowCount(), 0.0f);
     }
-    m_rows[row].cells[col].text = text;
-    markDirty();
-}
+    if (modelRow >= m_modelRowHeights.size()) return;
+    m_modelRowHeights[modelRow] = height;
 
-std::string LiteTable::getCellText(size_t row, size_t col) const {
-    if (row >= m_rows.size() || col >= m_rows[row].cells.size()) return "";
-    return m_rows[row].cells[col].text;
+    // 索引已是最新时只更新这一行（O(log n)），否则在下一次查询时重建
+    if (!m_rowHeightsDirty) {
+        int view = getViewRow(modelRow);
+        if (view >= 0) m_rowHeights.setHeight(static_cast<size_t>(view), height);
+    }
 }
 
-void LiteTable::setCellColor(size_t row, size_t col, const Color& textColor, const Color& bgColor) {
-    if (row >= m_rows.size() || col >= m_columns.size()) return;
-    if (col >= m_rows[row].cells.size()) {
-        m_rows[row].cells.resize(m_columns.size());
+void LiteTable::measureRows(size_t firstView, float bottom) {
+    const auto& heights = rowHeights();
+    size_t count = heights.getCount();
+    float y = heights.getOffset(firstView);
+    for (size_t view = firstView; view < count && y < bottom; ++view) {
+        size_t row = getModelRow(view);
+        // 组头行没有模型行，始终使用默认行高
+        if (!heights.isMeasured(view) && row < getRowCount()) {
+            // 测量结果无效时按默认行高记录，避免每帧重复测量
+            float height = m_rowHeightProvider(row);
+            storeRowHeight(row, height > 0 ? height : m_rowHeight);
+        }
+        y += heights.getHeight(view);
     }
-    m_rows[row].cells[col].textColor = textColor;
-    m_rows[row].cells[col].backgroundColor = bgColor;
-    markDirty();
 }
 
-// 选择
-void LiteTable::setSelectionMode(ListSelectionMode mode) {
-    if (m_selectionMode == mode) return;
-    m_selectionMode = mode;
-    
-    if (mode == ListSelectionMode::Single) {
-        bool foundSelected = false;
-        for (auto& row : m_rows) {
-            if (row.selected) {
-                if (foundSelected) {
-                    row.selected = false;
-                } else {
-                    foundSelected = true;
-                }
+void LiteTable::update() {
+    LiteScrollView::update();
+    drainRowQueue();
+    if (m_csvLoader) {
+        m_csvLoader->poll();
+        if (m_csvLoader->isFinished()) {
+            m_csvLoader.reset();
+        }
+    }
+
+    // 在取结果之前判断：此时没有进行中的任务，本帧之后也就不再需要此前的变化日志
+    bool idle = !m_sorter.isBusy() && !m_filter.isBusy();
+
+    // 数据变化引起的重新排序等上一次排序结束后再提交，避免持续修改时排序永远无法完成
+    if (m_sortDirty && !m_sorter.isBusy()) {
+        requestSort();
+    }
+
+    LiteTableSorter::Permutation permutation;
+    uint64_t revision = 0;
+    if (m_sorter.takeResult(permutation, revision)) {
+        // 排序期间模型又发生了变化：按变化日志映射到当前行号，新行暂时排在末尾
+        if (revision == m_modelRevision || remapStaleRows(revision, permutation, true)) {
+            if (permutation.size() == getRowCount()) {
+                applySortResult(std::move(permutation));
             }
         }
-    } else if (mode == ListSelectionMode::None) {
-        clearSelection();
     }
-    markDirty();
-}
 
-void LiteTable::setSelectedRow(int index) {
-    if (m_selectionMode == ListSelectionMode::None) return;
-    
-    if (m_selectionMode == ListSelectionMode::Single) {
-        for (auto& row : m_rows) {
-            row.selected = false;
+    if (m_filterDirty && !m_filter.isBusy()) {
+        requestFilter();
+    }
+
+    LiteTableFilter::RowList rows;
+    if (m_filter.takeResult(rows, revision)) {
+        bool complete = revision == m_modelRevision;
+        if (complete || remapStaleRows(revision, rows, false)) {
+            applyFilterResult(std::move(rows), complete);
         }
     }
-    
-    if (index >= 0 && index < static_cast<int>(m_rows.size())) {
-        m_rows[index].selected = true;
+
+    if (idle) {
+        m_changeLog.clear();
+        m_changeLogStart = m_modelRevision;
     }
-    
-    markDirty();
-    
-    if (m_onSelectionChanged) {
-        m_onSelectionChanged(index);
+
+    // 本帧的模型变化合并为一次重新分组
+    if (m_groupViewDirty) {
+        float anchorOffset = 0;
+        long long anchor = findScrollAnchor(anchorOffset);
+        refreshGroupView();
+        restoreScrollAnchor(anchor, anchorOffset);
     }
 }
 
-int LiteTable::getSelectedRow() const {
-    for (size_t i = 0; i < m_rows.size(); ++i) {
-        if (m_rows[i].selected) {
-            return static_cast<int>(i);
-        }
+// ==================== CSV 加载 ====================
+
+std::shared_ptr<LiteCsvLoader> LiteTable::loadCsv(const std::string& path, const CsvLoadOptions& options) {
+    auto model = std::make_shared<LiteColumnarTableModel>();
+    auto loader = std::make_shared<LiteCsvLoader>();
+    if (!loader->open(path, model, options)) return nullptr;
+
+    setModel(model);
+    clearColumns();
+    const auto& names = loader->getColumnNames();
+    const auto& types = loader->getColumnTypes();
+    for (size_t col = 0; col < names.size(); ++col) {
+        bool numeric = types[col] == ColumnType::Int64 || types[col] == ColumnType::Double;
+        addColumn(names[col], 120.0f, numeric ? TextAlign::Right : TextAlign::Left);
     }
-    return -1;
+    m_csvLoader = loader;
+    markDirty();
+    return loader;
 }
 
-std::vector<int> LiteTable::getSelectedRows() const {
-    std::vector<int> indices;
-    for (size_t i = 0; i < m_rows.size(); ++i) {
-        if (m_rows[i].selected) {
-            indices.push_back(static_cast<int>(i));
-        }
+// ==================== 流式写入 ====================
+
+std::shared_ptr<LiteTable::RowQueue> LiteTable::getRowQueue() {
+    if (!m_rowQueue) {
+        m_rowQueue = std::make_shared<RowQueue>();
     }
-    return indices;
+    return m_rowQueue;
 }
 
-void LiteTable::clearSelection() {
-    for (auto& row : m_rows) {
-        row.selected = false;
+void LiteTable::setMaxRowCount(size_t count) {
+    m_maxRowCount = count;
+    trimRows(0);
+}
+
+void LiteTable::drainRowQueue() {
+    if (!m_rowQueue || m_rowQueue->empty()) return;
+
+    std::vector<std::vector<std::string>> rows;
+    m_rowQueue->drain(rows);
+    auto* model = activeRowModel();
+    if (rows.empty() || !model) return;
+
+    bool follow = m_autoScrollToTail && isAtBottom();
+    bool modelOrder = m_sortOrder.empty() && !m_filterActive && !isGrouped();
+
+    // 本批超出保留行数的部分直接丢弃，不进入模型
+    if (m_maxRowCount > 0 && rows.size() > m_maxRowCount) {
+        rows.erase(rows.begin(), rows.end() - static_cast<std::ptrdiff_t>(m_maxRowCount));
+    }
+    // 删除头部行前记下其高度，未跟随底部时保持视口内容不动
+    float removedHeight = 0;
+    if (!follow && modelOrder && m_maxRowCount > 0) {
+        size_t total = getRowCount() + rows.size();
+        if (total > m_maxRowCount) {
+            removedHeight = rowHeights().getOffset(total - m_maxRowCount);
+        }
+    }
+    trimRows(rows.size());
+    model->addRows(std::move(rows));
+
+    if (follow) {
+        m_scrollY = getContentHeight();
+    } else {
+        m_scrollY -= removedHeight;
     }
+    clampScroll();
     markDirty();
 }
 
+size_t LiteTable::trimRows(size_t incoming) {
+    auto* model = activeRowModel();
+    if (!model || m_maxRowCount == 0) return 0;
+    size_t total = model->getRowCount() + incoming;
+    if (total <= m_maxRowCount) return 0;
+    size_t excess = std::min(total - m_maxRowCount, model->getRowCount());
+    model->removeRows(0, excess);
+    return excess;
+}
+
+bool LiteTable::isAtBottom() const {
+    // 与 clampScroll 的最大滚动距离一致
+    float maxScrollY = std::max(0.0f, getContentHeight() - getViewportHeight());
+    return m_scrollY >= maxScrollY - 1.0f;
+}
+
 // 回调
 void LiteTable::setOnSelectionChanged(SelectionChangedCallback callback) {
     m_onSelectionChanged = callback;
@@ -235,40 +1534,95 @@ void LiteTable::setOnCellClicked(std::function<void(int, int)> callback) {
     m_onCellClicked = callback;
 }
 
+void LiteTable::setOnSortChanged(std::function<void()> callback) {
+    m_onSortChanged = callback;
+}
+
+void LiteTable::setOnFilterChanged(std::function<void()> callback) {
+    m_onFilterChanged = callback;
+}
+
 // 辅助方法
 int LiteTable::getRowIndexAtY(float y) const {
-    if (m_rows.empty() || m_rowHeight <= 0) return -1;
+    size_t rowCount = getVisibleRowCount();
+    if (rowCount == 0 || y < 0) return -1;
     
     // y 是相对于内容区域的坐标（已经考虑了滚动偏移）
-    int index = static_cast<int>(y / m_rowHeight);
+    size_t index = rowHeights().getRowAt(y);
     
-    if (index < 0 || index >= static_cast<int>(m_rows.size())) {
+    if (index >= rowCount) {
         return -1;
     }
-    return index;
+    return static_cast<int>(index);
 }
 
 int LiteTable::getColumnIndexAtX(float x) const {
     if (m_columns.empty()) return -1;
-    
-    // x 是相对于内容区域的坐标（已经考虑了滚动偏移）
-    float currentX = 0;
-    
-    for (size_t i = 0; i < m_columns.size(); ++i) {
-        if (x >= currentX && x < currentX + m_columns[i].width) {
-            return static_cast<int>(i);
+
+    // x 是相对于内容区域的坐标（已经考虑了滚动偏移），在列边界上二分查找
+    const auto& offsets = columnOffsets();
+    if (x < 0 || x >= offsets.back()) return -1;
+    auto it = std::upper_bound(offsets.begin(), offsets.end(), x);
+    return static_cast<int>(it - offsets.begin()) - 1;
+}
+
+const std::vector<float>& LiteTable::columnOffsets() const {
+    if (m_columnOffsetsDirty) {
+        m_columnOffsets.resize(m_columns.size() + 1);
+        m_columnOffsets[0] = 0;
+        for (size_t i = 0; i < m_columns.size(); ++i) {
+            m_columnOffsets[i + 1] = m_columnOffsets[i] + std::max(0.0f, m_columns[i].width);
         }
-        currentX += m_columns[i].width;
+        m_columnOffsetsDirty = false;
     }
-    return -1;
+    return m_columnOffsets;
 }
 
-float LiteTable::getTotalColumnWidth() const {
-    float total = 0;
-    for (const auto& col : m_columns) {
-        total += col.width;
+bool LiteTable::getVisibleColumns(float left, float right, size_t& first, size_t& last) const {
+    const auto& offsets = columnOffsets();
+    if (m_columns.empty() || right <= left || right <= 0 || left >= offsets.back()) return false;
+
+    // 与 [left, right) 相交的列
+    auto begin = std::upper_bound(offsets.begin(), offsets.end(), std::max(left, 0.0f));
+    auto end = std::lower_bound(offsets.begin(), offsets.end(), right);
+    first = static_cast<size_t>(begin - offsets.begin()) - 1;
+    last = std::min(static_cast<size_t>(end - offsets.begin()), m_columns.size()) - 1;
+    return first <= last;
+}
+
+size_t LiteTable::frozenColumnCount() const {
+    return std::min(m_frozenColumns, m_columns.size());
+}
+
+float LiteTable::frozenWidth() const {
+    return columnOffsets()[frozenColumnCount()];
+}
+
+float LiteTable::viewportXToContentX(float x) const {
+    return x < std::min(frozenWidth(), getViewportWidth()) ? x : x + m_scrollX;
+}
+
+bool LiteTable::getVisibleRows(size_t& first, size_t& last) {
+    size_t rowCount = getVisibleRowCount();
+    if (rowCount == 0) return false;
+
+    float viewportH = bodyHeight();
+    const auto& heights = rowHeights();
+    first = heights.getRowAt(std::max(0.0f, m_scrollY));
+    if (first >= rowCount) return false;
+    if (m_rowHeightProvider) {
+        measureRows(first, m_scrollY + viewportH);
     }
-    return total;
+    last = std::min(rowCount - 1, heights.getRowAt(m_scrollY + viewportH));
+    return first <= last;
+}
+
+float LiteTable::bodyHeight() const {
+    return getViewportHeight() - (m_showHeader ? m_headerHeight : 0) - footerHeight();
+}
+
+float LiteTable::getTotalColumnWidth() const {
+    return columnOffsets().back();
 }
 
 float LiteTable::getContentWidth() const {
@@ -276,8 +1630,8 @@ float LiteTable::getContentWidth() const {
 }
 
 float LiteTable::getContentHeight() const {
-    // 内容高度 = 行数 × 行高（不包括表头，表头是固定的）
-    return m_rows.size() * m_rowHeight;
+    // 内容高度 = 显示行的行高之和（不包括表头，表头是固定的），页脚占用的高度需要额外滚动
+    return rowHeights().getTotalHeight() + footerHeight();
 }
 
 void LiteTable::render(SkCanvas* canvas) {
@@ -306,32 +1660,52 @@ void LiteTable::renderTree(SkCanvas* canvas) {
     float viewportW = getViewportWidth();
     float viewportH = getViewportHeight();
 
+    // 冻结列占据视口左侧，其余列在右侧的区域中水平滚动
+    size_t frozen = frozenColumnCount();
+    float frozenW = std::min(frozenWidth(), viewportW);
+    size_t firstColumn = 0, lastColumn = 0;
+    bool hasColumns = getVisibleColumns(m_scrollX + frozenW, m_scrollX + viewportW, firstColumn, lastColumn);
+    firstColumn = std::max(firstColumn, frozen);
+    hasColumns = hasColumns && firstColumn <= lastColumn;
+
     // 如果显示表头，绘制固定表头
     if (m_showHeader) {
         canvas->save();
         
         // 裁剪表头区域
-        SkRect headerClip = SkRect::MakeXYWH(contentX, contentY, viewportW, m_headerHeight);
+        SkRect headerClip = SkRect::MakeXYWH(contentX + frozenW, contentY, viewportW - frozenW, m_headerHeight);
         canvas->clipRect(headerClip, SkClipOp::kIntersect, true);
         
         // 平移 canvas（只水平滚动，垂直不滚动）
         canvas->translate(contentX - m_scrollX, contentY);
         
         // 绘制表头
-        drawHeader(canvas);
+        if (hasColumns) {
+            drawHeader(canvas, firstColumn, lastColumn);
+        }
         
         canvas->restore();
+
+        // 冻结列的表头不滚动
+        if (frozen > 0) {
+            canvas->save();
+            canvas->clipRect(SkRect::MakeXYWH(contentX, contentY, frozenW, m_headerHeight), SkClipOp::kIntersect, true);
+            canvas->translate(contentX, contentY);
+            drawHeader(canvas, 0, frozen - 1);
+            canvas->restore();
+        }
         
         // 调整内容区域的起始位置
         contentY += m_headerHeight;
         viewportH -= m_headerHeight;
     }
+    viewportH -= footerHeight();
 
     // 绘制表格内容（可滚动区域）
     canvas->save();
     
     // 裁剪内容区域
-    SkRect contentClip = SkRect::MakeXYWH(contentX, contentY, viewportW, viewportH);
+    SkRect contentClip = SkRect::MakeXYWH(contentX + frozenW, contentY, viewportW - frozenW, viewportH);
     canvas->clipRect(contentClip, SkClipOp::kIntersect, true);
     
     // 平移 canvas 以实现滚动效果
@@ -342,6 +1716,37 @@ void LiteTable::renderTree(SkCanvas* canvas) {
     
     canvas->restore();
 
+    // 冻结列只随垂直滚动
+    size_t firstRow = 0, lastRow = 0;
+    if (frozen > 0 && getVisibleRows(firstRow, lastRow)) {
+        canvas->save();
+        canvas->clipRect(SkRect::MakeXYWH(contentX, contentY, frozenW, viewportH), SkClipOp::kIntersect, true);
+        canvas->translate(contentX, contentY - m_scrollY);
+        drawBody(canvas, firstRow, lastRow, 0, frozen - 1);
+        canvas->restore();
+    }
+
+    // 页脚固定在行区域下方，与表头一样只随水平滚动
+    if (m_showFooter) {
+        float footerY = contentY + viewportH;
+        float footerH = footerHeight();
+        if (hasColumns) {
+            canvas->save();
+            canvas->clipRect(SkRect::MakeXYWH(contentX + frozenW, footerY, viewportW - frozenW, footerH),
+                             SkClipOp::kIntersect, true);
+            canvas->translate(contentX - m_scrollX, footerY);
+            drawFooter(canvas, firstColumn, lastColumn);
+            canvas->restore();
+        }
+        if (frozen > 0) {
+            canvas->save();
+            canvas->clipRect(SkRect::MakeXYWH(contentX, footerY, frozenW, footerH), SkClipOp::kIntersect, true);
+            canvas->translate(contentX, footerY);
+            drawFooter(canvas, 0, frozen - 1);
+            canvas->restore();
+        }
+    }
+
     // 绘制滚动条（在裁剪区域之外）
     if (m_showScrollbar) {
         drawScrollbar(canvas);
@@ -352,75 +1757,69 @@ void LiteTable::renderTree(SkCanvas* canvas) {
 }
 
 void LiteTable::renderContent(SkCanvas* canvas) {
-    if (m_rows.empty()) return;
-
-    float viewportH = getViewportHeight() - (m_showHeader ? m_headerHeight : 0);
-    
-    // 计算可见范围
-    int firstVisible = static_cast<int>(m_scrollY / m_rowHeight);
-    int lastVisible = static_cast<int>((m_scrollY + viewportH) / m_rowHeight);
-    
-    firstVisible = std::max(0, firstVisible);
-    lastVisible = std::min(static_cast<int>(m_rows.size()) - 1, lastVisible);
+    // 计算可见范围（只向模型查询这些行）
+    size_t firstVisible = 0, lastVisible = 0;
+    if (!getVisibleRows(firstVisible, lastVisible)) return;
 
-    // 绘制可见行
-    for (int i = firstVisible; i <= lastVisible; ++i) {
-        float rowY = i * m_rowHeight;
-        drawRow(canvas, i, rowY);
+    // 只绘制与滚动区域相交的列（冻结列由 renderTree 单独绘制）
+    size_t frozen = frozenColumnCount();
+    float viewportW = getViewportWidth();
+    float frozenW = std::min(frozenWidth(), viewportW);
+    size_t firstColumn = 0, lastColumn = 0;
+    bool hasColumns = getVisibleColumns(m_scrollX + frozenW, m_scrollX + viewportW, firstColumn, lastColumn);
+    firstColumn = std::max(firstColumn, frozen);
+
+    hasColumns = hasColumns && firstColumn <= lastColumn;
+    if (hasColumns) {
+        drawBody(canvas, firstVisible, lastVisible, firstColumn, lastColumn);
     }
 
-    // 绘制网格线
-    if (m_showGrid) {
-        drawGrid(canvas);
-    }
+    // 根据滚动速度在后台整形即将进入视口的行（只整形冻结列与当前可见的列）
+    size_t columnCount = std::min(m_columns.size(), m_model->getColumnCount());
+    size_t frozenEnd = std::min(frozen, columnCount);
+    size_t visibleEnd = hasColumns ? std::min(lastColumn + 1, columnCount) : 0;
+    m_prefetcher.update(m_scrollY, m_rowHeight, firstVisible, lastVisible, getVisibleRowCount(), getFontSpec(),
+                        [this, frozenEnd, firstColumn, visibleEnd](size_t row, std::vector<std::string>& texts) {
+                            size_t modelRow = getModelRow(row);
+                            if (modelRow >= m_model->getRowCount()) return;   // 组头行
+                            for (size_t col = 0; col < frozenEnd; ++col) {
+                                if (usesShapedText(col)) texts.push_back(m_model->getCellText(modelRow, col));
+                            }
+                            for (size_t col = firstColumn; col < visibleEnd; ++col) {
+                                if (usesShapedText(col)) texts.push_back(m_model->getCellText(modelRow, col));
+                            }
+                        });
 }
 
-void LiteTable::drawHeader(SkCanvas* canvas) {
-    float totalWidth = getTotalColumnWidth();
+void LiteTable::drawHeader(SkCanvas* canvas, size_t firstColumn, size_t lastColumn) {
+    // 表头背景与底部边框只覆盖 [firstColumn, lastColumn]
+    const auto& offsets = columnOffsets();
+    float left = offsets[firstColumn];
+    float right = offsets[lastColumn + 1];
 
     // 绘制表头背景
     SkPaint bgPaint;
     bgPaint.setColor(m_headerBgColor.toARGB());
     bgPaint.setStyle(SkPaint::kFill_Style);
-    canvas->drawRect(SkRect::MakeXYWH(0, 0, totalWidth, m_headerHeight), bgPaint);
+    canvas->drawRect(SkRect::MakeLTRB(left, 0, right, m_headerHeight), bgPaint);
 
-    // 绘制表头单元格
-    float currentX = 0;
-    for (size_t i = 0; i < m_columns.size(); ++i) {
+    // 绘制与视口相交的表头单元格
+    for (size_t i = firstColumn; i <= lastColumn; ++i) {
         const auto& col = m_columns[i];
-        
-        // 绘制表头文本
-        if (!col.title.empty()) {
-            auto& fontMgr = getFontManager();
-            auto fontCollection = fontMgr.getFontCollection();
-
-            skia::textlayout::TextAlign skAlign;
-            switch (col.align) {
-                case TextAlign::Left: skAlign = skia::textlayout::TextAlign::kLeft; break;
-                case TextAlign::Center: skAlign = skia::textlayout::TextAlign::kCenter; break;
-                case TextAlign::Right: skAlign = skia::textlayout::TextAlign::kRight; break;
-            }
-
-            ParagraphStyle paraStyle;
-            paraStyle.setTextAlign(skAlign);
-            paraStyle.setMaxLines(1);
-
-            auto textStyle = fontMgr.createTextStyle(m_headerTextColor, getFontSize(), getFontFamily());
-
-            auto builder = ParagraphBuilder::make(paraStyle, fontCollection);
-            builder->pushStyle(textStyle);
-            builder->addText(col.title.c_str());
-
-            auto paragraph = builder->Build();
-            paragraph->layout(col.width - m_cellPadding * 2);
-
-            float textHeight = paragraph->getHeight();
-            float textY = (m_headerHeight - textHeight) / 2;
+        float currentX = offsets[i];
 
-            paragraph->paint(canvas, currentX + m_cellPadding, textY);
+        // 绘制表头文本（排序列为指示器留出空间）
+        bool sorted = findSortKey(i) >= 0;
+        float textWidth = col.width - m_cellPadding * 2 - (sorted ? kSortIndicatorWidth : 0);
+        if (!col.title.empty()) {
+            LiteTextRenderer::getInstance().drawSingleLine(
+                canvas, col.title, getFontSpec(), m_headerTextColor,
+                currentX + m_cellPadding, 0, textWidth, m_headerHeight,
+                col.align, false);
+        }
+        if (sorted) {
+            drawSortIndicator(canvas, i, currentX, col.width);
         }
-
-        currentX += col.width;
     }
 
     // 绘制表头底部边框
@@ -428,109 +1827,280 @@ void LiteTable::drawHeader(SkCanvas* canvas) {
     borderPaint.setColor(m_gridColor.toARGB());
     borderPaint.setStyle(SkPaint::kStroke_Style);
     borderPaint.setStrokeWidth(1.0f);
-    canvas->drawLine(0, m_headerHeight, totalWidth, m_headerHeight, borderPaint);
+    canvas->drawLine(left, m_headerHeight, right, m_headerHeight, borderPaint);
+}
+
+void LiteTable::drawSortIndicator(SkCanvas* canvas, size_t column, float x, float width) {
+    int index = findSortKey(column);
+    if (index < 0) return;
+
+    SkPaint arrowPaint;
+    arrowPaint.setAntiAlias(true);
+    arrowPaint.setColor(m_headerTextColor.toARGB());
+    arrowPaint.setStyle(SkPaint::kStroke_Style);
+    arrowPaint.setStrokeWidth(1.5f);
+
+    float arrowX = x + width - m_cellPadding - 4;
+    float arrowY = m_headerHeight / 2;
+    float tip = m_sortKeys[index].ascending ? -2.0f : 2.0f;
+    canvas->drawLine(arrowX - 4, arrowY - tip, arrowX, arrowY + tip, arrowPaint);
+    canvas->drawLine(arrowX, arrowY + tip, arrowX + 4, arrowY - tip, arrowPaint);
+
+    // 多列排序时在箭头前标出优先级
+    if (m_sortKeys.size() > 1) {
+        FontSpec font = getFontSpec();
+        font.fontSize = std::max(8.0f, font.fontSize * 0.7f);
+        LiteTextRenderer::getInstance().drawSingleLine(
+            canvas, std::to_string(index + 1), font, m_headerTextColor,
+            arrowX - 4 - kSortIndicatorWidth, 0, kSortIndicatorWidth - 2, m_headerHeight,
+            TextAlign::Right, false);
+    }
 }
 
-void LiteTable::drawRow(SkCanvas* canvas, size_t index, float y) {
-    if (index >= m_rows.size()) return;
+void LiteTable::drawBody(SkCanvas* canvas, size_t firstRow, size_t lastRow, size_t firstColumn, size_t lastColumn) {
+    // 绘制可见行
+    const auto& heights = rowHeights();
+    float rowY = heights.getOffset(firstRow);
+    for (size_t i = firstRow; i <= lastRow; ++i) {
+        float height = heights.getHeight(i);
+        drawRow(canvas, i, rowY, height, firstColumn, lastColumn);
+        rowY += height;
+    }
+
+    // 绘制网格线
+    if (m_showGrid) {
+        drawGrid(canvas, firstRow, lastRow, firstColumn, lastColumn);
+    }
+}
 
-    const TableRow& row = m_rows[index];
-    float totalWidth = getTotalColumnWidth();
+void LiteTable::drawRow(SkCanvas* canvas, size_t index, float y, float height, size_t firstColumn, size_t lastColumn) {
+    if (index >= getVisibleRowCount()) return;
+
+    // 行背景只覆盖可见列
+    const auto& offsets = columnOffsets();
+    float left = offsets[firstColumn];
+    float rowWidth = offsets[lastColumn + 1] - left;
+    // index 为视图行，数据与选择按模型行查询
+    size_t modelRow = getModelRow(index);
+    if (modelRow >= m_model->getRowCount()) {
+        // 组头行（或模型变化后尚未重新分组的行）
+        int group = getGroupAt(index);
+        if (group >= 0) {
+            drawGroupRow(canvas, static_cast<size_t>(group), y, height, firstColumn, lastColumn);
+        }
+        return;
+    }
 
     // 绘制行背景
     SkPaint bgPaint;
     bgPaint.setStyle(SkPaint::kFill_Style);
 
-    if (row.selected) {
+    if (m_selection.isSelected(modelRow)) {
         bgPaint.setColor(m_selectedRowColor.toARGB());
-        canvas->drawRect(SkRect::MakeXYWH(0, y, totalWidth, m_rowHeight), bgPaint);
+        canvas->drawRect(SkRect::MakeXYWH(left, y, rowWidth, height), bgPaint);
     } else if (static_cast<int>(index) == m_hoverRow) {
         bgPaint.setColor(m_hoverRowColor.toARGB());
-        canvas->drawRect(SkRect::MakeXYWH(0, y, totalWidth, m_rowHeight), bgPaint);
+        canvas->drawRect(SkRect::MakeXYWH(left, y, rowWidth, height), bgPaint);
     } else if (m_showAlternateRows && index % 2 == 1) {
         bgPaint.setColor(m_alternateRowColor.toARGB());
-        canvas->drawRect(SkRect::MakeXYWH(0, y, totalWidth, m_rowHeight), bgPaint);
+        canvas->drawRect(SkRect::MakeXYWH(left, y, rowWidth, height), bgPaint);
     }
 
-    // 绘制单元格
-    float currentX = 0;
-    for (size_t i = 0; i < m_columns.size(); ++i) {
+    // 绘制可见单元格（只查询模型中存在的列）
+    size_t columnCount = std::min(m_columns.size(), m_model->getColumnCount());
+    for (size_t i = firstColumn; i <= lastColumn && i < columnCount; ++i) {
         const auto& col = m_columns[i];
-        
-        if (i < row.cells.size()) {
-            drawCell(canvas, row.cells[i], currentX, y, col.width, m_rowHeight, col.align);
+        if (col.renderer) {
+            drawRendererCell(canvas, *col.renderer, modelRow, i, offsets[i], y, col.width, height, col.align);
+        } else {
+            drawCell(canvas, m_model->getCellText(modelRow, i), m_model->getCellStyle(modelRow, i),
+                     offsets[i], y, col.width, height, col.align);
         }
-        
-        currentX += col.width;
     }
 }
 
-void LiteTable::drawCell(SkCanvas* canvas, const TableCell& cell, float x, float y, 
-                         float width, float height, TextAlign align) {
-    // 绘制单元格背景
-    if (cell.backgroundColor.a > 0) {
+void LiteTable::drawRendererCell(SkCanvas* canvas, LiteCellRenderer& renderer, size_t modelRow, size_t col,
+                                 float x, float y, float width, float height, TextAlign align) {
+    // 单元格背景与文本颜色仍按模型样式
+    TableCellStyle style = m_model->getCellStyle(modelRow, col);
+    if (style.backgroundColor.a > 0) {
         SkPaint bgPaint;
-        bgPaint.setColor(cell.backgroundColor.toARGB());
+        bgPaint.setColor(style.backgroundColor.toARGB());
         bgPaint.setStyle(SkPaint::kFill_Style);
         canvas->drawRect(SkRect::MakeXYWH(x, y, width, height), bgPaint);
     }
 
-    // 绘制单元格文本
-    if (!cell.text.empty()) {
-        auto& fontMgr = getFontManager();
-        auto fontCollection = fontMgr.getFontCollection();
+    CellRenderContext context;
+    context.model = m_model.get();
+    context.row = modelRow;
+    context.col = col;
+    context.x = x;
+    context.y = y;
+    context.width = width;
+    context.height = height;
+    context.padding = m_cellPadding;
+    context.font = getFontSpec();
+    context.textColor = (style.textColor.a > 0) ? style.textColor : getTextColor();
+    context.align = align;
+    context.selected = m_selection.isSelected(modelRow);
+
+    canvas->save();
+    canvas->clipRect(SkRect::MakeXYWH(x, y, width, height));
+    renderer.draw(canvas, context);
+    canvas->restore();
+}
 
-        skia::textlayout::TextAlign skAlign;
-        switch (align) {
-            case TextAlign::Left: skAlign = skia::textlayout::TextAlign::kLeft; break;
-            case TextAlign::Center: skAlign = skia::textlayout::TextAlign::kCenter; break;
-            case TextAlign::Right: skAlign = skia::textlayout::TextAlign::kRight; break;
+void LiteTable::drawGroupRow(SkCanvas* canvas, size_t group, float y, float height,
+                             size_t firstColumn, size_t lastColumn) {
+    const auto& offsets = columnOffsets();
+    SkPaint bgPaint;
+    bgPaint.setColor(m_groupRowColor.toARGB());
+    bgPaint.setStyle(SkPaint::kFill_Style);
+    canvas->drawRect(SkRect::MakeLTRB(offsets[firstColumn], y, offsets[lastColumn + 1], y + height), bgPaint);
+
+    // 第一列：展开/折叠箭头与 "键 (行数)"
+    Color textColor = getTextColor();
+    if (firstColumn == 0) {
+        const std::string& key = m_grouping.getGroupKey(group);
+        SkPaint arrowPaint;
+        arrowPaint.setAntiAlias(true);
+        arrowPaint.setColor(textColor.toARGB());
+        arrowPaint.setStyle(SkPaint::kStroke_Style);
+        arrowPaint.setStrokeWidth(1.5f);
+
+        float arrowX = m_cellPadding + 4;
+        float arrowY = y + height / 2;
+        if (isGroupExpanded(key)) {
+            canvas->drawLine(arrowX - 4, arrowY - 2, arrowX, arrowY + 2, arrowPaint);
+            canvas->drawLine(arrowX, arrowY + 2, arrowX + 4, arrowY - 2, arrowPaint);
+        } else {
+            canvas->drawLine(arrowX - 2, arrowY - 4, arrowX + 2, arrowY, arrowPaint);
+            canvas->drawLine(arrowX + 2, arrowY, arrowX - 2, arrowY + 4, arrowPaint);
         }
 
-        ParagraphStyle paraStyle;
-        paraStyle.setTextAlign(skAlign);
-        paraStyle.setMaxLines(1);
+        float labelX = arrowX + 4 + m_cellPadding;
+        std::string label = key + " (" + std::to_string(m_grouping.getGroupRowCount(group)) + ")";
+        LiteTextRenderer::getInstance().drawSingleLine(
+            canvas, label, getFontSpec(), textColor,
+            labelX, y, m_columns[0].width - labelX - m_cellPadding, height, TextAlign::Left, true);
+    }
+
+    // 其余列：组内聚合值
+    for (size_t col = std::max<size_t>(firstColumn, 1); col <= lastColumn; ++col) {
+        size_t valueIndex = m_grouping.getValueIndex(col);
+        if (valueIndex == SIZE_MAX) continue;
+        drawAggregate(canvas, col, m_grouping.getGroupValue(group, valueIndex), textColor,
+                      offsets[col], y, m_columns[col].width, height);
+    }
+}
+
+void LiteTable::drawFooter(SkCanvas* canvas, size_t firstColumn, size_t lastColumn) {
+    const auto& offsets = columnOffsets();
+    float left = offsets[firstColumn];
+    float right = offsets[lastColumn + 1];
+    float height = footerHeight();
+
+    SkPaint bgPaint;
+    bgPaint.setColor(m_headerBgColor.toARGB());
+    bgPaint.setStyle(SkPaint::kFill_Style);
+    canvas->drawRect(SkRect::MakeLTRB(left, 0, right, height), bgPaint);
+
+    // 全表聚合值
+    for (size_t col = firstColumn; col <= lastColumn; ++col) {
+        size_t valueIndex = m_grouping.getValueIndex(col);
+        if (valueIndex == SIZE_MAX) continue;
+        drawAggregate(canvas, col, m_grouping.getTotal(valueIndex), m_headerTextColor,
+                      offsets[col], 0, m_columns[col].width, height);
+    }
+
+    // 页脚顶部边框
+    SkPaint borderPaint;
+    borderPaint.setColor(m_gridColor.toARGB());
+    borderPaint.setStyle(SkPaint::kStroke_Style);
+    borderPaint.setStrokeWidth(1.0f);
+    canvas->drawLine(left, 0, right, 0, borderPaint);
+}
 
-        Color textColor = (cell.textColor.a > 0) ? cell.textColor : getTextColor();
-        auto textStyle = fontMgr.createTextStyle(textColor, getFontSize(), getFontFamily());
+void LiteTable::drawAggregate(SkCanvas* canvas, size_t col, const TableAggregateValue& value, const Color& color,
+                              float x, float y, float width, float height) {
+    const auto& column = m_columns[col];
+    double number = 0;
+    if (!value.get(column.aggregate, number)) return;
+
+    // 数值渲染器列沿用其格式，计数总是显示为整数
+    LiteNumberCellRenderer::Format format;
+    if (column.aggregate == TableAggregate::Count) {
+        format.decimals = 0;
+    } else if (auto* renderer = dynamic_cast<const LiteNumberCellRenderer*>(column.renderer.get())) {
+        format = renderer->getFormat();
+    }
 
-        auto builder = ParagraphBuilder::make(paraStyle, fontCollection);
-        builder->pushStyle(textStyle);
-        builder->addText(cell.text.c_str());
+    char buffer[96];
+    size_t length = LiteNumberCellRenderer::format(number, format, buffer, sizeof(buffer));
+    float textX = x + m_cellPadding;
+    float textWidth = width - m_cellPadding * 2;
+    if (!LiteNumericText::draw(canvas, buffer, length, getFontSpec(), color, textX, y, textWidth, height)) {
+        LiteTextRenderer::getInstance().drawSingleLine(canvas, std::string(buffer, length), getFontSpec(), color,
+                                                       textX, y, textWidth, height, TextAlign::Right, true);
+    }
+}
 
-        auto paragraph = builder->Build();
-        paragraph->layout(width - m_cellPadding * 2);
+bool LiteTable::usesShapedText(size_t col) const {
+    const auto& renderer = m_columns[col].renderer;
+    return !renderer || renderer->usesShapedText();
+}
 
-        float textHeight = paragraph->getHeight();
-        float textY = y + (height - textHeight) / 2;
+void LiteTable::drawCell(SkCanvas* canvas, const std::string& text, const TableCellStyle& style,
+                         float x, float y, float width, float height, TextAlign align) {
+    // 绘制单元格背景
+    if (style.backgroundColor.a > 0) {
+        SkPaint bgPaint;
+        bgPaint.setColor(style.backgroundColor.toARGB());
+        bgPaint.setStyle(SkPaint::kFill_Style);
+        canvas->drawRect(SkRect::MakeXYWH(x, y, width, height), bgPaint);
+    }
 
-        paragraph->paint(canvas, x + m_cellPadding, textY);
+    // 绘制单元格文本
+    if (!text.empty()) {
+        Color textColor = (style.textColor.a > 0) ? style.textColor : getTextColor();
+        LiteTextRenderer::getInstance().drawSingleLine(
+            canvas, text, getFontSpec(), textColor,
+            x + m_cellPadding, y, width - m_cellPadding * 2, height, align, false);
     }
 }
 
-void LiteTable::drawGrid(SkCanvas* canvas) {
+void LiteTable::drawGrid(SkCanvas* canvas, size_t firstRow, size_t lastRow,
+                         size_t firstColumn, size_t lastColumn) {
     SkPaint gridPaint;
     gridPaint.setColor(m_gridColor.toARGB());
     gridPaint.setStyle(SkPaint::kStroke_Style);
     gridPaint.setStrokeWidth(1.0f);
 
-    float totalWidth = getTotalColumnWidth();
-    float totalHeight = m_rows.size() * m_rowHeight;
-
-    // 绘制水平线
-    for (size_t i = 0; i <= m_rows.size(); ++i) {
-        float y = i * m_rowHeight;
-        canvas->drawLine(0, y, totalWidth, y, gridPaint);
+    // 网格线只覆盖可见行与可见列围成的矩形，合并为一条路径绘制
+    const auto& offsets = columnOffsets();
+    float left = offsets[firstColumn];
+    float right = offsets[lastColumn + 1];
+    const auto& heights = rowHeights();
+    float top = heights.getOffset(firstRow);
+    float bottom = top;
+
+    SkPathBuilder builder;
+    builder.incReserve(static_cast<int>((lastRow - firstRow + lastColumn - firstColumn + 4) * 2));
+
+    // 水平线
+    for (size_t i = firstRow; i <= lastRow + 1; ++i) {
+        builder.moveTo(left, bottom);
+        builder.lineTo(right, bottom);
+        if (i <= lastRow) bottom += heights.getHeight(i);
     }
 
-    // 绘制垂直线
-    float currentX = 0;
-    for (size_t i = 0; i <= m_columns.size(); ++i) {
-        canvas->drawLine(currentX, 0, currentX, totalHeight, gridPaint);
-        if (i < m_columns.size()) {
-            currentX += m_columns[i].width;
-        }
+    // 垂直线
+    for (size_t i = firstColumn; i <= lastColumn + 1; ++i) {
+        builder.moveTo(offsets[i], top);
+        builder.lineTo(offsets[i], bottom);
     }
+
+    canvas->drawPath(builder.detach(), gridPaint);
 }
 
 void LiteTable::onMousePressed(const MouseEvent& event) {
@@ -552,9 +2122,14 @@ void LiteTable::onMousePressed(const MouseEvent& event) {
     float contentX = event.x - borderL - padL;
     float contentY = event.y - borderT - padT;
 
-    // 检查是否点击了表头
+    // 检查是否点击了表头：按该列排序，Shift + 点击追加排序键
     if (m_showHeader && contentY >= 0 && contentY < m_headerHeight) {
-        // 表头点击，可以用于排序等功能
+        if (contentX >= 0 && contentX < getViewportWidth()) {
+            int colIndex = getColumnIndexAtX(viewportXToContentX(contentX));
+            if (colIndex >= 0) {
+                onHeaderClicked(static_cast<size_t>(colIndex), (event.mods & 1) != 0);
+            }
+        }
         return;
     }
 
@@ -568,23 +2143,41 @@ void LiteTable::onMousePressed(const MouseEvent& event) {
         contentY -= m_headerHeight;
     }
 
-    if (contentY < 0 || contentY >= (getViewportHeight() - (m_showHeader ? m_headerHeight : 0))) {
+    if (contentY < 0 || contentY >= bodyHeight()) {
         return;
     }
 
     // 加上滚动偏移，得到实际内容坐标
     float actualY = contentY + m_scrollY;
-    float actualX = contentX + m_scrollX;
+    float actualX = viewportXToContentX(contentX);
     
-    int rowIndex = getRowIndexAtY(actualY);
+    int viewRow = getRowIndexAtY(actualY);
     int colIndex = getColumnIndexAtX(actualX);
 
-    if (rowIndex >= 0 && rowIndex < static_cast<int>(m_rows.size())) {
+    // 点击组头行折叠/展开该组
+    int group = viewRow >= 0 ? getGroupAt(static_cast<size_t>(viewRow)) : -1;
+    if (group >= 0) {
+        std::string key = m_grouping.getGroupKey(static_cast<size_t>(group));
+        setGroupExpanded(key, !isGroupExpanded(key));
+        return;
+    }
+
+    if (viewRow >= 0 && viewRow < static_cast<int>(getVisibleRowCount()) &&
+        getModelRow(static_cast<size_t>(viewRow)) < getRowCount()) {
+        int rowIndex = static_cast<int>(getModelRow(static_cast<size_t>(viewRow)));
         if (m_selectionMode == ListSelectionMode::Single) {
             setSelectedRow(rowIndex);
         } else if (m_selectionMode == ListSelectionMode::Multiple) {
-            m_rows[rowIndex].selected = !m_rows[rowIndex].selected;
-            markDirty();
+            size_t row = static_cast<size_t>(rowIndex);
+            long long anchor = m_selection.getAnchor();
+            int anchorView = anchor >= 0 ? getViewRow(static_cast<size_t>(anchor)) : -1;
+            if ((event.mods & 1) && anchorView >= 0) {
+                // Shift + 点击：按显示顺序选中锚点到当前行
+                selectViewRange(static_cast<size_t>(anchorView), static_cast<size_t>(viewRow));
+            } else {
+                m_selection.toggle(row);
+                m_selection.setAnchor(rowIndex);
+            }
             if (m_onSelectionChanged) {
                 m_onSelectionChanged(rowIndex);
             }
@@ -620,7 +2213,7 @@ void LiteTable::onMouseMoved(const MouseEvent& event) {
 
     // 检查是否在视口范围内
     if (contentX < 0 || contentX >= getViewportWidth() ||
-        contentY < 0 || contentY >= (getViewportHeight() - (m_showHeader ? m_headerHeight : 0))) {
+        contentY < 0 || contentY >= bodyHeight()) {
         if (m_hoverRow != -1) {
             m_hoverRow = -1;
             markDirty();
@@ -0,0 +1,317 @@
+/**
+ * lite_table_filter.cpp - 表格后台筛选实现
+ */
+
+#include "lite_table_filter.h"
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LITE_FILTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace liteDui {
+
+namespace {
+
+// 逐行筛选时每隔多少行检查一次取消标记
+constexpr size_t kCancelCheckRows = 4096;
+
+bool isCancelled(const std::atomic<bool>* cancel) {
+    return cancel && cancel->load(std::memory_order_relaxed);
+}
+
+#ifdef LITE_FILTER_SSE2
+inline int countTrailingZeros32(uint32_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(v);
+#else
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return static_cast<int>(index);
+#endif
+}
+#endif
+
+void appendEntries(LiteTableFilter::TextColumn& column, const std::vector<std::string>& values) {
+    size_t total = 0;
+    for (const auto& value : values) {
+        total += value.size() + 1;
+    }
+    column.text.reserve(total);
+    column.offsets.reserve(values.size() + 1);
+    for (const auto& value : values) {
+        column.offsets.push_back(static_cast<uint32_t>(column.text.size()));
+        column.text += value;
+        column.text.push_back('\0');
+    }
+    column.offsets.push_back(static_cast<uint32_t>(column.text.size()));
+}
+
+size_t entryCount(const LiteTableFilter::TextColumn& column) {
+    return column.offsets.empty() ? 0 : column.offsets.size() - 1;
+}
+
+bool entryContains(const LiteTableFilter::TextColumn& column, size_t entry, const std::string& needle) {
+    const char* text = column.text.data() + column.offsets[entry];
+    size_t length = column.offsets[entry + 1] - column.offsets[entry] - 1;
+    return LiteTableFilter::find(text, length, needle.data(), needle.size()) != SIZE_MAX;
+}
+
+/**
+ * 在 [begin, end) 项的连续缓冲区上查找，每个命中的项回调一次
+ * 命中后直接跳到下一项开头，分隔符 '\0' 保证匹配不会跨项
+ */
+template <typename Fn>
+bool searchEntries(const LiteTableFilter::TextColumn& column, size_t begin, size_t end, const std::string& needle,
+                   Fn&& onMatch, const std::atomic<bool>* cancel) {
+    if (begin >= end) return !isCancelled(cancel);
+    const char* text = column.text.data();
+    size_t length = column.offsets[end];
+    size_t pos = column.offsets[begin];
+    size_t matches = 0;
+    while (pos < length) {
+        size_t hit = LiteTableFilter::find(text + pos, length - pos, needle.data(), needle.size());
+        if (hit == SIZE_MAX) break;
+        hit += pos;
+
+        auto it = std::upper_bound(column.offsets.begin(), column.offsets.end(), static_cast<uint32_t>(hit));
+        size_t entry = static_cast<size_t>(it - column.offsets.begin()) - 1;
+        onMatch(entry);
+        pos = column.offsets[entry + 1];
+
+        if (++matches % kCancelCheckRows == 0 && isCancelled(cancel)) return false;
+    }
+    return !isCancelled(cancel);
+}
+
+} // namespace
+
+// ==================== 查找 ====================
+
+void LiteTableFilter::foldCase(std::string& text) {
+    for (auto& c : text) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c + ('a' - 'A'));
+    }
+}
+
+size_t LiteTableFilter::find(const char* haystack, size_t length, const char* needle, size_t needleLength) {
+    if (needleLength == 0) return 0;
+    if (needleLength > length) return SIZE_MAX;
+    if (needleLength == 1) {
+        const void* hit = std::memchr(haystack, needle[0], length);
+        return hit ? static_cast<size_t>(static_cast<const char*>(hit) - haystack) : SIZE_MAX;
+    }
+
+    // 可能的起点数
+    size_t limit = length - needleLength + 1;
+    size_t i = 0;
+
+#ifdef LITE_FILTER_SSE2
+    // 同时比较 16 个起点的首字节和末字节，两者都相等的位置再逐字节确认
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+    for (; i + 16 <= limit; i += 16) {
+        __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+        __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needleLength - 1));
+        __m128i equal = _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+        while (mask) {
+            size_t offset = i + countTrailingZeros32(mask);
+            if (std::memcmp(haystack + offset + 1, needle + 1, needleLength - 2) == 0) {
+                return offset;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    std::string_view rest(haystack + i, length - i);
+    size_t hit = rest.find(std::string_view(needle, needleLength));
+    return hit == std::string_view::npos ? SIZE_MAX : i + hit;
+}
+
+// ==================== 快照 ====================
+
+std::shared_ptr<LiteTableFilter::TextColumn> LiteTableFilter::makeColumn(const LiteTableModel& model, size_t col,
+                                                                         size_t first, size_t count,
+                                                                         bool caseSensitive) {
+    TableSortColumn source;
+    model.getSortColumn(col, first, count, source);
+
+    auto column = std::make_shared<TextColumn>();
+    if (source.kind == TableSortColumn::Kind::Dictionary) {
+        column->dictionary = true;
+        appendEntries(*column, source.strings);
+        column->codes = std::move(source.codes);
+        // null 行不匹配任何字典项
+        for (size_t row = 0; row < source.nulls.size() && row < column->codes.size(); ++row) {
+            if (source.nulls[row]) column->codes[row] = UINT32_MAX;
+        }
+    } else if (source.kind == TableSortColumn::Kind::Text) {
+        appendEntries(*column, source.strings);
+    } else {
+        // 数值列按显示文本搜索
+        std::vector<std::string> texts;
+        texts.reserve(count);
+        for (size_t row = first; row < first + count; ++row) {
+            texts.push_back(model.getCellText(row, col));
+        }
+        appendEntries(*column, texts);
+    }
+
+    if (!caseSensitive) {
+        foldCase(column->text);
+    }
+    return column;
+}
+
+std::shared_ptr<LiteTableFilter::Snapshot> LiteTableFilter::makeSnapshot(const LiteTableModel& model,
+                                                                         const std::vector<size_t>& columns,
+                                                                         bool caseSensitive) {
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->rowCount = model.getRowCount();
+    snapshot->caseSensitive = caseSensitive;
+
+    size_t columnCount = model.getColumnCount();
+    std::vector<size_t> ids = columns;
+    if (ids.empty()) {
+        for (size_t col = 0; col < columnCount; ++col) ids.push_back(col);
+    }
+
+    for (size_t col : ids) {
+        if (col >= columnCount) continue;
+        ColumnSnapshot column;
+        snapshot->columns.push_back(column.publish(snapshot->rowCount, [&](size_t first, size_t count) {
+            return makeColumn(model, col, first, count, caseSensitive);
+        }));
+    }
+    return snapshot;
+}
+
+// ==================== 同步筛选 ====================
+
+bool LiteTableFilter::filter(const Query& query, RowList& rows, const std::atomic<bool>* cancel) {
+    rows.clear();
+    size_t rowCount = query.rowCount;
+    const RowList* candidates = query.candidates.get();
+
+    auto accept = [&](size_t row) {
+        if (!query.predicate || query.predicate(row)) {
+            rows.push_back(static_cast<uint32_t>(row));
+        }
+    };
+
+    // 只有谓词：逐行调用
+    if (query.text.empty() || !query.snapshot) {
+        size_t count = candidates ? candidates->size() : rowCount;
+        for (size_t i = 0; i < count; ++i) {
+            size_t row = candidates ? (*candidates)[i] : i;
+            if (row >= rowCount) break;
+            accept(row);
+            if (i % kCancelCheckRows == 0 && isCancelled(cancel)) return false;
+        }
+        return !isCancelled(cancel);
+    }
+
+    const Snapshot& snapshot = *query.snapshot;
+    rowCount = std::min(rowCount, snapshot.rowCount);
+    std::string needle = query.text;
+    if (!snapshot.caseSensitive) {
+        foldCase(needle);
+    }
+
+    // 任意一列包含查询文本即匹配；每列按块查找，part 的第 i 项为第 first + i 行
+    std::vector<uint8_t> matched(rowCount, 0);
+    std::vector<uint8_t> codeMatched;
+    for (const auto& data : snapshot.columns) {
+        if (!data) continue;
+        const TextColumn* dictionaryBlock = nullptr;
+        for (const auto& part : data->parts) {
+            if (part.first >= rowCount) break;
+            if (isCancelled(cancel)) return false;
+
+            const TextColumn& block = *part.block;
+            size_t count = std::min(part.count, rowCount - part.first);
+
+            // 落在这一段中的候选行
+            const uint32_t* candidateBegin = nullptr;
+            const uint32_t* candidateEnd = nullptr;
+            if (candidates) {
+                candidateBegin = std::lower_bound(candidates->data(), candidates->data() + candidates->size(),
+                                                  static_cast<uint32_t>(part.first));
+                candidateEnd = std::lower_bound(candidateBegin, candidates->data() + candidates->size(),
+                                                static_cast<uint32_t>(part.first + count));
+                if (candidateBegin == candidateEnd) continue;
+            }
+
+            if (block.dictionary) {
+                // 同一块被拆成相邻的几段时只查找一次字典
+                if (dictionaryBlock != &block) {
+                    dictionaryBlock = &block;
+                    codeMatched.assign(entryCount(block), 0);
+                    bool completed = searchEntries(block, 0, entryCount(block), needle, [&](size_t entry) {
+                        codeMatched[entry] = 1;
+                    }, cancel);
+                    if (!completed) return false;
+                }
+
+                auto markRow = [&](size_t row) {
+                    size_t index = part.offset + (row - part.first);
+                    uint32_t code = index < block.codes.size() ? block.codes[index] : UINT32_MAX;
+                    if (code < codeMatched.size() && codeMatched[code]) matched[row] = 1;
+                };
+                if (candidates) {
+                    for (const uint32_t* it = candidateBegin; it != candidateEnd; ++it) markRow(*it);
+                } else {
+                    for (size_t row = part.first; row < part.first + count; ++row) markRow(row);
+                }
+            } else if (candidates) {
+                // 在上一次结果中细化：逐行查找，已匹配的行跳过
+                for (const uint32_t* it = candidateBegin; it != candidateEnd; ++it) {
+                    size_t row = *it;
+                    if (!matched[row] && entryContains(block, part.offset + (row - part.first), needle)) {
+                        matched[row] = 1;
+                    }
+                }
+            } else {
+                bool completed = searchEntries(block, part.offset, part.offset + count, needle, [&](size_t entry) {
+                    matched[part.first + (entry - part.offset)] = 1;
+                }, cancel);
+                if (!completed) return false;
+            }
+        }
+    }
+
+    if (candidates) {
+        for (uint32_t row : *candidates) {
+            if (row < rowCount && matched[row]) accept(row);
+        }
+    } else {
+        for (size_t row = 0; row < rowCount; ++row) {
+            if (matched[row]) accept(row);
+        }
+    }
+    return !isCancelled(cancel);
+}
+
+// ==================== 后台筛选 ====================
+
+void LiteTableFilter::request(uint64_t revision, Query query) {
+    auto job = std::make_shared<Query>(std::move(query));
+    m_task.submit(revision, [job](const std::atomic<bool>& cancel, RowList& rows) {
+        return filter(*job, rows, &cancel);
+    });
+}
+
+void LiteTableFilter::cancel() {
+    m_task.cancel();
+}
+
+} // namespace liteDui
@@ -0,0 +1,485 @@
+/**
+ * lite_table_grouping.cpp - 表格分组与聚合实现
+ */
+
+#include "lite_table_grouping.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LITE_GROUPING_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace liteDui {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+} // namespace
+
+// ==================== TableAggregateValue ====================
+
+bool TableAggregateValue::get(TableAggregate aggregate, double& value) const {
+    switch (aggregate) {
+        case TableAggregate::None:
+            return false;
+        case TableAggregate::Count:
+            value = static_cast<double>(count);
+            return true;
+        case TableAggregate::Sum:
+            value = sum;
+            return true;
+        case TableAggregate::Min:
+            value = min;
+            return count > 0;
+        case TableAggregate::Max:
+            value = max;
+            return count > 0;
+        case TableAggregate::Average:
+            value = count > 0 ? sum / static_cast<double>(count) : 0.0;
+            return count > 0;
+    }
+    return false;
+}
+
+// ==================== LiteTableGrouping ====================
+
+void LiteTableGrouping::configure(int keyColumn, std::vector<size_t> valueColumns) {
+    m_keyColumn = keyColumn;
+    m_valueColumns = std::move(valueColumns);
+    reset();
+}
+
+void LiteTableGrouping::reset() {
+    m_rowGroups.clear();
+    m_values.clear();
+    m_groups.clear();
+    m_groupIndex.clear();
+    m_emptyGroups = 0;
+    m_groupValues.clear();
+    m_groupStale.clear();
+    m_totals.assign(m_valueColumns.size(), TableAggregateValue());
+    m_totalStale.assign(m_valueColumns.size(), 0);
+    m_anyGroupStale = false;
+}
+
+size_t LiteTableGrouping::trackedRowCount() const {
+    return m_keyColumn >= 0 ? m_rowGroups.size() : (m_values.empty() ? 0 : m_values[0].size());
+}
+
+size_t LiteTableGrouping::getValueIndex(size_t column) const {
+    auto it = std::find(m_valueColumns.begin(), m_valueColumns.end(), column);
+    return it != m_valueColumns.end() ? static_cast<size_t>(it - m_valueColumns.begin()) : SIZE_MAX;
+}
+
+int LiteTableGrouping::findGroup(const std::string& key) const {
+    auto it = m_groupIndex.find(key);
+    return it != m_groupIndex.end() ? static_cast<int>(it->second) : -1;
+}
+
+uint32_t LiteTableGrouping::groupFor(const std::string& key) {
+    auto it = m_groupIndex.find(key);
+    if (it != m_groupIndex.end()) return it->second;
+
+    uint32_t group = static_cast<uint32_t>(m_groups.size());
+    m_groups.push_back({key, 0});
+    m_groupIndex.emplace(key, group);
+    ++m_emptyGroups;
+    m_groupValues.resize(m_groupValues.size() + m_valueColumns.size());
+    m_groupStale.resize(m_groupStale.size() + m_valueColumns.size(), 0);
+    return group;
+}
+
+double LiteTableGrouping::readValue(const LiteTableModel& model, size_t row, size_t valueIndex) const {
+    double value = 0;
+    return model.getCellNumber(row, m_valueColumns[valueIndex], value) ? value : kNaN;
+}
+
+void LiteTableGrouping::rebuild(const LiteTableModel& model) {
+    reset();
+    size_t rowCount = model.getRowCount();
+    size_t valueCount = m_valueColumns.size();
+
+    // 组号：字典编码的键列每个字典项只查一次文本
+    if (m_keyColumn >= 0) {
+        size_t keyColumn = static_cast<size_t>(m_keyColumn);
+        m_rowGroups.resize(rowCount);
+        TableSortColumn keys;
+        model.getSortColumn(keyColumn, keys);
+        bool hasNulls = !keys.nulls.empty();
+        if (keys.kind == TableSortColumn::Kind::Dictionary && keys.codes.size() >= rowCount) {
+            std::vector<uint32_t> codeGroups(keys.strings.size(), kNoGroup);
+            for (size_t row = 0; row < rowCount; ++row) {
+                uint32_t code = keys.codes[row];
+                if ((hasNulls && keys.nulls[row]) || code >= codeGroups.size()) {
+                    m_rowGroups[row] = groupFor(model.getCellText(row, keyColumn));
+                    continue;
+                }
+                if (codeGroups[code] == kNoGroup) {
+                    codeGroups[code] = groupFor(model.getCellText(row, keyColumn));
+                }
+                m_rowGroups[row] = codeGroups[code];
+            }
+        } else if (keys.kind == TableSortColumn::Kind::Text && keys.strings.size() >= rowCount) {
+            for (size_t row = 0; row < rowCount; ++row) {
+                // 相邻行键相同（如已按键排序）时省去一次哈希查找
+                m_rowGroups[row] = row > 0 && keys.strings[row] == keys.strings[row - 1]
+                                       ? m_rowGroups[row - 1]
+                                       : groupFor(keys.strings[row]);
+            }
+        } else {
+            for (size_t row = 0; row < rowCount; ++row) {
+                m_rowGroups[row] = groupFor(model.getCellText(row, keyColumn));
+            }
+        }
+        for (uint32_t group : m_rowGroups) {
+            ++m_groups[group].rowCount;
+        }
+        m_emptyGroups = 0;
+    }
+
+    // 数值：数值列直接取列快照，字典列每个字典项只解析一次
+    m_values.assign(valueCount, std::vector<double>());
+    for (size_t v = 0; v < valueCount; ++v) {
+        std::vector<double>& values = m_values[v];
+        TableSortColumn data;
+        model.getSortColumn(m_valueColumns[v], data);
+        switch (data.kind) {
+            case TableSortColumn::Kind::Double:
+                values = std::move(data.doubles);
+                break;
+            case TableSortColumn::Kind::Int64:
+                values.assign(data.ints.begin(), data.ints.end());
+                break;
+            case TableSortColumn::Kind::Dictionary: {
+                values.assign(rowCount, kNaN);
+                std::vector<double> codeValues(data.strings.size(), 0.0);
+                std::vector<uint8_t> parsed(data.strings.size(), 0);
+                for (size_t row = 0; row < rowCount && row < data.codes.size(); ++row) {
+                    uint32_t code = data.codes[row];
+                    if (code >= parsed.size()) continue;
+                    if (!parsed[code]) {
+                        codeValues[code] = readValue(model, row, v);
+                        parsed[code] = 1;
+                    }
+                    values[row] = codeValues[code];
+                }
+                break;
+            }
+            case TableSortColumn::Kind::Text:
+                values.resize(rowCount);
+                for (size_t row = 0; row < rowCount; ++row) {
+                    values[row] = readValue(model, row, v);
+                }
+                break;
+        }
+        values.resize(rowCount, kNaN);
+        if (!data.nulls.empty()) {
+            for (size_t row = 0; row < rowCount && row < data.nulls.size(); ++row) {
+                if (data.nulls[row]) values[row] = kNaN;
+            }
+        }
+
+        aggregate(values.data(), rowCount, m_totals[v]);
+        if (m_keyColumn >= 0) {
+            for (size_t row = 0; row < rowCount; ++row) {
+                double value = values[row];
+                if (value == value) {
+                    add(m_groupValues[m_rowGroups[row] * valueCount + v], value);
+                }
+            }
+        }
+    }
+}
+
+void LiteTableGrouping::rowsInserted(const LiteTableModel& model, size_t first, size_t count) {
+    if (count == 0) return;
+    size_t rowCount = trackedRowCount();
+    first = std::min(first, rowCount);
+    if (m_keyColumn >= 0) {
+        m_rowGroups.insert(m_rowGroups.begin() + first, count, kNoGroup);
+    }
+    for (auto& values : m_values) {
+        values.insert(values.begin() + first, count, kNaN);
+    }
+    loadRows(model, first, count);
+}
+
+void LiteTableGrouping::rowsRemoved(size_t first, size_t count) {
+    size_t rowCount = trackedRowCount();
+    if (first >= rowCount || count == 0) return;
+    size_t end = std::min(first + count, rowCount);
+    for (size_t row = first; row < end; ++row) {
+        subtractRow(row);
+    }
+    if (m_keyColumn >= 0) {
+        m_rowGroups.erase(m_rowGroups.begin() + first, m_rowGroups.begin() + end);
+    }
+    for (auto& values : m_values) {
+        values.erase(values.begin() + first, values.begin() + end);
+    }
+}
+
+void LiteTableGrouping::rowsChanged(const LiteTableModel& model, size_t first, size_t count) {
+    size_t rowCount = trackedRowCount();
+    if (first >= rowCount) return;
+    count = std::min(count, rowCount - first);
+    for (size_t row = first; row < first + count; ++row) {
+        subtractRow(row);
+    }
+    loadRows(model, first, count);
+}
+
+void LiteTableGrouping::rowsRemapped(const LiteTableModel& model, const std::vector<uint32_t>& sources) {
+    size_t rowCount = trackedRowCount();
+
+    // 不再出现的旧行从聚合中减去
+    std::vector<uint8_t> kept(rowCount, 0);
+    for (uint32_t source : sources) {
+        if (source < rowCount) kept[source] = 1;
+    }
+    for (size_t row = 0; row < rowCount; ++row) {
+        if (!kept[row]) subtractRow(row);
+    }
+
+    // 保留行的组号与数值随行移动，聚合不变
+    if (m_keyColumn >= 0) {
+        std::vector<uint32_t> groups(sources.size(), kNoGroup);
+        for (size_t row = 0; row < sources.size(); ++row) {
+            if (sources[row] < rowCount) groups[row] = m_rowGroups[sources[row]];
+        }
+        m_rowGroups.swap(groups);
+    }
+    for (auto& values : m_values) {
+        std::vector<double> moved(sources.size(), kNaN);
+        for (size_t row = 0; row < sources.size(); ++row) {
+            if (sources[row] < rowCount) moved[row] = values[sources[row]];
+        }
+        values.swap(moved);
+    }
+
+    for (size_t row = 0; row < sources.size(); ++row) {
+        if (sources[row] >= rowCount) loadRows(model, row, 1);
+    }
+}
+
+void LiteTableGrouping::loadRows(const LiteTableModel& model, size_t first, size_t count) {
+    for (size_t row = first; row < first + count; ++row) {
+        if (m_keyColumn >= 0) {
+            m_rowGroups[row] = groupFor(model.getCellText(row, static_cast<size_t>(m_keyColumn)));
+        }
+        for (size_t v = 0; v < m_values.size(); ++v) {
+            m_values[v][row] = readValue(model, row, v);
+        }
+        addRow(row);
+    }
+}
+
+void LiteTableGrouping::addRow(size_t row) {
+    size_t valueCount = m_valueColumns.size();
+    uint32_t group = m_keyColumn >= 0 ? m_rowGroups[row] : kNoGroup;
+    if (group != kNoGroup) {
+        if (m_groups[group].rowCount++ == 0) --m_emptyGroups;
+    }
+    for (size_t v = 0; v < valueCount; ++v) {
+        double value = m_values[v][row];
+        if (value != value) continue;
+        add(m_totals[v], value);
+        if (group != kNoGroup) {
+            add(m_groupValues[group * valueCount + v], value);
+        }
+    }
+}
+
+void LiteTableGrouping::subtractRow(size_t row) {
+    size_t valueCount = m_valueColumns.size();
+    uint32_t group = m_keyColumn >= 0 ? m_rowGroups[row] : kNoGroup;
+    if (group != kNoGroup && m_groups[group].rowCount > 0) {
+        if (--m_groups[group].rowCount == 0) ++m_emptyGroups;
+    }
+    for (size_t v = 0; v < valueCount; ++v) {
+        double value = m_values[v][row];
+        if (value != value) continue;
+        subtract(m_totals[v], value, m_totalStale[v]);
+        if (group != kNoGroup) {
+            size_t index = group * valueCount + v;
+            subtract(m_groupValues[index], value, m_groupStale[index]);
+            m_anyGroupStale = m_anyGroupStale || m_groupStale[index];
+        }
+    }
+}
+
+bool LiteTableGrouping::compact() {
+    size_t liveGroups = m_groups.size() - m_emptyGroups;
+    if (m_emptyGroups < kMinCompactGroups || m_emptyGroups * 2 < liveGroups) return false;
+
+    // 有行的组按原顺序前移，聚合值与失效标记随组移动
+    size_t valueCount = m_valueColumns.size();
+    std::vector<uint32_t> remap(m_groups.size(), kNoGroup);
+    size_t out = 0;
+    for (size_t group = 0; group < m_groups.size(); ++group) {
+        if (m_groups[group].rowCount == 0) continue;
+        remap[group] = static_cast<uint32_t>(out);
+        if (out != group) {
+            m_groups[out] = std::move(m_groups[group]);
+            for (size_t v = 0; v < valueCount; ++v) {
+                m_groupValues[out * valueCount + v] = m_groupValues[group * valueCount + v];
+                m_groupStale[out * valueCount + v] = m_groupStale[group * valueCount + v];
+            }
+        }
+        ++out;
+    }
+    m_groups.resize(out);
+    m_groupValues.resize(out * valueCount);
+    m_groupStale.resize(out * valueCount);
+
+    m_groupIndex.clear();
+    m_groupIndex.reserve(out);
+    for (size_t group = 0; group < out; ++group) {
+        m_groupIndex.emplace(m_groups[group].key, static_cast<uint32_t>(group));
+    }
+    for (auto& group : m_rowGroups) {
+        if (group != kNoGroup) group = remap[group];
+    }
+    m_emptyGroups = 0;
+    return true;
+}
+
+void LiteTableGrouping::add(TableAggregateValue& target, double value) {
+    if (target.count == 0) {
+        target.min = value;
+        target.max = value;
+    } else {
+        target.min = std::min(target.min, value);
+        target.max = std::max(target.max, value);
+    }
+    ++target.count;
+    target.sum += value;
+}
+
+void LiteTableGrouping::subtract(TableAggregateValue& target, double value, uint8_t& stale) {
+    if (target.count == 0) return;
+    if (--target.count == 0) {
+        // 清零同时消除累计的舍入误差
+        target = TableAggregateValue();
+        stale = 0;
+        return;
+    }
+    target.sum -= value;
+    // 去掉的是当前极值时无法增量得到新的极值
+    if (value <= target.min || value >= target.max) {
+        stale = 1;
+    }
+}
+
+void LiteTableGrouping::resolve() const {
+    size_t valueCount = m_valueColumns.size();
+
+    if (m_anyGroupStale) {
+        for (size_t v = 0; v < valueCount; ++v) {
+            bool any = false;
+            for (size_t group = 0; group < m_groups.size(); ++group) {
+                size_t index = group * valueCount + v;
+                if (!m_groupStale[index]) continue;
+                m_groupValues[index].min = kInfinity;
+                m_groupValues[index].max = -kInfinity;
+                any = true;
+            }
+            if (!any) continue;
+
+            // 一次扫描重算该列所有失效组的极值
+            const std::vector<double>& values = m_values[v];
+            for (size_t row = 0; row < values.size(); ++row) {
+                size_t index = m_rowGroups[row] * valueCount + v;
+                double value = values[row];
+                if (!m_groupStale[index] || value != value) continue;
+                TableAggregateValue& target = m_groupValues[index];
+                target.min = std::min(target.min, value);
+                target.max = std::max(target.max, value);
+            }
+            for (size_t group = 0; group < m_groups.size(); ++group) {
+                m_groupStale[group * valueCount + v] = 0;
+            }
+        }
+        m_anyGroupStale = false;
+    }
+
+    for (size_t v = 0; v < valueCount; ++v) {
+        if (m_totalStale[v]) {
+            // 全表重算同时消除增量求和的舍入误差
+            aggregate(m_values[v].data(), m_values[v].size(), m_totals[v]);
+            m_totalStale[v] = 0;
+        }
+    }
+}
+
+const TableAggregateValue& LiteTableGrouping::getGroupValue(size_t group, size_t valueIndex) const {
+    resolve();
+    return m_groupValues[group * m_valueColumns.size() + valueIndex];
+}
+
+const TableAggregateValue& LiteTableGrouping::getTotal(size_t valueIndex) const {
+    resolve();
+    return m_totals[valueIndex];
+}
+
+void LiteTableGrouping::aggregate(const double* values, size_t count, TableAggregateValue& out) {
+    size_t valid = 0;
+    double sum = 0.0;
+    double minimum = kInfinity;
+    double maximum = -kInfinity;
+    size_t i = 0;
+
+#ifdef LITE_GROUPING_SSE2
+    // 两组累加器交错处理 4 个 double；NaN 通过有序比较掩码剔除
+    const __m128d inf = _mm_set1_pd(kInfinity);
+    const __m128d negInf = _mm_set1_pd(-kInfinity);
+    __m128d sum0 = _mm_setzero_pd(), sum1 = _mm_setzero_pd();
+    __m128d min0 = inf, min1 = inf;
+    __m128d max0 = negInf, max1 = negInf;
+    for (; i + 4 <= count; i += 4) {
+        __m128d a = _mm_loadu_pd(values + i);
+        __m128d b = _mm_loadu_pd(values + i + 2);
+        __m128d maskA = _mm_cmpord_pd(a, a);
+        __m128d maskB = _mm_cmpord_pd(b, b);
+        sum0 = _mm_add_pd(sum0, _mm_and_pd(maskA, a));
+        sum1 = _mm_add_pd(sum1, _mm_and_pd(maskB, b));
+        min0 = _mm_min_pd(min0, _mm_or_pd(_mm_and_pd(maskA, a), _mm_andnot_pd(maskA, inf)));
+        min1 = _mm_min_pd(min1, _mm_or_pd(_mm_and_pd(maskB, b), _mm_andnot_pd(maskB, inf)));
+        max0 = _mm_max_pd(max0, _mm_or_pd(_mm_and_pd(maskA, a), _mm_andnot_pd(maskA, negInf)));
+        max1 = _mm_max_pd(max1, _mm_or_pd(_mm_and_pd(maskB, b), _mm_andnot_pd(maskB, negInf)));
+        static const uint8_t kBits[4] = {0, 1, 1, 2};
+        valid += kBits[_mm_movemask_pd(maskA)] + kBits[_mm_movemask_pd(maskB)];
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, _mm_add_pd(sum0, sum1));
+    sum = lanes[0] + lanes[1];
+    _mm_store_pd(lanes, _mm_min_pd(min0, min1));
+    minimum = std::min(lanes[0], lanes[1]);
+    _mm_store_pd(lanes, _mm_max_pd(max0, max1));
+    maximum = std::max(lanes[0], lanes[1]);
+#endif
+
+    for (; i < count; ++i) {
+        double value = values[i];
+        if (value != value) continue;
+        ++valid;
+        sum += value;
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+
+    out = TableAggregateValue();
+    out.count = valid;
+    if (valid > 0) {
+        out.sum = sum;
+        out.min = minimum;
+        out.max = maximum;
+    }
+}
+
+} // namespace liteDui
@@ -0,0 +1,365 @@
+/**
+ * lite_table_model.cpp - 表格数据模型实现
+ */
+
+#include "lite_table_model.h"
+#include "lite_keyed_diff.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+namespace liteDui {
+
+namespace {
+
+// setRows 的插入/删除区间超过该数量（或有行需要移动）时改为一次重排通知
+constexpr size_t kMaxRangeChanges = 8;
+
+} // namespace
+
+// ==================== LiteTableModel ====================
+
+size_t LiteTableModel::addListener(ChangeListener listener) {
+    return m_listeners.add(std::move(listener));
+}
+
+void LiteTableModel::removeListener(size_t id) {
+    m_listeners.remove(id);
+}
+
+void LiteTableModel::notify(const TableModelChange& change) {
+    m_listeners.notify(change);
+}
+
+void LiteTableModel::getSortColumn(size_t col, size_t first, size_t count, TableSortColumn& out) const {
+    size_t end = first + std::min(count, getRowCount() - std::min(first, getRowCount()));
+    out.kind = TableSortColumn::Kind::Text;
+    out.strings.clear();
+    out.strings.reserve(end - first);
+    for (size_t row = first; row < end; ++row) {
+        out.strings.push_back(getCellText(row, col));
+    }
+}
+
+bool LiteTableModel::getCellNumber(size_t row, size_t col, double& value) const {
+    std::string text = getCellText(row, col);
+    const char* begin = text.c_str();
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    if (end == begin) return false;
+    // 数值后只允许空白
+    while (*end == ' ' || *end == '\t') ++end;
+    return *end == '\0';
+}
+
+bool LiteTableModel::getCellSeries(size_t row, size_t col, std::vector<double>& values) const {
+    values.clear();
+    std::string text = getCellText(row, col);
+    const char* p = text.c_str();
+    while (*p) {
+        if (*p == ',' || *p == ';' || *p == ' ' || *p == '\t') {
+            ++p;
+            continue;
+        }
+        char* end = nullptr;
+        double value = std::strtod(p, &end);
+        if (end == p) return !values.empty();
+        values.push_back(value);
+        p = end;
+    }
+    return !values.empty();
+}
+
+// ==================== LiteRowTableModel ====================
+
+std::string LiteRowTableModel::getCellText(size_t row, size_t col) const {
+    if (row >= m_rows.size() || col >= m_rows[row].cells.size()) return "";
+    return m_rows[row].cells[col].text;
+}
+
+void LiteRowTableModel::getSortColumn(size_t col, size_t first, size_t count, TableSortColumn& out) const {
+    // 直接读取行存储，省去每格一次虚函数调用和边界检查
+    first = std::min(first, m_rows.size());
+    size_t end = first + std::min(count, m_rows.size() - first);
+    out.kind = TableSortColumn::Kind::Text;
+    out.strings.clear();
+    out.strings.reserve(end - first);
+    for (size_t row = first; row < end; ++row) {
+        const auto& cells = m_rows[row].cells;
+        out.strings.push_back(col < cells.size() ? cells[col].text : std::string());
+    }
+}
+
+TableCellStyle LiteRowTableModel::getCellStyle(size_t row, size_t col) const {
+    TableCellStyle style;
+    if (row < m_rows.size() && col < m_rows[row].cells.size()) {
+        const TableCell& cell = m_rows[row].cells[col];
+        style.textColor = cell.textColor;
+        style.backgroundColor = cell.backgroundColor;
+    }
+    return style;
+}
+
+void LiteRowTableModel::setColumnCount(size_t count) {
+    if (m_columnCount == count) return;
+    m_columnCount = count;
+    invalidateRowKeys();
+    notifyColumnsChanged();
+}
+
+TableRow LiteRowTableModel::makeRow(const std::vector<std::string>& cells) const {
+    TableRow row;
+    size_t count = std::max(cells.size(), m_columnCount);
+    row.cells.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        row.cells.emplace_back(i < cells.size() ? cells[i] : std::string());
+    }
+    return row;
+}
+
+void LiteRowTableModel::invalidateRowKeys() {
+    m_rowKeys.clear();
+    m_rowKeysValid = false;
+}
+
+TableCell* LiteRowTableModel::cellAt(size_t row, size_t col) {
+    if (row >= m_rows.size() || col >= std::max(m_columnCount, m_rows[row].cells.size())) return nullptr;
+    if (col >= m_rows[row].cells.size()) {
+        m_rows[row].cells.resize(m_columnCount);
+    }
+    return &m_rows[row].cells[col];
+}
+
+void LiteRowTableModel::addRow(const std::vector<std::string>& cells) {
+    m_rows.push_back(makeRow(cells));
+    invalidateRowKeys();
+    notifyRowsInserted(m_rows.size() - 1, 1);
+}
+
+void LiteRowTableModel::insertRow(size_t index, const std::vector<std::string>& cells) {
+    if (index > m_rows.size()) {
+        index = m_rows.size();
+    }
+    m_rows.insert(m_rows.begin() + index, makeRow(cells));
+    invalidateRowKeys();
+    notifyRowsInserted(index, 1);
+}
+
+void LiteRowTableModel::removeRow(size_t index) {
+    if (index >= m_rows.size()) return;
+    m_rows.erase(m_rows.begin() + index);
+    invalidateRowKeys();
+    notifyRowsRemoved(index, 1);
+}
+
+void LiteRowTableModel::removeRows(size_t first, size_t count) {
+    if (first >= m_rows.size() || count == 0) return;
+    count = std::min(count, m_rows.size() - first);
+    m_rows.erase(m_rows.begin() + first, m_rows.begin() + first + count);
+    invalidateRowKeys();
+    notifyRowsRemoved(first, count);
+}
+
+void LiteRowTableModel::clear() {
+    if (m_rows.empty()) return;
+    m_rows.clear();
+    invalidateRowKeys();
+    notifyReset();
+}
+
+TableRow LiteRowTableModel::takeRow(std::vector<std::string>& cells) const {
+    TableRow row;
+    cells.resize(std::max(cells.size(), m_columnCount));
+    row.cells.reserve(cells.size());
+    for (auto& text : cells) {
+        row.cells.emplace_back(std::move(text));
+    }
+    return row;
+}
+
+void LiteRowTableModel::addRows(std::vector<std::vector<std::string>> rows) {
+    if (rows.empty()) return;
+    size_t first = m_rows.size();
+    for (auto& cells : rows) {
+        m_rows.push_back(takeRow(cells));
+    }
+    invalidateRowKeys();
+    notifyRowsInserted(first, rows.size());
+}
+
+void LiteRowTableModel::setRows(std::vector<std::vector<std::string>> rows, const RowKeyFunction& key) {
+    // 旧行的键优先用上一次缓存的结果；缓存失效时才复制单元格文本重新计算
+    std::vector<std::string> oldKeys;
+    if (m_rowKeysValid && m_rowKeys.size() == m_rows.size()) {
+        oldKeys.swap(m_rowKeys);
+    } else {
+        oldKeys.resize(m_rows.size());
+        std::vector<std::string> texts;
+        for (size_t row = 0; row < m_rows.size(); ++row) {
+            const auto& cells = m_rows[row].cells;
+            texts.resize(cells.size());
+            for (size_t col = 0; col < cells.size(); ++col) {
+                texts[col] = cells[col].text;
+            }
+            oldKeys[row] = key(texts);
+        }
+    }
+    std::vector<std::string> newKeys(rows.size());
+    for (size_t row = 0; row < rows.size(); ++row) {
+        newKeys[row] = key(rows[row]);
+    }
+    invalidateRowKeys();
+    applyRows(std::move(rows), oldKeys, newKeys);
+    m_rowKeys = std::move(newKeys);
+    m_rowKeysValid = true;
+}
+
+void LiteRowTableModel::setRows(std::vector<std::vector<std::string>> rows, size_t keyColumn) {
+    std::vector<std::string> oldKeys(m_rows.size());
+    for (size_t row = 0; row < m_rows.size(); ++row) {
+        const auto& cells = m_rows[row].cells;
+        if (keyColumn < cells.size()) oldKeys[row] = cells[keyColumn].text;
+    }
+    std::vector<std::string> newKeys(rows.size());
+    for (size_t row = 0; row < rows.size(); ++row) {
+        if (keyColumn < rows[row].size()) newKeys[row] = rows[row][keyColumn];
+    }
+    invalidateRowKeys();
+    applyRows(std::move(rows), oldKeys, newKeys);
+}
+
+void LiteRowTableModel::applyRows(std::vector<std::vector<std::string>> rows,
+                                  const std::vector<std::string>& oldKeys,
+                                  const std::vector<std::string>& newKeys) {
+    LiteKeyedDiff diff = LiteKeyedDiff::compute(oldKeys, newKeys);
+
+    // 保留行在原位置更新文本变化的单元格（缺少的单元格视为空文本）
+    std::vector<uint8_t> changed(rows.size(), 0);
+    for (size_t row = 0; row < rows.size(); ++row) {
+        uint32_t source = diff.sources[row];
+        if (source == LiteKeyedDiff::kInserted) continue;
+        auto& cells = m_rows[source].cells;
+        auto& texts = rows[row];
+        if (cells.size() < texts.size()) cells.resize(texts.size());
+        for (size_t col = 0; col < cells.size(); ++col) {
+            if (col < texts.size()) {
+                if (cells[col].text != texts[col]) {
+                    cells[col].text = std::move(texts[col]);
+                    changed[row] = 1;
+                }
+            } else if (!cells[col].text.empty()) {
+                cells[col].text.clear();
+                changed[row] = 1;
+            }
+        }
+    }
+
+    if (!diff.isIdentity()) {
+        // 删除区间（旧行号）与插入区间（新行号）
+        std::vector<uint32_t> targets = diff.targets();
+        std::vector<std::pair<size_t, size_t>> removed;
+        std::vector<std::pair<size_t, size_t>> inserted;
+        for (size_t row = 0; row < targets.size(); ++row) {
+            if (targets[row] != LiteKeyedDiff::kInserted) continue;
+            if (!removed.empty() && removed.back().first + removed.back().second == row) {
+                ++removed.back().second;
+            } else {
+                removed.emplace_back(row, 1);
+            }
+        }
+        for (size_t row = 0; row < diff.sources.size(); ++row) {
+            if (diff.sources[row] != LiteKeyedDiff::kInserted) continue;
+            if (!inserted.empty() && inserted.back().first + inserted.back().second == row) {
+                ++inserted.back().second;
+            } else {
+                inserted.emplace_back(row, 1);
+            }
+        }
+
+        if (diff.movedCount == 0 && removed.size() + inserted.size() <= kMaxRangeChanges) {
+            // 从后向前删除，前面的行号不受影响；再按新行号从前向后插入
+            for (auto it = removed.rbegin(); it != removed.rend(); ++it) {
+                m_rows.erase(m_rows.begin() + it->first, m_rows.begin() + it->first + it->second);
+                notifyRowsRemoved(it->first, it->second);
+            }
+            for (const auto& range : inserted) {
+                std::vector<TableRow> block;
+                block.reserve(range.second);
+                for (size_t row = range.first; row < range.first + range.second; ++row) {
+                    block.push_back(takeRow(rows[row]));
+                }
+                m_rows.insert(m_rows.begin() + range.first,
+                              std::make_move_iterator(block.begin()), std::make_move_iterator(block.end()));
+                notifyRowsInserted(range.first, range.second);
+            }
+        } else {
+            // 按新顺序移入保留行，视图一次完成重排
+            std::deque<TableRow> next;
+            for (size_t row = 0; row < rows.size(); ++row) {
+                uint32_t source = diff.sources[row];
+                if (source == LiteKeyedDiff::kInserted) {
+                    next.push_back(takeRow(rows[row]));
+                } else {
+                    next.push_back(std::move(m_rows[source]));
+                }
+            }
+            m_rows.swap(next);
+            notifyRowsRemapped(diff.oldCount, diff.sources);
+        }
+    }
+
+    // 内容变化的保留行按连续区间通知
+    for (size_t row = 0; row < changed.size();) {
+        if (!changed[row]) {
+            ++row;
+            continue;
+        }
+        size_t end = row + 1;
+        while (end < changed.size() && changed[end]) ++end;
+        notifyDataChanged(row, end - row);
+        row = end;
+    }
+}
+
+void LiteRowTableModel::removeColumn(size_t col) {
+    for (auto& row : m_rows) {
+        if (col < row.cells.size()) {
+            row.cells.erase(row.cells.begin() + col);
+        }
+    }
+    if (col < m_columnCount) {
+        --m_columnCount;
+    }
+    invalidateRowKeys();
+    notifyColumnsChanged();
+}
+
+TableRow* LiteRowTableModel::getRow(size_t index) {
+    if (index >= m_rows.size()) return nullptr;
+    // 调用方可能直接修改单元格文本
+    invalidateRowKeys();
+    return &m_rows[index];
+}
+
+const TableRow* LiteRowTableModel::getRow(size_t index) const {
+    if (index >= m_rows.size()) return nullptr;
+    return &m_rows[index];
+}
+
+void LiteRowTableModel::setCellText(size_t row, size_t col, const std::string& text) {
+    TableCell* cell = cellAt(row, col);
+    if (!cell) return;
+    cell->text = text;
+    invalidateRowKeys();
+    notifyDataChanged(row, 1);
+}
+
+void LiteRowTableModel::setCellColor(size_t row, size_t col, const Color& textColor, const Color& bgColor) {
+    TableCell* cell = cellAt(row, col);
+    if (!cell) return;
+    cell->textColor = textColor;
+    cell->backgroundColor = bgColor;
+    notifyDataChanged(row, 1);
+}
+
+} // namespace liteDui
@@ -0,0 +1,566 @@
+/**
+ * lite_table_sorter.cpp - 表格后台排序实现
+ */
+
+#include "lite_table_sorter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <locale>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace liteDui {
+
+namespace {
+
+// 行数达到该值才分块并行
+constexpr size_t kParallelThreshold = 1 << 15;
+constexpr size_t kMaxSortThreads = 8;
+
+bool isCancelled(const std::atomic<bool>* cancel) {
+    return cancel && cancel->load(std::memory_order_relaxed);
+}
+
+size_t sortThreadCount(size_t count) {
+    if (count < kParallelThreshold) return 1;
+    size_t hardware = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    return std::min({hardware, kMaxSortThreads, count / (kParallelThreshold / 2)});
+}
+
+/**
+ * 在 count 个线程上执行 fn(i)，当前线程承担第 0 份
+ */
+template <typename Fn>
+void runChunks(size_t count, Fn&& fn) {
+    std::vector<std::thread> workers;
+    workers.reserve(count > 0 ? count - 1 : 0);
+    for (size_t i = 1; i < count; ++i) {
+        workers.emplace_back([&fn, i] { fn(i); });
+    }
+    if (count > 0) fn(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * 把 [0, count) 切分后并行执行 fn(begin, end)
+ */
+template <typename Fn>
+void parallelFor(size_t count, Fn&& fn) {
+    size_t threads = sortThreadCount(count);
+    runChunks(threads, [&](size_t i) {
+        fn(count * i / threads, count * (i + 1) / threads);
+    });
+}
+
+/**
+ * 分块并行排序后逐轮两两归并
+ * 比较函数必须是全序（相等元素按下标区分），否则归并结果与单线程不一致
+ */
+template <typename T, typename Less>
+bool parallelSort(std::vector<T>& items, const Less& less, const std::atomic<bool>* cancel) {
+    size_t count = items.size();
+    size_t chunks = sortThreadCount(count);
+    if (chunks <= 1) {
+        std::sort(items.begin(), items.end(), less);
+        return !isCancelled(cancel);
+    }
+
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t i = 0; i <= chunks; ++i) {
+        bounds[i] = count * i / chunks;
+    }
+
+    auto begin = items.begin();
+    runChunks(chunks, [&](size_t i) {
+        std::sort(begin + bounds[i], begin + bounds[i + 1], less);
+    });
+
+    for (size_t width = 1; width < chunks; width *= 2) {
+        if (isCancelled(cancel)) return false;
+        std::vector<size_t> merges;
+        for (size_t i = 0; i + width < chunks; i += 2 * width) {
+            merges.push_back(i);
+        }
+        runChunks(merges.size(), [&](size_t m) {
+            size_t i = merges[m];
+            std::inplace_merge(begin + bounds[i], begin + bounds[i + width],
+                               begin + bounds[std::min(i + 2 * width, chunks)], less);
+        });
+    }
+    return !isCancelled(cancel);
+}
+
+const std::locale& systemLocale() {
+    static const std::locale locale = [] {
+        try {
+            return std::locale("");
+        } catch (const std::runtime_error&) {
+            return std::locale::classic();
+        }
+    }();
+    return locale;
+}
+
+/**
+ * 解析文本开头的数字，忽略前导空白
+ */
+bool parseNumber(const std::string& text, double& value) {
+    const char* begin = text.c_str();
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    return end != begin && !std::isnan(value);
+}
+
+/**
+ * 自然顺序排序键：ASCII 大小写折叠，连续数字编码为 '0' + 两字节长度 + 去掉前导零的数字，
+ * 按字节比较排序键与 compareNatural 的顺序一致（只差大小写或前导零的字符串视为相等）
+ */
+std::string naturalKey(const std::string& text) {
+    std::string key;
+    key.reserve(text.size() + 4);
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (c >= '0' && c <= '9') {
+            while (i < text.size() && text[i] == '0') ++i;
+            size_t start = i;
+            while (i < text.size() && text[i] >= '0' && text[i] <= '9') ++i;
+            size_t length = std::min<size_t>(i - start, 0xFFFF);
+            key.push_back('0');
+            key.push_back(static_cast<char>(length >> 8));
+            key.push_back(static_cast<char>(length & 0xFF));
+            key.append(text, start, length);
+            continue;
+        }
+        key.push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c);
+        ++i;
+    }
+    return key;
+}
+
+/**
+ * 按字节对排序键排序并给出名次，相等的键名次相同
+ * 先比较打包成整数的前 8 字节，大部分比较不需要访问字符串本身
+ */
+bool rankKeys(const std::vector<std::string>& keys, std::vector<uint32_t>& ranks,
+              const std::atomic<bool>* cancel) {
+    struct Entry {
+        uint64_t prefix;
+        uint32_t index;
+    };
+
+    std::vector<Entry> entries(keys.size());
+    parallelFor(keys.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const std::string& key = keys[i];
+            uint64_t prefix = 0;
+            for (size_t b = 0; b < 8; ++b) {
+                prefix = (prefix << 8) | (b < key.size() ? static_cast<unsigned char>(key[b]) : 0);
+            }
+            entries[i] = Entry{prefix, static_cast<uint32_t>(i)};
+        }
+    });
+    if (isCancelled(cancel)) return false;
+
+    auto compare = [&keys](const Entry& a, const Entry& b) {
+        if (a.prefix != b.prefix) return a.prefix < b.prefix ? -1 : 1;
+        return keys[a.index].compare(keys[b.index]);
+    };
+    bool completed = parallelSort(entries, [&compare](const Entry& a, const Entry& b) {
+        int result = compare(a, b);
+        return result != 0 ? result < 0 : a.index < b.index;
+    }, cancel);
+    if (!completed) return false;
+
+    ranks.resize(keys.size());
+    uint32_t rank = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (i > 0 && compare(entries[i - 1], entries[i]) != 0) {
+            ++rank;
+        }
+        ranks[entries[i].index] = rank;
+    }
+    return true;
+}
+
+bool rankValues(const std::vector<std::string>& values, TableSortType type,
+                std::vector<uint32_t>& ranks, const std::atomic<bool>* cancel) {
+    if (type == TableSortType::Text) {
+        return rankKeys(values, ranks, cancel);
+    }
+
+    // 先转换为排序键，之后按字节比较即等价于按自然顺序或区域规则比较
+    std::vector<std::string> keys(values.size());
+    if (type == TableSortType::Locale) {
+        const auto& collate = std::use_facet<std::collate<char>>(systemLocale());
+        parallelFor(values.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const std::string& value = values[i];
+                keys[i] = collate.transform(value.data(), value.data() + value.size());
+            }
+        });
+    } else {
+        parallelFor(values.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                keys[i] = naturalKey(values[i]);
+            }
+        });
+    }
+    if (isCancelled(cancel)) return false;
+    return rankKeys(keys, ranks, cancel);
+}
+
+/**
+ * 准备好的排序键：所有类型都归一为 int64 / double / 名次 之一
+ */
+struct PreparedKey {
+    enum class Kind { Int64, Double, Rank };
+
+    Kind kind = Kind::Int64;
+    const int64_t* ints = nullptr;
+    const double* doubles = nullptr;
+    const uint32_t* ranks = nullptr;
+    const uint8_t* nulls = nullptr;
+    bool ascending = true;
+};
+
+void markNull(TableSortColumn& column, size_t rowCount, size_t row) {
+    if (column.nulls.size() < rowCount) {
+        column.nulls.resize(rowCount, 0);
+    }
+    column.nulls[row] = 1;
+}
+
+/**
+ * 把文本解析为数值，无法解析的行标记为 null
+ */
+void parseColumn(TableSortColumn& column, size_t rowCount, const std::vector<std::string>& values,
+                 const uint32_t* codes) {
+    std::vector<double> parsed(values.size());
+    std::vector<uint8_t> valid(values.size());
+    parallelFor(values.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            valid[i] = parseNumber(values[i], parsed[i]) ? 1 : 0;
+        }
+    });
+
+    column.doubles.resize(rowCount);
+    for (size_t row = 0; row < rowCount; ++row) {
+        size_t index = codes ? codes[row] : row;
+        column.doubles[row] = parsed[index];
+        if (!valid[index]) {
+            markNull(column, rowCount, row);
+        }
+    }
+}
+
+/**
+ * 把列快照转换为 PreparedKey，必要时在快照中就地生成名次或数值
+ * @return 被取消时返回 false；快照与行数不符的键会被忽略
+ */
+bool prepareKey(const TableSortKey& key, TableSortColumn& column, size_t rowCount,
+                std::vector<PreparedKey>& prepared, const std::atomic<bool>* cancel) {
+    bool numericColumn = column.kind == TableSortColumn::Kind::Int64 ||
+                         column.kind == TableSortColumn::Kind::Double;
+    TableSortType type = key.type;
+    if (type == TableSortType::Auto) {
+        type = numericColumn ? TableSortType::Numeric : TableSortType::Natural;
+    }
+
+    PreparedKey result;
+    result.ascending = key.ascending;
+
+    switch (column.kind) {
+        case TableSortColumn::Kind::Int64:
+            if (column.ints.size() < rowCount) return true;
+            result.kind = PreparedKey::Kind::Int64;
+            break;
+
+        case TableSortColumn::Kind::Double:
+            if (column.doubles.size() < rowCount) return true;
+            // NaN 与 null 一样排在最后
+            for (size_t row = 0; row < rowCount; ++row) {
+                if (std::isnan(column.doubles[row])) {
+                    markNull(column, rowCount, row);
+                }
+            }
+            result.kind = PreparedKey::Kind::Double;
+            break;
+
+        case TableSortColumn::Kind::Text:
+            if (column.strings.size() < rowCount) return true;
+            if (type == TableSortType::Numeric) {
+                parseColumn(column, rowCount, column.strings, nullptr);
+                result.kind = PreparedKey::Kind::Double;
+            } else {
+                if (!rankValues(column.strings, type, column.codes, cancel)) return false;
+                result.kind = PreparedKey::Kind::Rank;
+            }
+            break;
+
+        case TableSortColumn::Kind::Dictionary: {
+            if (column.codes.size() < rowCount) return true;
+            for (size_t row = 0; row < rowCount; ++row) {
+                if (column.codes[row] >= column.strings.size()) return true;
+            }
+            if (type == TableSortType::Numeric) {
+                parseColumn(column, rowCount, column.strings, column.codes.data());
+                result.kind = PreparedKey::Kind::Double;
+            } else {
+                // 只对字典排序，再把每行的编号替换为名次
+                std::vector<uint32_t> dictionaryRanks;
+                if (!rankValues(column.strings, type, dictionaryRanks, cancel)) return false;
+                parallelFor(rowCount, [&](size_t begin, size_t end) {
+                    for (size_t row = begin; row < end; ++row) {
+                        column.codes[row] = dictionaryRanks[column.codes[row]];
+                    }
+                });
+                result.kind = PreparedKey::Kind::Rank;
+            }
+            break;
+        }
+    }
+
+    result.ints = column.ints.data();
+    result.doubles = column.doubles.data();
+    result.ranks = column.codes.data();
+    if (column.nulls.size() >= rowCount) {
+        result.nulls = column.nulls.data();
+    }
+    prepared.push_back(result);
+    return true;
+}
+
+template <typename T>
+int compareValues(T a, T b) {
+    return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+/**
+ * 把键值编码为无符号整数，整数大小顺序与键值顺序一致
+ */
+uint64_t encodeKey(const PreparedKey& key, size_t row) {
+    constexpr uint64_t kSignBit = uint64_t(1) << 63;
+    switch (key.kind) {
+        case PreparedKey::Kind::Int64:
+            return static_cast<uint64_t>(key.ints[row]) ^ kSignBit;
+        case PreparedKey::Kind::Double: {
+            double value = key.doubles[row];
+            if (value == 0.0) value = 0.0;   // -0.0 与 0.0 相等
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return (bits & kSignBit) ? ~bits : (bits | kSignBit);
+        }
+        case PreparedKey::Kind::Rank:
+            return key.ranks[row];
+    }
+    return 0;
+}
+
+} // namespace
+
+// ==================== 比较 ====================
+
+int LiteTableSorter::compareNatural(const std::string& a, const std::string& b) {
+    auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+    auto fold = [](unsigned char c) -> unsigned char {
+        return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+    };
+
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (isDigit(a[i]) && isDigit(b[j])) {
+            // 跳过前导零，位数多的数更大，位数相同时逐位比较
+            size_t startA = i, startB = j;
+            while (startA < a.size() && a[startA] == '0') ++startA;
+            while (startB < b.size() && b[startB] == '0') ++startB;
+            size_t endA = startA, endB = startB;
+            while (endA < a.size() && isDigit(a[endA])) ++endA;
+            while (endB < b.size() && isDigit(b[endB])) ++endB;
+
+            size_t lengthA = endA - startA, lengthB = endB - startB;
+            if (lengthA != lengthB) return lengthA < lengthB ? -1 : 1;
+            int result = a.compare(startA, lengthA, b, startB, lengthB);
+            if (result != 0) return result < 0 ? -1 : 1;
+            i = endA;
+            j = endB;
+            continue;
+        }
+
+        unsigned char ca = fold(static_cast<unsigned char>(a[i]));
+        unsigned char cb = fold(static_cast<unsigned char>(b[j]));
+        if (ca != cb) return ca < cb ? -1 : 1;
+        ++i;
+        ++j;
+    }
+
+    if (i < a.size()) return 1;
+    if (j < b.size()) return -1;
+    // 只有大小写或前导零不同时按字节比较，保证全序
+    int result = a.compare(b);
+    return result < 0 ? -1 : (result > 0 ? 1 : 0);
+}
+
+// ==================== 同步排序 ====================
+
+LiteTableSorter::Permutation LiteTableSorter::sort(size_t rowCount, const std::vector<TableSortKey>& keys,
+                                                   std::vector<TableSortColumn>& columns,
+                                                   const std::atomic<bool>* cancel) {
+    Permutation order(rowCount);
+    std::iota(order.begin(), order.end(), 0);
+    if (rowCount < 2) return order;
+
+    std::vector<PreparedKey> prepared;
+    for (size_t i = 0; i < keys.size() && i < columns.size(); ++i) {
+        if (!prepareKey(keys[i], columns[i], rowCount, prepared, cancel)) return Permutation();
+    }
+    if (prepared.empty()) return order;
+
+    // 第一个键编码为保序的 64 位整数与行号一起排序，只有第一个键相等时才比较后续键
+    struct Entry {
+        uint64_t key;
+        uint32_t isNull;
+        uint32_t row;
+    };
+
+    const PreparedKey& primary = prepared.front();
+    std::vector<Entry> entries(rowCount);
+    parallelFor(rowCount, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            uint64_t key = encodeKey(primary, row);
+            entries[row] = Entry{primary.ascending ? key : ~key,
+                                 primary.nulls ? primary.nulls[row] : 0u,
+                                 static_cast<uint32_t>(row)};
+        }
+    });
+    if (isCancelled(cancel)) return Permutation();
+
+    auto less = [&prepared](const Entry& a, const Entry& b) {
+        if (a.isNull != b.isNull) return a.isNull < b.isNull;
+        if (!a.isNull && a.key != b.key) return a.key < b.key;
+
+        for (size_t k = 1; k < prepared.size(); ++k) {
+            const PreparedKey& key = prepared[k];
+            if (key.nulls) {
+                bool nullA = key.nulls[a.row] != 0;
+                bool nullB = key.nulls[b.row] != 0;
+                if (nullA || nullB) {
+                    if (nullA != nullB) return nullB;
+                    continue;
+                }
+            }
+
+            int result = 0;
+            switch (key.kind) {
+                case PreparedKey::Kind::Int64:
+                    result = compareValues(key.ints[a.row], key.ints[b.row]);
+                    break;
+                case PreparedKey::Kind::Double:
+                    result = compareValues(key.doubles[a.row], key.doubles[b.row]);
+                    break;
+                case PreparedKey::Kind::Rank:
+                    result = compareValues(key.ranks[a.row], key.ranks[b.row]);
+                    break;
+            }
+            if (result != 0) return key.ascending ? result < 0 : result > 0;
+        }
+        // 相等的行保持模型顺序
+        return a.row < b.row;
+    };
+
+    if (!parallelSort(entries, less, cancel)) return Permutation();
+    for (size_t i = 0; i < rowCount; ++i) {
+        order[i] = entries[i].row;
+    }
+    return order;
+}
+
+// ==================== 后台排序 ====================
+
+void LiteTableSorter::gather(const ColumnSnapshot::Data& data, TableSortColumn& out) {
+    out = TableSortColumn();
+    if (data.parts.empty()) return;
+    out.kind = data.parts.front().block->kind;
+
+    bool hasNulls = false;
+    for (const auto& part : data.parts) {
+        hasNulls = hasNulls || !part.block->nulls.empty();
+    }
+    size_t rowCount = data.rowCount;
+    switch (out.kind) {
+        case TableSortColumn::Kind::Text: out.strings.reserve(rowCount); break;
+        case TableSortColumn::Kind::Int64: out.ints.reserve(rowCount); break;
+        case TableSortColumn::Kind::Double: out.doubles.reserve(rowCount); break;
+        case TableSortColumn::Kind::Dictionary: out.codes.reserve(rowCount); break;
+    }
+    if (hasNulls) out.nulls.reserve(rowCount);
+
+    // 字典项以块中的字符串为键，块在拼接期间保持有效
+    std::unordered_map<std::string_view, uint32_t> dictionary;
+    std::vector<uint32_t> codes;
+    for (const auto& part : data.parts) {
+        const TableSortColumn& block = *part.block;
+        auto begin = static_cast<std::ptrdiff_t>(part.offset);
+        auto end = static_cast<std::ptrdiff_t>(part.offset + part.count);
+        switch (out.kind) {
+            case TableSortColumn::Kind::Text:
+                out.strings.insert(out.strings.end(), block.strings.begin() + begin, block.strings.begin() + end);
+                break;
+            case TableSortColumn::Kind::Int64:
+                out.ints.insert(out.ints.end(), block.ints.begin() + begin, block.ints.begin() + end);
+                break;
+            case TableSortColumn::Kind::Double:
+                out.doubles.insert(out.doubles.end(), block.doubles.begin() + begin, block.doubles.begin() + end);
+                break;
+            case TableSortColumn::Kind::Dictionary:
+                codes.assign(block.strings.size(), UINT32_MAX);
+                for (auto it = block.codes.begin() + begin; it != block.codes.begin() + end; ++it) {
+                    uint32_t& code = codes[*it];
+                    if (code == UINT32_MAX) {
+                        auto result = dictionary.emplace(block.strings[*it], static_cast<uint32_t>(out.strings.size()));
+                        if (result.second) out.strings.push_back(block.strings[*it]);
+                        code = result.first->second;
+                    }
+                    out.codes.push_back(code);
+                }
+                break;
+        }
+        if (hasNulls) {
+            if (block.nulls.empty()) {
+                out.nulls.resize(out.nulls.size() + part.count, 0);
+            } else {
+                out.nulls.insert(out.nulls.end(), block.nulls.begin() + begin, block.nulls.begin() + end);
+            }
+        }
+    }
+}
+
+void LiteTableSorter::request(uint64_t revision, std::vector<TableSortKey> keys, std::vector<ColumnData> columns) {
+    auto job = std::make_shared<std::pair<std::vector<TableSortKey>, std::vector<ColumnData>>>(
+        std::move(keys), std::move(columns));
+    m_task.submit(revision, [job](const std::atomic<bool>& cancel, Permutation& permutation) {
+        // 在排序线程中拼接整列，UI 线程只提交块列表
+        size_t rowCount = job->second.empty() ? 0 : job->second.front()->rowCount;
+        std::vector<TableSortColumn> columns(job->second.size());
+        for (size_t k = 0; k < columns.size(); ++k) {
+            gather(*job->second[k], columns[k]);
+            if (cancel.load()) return false;
+        }
+        // 正在执行的旧任务会在下一个阶段检查点放弃
+        permutation = sort(rowCount, job->first, columns, &cancel);
+        return !cancel.load();
+    });
+}
+
+void LiteTableSorter::cancel() {
+    m_task.cancel();
+}
+
+} // namespace liteDui
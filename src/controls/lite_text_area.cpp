@@ -0,0 +1,600 @@
+/**
+ * lite_text_area.cpp - 多行文本编辑控件实现
+ * 只为可见行整形和绘制，编辑时只失效受影响的行
+ */
+
+#include "lite_text_area.h"
+#include "lite_utf8.h"
+#include "lite_text_renderer.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include <cmath>
+
+namespace liteDui {
+
+namespace {
+
+// 统一换行符："\r\n" 与单独的 "\r" 转为 "\n"
+std::string normalizeNewlines(const std::string& text) {
+    if (text.find('\r') == std::string::npos) return text;
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\r') {
+            result.push_back('\n');
+            if (i + 1 < text.size() && text[i + 1] == '\n') ++i;
+        } else {
+            result.push_back(text[i]);
+        }
+    }
+    return result;
+}
+
+// 光标线宽，内容宽度需要为行尾光标留出空间
+constexpr float kCursorWidth = 1.5f;
+
+} // namespace
+
+LiteTextArea::LiteTextArea() {
+    setScrollDirection(ScrollDirection::Both);
+    setBackgroundColor(m_normalBgColor);
+    setBorderColor(m_normalBorderColor);
+    setBorderRadius(EdgeInsets::All(4.0f));
+    setPadding(EdgeInsets::Symmetric(8.0f, 6.0f));
+    setBorder(EdgeInsets::All(1.0f));
+    setFontSize(14.0f);
+    syncFont();
+    m_lastBlinkTime = std::chrono::steady_clock::now();
+}
+
+LiteTextArea::LiteTextArea(const std::string& placeholder) : LiteTextArea() {
+    m_placeholder = placeholder;
+}
+
+void LiteTextArea::setValue(const std::string& value) {
+    m_buffer.setText(normalizeNewlines(value));
+    m_lineCache.clear();
+    m_maxLineWidth = 0.0f;
+    m_cursorPos = std::min(m_cursorPos, m_buffer.length());
+    m_preferredX = -1.0f;
+    clearSelection();
+    clampScroll();
+    resetCursorBlink();
+    notifyTextChanged();
+}
+
+void LiteTextArea::setPlaceholder(const std::string& placeholder) {
+    m_placeholder = placeholder;
+    markDirty();
+}
+
+void LiteTextArea::setDisabled(bool disabled) {
+    setState(disabled ? ControlState::Disabled : ControlState::Normal);
+}
+
+void LiteTextArea::setCursorPosition(size_t pos) {
+    m_cursorPos = std::min(pos, m_buffer.length());
+    m_preferredX = -1.0f;
+    clearSelection();
+    ensureCursorVisible();
+    resetCursorBlink();
+}
+
+void LiteTextArea::selectAll() {
+    m_selectionStart = 0;
+    m_selectionEnd = m_buffer.length();
+    markDirty();
+}
+
+void LiteTextArea::clearSelection() {
+    m_selectionStart = kNoSelection;
+    m_selectionEnd = kNoSelection;
+    markDirty();
+}
+
+bool LiteTextArea::hasSelection() const {
+    return m_selectionStart != kNoSelection && m_selectionEnd != kNoSelection &&
+           m_selectionStart != m_selectionEnd;
+}
+
+std::string LiteTextArea::getSelectedText() const {
+    if (!hasSelection()) return "";
+    size_t start = std::min(m_selectionStart, m_selectionEnd);
+    size_t end = std::max(m_selectionStart, m_selectionEnd);
+    return m_buffer.getText(start, end - start);
+}
+
+void LiteTextArea::clear() {
+    setValue(std::string());
+    m_cursorPos = 0;
+    scrollTo(0, 0);
+}
+
+void LiteTextArea::insertText(const std::string& text) {
+    if (text.empty() || m_readOnly) return;
+
+    std::string normalized = normalizeNewlines(text);
+    size_t start = m_cursorPos;
+    size_t end = m_cursorPos;
+    if (hasSelection()) {
+        start = std::min(m_selectionStart, m_selectionEnd);
+        end = std::max(m_selectionStart, m_selectionEnd);
+    }
+
+    replaceText(start, end, normalized);
+    m_cursorPos = start + normalized.size();
+    m_preferredX = -1.0f;
+    clearSelection();
+    ensureCursorVisible();
+    resetCursorBlink();
+    notifyTextChanged();
+}
+
+float LiteTextArea::getContentWidth() const {
+    return m_maxLineWidth + kCursorWidth;
+}
+
+float LiteTextArea::getContentHeight() const {
+    return static_cast<float>(m_buffer.getLineCount()) * m_lineHeight;
+}
+
+void LiteTextArea::setState(ControlState state) {
+    if (m_state == state) return;
+
+    bool wasFocused = (m_state == ControlState::Focused);
+    bool isFocused = (state == ControlState::Focused);
+
+    m_state = state;
+    updateAppearance();
+
+    if (isFocused) {
+        resetCursorBlink();
+    }
+
+    if (wasFocused != isFocused && m_onFocusChanged) {
+        m_onFocusChanged(isFocused);
+    }
+}
+
+void LiteTextArea::updateAppearance() {
+    switch (m_state) {
+    case ControlState::Focused:
+        setBackgroundColor(m_normalBgColor);
+        setBorderColor(m_focusedBorderColor);
+        break;
+    case ControlState::Disabled:
+        setBackgroundColor(m_disabledBgColor);
+        setBorderColor(m_disabledBorderColor);
+        break;
+    default:
+        setBackgroundColor(m_normalBgColor);
+        setBorderColor(m_normalBorderColor);
+        break;
+    }
+    markDirty();
+}
+
+void LiteTextArea::notifyTextChanged() {
+    if (m_onTextChanged) m_onTextChanged(m_buffer.getText());
+}
+
+void LiteTextArea::syncFont() {
+    FontSpec spec = getFontSpec();
+    if (spec == m_fontSpec && m_lineHeight > 0) return;
+
+    m_fontSpec = spec;
+    m_lineCache.clear();
+    m_maxLineWidth = 0.0f;
+
+    // 固定行高取空行的度量，y -> 行号只需一次除法
+    auto empty = LiteTextRenderer::getInstance().shape(std::string(), spec);
+    m_lineHeight = std::ceil(empty ? empty->getHeight() : spec.fontSize * 1.2f);
+}
+
+const LiteTextLine& LiteTextArea::lineLayout(size_t line) {
+    auto it = m_lineCache.find(line);
+    if (it != m_lineCache.end()) return *it->second;
+
+    auto layout = std::make_unique<LiteTextLine>();
+    layout->setFont(m_fontSpec);
+    layout->setText(m_buffer.getLine(line));
+    m_maxLineWidth = std::max(m_maxLineWidth, layout->getWidth());
+    return *m_lineCache.emplace(line, std::move(layout)).first->second;
+}
+
+void LiteTextArea::trimLineCache(size_t firstKeep, size_t lastKeep) {
+    if (m_lineCache.size() <= m_maxCachedLines) return;
+
+    // 先淘汰离可见区域最远的一侧
+    while (m_lineCache.size() > m_maxCachedLines) {
+        auto front = m_lineCache.begin();
+        auto back = std::prev(m_lineCache.end());
+        size_t frontDist = front->first < firstKeep ? firstKeep - front->first : 0;
+        size_t backDist = back->first > lastKeep ? back->first - lastKeep : 0;
+        if (frontDist == 0 && backDist == 0) break;
+        if (frontDist >= backDist) {
+            m_lineCache.erase(front);
+        } else {
+            m_lineCache.erase(back);
+        }
+    }
+}
+
+void LiteTextArea::replaceText(size_t start, size_t end, const std::string& text) {
+    syncFont();
+
+    size_t firstLine = m_buffer.getLineAt(start);
+    size_t removedBreaks = m_buffer.countLineBreaks(start, end - start);
+    size_t addedBreaks = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+
+    if (removedBreaks == 0 && addedBreaks == 0) {
+        // 行内编辑：只增量重新整形该行受影响的片段
+        auto it = m_lineCache.find(firstLine);
+        if (it != m_lineCache.end()) {
+            size_t lineStart = m_buffer.getLineStart(firstLine);
+            it->second->replace(start - lineStart, end - lineStart, text);
+            m_maxLineWidth = std::max(m_maxLineWidth, it->second->getWidth());
+        }
+    } else {
+        // 跨行编辑：丢弃被改动的行，后续行的缓存按行数变化平移
+        size_t lastLine = firstLine + removedBreaks;
+        std::map<size_t, std::unique_ptr<LiteTextLine>> shifted;
+        for (auto& entry : m_lineCache) {
+            if (entry.first < firstLine) {
+                shifted.emplace_hint(shifted.end(), entry.first, std::move(entry.second));
+            } else if (entry.first > lastLine) {
+                shifted.emplace_hint(shifted.end(), entry.first - removedBreaks + addedBreaks,
+                                     std::move(entry.second));
+            }
+        }
+        m_lineCache.swap(shifted);
+    }
+
+    if (end > start) {
+        m_buffer.erase(start, end - start);
+    }
+    m_buffer.insert(start, text);
+    markDirty();
+}
+
+void LiteTextArea::deleteSelected() {
+    if (!hasSelection()) return;
+
+    size_t start = std::min(m_selectionStart, m_selectionEnd);
+    size_t end = std::max(m_selectionStart, m_selectionEnd);
+    replaceText(start, end, std::string());
+    m_cursorPos = start;
+    m_preferredX = -1.0f;
+    clearSelection();
+    resetCursorBlink();
+    notifyTextChanged();
+}
+
+size_t LiteTextArea::prevCharPos(size_t pos) {
+    if (pos == 0) return 0;
+    size_t line = m_buffer.getLineAt(pos);
+    size_t lineStart = m_buffer.getLineStart(line);
+    if (pos == lineStart) return pos - 1;   // 跨过上一行的换行符
+    const std::string& text = lineLayout(line).getText();
+    return lineStart + Utf8Helper::getPrevCharPos(text, static_cast<int>(pos - lineStart));
+}
+
+size_t LiteTextArea::nextCharPos(size_t pos) {
+    if (pos >= m_buffer.length()) return m_buffer.length();
+    size_t line = m_buffer.getLineAt(pos);
+    size_t lineStart = m_buffer.getLineStart(line);
+    const std::string& text = lineLayout(line).getText();
+    if (pos - lineStart >= text.size()) return pos + 1;   // 跨过本行的换行符
+    return lineStart + Utf8Helper::getNextCharPos(text, static_cast<int>(pos - lineStart));
+}
+
+size_t LiteTextArea::offsetForPoint(float x, float y) {
+    syncFont();
+    size_t lineCount = m_buffer.getLineCount();
+    size_t line = 0;
+    if (y > 0 && m_lineHeight > 0) {
+        line = std::min(static_cast<size_t>(y / m_lineHeight), lineCount - 1);
+    }
+    return m_buffer.getLineStart(line) + lineLayout(line).getOffsetForX(x);
+}
+
+float LiteTextArea::cursorXForOffset(size_t pos) {
+    size_t line = m_buffer.getLineAt(pos);
+    return lineLayout(line).getXForOffset(pos - m_buffer.getLineStart(line));
+}
+
+size_t LiteTextArea::verticalMove(size_t pos, long lineDelta) {
+    if (m_preferredX < 0) {
+        m_preferredX = cursorXForOffset(pos);
+    }
+
+    long line = static_cast<long>(m_buffer.getLineAt(pos)) + lineDelta;
+    long lastLine = static_cast<long>(m_buffer.getLineCount()) - 1;
+    if (line < 0) return 0;
+    if (line > lastLine) return m_buffer.length();
+
+    size_t target = static_cast<size_t>(line);
+    return m_buffer.getLineStart(target) + lineLayout(target).getOffsetForX(m_preferredX);
+}
+
+void LiteTextArea::moveCursor(size_t pos, bool extendSelection) {
+    if (extendSelection) {
+        if (!hasSelection()) m_selectionStart = m_cursorPos;
+        m_cursorPos = pos;
+        m_selectionEnd = m_cursorPos;
+    } else {
+        m_cursorPos = pos;
+        clearSelection();
+    }
+    resetCursorBlink();
+}
+
+void LiteTextArea::ensureCursorVisible() {
+    syncFont();
+    float viewportW = getViewportWidth();
+    float viewportH = getViewportHeight();
+
+    float cursorY = static_cast<float>(m_buffer.getLineAt(m_cursorPos)) * m_lineHeight;
+    if (cursorY < m_scrollY) {
+        m_scrollY = cursorY;
+    } else if (cursorY + m_lineHeight > m_scrollY + viewportH) {
+        m_scrollY = cursorY + m_lineHeight - viewportH;
+    }
+
+    float cursorX = cursorXForOffset(m_cursorPos);
+    if (cursorX < m_scrollX) {
+        m_scrollX = cursorX;
+    } else if (cursorX + kCursorWidth > m_scrollX + viewportW) {
+        m_scrollX = cursorX + kCursorWidth - viewportW;
+    }
+
+    clampScroll();
+    markDirty();
+}
+
+void LiteTextArea::handleSpecialKey(const KeyEvent& event) {
+    if (!event.pressed) return;
+
+    bool shift = event.mods & 1;
+    bool ctrl = event.mods & 2;
+    bool editable = !m_readOnly;
+    size_t length = m_buffer.length();
+    size_t line = m_buffer.getLineAt(m_cursorPos);
+    long pageLines = std::max(1L, static_cast<long>(getViewportHeight() / std::max(m_lineHeight, 1.0f)));
+
+    switch (event.keyCode) {
+    case 259: // Backspace
+        if (!editable) break;
+        if (hasSelection()) {
+            deleteSelected();
+        } else if (m_cursorPos > 0) {
+            size_t prevPos = prevCharPos(m_cursorPos);
+            replaceText(prevPos, m_cursorPos, std::string());
+            m_cursorPos = prevPos;
+            m_preferredX = -1.0f;
+            resetCursorBlink();
+            notifyTextChanged();
+        }
+        break;
+
+    case 261: // Delete
+        if (!editable) break;
+        if (hasSelection()) {
+            deleteSelected();
+        } else if (m_cursorPos < length) {
+            replaceText(m_cursorPos, nextCharPos(m_cursorPos), std::string());
+            m_preferredX = -1.0f;
+            resetCursorBlink();
+            notifyTextChanged();
+        }
+        break;
+
+    case 257: // Enter
+    case 335: // Keypad Enter
+        if (editable) insertText("\n");
+        break;
+
+    case 263: // Left
+        m_preferredX = -1.0f;
+        moveCursor(prevCharPos(m_cursorPos), shift);
+        break;
+
+    case 262: // Right
+        m_preferredX = -1.0f;
+        moveCursor(nextCharPos(m_cursorPos), shift);
+        break;
+
+    case 265: // Up
+        moveCursor(verticalMove(m_cursorPos, -1), shift);
+        break;
+
+    case 264: // Down
+        moveCursor(verticalMove(m_cursorPos, 1), shift);
+        break;
+
+    case 266: // PageUp
+        moveCursor(verticalMove(m_cursorPos, -pageLines), shift);
+        break;
+
+    case 267: // PageDown
+        moveCursor(verticalMove(m_cursorPos, pageLines), shift);
+        break;
+
+    case 268: // Home（Ctrl 时到文档开头）
+        m_preferredX = -1.0f;
+        moveCursor(ctrl ? 0 : m_buffer.getLineStart(line), shift);
+        break;
+
+    case 269: // End（Ctrl 时到文档末尾）
+        m_preferredX = -1.0f;
+        moveCursor(ctrl ? length : m_buffer.getLineStart(line) + m_buffer.getLineLength(line), shift);
+        break;
+
+    default:
+        return;
+    }
+
+    ensureCursorVisible();
+}
+
+void LiteTextArea::updateCursorBlink() {
+    if (m_state != ControlState::Focused) {
+        if (!m_cursorVisible) {
+            m_cursorVisible = true;
+            markDirty();
+        }
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastBlinkTime);
+    if (duration.count() > 500) {
+        m_cursorVisible = !m_cursorVisible;
+        m_lastBlinkTime = now;
+        markDirty();
+    }
+}
+
+void LiteTextArea::resetCursorBlink() {
+    m_cursorVisible = true;
+    m_lastBlinkTime = std::chrono::steady_clock::now();
+    markDirty();
+}
+
+void LiteTextArea::update() {
+    updateCursorBlink();
+}
+
+void LiteTextArea::renderContent(SkCanvas* canvas) {
+    syncFont();
+    if (m_lineHeight <= 0) return;
+
+    float viewportW = getViewportWidth();
+    float viewportH = getViewportHeight();
+
+    if (m_buffer.empty() && !m_placeholder.empty()) {
+        LiteTextRenderer::getInstance().drawSingleLine(
+            canvas, m_placeholder, m_fontSpec, m_placeholderColor,
+            0, 0, viewportW, m_lineHeight, TextAlign::Left, false);
+    }
+
+    // 可见行范围（canvas 已平移滚动偏移，这里使用内容坐标）
+    size_t lineCount = m_buffer.getLineCount();
+    size_t firstLine = static_cast<size_t>(std::max(0.0f, m_scrollY) / m_lineHeight);
+    size_t lastLine = static_cast<size_t>((m_scrollY + viewportH) / m_lineHeight);
+    lastLine = std::min(lastLine, lineCount - 1);
+
+    bool selection = hasSelection();
+    size_t selStart = selection ? std::min(m_selectionStart, m_selectionEnd) : 0;
+    size_t selEnd = selection ? std::max(m_selectionStart, m_selectionEnd) : 0;
+
+    SkPaint selPaint;
+    selPaint.setColor(m_selectionColor.toARGB());
+    Color textColor = getTextColor();
+
+    for (size_t line = firstLine; line <= lastLine; ++line) {
+        const LiteTextLine& layout = lineLayout(line);
+        size_t lineStart = m_buffer.getLineStart(line);
+        size_t lineEnd = lineStart + layout.getText().size();
+        float y = static_cast<float>(line) * m_lineHeight;
+
+        // 选择高亮：选择跨过行尾时多画出一小段表示换行符
+        if (selection && selStart <= lineEnd && selEnd > lineStart) {
+            float startX = layout.getXForOffset(std::max(selStart, lineStart) - lineStart);
+            float endX = selEnd > lineEnd ? layout.getWidth() + m_lineHeight * 0.3f
+                                          : layout.getXForOffset(selEnd - lineStart);
+            canvas->drawRect(SkRect::MakeXYWH(startX, y, endX - startX, m_lineHeight), selPaint);
+        }
+
+        float top = y + (m_lineHeight - layout.getHeight()) * 0.5f;
+        layout.draw(canvas, 0, top, textColor, m_scrollX, m_scrollX + viewportW);
+    }
+
+    // 绘制光标
+    if (m_state == ControlState::Focused && m_cursorVisible) {
+        size_t cursorLine = m_buffer.getLineAt(m_cursorPos);
+        if (cursorLine >= firstLine && cursorLine <= lastLine) {
+            float cursorX = cursorXForOffset(m_cursorPos);
+            float cursorY = static_cast<float>(cursorLine) * m_lineHeight;
+
+            SkPaint cursorPaint;
+            cursorPaint.setColor(m_cursorColor.toARGB());
+            cursorPaint.setStrokeWidth(kCursorWidth);
+            cursorPaint.setStyle(SkPaint::kStroke_Style);
+            canvas->drawLine(cursorX, cursorY, cursorX, cursorY + m_lineHeight, cursorPaint);
+        }
+    }
+
+    trimLineCache(firstLine, lastLine);
+}
+
+void LiteTextArea::onMousePressed(const MouseEvent& event) {
+    if (m_state == ControlState::Disabled) return;
+
+    if (isPointInVerticalScrollbar(event.x, event.y) ||
+        isPointInHorizontalScrollbar(event.x, event.y)) {
+        LiteScrollView::onMousePressed(event);
+        return;
+    }
+    if (event.button != MouseButton::Left) return;
+
+    float x = event.x - getLayoutBorderLeft() - getLayoutPaddingLeft() + m_scrollX;
+    float y = event.y - getLayoutBorderTop() - getLayoutPaddingTop() + m_scrollY;
+
+    m_cursorPos = offsetForPoint(x, y);
+    m_preferredX = -1.0f;
+    m_selectionStart = m_cursorPos;
+    m_selectionEnd = m_cursorPos;
+    m_isDragging = true;
+
+    ensureCursorVisible();
+    resetCursorBlink();
+}
+
+void LiteTextArea::onMouseReleased(const MouseEvent& event) {
+    LiteScrollView::onMouseReleased(event);
+    m_isDragging = false;
+    if (m_selectionStart == m_selectionEnd) {
+        clearSelection();
+    }
+}
+
+void LiteTextArea::onMouseMoved(const MouseEvent& event) {
+    if (!m_isDragging) {
+        // 滚动条拖拽
+        LiteScrollView::onMouseMoved(event);
+        return;
+    }
+
+    float x = event.x - getLayoutBorderLeft() - getLayoutPaddingLeft() + m_scrollX;
+    float y = event.y - getLayoutBorderTop() - getLayoutPaddingTop() + m_scrollY;
+
+    m_cursorPos = offsetForPoint(x, y);
+    m_selectionEnd = m_cursorPos;
+    ensureCursorVisible();
+}
+
+void LiteTextArea::onKeyPressed(const KeyEvent& event) {
+    if (m_state == ControlState::Disabled) return;
+    handleSpecialKey(event);
+}
+
+void LiteTextArea::onCharInput(unsigned int codepoint) {
+    if (m_state != ControlState::Focused || m_readOnly) return;
+    insertText(Utf8Helper::codepointToUtf8(codepoint));
+}
+
+void LiteTextArea::onFocusGained() {
+    if (m_state == ControlState::Disabled) return;
+    setState(ControlState::Focused);
+    resetCursorBlink();
+}
+
+void LiteTextArea::onFocusLost() {
+    if (m_state == ControlState::Disabled) return;
+    setState(ControlState::Normal);
+    m_isDragging = false;
+}
+
+} // namespace liteDui
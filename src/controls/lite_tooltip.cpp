@@ -5,11 +5,6 @@
 #include "lite_tooltip.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkRRect.h"
-#include "include/core/SkFont.h"
-#include "modules/skparagraph/include/Paragraph.h"
-#include "modules/skparagraph/include/ParagraphBuilder.h"
-#include "modules/skparagraph/include/ParagraphStyle.h"
-#include "modules/skparagraph/include/TextStyle.h"
 
 namespace liteDui {
 
@@ -22,29 +17,12 @@ void LiteTooltipOverlay::show(const std::string& text, float anchorX, float anch
     m_tipText = text;
     if (m_tipText.empty()) return;
 
-    // 测量文本尺寸
+    // 测量文本尺寸（用窗口宽度作为最大约束）
     setFontSize(m_tipFontSize);
-    auto& fontMgr = getFontManager();
-    
-    skia::textlayout::TextStyle textStyle;
-    textStyle.setFontSize(m_tipFontSize);
-    textStyle.setColor(m_tipTextColor.toARGB());
-    std::vector<SkString> families;
-    families.push_back(SkString(getFontFamily().c_str()));
-    textStyle.setFontFamilies(families);
-
-    skia::textlayout::ParagraphStyle paraStyle;
-    paraStyle.setTextStyle(textStyle);
-
-    auto builder = skia::textlayout::ParagraphBuilder::make(
-        paraStyle, fontMgr.getFontCollection());
-    builder->pushStyle(textStyle);
-    builder->addText(m_tipText.c_str(), m_tipText.size());
-    auto paragraph = builder->Build();
-    paragraph->layout(windowW);  // 用窗口宽度作为最大约束
-
-    float textWidth = paragraph->getMaxIntrinsicWidth();
-    float textHeight = paragraph->getHeight();
+    TextMetrics metrics = getFontManager().measureText(m_tipText, getFontSpec(), windowW);
+
+    float textWidth = metrics.width;
+    float textHeight = metrics.height;
 
     m_tipWidth = textWidth + kPaddingH * 2;
     m_tipHeight = textHeight + kPaddingV * 2;
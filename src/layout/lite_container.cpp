@@ -3,6 +3,7 @@
  */
 
 #include "lite_container.h"
+#include "lite_text_renderer.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkRRect.h"
@@ -49,6 +50,7 @@ void LiteContainer::setBorderRadius(const EdgeInsets& radius) {
 // 文本属性
 void LiteContainer::setText(const std::string& text) {
     m_text = text;
+    ++m_textVersion;
     markDirty();
 }
 
@@ -67,6 +69,16 @@ void LiteContainer::setFontFamily(const std::string& family) {
     markDirty();
 }
 
+void LiteContainer::setFontWeight(FontWeight weight) {
+    m_fontWeight = weight;
+    markDirty();
+}
+
+void LiteContainer::setFontStyle(FontStyle style) {
+    m_fontStyle = style;
+    markDirty();
+}
+
 void LiteContainer::setTextAlign(TextAlign align) {
     m_textAlign = align;
     markDirty();
@@ -149,6 +161,13 @@ void LiteContainer::drawText(SkCanvas* canvas, float x, float y, float w, float
 
     if (textW <= 0) return;
 
+    // 单行简单文本且宽度足够时直接绘制缓存的 SkTextBlob，否则走段落排版（支持换行）
+    if (LiteTextRenderer::getInstance().drawLine(canvas, m_text, getFontSpec(), m_textColor,
+                                                 textX, textY, textW, m_textAlign,
+                                                 LineOverflow::Reject)) {
+        return;
+    }
+
     // 使用 LiteFontManager 获取字体资源和样式
     auto& fontMgr = getFontManager();
     auto fontCollection = fontMgr.getFontCollection();
@@ -170,7 +189,8 @@ LiteFontManager& LiteContainer::getFontManager() const {
 }
 
 skia::textlayout::TextStyle LiteContainer::getTextStyle() const {
-    return getFontManager().createTextStyle(m_textColor, m_fontSize, m_fontFamily);
+    return getFontManager().createTextStyle(m_textColor, m_fontSize, m_fontFamily,
+                                            m_fontWeight, m_fontStyle);
 }
 
 skia::textlayout::ParagraphStyle LiteContainer::getParagraphStyle() const {
@@ -178,7 +198,11 @@ skia::textlayout::ParagraphStyle LiteContainer::getParagraphStyle() const {
 }
 
 SkFont LiteContainer::getFont() const {
-    return getFontManager().createFont(m_fontSize, m_fontFamily);
+    return getFontManager().createFont(m_fontSize, m_fontFamily, m_fontWeight, m_fontStyle);
+}
+
+FontSpec LiteContainer::getFontSpec() const {
+    return FontSpec{m_fontSize, m_fontFamily, m_fontWeight, m_fontStyle};
 }
 
 float LiteContainer::getAbsoluteLeft() const {
@@ -3,47 +3,272 @@
  */
 
 #include "lite_font_manager.h"
+#include "lite_task_pool.h"
+#include "lite_text_renderer.h"
+#include "lite_utf8.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "include/ports/SkFontMgr_fontconfig.h"
 #include "include/ports/SkFontScanner_FreeType.h"
+#include "modules/skparagraph/include/TypefaceFontProvider.h"
+#include "modules/skparagraph/include/Paragraph.h"
+#include "modules/skparagraph/include/ParagraphBuilder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
 
 namespace liteDui {
 
-LiteFontManager& LiteFontManager::getInstance() {
+LiteFontManager& LiteFontManager::instance() {
     static LiteFontManager instance;
     return instance;
 }
 
+LiteFontManager& LiteFontManager::getInstance() {
+    LiteFontManager& manager = instance();
+    if (!manager.m_initialized.load(std::memory_order_acquire)) {
+        manager.waitForInitialization();
+    }
+    return manager;
+}
+
+void LiteFontManager::startInitialization() {
+    LiteFontManager& manager = instance();
+    std::call_once(manager.m_startOnce, [&manager] {
+        if (manager.m_initialized.load(std::memory_order_acquire)) return;
+        manager.m_initStarted.store(true);
+        manager.m_initThread = std::thread([&manager] {
+            std::call_once(manager.m_initOnce, [&manager] { manager.initialize(true); });
+        });
+    });
+}
+
+bool LiteFontManager::isInitialized() {
+    return instance().m_initialized.load(std::memory_order_acquire);
+}
+
 LiteFontManager::LiteFontManager() 
-    : m_defaultFontFamily(LITE_DEFAULT_FONT_FAMILY) {
-    initialize();
+    : m_defaultFontFamily(LITE_DEFAULT_FONT_FAMILY)
+    , m_fallbackSaveGroup(LiteTaskPool::getInstance().createGroup()) {
 }
 
-void LiteFontManager::initialize() {
-    // 创建平台相关的字体管理器
-    m_fontMgr = SkFontMgr_New_FontConfig(nullptr, SkFontScanner_Make_FreeType());
+LiteFontManager::~LiteFontManager() {
+    if (m_initThread.joinable()) {
+        m_initThread.join();
+    }
+
+    // 尚未开始的后台保存改为在这里同步完成，正在进行的等待其结束
+    {
+        std::unique_lock<std::mutex> lock(m_fallbackMutex);
+        if (LiteTaskPool::getInstance().cancel(m_fallbackSaveGroup) > 0) {
+            m_fallbackSaveScheduled = false;
+        }
+        m_fallbackSaveCv.wait(lock, [this] { return !m_fallbackSaveScheduled; });
+    }
+    if (m_fallbackDirty) {
+        saveFallbackCache();
+    }
+}
+
+void LiteFontManager::waitForInitialization() {
+    // 后台线程正在初始化时 call_once 会阻塞到其完成；从未启动过则在当前线程执行
+    auto start = std::chrono::steady_clock::now();
+    std::call_once(m_initOnce, [this] { initialize(false); });
+    auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    if (m_initStarted.load() && waited > 0) {
+        m_initWaitUs.fetch_add(waited);
+        std::cout << "LiteFontManager: waited " << waited / 1000.0
+                  << " ms for background font initialization" << std::endl;
+    }
+}
+
+void LiteFontManager::initialize(bool background) {
+    auto start = std::chrono::steady_clock::now();
+
+    // 应用注册的字体（registerFont）
+    m_fontProvider = sk_make_sp<skia::textlayout::TypefaceFontProvider>();
+
+    // 创建平台相关的字体管理器；不使用系统字体时跳过 fontconfig 扫描，只使用注册的字体
+    if (m_useSystemFonts) {
+        m_fontMgr = SkFontMgr_New_FontConfig(nullptr, SkFontScanner_Make_FreeType());
+    } else {
+        m_fontMgr = m_fontProvider;
+    }
     
-    // 创建字体集合
+    // 创建字体集合（注册的字体优先于系统字体）
     m_fontCollection = sk_make_sp<skia::textlayout::FontCollection>();
+    m_fontCollection->setAssetFontManager(m_fontProvider);
     m_fontCollection->setDefaultFontManager(m_fontMgr);
     m_fontCollection->enableFontFallback();
+
+    preloadDefaultTypefaces();
+
+    m_initTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    m_initialized.store(true, std::memory_order_release);
+
+    std::cout << "LiteFontManager: font initialization took " << m_initTimeMs << " ms ("
+              << (background ? "background" : "synchronous") << ")" << std::endl;
+}
+
+void LiteFontManager::preloadDefaultTypefaces() {
+    // 控件默认只使用常规体和粗体，提前解析以免首帧付出 fontconfig 匹配的代价
+    matchTypeface(std::string(), FontWeight::Normal, FontStyle::Normal);
+    matchTypeface(std::string(), FontWeight::Bold, FontStyle::Normal);
+}
+
+std::string LiteFontManager::getDefaultFontFamily() const {
+    std::lock_guard<std::mutex> lock(m_typefaceMutex);
+    return m_defaultFontFamily;
 }
 
 void LiteFontManager::setDefaultFontFamily(const std::string& family) {
-    m_defaultFontFamily = family;
+    {
+        std::lock_guard<std::mutex> lock(m_typefaceMutex);
+        if (m_defaultFontFamily == family) return;
+        m_defaultFontFamily = family;
+    }
+    // 测量与整形缓存以 FontSpec 为键，空字体族代表默认字体，已缓存的结果对应旧字体；
+    // 先递增版本，正在测量的线程不会把旧结果写回清空后的缓存
+    m_fontGeneration.fetch_add(1, std::memory_order_acq_rel);
+    clearMeasureCache();
+    LiteTextRenderer::getInstance().clearCache();
+    preloadDefaultTypefaces();
+}
+
+SkFontStyle LiteFontManager::toSkFontStyle(FontWeight weight, FontStyle style) {
+    return SkFontStyle(static_cast<int>(weight),
+                       SkFontStyle::kNormal_Width,
+                       style == FontStyle::Italic ? SkFontStyle::kItalic_Slant
+                                                  : SkFontStyle::kUpright_Slant);
+}
+
+sk_sp<SkTypeface> LiteFontManager::matchTypeface(const std::string& fontFamily,
+                                                 FontWeight weight,
+                                                 FontStyle style) const {
+    if (!m_fontMgr) return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_typefaceMutex);
+    const std::string& family = fontFamily.empty() ? m_defaultFontFamily : fontFamily;
+    if (family.empty()) return nullptr;
+
+    SkFontStyle skStyle = toSkFontStyle(weight, style);
+    TypefaceKey key{family, skStyle.weight(), static_cast<int>(skStyle.slant())};
+
+    auto it = m_typefaceCache.find(key);
+    if (it != m_typefaceCache.end()) {
+        return it->second;
+    }
+
+    // 未命中时才通过 fontconfig 匹配，失败结果也缓存，避免反复查询不存在的字体
+    sk_sp<SkTypeface> typeface = matchFamilyStyleLocked(family, skStyle);
+    m_typefaceCache.emplace(std::move(key), typeface);
+    return typeface;
+}
+
+sk_sp<SkTypeface> LiteFontManager::matchFamilyStyleLocked(const std::string& family,
+                                                          const SkFontStyle& style) const {
+    if (m_fontProvider) {
+        sk_sp<SkTypeface> typeface = m_fontProvider->matchFamilyStyle(family.c_str(), style);
+        if (typeface) return typeface;
+    }
+    if (m_fontMgr && m_fontMgr.get() != m_fontProvider.get()) {
+        return m_fontMgr->matchFamilyStyle(family.c_str(), style);
+    }
+    return nullptr;
+}
+
+void LiteFontManager::setUseSystemFonts(bool enabled) {
+    LiteFontManager& manager = instance();
+    if (manager.m_initialized.load() || manager.m_initStarted.load()) {
+        std::cerr << "LiteFontManager: setUseSystemFonts must be called before font initialization" << std::endl;
+        return;
+    }
+    manager.m_useSystemFonts = enabled;
+}
+
+bool LiteFontManager::registerFont(const std::string& path, const std::string& alias) {
+    // 内存映射字体文件：字形数据按需换入，不整体读入内存
+    sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+    if (!data) {
+        std::cerr << "LiteFontManager: Failed to map font file: " << path << std::endl;
+        return false;
+    }
+    return registerFont(std::move(data), alias);
+}
+
+bool LiteFontManager::registerFont(const void* data, size_t length, const std::string& alias) {
+    if (!data || length == 0) return false;
+    return registerFont(SkData::MakeWithCopy(data, length), alias);
 }
 
-SkFont LiteFontManager::createFont(float fontSize, const std::string& fontFamily) const {
+bool LiteFontManager::registerFont(sk_sp<SkData> data, const std::string& alias) {
+    if (!data || !m_fontProvider) return false;
+
+    // 直接用 FreeType 解析，不经过 fontconfig
+    auto scanner = SkFontScanner_Make_FreeType();
+    sk_sp<SkTypeface> typeface = scanner->MakeFromStream(SkMemoryStream::Make(std::move(data)),
+                                                         SkFontArguments());
+    if (!typeface) {
+        std::cerr << "LiteFontManager: Failed to load font data" << (alias.empty() ? "" : " for ")
+                  << alias << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_typefaceMutex);
+        if (alias.empty()) {
+            m_fontProvider->registerTypeface(typeface);
+        } else {
+            m_fontProvider->registerTypeface(typeface, SkString(alias.c_str()));
+        }
+        // 之前缓存的匹配结果（包括失败结果）可能已不再正确
+        m_typefaceCache.clear();
+    }
+
+    m_fontGeneration.fetch_add(1, std::memory_order_acq_rel);
+    clearFallbackCache();
+    clearMeasureCache();
+    m_fontCollection->clearCaches();
+    LiteTextRenderer::getInstance().clearCache();
+    preloadDefaultTypefaces();
+    return true;
+}
+
+std::vector<std::string> LiteFontManager::getRegisteredFamilies() const {
+    std::vector<std::string> families;
+    std::lock_guard<std::mutex> lock(m_typefaceMutex);
+    if (!m_fontProvider) return families;
+    int count = m_fontProvider->countFamilies();
+    for (int i = 0; i < count; ++i) {
+        SkString name;
+        m_fontProvider->getFamilyName(i, &name);
+        families.emplace_back(name.c_str());
+    }
+    return families;
+}
+
+SkFont LiteFontManager::createFont(float fontSize, const std::string& fontFamily,
+                                   FontWeight weight, FontStyle style) const {
     SkFont font;
     font.setSize(fontSize);
     
-    // 尝试加载指定字体
-    const std::string& family = fontFamily.empty() ? m_defaultFontFamily : fontFamily;
-    if (m_fontMgr && !family.empty()) {
-        sk_sp<SkTypeface> typeface = m_fontMgr->matchFamilyStyle(family.c_str(), SkFontStyle::Normal());
-        if (typeface) {
-            font.setTypeface(typeface);
-        }
+    // 尝试加载指定字体（命中缓存时不再访问 fontconfig）
+    sk_sp<SkTypeface> typeface = matchTypeface(fontFamily, weight, style);
+    if (typeface) {
+        font.setTypeface(typeface);
     }
     
     return font;
@@ -52,18 +277,23 @@ SkFont LiteFontManager::createFont(float fontSize, const std::string& fontFamily
 skia::textlayout::TextStyle LiteFontManager::createTextStyle(
     const Color& color,
     float fontSize,
-    const std::string& fontFamily) const {
+    const std::string& fontFamily,
+    FontWeight weight,
+    FontStyle style) const {
     
     using namespace skia::textlayout;
     
-    TextStyle style;
-    style.setColor(color.toARGB());
-    style.setFontSize(fontSize);
+    TextStyle textStyle;
+    textStyle.setColor(color.toARGB());
+    textStyle.setFontSize(fontSize);
+    textStyle.setFontStyle(toSkFontStyle(weight, style));
     
-    const std::string& family = fontFamily.empty() ? m_defaultFontFamily : fontFamily;
-    style.setFontFamilies({SkString(family.c_str())});
+    // 已知的回退字体族排在请求字体之后，skparagraph 会先按字体族匹配，避免按字符搜索系统字体；
+    // 列表按字体族与样式缓存，回退结果变化前不重新生成
+    std::string family = fontFamily.empty() ? getDefaultFontFamily() : fontFamily;
+    textStyle.setFontFamilies(getStyleFamilies(family, toSkFontStyle(weight, style)));
     
-    return style;
+    return textStyle;
 }
 
 skia::textlayout::ParagraphStyle LiteFontManager::createParagraphStyle(TextAlign textAlign) const {
@@ -87,4 +317,631 @@ skia::textlayout::ParagraphStyle LiteFontManager::createParagraphStyle(TextAlign
     return style;
 }
 
+TextMetrics LiteFontManager::measureText(const std::string& text, const FontSpec& font,
+                                         float maxWidth) const {
+    if (text.empty()) return TextMetrics{};
+    if (maxWidth < 0) maxWidth = 0;
+
+    MeasureKey key{text, font, maxWidth};
+    {
+        std::lock_guard<std::mutex> lock(m_measureMutex);
+        auto it = m_measureCache.find(key);
+        if (it != m_measureCache.end()) {
+            return it->second;
+        }
+    }
+
+    uint64_t generation = getFontGeneration();
+    TextMetrics metrics = measureTextUncached(text, font, maxWidth);
+
+    // 测量期间字体配置变化（缓存已被清空）时不写入按旧字体得到的结果
+    std::lock_guard<std::mutex> lock(m_measureMutex);
+    if (generation != getFontGeneration()) return metrics;
+    if (m_measureCache.size() >= kMaxMeasureCacheSize) {
+        m_measureCache.clear();
+    }
+    m_measureCache.emplace(std::move(key), metrics);
+    return metrics;
+}
+
+TextMetrics LiteFontManager::measureTextUncached(const std::string& text, const FontSpec& font,
+                                                 float maxWidth) const {
+    TextMetrics metrics;
+
+    // 单行简单文本：复用整形缓存，绘制时无需再次整形
+    if (LiteTextRenderer::isSimpleText(text)) {
+        auto shaped = LiteTextRenderer::getInstance().shape(text, font);
+        if (shaped && (maxWidth <= 0 || shaped->getWidth() <= maxWidth)) {
+            metrics.width = shaped->getWidth();
+            metrics.height = shaped->getHeight();
+            metrics.baseline = shaped->getBaseline();
+            metrics.lineCount = 1;
+            return metrics;
+        }
+    }
+
+    using namespace skia::textlayout;
+    ParagraphStyle paraStyle;
+    auto textStyle = createTextStyle(Color::Black(), font.fontSize, font.fontFamily,
+                                     font.weight, font.style);
+    auto builder = ParagraphBuilder::make(paraStyle, m_fontCollection);
+    builder->pushStyle(textStyle);
+    builder->addText(text.c_str(), text.size());
+
+    auto paragraph = builder->Build();
+    paragraph->layout(maxWidth > 0 ? maxWidth : std::numeric_limits<float>::max());
+
+    metrics.width = paragraph->getLongestLine();
+    metrics.height = paragraph->getHeight();
+    metrics.baseline = paragraph->getAlphabeticBaseline();
+    metrics.lineCount = static_cast<int>(paragraph->lineNumber());
+    return metrics;
+}
+
+void LiteFontManager::clearMeasureCache() {
+    std::lock_guard<std::mutex> lock(m_measureMutex);
+    m_measureCache.clear();
+}
+
+// ==================== 字体回退 ====================
+
+namespace {
+
+const char* const kScriptNames[] = {
+    "latin", "greek", "cyrillic", "armenian", "hebrew", "arabic", "indic", "thai", "lao",
+    "tibetan", "myanmar", "georgian", "hangul", "kana", "han", "symbols", "emoji", "other"
+};
+static_assert(sizeof(kScriptNames) / sizeof(kScriptNames[0]) == static_cast<size_t>(FallbackScript::Count),
+              "kScriptNames must match FallbackScript");
+
+const char* const kFallbackCacheHeader = "# liteDui font fallback cache v1";
+
+std::string trim(const std::string& str) {
+    size_t begin = str.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return std::string();
+    size_t end = str.find_last_not_of(" \t\r\n");
+    return str.substr(begin, end - begin + 1);
+}
+
+std::string familyNameOf(const sk_sp<SkTypeface>& typeface) {
+    SkString name;
+    typeface->getFamilyName(&name);
+    return std::string(name.c_str());
+}
+
+} // namespace
+
+FallbackScript LiteFontManager::classifyScript(SkUnichar c) {
+    if (c < 0x0370) return FallbackScript::Latin;       // 基本拉丁、拉丁扩展、IPA、组合附加符号
+    if (c < 0x0400) return FallbackScript::Greek;
+    if (c < 0x0530) return FallbackScript::Cyrillic;
+    if (c < 0x0590) return FallbackScript::Armenian;
+    if (c < 0x0600) return FallbackScript::Hebrew;
+    if (c < 0x0900) return FallbackScript::Arabic;      // 含叙利亚文、它拿字母
+    if (c < 0x0E00) return FallbackScript::Indic;
+    if (c < 0x0E80) return FallbackScript::Thai;
+    if (c < 0x0F00) return FallbackScript::Lao;
+    if (c < 0x1000) return FallbackScript::Tibetan;
+    if (c < 0x10A0) return FallbackScript::Myanmar;
+    if (c < 0x1100) return FallbackScript::Georgian;
+    if (c < 0x1200) return FallbackScript::Hangul;      // 谚文字母
+    if (c >= 0x1E00 && c < 0x1F00) return FallbackScript::Latin;
+    if (c >= 0x1F00 && c < 0x2000) return FallbackScript::Greek;
+    if (c >= 0x2000 && c < 0x2C00) return FallbackScript::Symbols;   // 标点、箭头、数学符号、制表符、杂项符号
+    if (c >= 0x2C60 && c < 0x2C80) return FallbackScript::Latin;
+    if (c >= 0x2E80 && c < 0x3040) return FallbackScript::Han;       // 部首、CJK 标点
+    if (c >= 0x3040 && c < 0x3100) return FallbackScript::Kana;
+    if (c >= 0x3100 && c < 0x3130) return FallbackScript::Han;       // 注音符号
+    if (c >= 0x3130 && c < 0x3190) return FallbackScript::Hangul;
+    if (c >= 0x31F0 && c < 0x3200) return FallbackScript::Kana;
+    if (c >= 0x3190 && c < 0xA000) return FallbackScript::Han;       // CJK 统一汉字及扩展 A
+    if (c >= 0xA720 && c < 0xA800) return FallbackScript::Latin;
+    if (c >= 0xAC00 && c < 0xD7B0) return FallbackScript::Hangul;
+    if (c >= 0xF900 && c < 0xFB00) return FallbackScript::Han;
+    if (c >= 0xFB1D && c < 0xFB50) return FallbackScript::Hebrew;
+    if (c >= 0xFB50 && c < 0xFE00) return FallbackScript::Arabic;
+    if (c >= 0xFE30 && c < 0xFE50) return FallbackScript::Han;
+    if (c >= 0xFE70 && c < 0xFF00) return FallbackScript::Arabic;
+    if (c >= 0xFF00 && c < 0xFFF0) return FallbackScript::Han;       // 全角/半角形式
+    if (c >= 0x1F000 && c < 0x1FB00) return FallbackScript::Emoji;
+    if (c >= 0x20000 && c < 0x40000) return FallbackScript::Han;     // CJK 扩展 B 及之后
+    return FallbackScript::Other;
+}
+
+const char* LiteFontManager::getScriptName(FallbackScript script) {
+    size_t index = static_cast<size_t>(script);
+    return index < static_cast<size_t>(FallbackScript::Count) ? kScriptNames[index] : "other";
+}
+
+bool LiteFontManager::parseScriptName(const std::string& name, FallbackScript& script) {
+    for (size_t i = 0; i < static_cast<size_t>(FallbackScript::Count); ++i) {
+        if (name == kScriptNames[i]) {
+            script = static_cast<FallbackScript>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+sk_sp<SkTypeface> LiteFontManager::matchFallbackTypeface(const std::string& fontFamily,
+                                                         SkUnichar character,
+                                                         FontWeight weight,
+                                                         FontStyle style) const {
+    if (!m_fontMgr) return nullptr;
+    std::string family = fontFamily.empty() ? getDefaultFontFamily() : fontFamily;
+
+    SkFontStyle skStyle = toSkFontStyle(weight, style);
+    FallbackScript script = classifyScript(character);
+    FallbackKey key{family, script, skStyle.weight(), static_cast<int>(skStyle.slant())};
+
+    std::lock_guard<std::mutex> lock(m_fallbackMutex);
+    auto it = m_fallbackCache.find(key);
+    if (it != m_fallbackCache.end()) {
+        FallbackEntry& entry = it->second;
+        if (!entry.resolved) {
+            // 从缓存文件加载的项：只做字体族名匹配，比按字符搜索便宜得多
+            if (!entry.resolvedFamily.empty()) {
+                std::lock_guard<std::mutex> typefaceLock(m_typefaceMutex);
+                entry.typeface = matchFamilyStyleLocked(entry.resolvedFamily, skStyle);
+            }
+            entry.resolved = true;
+        }
+        if (entry.typeface && entry.typeface->unicharToGlyph(character) != 0) {
+            entry.verified = true;
+            return entry.typeface;
+        }
+        if (entry.verified && !entry.typeface) {
+            return nullptr;
+        }
+        if (!entry.verified) {
+            // 缓存文件中的结果已失效（字体被卸载或替换），以新结果为准
+            sk_sp<SkTypeface> typeface = discoverFallbackLocked(family, script, character, skStyle);
+            entry.typeface = typeface;
+            entry.resolvedFamily = typeface ? familyNameOf(typeface) : std::string();
+            entry.verified = true;
+            ++m_fallbackVersion;
+            scheduleFallbackSaveLocked();
+            return typeface;
+        }
+
+        // 同一分类中该字体恰好缺少此字符：按字符单独搜索并缓存（包括找不到的结果），不覆盖分类的结果
+        FallbackCharacterKey characterKey{family, character, key.weight, key.slant};
+        auto cached = m_fallbackCharacters.find(characterKey);
+        if (cached != m_fallbackCharacters.end()) {
+            return cached->second;
+        }
+        sk_sp<SkTypeface> typeface = discoverFallbackLocked(family, script, character, skStyle);
+        if (m_fallbackCharacters.size() >= kMaxFallbackCharacters) {
+            m_fallbackCharacters.clear();
+        }
+        m_fallbackCharacters.emplace(std::move(characterKey), typeface);
+        return typeface;
+    }
+
+    sk_sp<SkTypeface> typeface = discoverFallbackLocked(family, script, character, skStyle);
+    FallbackEntry entry;
+    entry.typeface = typeface;
+    entry.resolvedFamily = typeface ? familyNameOf(typeface) : std::string();
+    entry.resolved = true;
+    entry.verified = true;
+    m_fallbackCache.emplace(std::move(key), std::move(entry));
+    ++m_fallbackVersion;
+    scheduleFallbackSaveLocked();
+    return typeface;
+}
+
+sk_sp<SkTypeface> LiteFontManager::discoverFallbackLocked(const std::string& family,
+                                                          FallbackScript script,
+                                                          SkUnichar character,
+                                                          const SkFontStyle& style) const {
+    {
+        // 先尝试配置的回退链，再尝试注册的字体，都只需要按字体族名匹配
+        std::lock_guard<std::mutex> typefaceLock(m_typefaceMutex);
+        for (const auto& candidate : m_fallbackChains[static_cast<size_t>(script)]) {
+            sk_sp<SkTypeface> typeface = matchFamilyStyleLocked(candidate, style);
+            if (typeface && typeface->unicharToGlyph(character) != 0) {
+                return typeface;
+            }
+        }
+        int count = m_fontProvider ? m_fontProvider->countFamilies() : 0;
+        for (int i = 0; i < count; ++i) {
+            SkString name;
+            m_fontProvider->getFamilyName(i, &name);
+            sk_sp<SkTypeface> typeface = m_fontProvider->matchFamilyStyle(name.c_str(), style);
+            if (typeface && typeface->unicharToGlyph(character) != 0) {
+                return typeface;
+            }
+        }
+    }
+    if (m_fontMgr.get() == m_fontProvider.get()) return nullptr;
+
+    // 最后才按字符搜索系统字体（fontconfig 下代价较高）
+    return m_fontMgr->matchFamilyStyleCharacter(family.c_str(), style, nullptr, 0, character);
+}
+
+void LiteFontManager::setFallbackChain(FallbackScript script, const std::vector<std::string>& families) {
+    size_t index = static_cast<size_t>(script);
+    if (index >= static_cast<size_t>(FallbackScript::Count)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_fallbackMutex);
+        m_fallbackChains[index] = families;
+        for (auto it = m_fallbackCache.begin(); it != m_fallbackCache.end();) {
+            if (it->first.script == script) {
+                it = m_fallbackCache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        m_fallbackCharacters.clear();
+        ++m_fallbackVersion;
+    }
+
+    // 预先解析回退链中的字体，首次遇到该文字时只剩缓存查找
+    for (const auto& family : families) {
+        matchTypeface(family, FontWeight::Normal, FontStyle::Normal);
+    }
+    clearMeasureCache();
+}
+
+std::vector<std::string> LiteFontManager::getFallbackChain(FallbackScript script) const {
+    size_t index = static_cast<size_t>(script);
+    if (index >= static_cast<size_t>(FallbackScript::Count)) return {};
+    std::lock_guard<std::mutex> lock(m_fallbackMutex);
+    return m_fallbackChains[index];
+}
+
+bool LiteFontManager::loadFallbackConfig(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+
+        FallbackScript script;
+        if (!parseScriptName(trim(line.substr(0, colon)), script)) continue;
+
+        std::vector<std::string> families;
+        std::stringstream list(line.substr(colon + 1));
+        std::string family;
+        while (std::getline(list, family, ',')) {
+            family = trim(family);
+            if (!family.empty()) families.push_back(family);
+        }
+        setFallbackChain(script, families);
+    }
+    return true;
+}
+
+void LiteFontManager::setFallbackCachePath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_fallbackMutex);
+    m_fallbackCachePath = path;
+    if (path.empty()) return;
+
+    std::ifstream file(path);
+    if (!file) return;
+
+    // 每行：请求字体族 \t 分类 \t weight \t slant \t 回退字体族（空表示无可用字体）
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> fields;
+        size_t start = 0;
+        while (true) {
+            size_t tab = line.find('\t', start);
+            fields.push_back(line.substr(start, tab - start));
+            if (tab == std::string::npos) break;
+            start = tab + 1;
+        }
+        if (fields.size() != 5) continue;
+
+        FallbackKey key;
+        key.family = fields[0];
+        if (!parseScriptName(fields[1], key.script)) continue;
+        key.weight = std::atoi(fields[2].c_str());
+        key.slant = std::atoi(fields[3].c_str());
+
+        // 运行中已解析的结果优先
+        FallbackEntry entry;
+        entry.resolvedFamily = fields[4];
+        m_fallbackCache.emplace(std::move(key), std::move(entry));
+    }
+    ++m_fallbackVersion;
+}
+
+bool LiteFontManager::saveFallbackCache() const {
+    // 文件锁在前：内容与写入顺序一致，不会被较早取得内容的后台任务覆盖
+    std::lock_guard<std::mutex> fileLock(m_fallbackFileMutex);
+    std::string path;
+    std::string content;
+    {
+        std::lock_guard<std::mutex> lock(m_fallbackMutex);
+        if (m_fallbackCachePath.empty()) return false;
+        path = m_fallbackCachePath;
+        content = formatFallbackCacheLocked();
+        m_fallbackDirty = false;
+    }
+    return writeFallbackCache(path, content);
+}
+
+std::string LiteFontManager::formatFallbackCacheLocked() const {
+    std::ostringstream out;
+    out << kFallbackCacheHeader << '\n';
+    for (const auto& item : m_fallbackCache) {
+        const FallbackKey& key = item.first;
+        out << key.family << '\t' << getScriptName(key.script) << '\t' << key.weight << '\t'
+            << key.slant << '\t' << item.second.resolvedFamily << '\n';
+    }
+    return out.str();
+}
+
+void LiteFontManager::scheduleFallbackSaveLocked() const {
+    m_fallbackDirty = true;
+    if (m_fallbackSaveScheduled || m_fallbackCachePath.empty()) return;
+    m_fallbackSaveScheduled = true;
+    LiteTaskPool::getInstance().submit(m_fallbackSaveGroup, [this] { flushFallbackCache(); });
+}
+
+void LiteFontManager::flushFallbackCache() const {
+    {
+        // 任务排队期间发现的结果一并写入
+        std::lock_guard<std::mutex> fileLock(m_fallbackFileMutex);
+        std::string path;
+        std::string content;
+        {
+            std::lock_guard<std::mutex> lock(m_fallbackMutex);
+            if (m_fallbackDirty && !m_fallbackCachePath.empty()) {
+                path = m_fallbackCachePath;
+                content = formatFallbackCacheLocked();
+                m_fallbackDirty = false;
+            }
+        }
+        if (!path.empty()) {
+            writeFallbackCache(path, content);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_fallbackMutex);
+    m_fallbackSaveScheduled = false;
+    if (m_fallbackDirty) {
+        scheduleFallbackSaveLocked();
+    }
+    m_fallbackSaveCv.notify_all();
+}
+
+bool LiteFontManager::writeFallbackCache(const std::string& path, const std::string& content) {
+    // 先写临时文件再替换，避免进程中途退出留下半个文件
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file) return false;
+        file << content;
+        if (!file) return false;
+    }
+    std::remove(path.c_str());
+    return std::rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+void LiteFontManager::clearFallbackCache() {
+    std::lock_guard<std::mutex> lock(m_fallbackMutex);
+    m_fallbackCache.clear();
+    m_fallbackCharacters.clear();
+    ++m_fallbackVersion;
+}
+
+std::vector<std::string> LiteFontManager::getFallbackFamilies(const std::string& fontFamily) const {
+    std::string family = fontFamily.empty() ? getDefaultFontFamily() : fontFamily;
+    std::lock_guard<std::mutex> lock(m_fallbackMutex);
+    return collectFallbackFamiliesLocked(family, nullptr);
+}
+
+std::vector<std::string> LiteFontManager::getFallbackFamilies(const std::string& fontFamily, FontWeight weight,
+                                                              FontStyle style) const {
+    std::string family = fontFamily.empty() ? getDefaultFontFamily() : fontFamily;
+    SkFontStyle skStyle = toSkFontStyle(weight, style);
+    std::lock_guard<std::mutex> lock(m_fallbackMutex);
+    return collectFallbackFamiliesLocked(family, &skStyle);
+}
+
+std::vector<SkString> LiteFontManager::getStyleFamilies(const std::string& family, const SkFontStyle& style) const {
+    FallbackKey key{family, FallbackScript::Other, style.weight(), static_cast<int>(style.slant())};
+    std::lock_guard<std::mutex> lock(m_fallbackMutex);
+    auto it = m_styleFamilies.find(key);
+    if (it != m_styleFamilies.end() && it->second.version == m_fallbackVersion) {
+        return it->second.families;
+    }
+
+    StyleFamilies entry;
+    entry.version = m_fallbackVersion;
+    entry.families.emplace_back(family.c_str());
+    for (const auto& fallback : collectFallbackFamiliesLocked(family, &style)) {
+        entry.families.emplace_back(fallback.c_str());
+    }
+    if (it != m_styleFamilies.end()) {
+        it->second = entry;
+    } else {
+        if (m_styleFamilies.size() >= kMaxStyleFamilies) m_styleFamilies.clear();
+        m_styleFamilies.emplace(std::move(key), entry);
+    }
+    return entry.families;
+}
+
+std::vector<std::string> LiteFontManager::collectFallbackFamiliesLocked(const std::string& family,
+                                                                        const SkFontStyle* style) const {
+    std::vector<std::string> families;
+    auto addFamily = [&](const std::string& name) {
+        if (name.empty() || name == family) return;
+        if (std::find(families.begin(), families.end(), name) == families.end()) {
+            families.push_back(name);
+        }
+    };
+
+    // 显式配置的回退链在前；已解析结果排序后追加，保证 TextStyle 稳定（段落缓存依赖它）
+    for (const auto& chain : m_fallbackChains) {
+        for (const auto& name : chain) {
+            addFamily(name);
+        }
+    }
+    std::vector<std::string> resolved;
+    for (const auto& item : m_fallbackCache) {
+        const FallbackKey& key = item.first;
+        if (key.family != family || item.second.resolvedFamily.empty()) continue;
+        if (style && (key.weight != style->weight() || key.slant != static_cast<int>(style->slant()))) continue;
+        resolved.push_back(item.second.resolvedFamily);
+    }
+    std::sort(resolved.begin(), resolved.end());
+    for (const auto& name : resolved) {
+        addFamily(name);
+    }
+    return families;
+}
+
+// ==================== 字形预热 ====================
+
+namespace {
+
+// 界面文本中最常见的汉字与中文标点
+const char* const kCommonCJK =
+    "的一是不了人我在有他这为之大来以个中上们到说国和地也子时道出而要于就下得可你年生自会那后能对着事其"
+    "里所去行过家十用发天如然作方成者多日都三小军二无同么经法当起与好看学进种将还分此心前面又定见只主没公"
+    "从知已两些现山民候手本长使新四高意开力问最走物文体理明实真点向正次名外回水身全期工果入位条门数感声情"
+    "先美月重间白路总部神等变老今给立比信南各加常样受系话通东像关记员相结并反世利义合少特住口接品元程度才"
+    "王直气代战放区化打界提指听很及象原该色张至光克题电认何己资料表格选择设置保存闭取消确删除添编辑搜索查"
+    "找替换复制粘贴剪切件窗帮助视图具错误警告示息功失败载请稍输密码户登录注册退返步完应默刷导印预览排序筛"
+    "列单值类型状态称描述操详更首页尾共第每显隐藏展收传网络连服务器据库配参版检统语言英简繁字颜背景边框宽"
+    "左右居齐顶底"
+    "，。、；：？！“”‘’（）《》【】…—·";
+
+} // namespace
+
+void LiteFontManager::addWarmUpGlyphs(WarmUpGlyphSet set, const FontSpec& font) {
+    std::vector<SkUnichar> characters;
+    switch (set) {
+        case WarmUpGlyphSet::Ascii:
+            for (SkUnichar c = 0x20; c < 0x7F; ++c) {
+                characters.push_back(c);
+            }
+            break;
+        case WarmUpGlyphSet::CommonCJK:
+            for (const auto& info : Utf8Helper::toCodePoints(kCommonCJK)) {
+                characters.push_back(static_cast<SkUnichar>(info.codepoint));
+            }
+            break;
+    }
+    addWarmUpCharacters(characters, font);
+}
+
+void LiteFontManager::addWarmUpText(const std::string& text, const FontSpec& font) {
+    std::vector<SkUnichar> characters;
+    for (const auto& info : Utf8Helper::toCodePoints(text)) {
+        if (info.codepoint > 0x20) {
+            characters.push_back(static_cast<SkUnichar>(info.codepoint));
+        }
+    }
+    addWarmUpCharacters(characters, font);
+}
+
+void LiteFontManager::addWarmUpCharacters(const std::vector<SkUnichar>& characters, const FontSpec& font) {
+    std::lock_guard<std::mutex> lock(m_warmUpMutex);
+    auto& seen = m_warmUpSeen[font];
+
+    WarmUpTask task{font, {}};
+    for (SkUnichar c : characters) {
+        if (!seen.insert(c).second) continue;
+        task.characters.push_back(c);
+        if (task.characters.size() == kWarmUpBatchSize) {
+            m_warmUpTasks.push_back(task);
+            task.characters.clear();
+        }
+    }
+    if (!task.characters.empty()) {
+        m_warmUpTasks.push_back(std::move(task));
+    }
+}
+
+size_t LiteFontManager::getWarmUpTaskCount() const {
+    std::lock_guard<std::mutex> lock(m_warmUpMutex);
+    return m_warmUpTasks.size();
+}
+
+bool LiteFontManager::runWarmUp(SkCanvas* canvas, size_t& cursor, double budgetMs) const {
+    if (!canvas) return false;
+
+    auto start = std::chrono::steady_clock::now();
+    while (true) {
+        WarmUpTask task;
+        {
+            std::lock_guard<std::mutex> lock(m_warmUpMutex);
+            if (cursor >= m_warmUpTasks.size()) return false;
+            task = m_warmUpTasks[cursor++];
+        }
+        drawWarmUpTask(canvas, task);
+
+        double elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= budgetMs) break;
+    }
+
+    std::lock_guard<std::mutex> lock(m_warmUpMutex);
+    return cursor < m_warmUpTasks.size();
+}
+
+void LiteFontManager::drawWarmUpTask(SkCanvas* canvas, const WarmUpTask& task) const {
+    // 与整形绘制使用相同的字体设置，保证命中同一个字形缓存项
+    SkFont primary = LiteTextRenderer::makeFont(task.font);
+
+    // 按字体分组：主字体缺字时使用回退字体（同时预热回退缓存）
+    struct Group {
+        SkFont font;
+        std::vector<SkGlyphID> glyphs;
+    };
+    std::vector<Group> groups;
+    for (SkUnichar c : task.characters) {
+        SkFont font = primary;
+        SkGlyphID glyph = primary.unicharToGlyph(c);
+        if (glyph == 0) {
+            sk_sp<SkTypeface> fallback = matchFallbackTypeface(task.font.fontFamily, c,
+                                                               task.font.weight, task.font.style);
+            if (!fallback) continue;
+            glyph = fallback->unicharToGlyph(c);
+            font.setTypeface(std::move(fallback));
+        }
+        if (groups.empty() || groups.back().font.getTypeface() != font.getTypeface()) {
+            groups.push_back(Group{font, {}});
+        }
+        groups.back().glyphs.push_back(glyph);
+    }
+    if (groups.empty()) return;
+
+    // 字形需要落在表面内才会被光栅化，按网格排布
+    float cell = std::ceil(task.font.fontSize * 1.25f);
+    int columns = std::max(1, static_cast<int>(kWarmUpSurfaceSize / cell));
+    int rows = std::max(1, static_cast<int>(kWarmUpSurfaceSize / cell));
+
+    SkTextBlobBuilder builder;
+    int index = 0;
+    for (const auto& group : groups) {
+        const auto& run = builder.allocRunPos(group.font, static_cast<int>(group.glyphs.size()));
+        SkPoint* points = run.points();
+        for (size_t i = 0; i < group.glyphs.size(); ++i, ++index) {
+            run.glyphs[i] = group.glyphs[i];
+            points[i] = SkPoint::Make((index % columns) * cell,
+                                      ((index / columns) % rows + 1) * cell);
+        }
+    }
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorBLACK);
+    canvas->clear(SK_ColorTRANSPARENT);
+    canvas->drawTextBlob(builder.make(), 0, 0, paint);
+}
+
 } // namespace liteDui
@@ -0,0 +1,171 @@
+/**
+ * lite_row_prefetcher.cpp - 行文本整形预取实现
+ */
+
+#include "lite_row_prefetcher.h"
+#include "lite_task_pool.h"
+#include "lite_text_renderer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace liteDui {
+
+namespace {
+
+// 速度低于每秒半屏时视为静止，两侧各预取半屏
+constexpr float kIdleScreensPerSecond = 0.5f;
+// 向前预取最多 4 屏
+constexpr float kMaxAheadScreens = 4.0f;
+// 两帧间隔超过该值时认为滚动已停止，重新开始估计速度
+constexpr float kMaxSampleInterval = 0.5f;
+
+} // namespace
+
+LiteRowPrefetcher::LiteRowPrefetcher()
+    : m_group(LiteTaskPool::getInstance().createGroup())
+    , m_state(std::make_shared<SharedState>()) {
+}
+
+LiteRowPrefetcher::~LiteRowPrefetcher() {
+    cancel();
+}
+
+void LiteRowPrefetcher::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    if (!enabled) cancel();
+}
+
+void LiteRowPrefetcher::cancel() {
+    m_state->generation.fetch_add(1);
+    LiteTaskPool::getInstance().cancel(m_group);
+    m_submittedBegin = m_submittedEnd = 0;
+}
+
+void LiteRowPrefetcher::shiftRows(size_t count) {
+    if (count == 0) return;
+    auto shift = [count](size_t row) { return row > count ? row - count : 0; };
+    m_state->shifted.fetch_add(count);
+    m_state->windowBegin.store(shift(m_state->windowBegin.load()));
+    m_state->windowEnd.store(shift(m_state->windowEnd.load()));
+    m_submittedBegin = shift(m_submittedBegin);
+    m_submittedEnd = shift(m_submittedEnd);
+    // 调用方随后按删除的高度调整滚动位置，速度估计不应把它当作滚动
+    if (m_hasLastSample) {
+        m_lastScrollY -= static_cast<float>(count) * m_lastRowHeight;
+    }
+}
+
+void LiteRowPrefetcher::update(float scrollY, float rowHeight, size_t firstVisible, size_t lastVisible,
+                               size_t rowCount, const FontSpec& font, const RowTextProvider& provider) {
+    if (!m_enabled || rowHeight <= 0 || rowCount == 0 || lastVisible < firstVisible) return;
+
+    // 更新滚动速度
+    auto now = std::chrono::steady_clock::now();
+    if (m_hasLastSample) {
+        float dt = std::chrono::duration<float>(now - m_lastSampleTime).count();
+        if (dt > kMaxSampleInterval) {
+            m_velocity = 0.0f;
+        } else if (dt > 0) {
+            float instant = (scrollY - m_lastScrollY) / rowHeight / dt;
+            m_velocity = 0.6f * instant + 0.4f * m_velocity;
+        }
+    }
+    m_hasLastSample = true;
+    m_lastScrollY = scrollY;
+    m_lastRowHeight = rowHeight;
+    m_lastSampleTime = now;
+
+    if (font != m_font) {
+        cancel();
+        m_font = font;
+    }
+
+    // 计算预取窗口（包含可见行）
+    size_t visibleCount = lastVisible - firstVisible + 1;
+    float speed = std::fabs(m_velocity);
+    size_t begin = firstVisible;
+    size_t end = lastVisible + 1;
+    if (speed < visibleCount * kIdleScreensPerSecond) {
+        size_t half = std::max<size_t>(visibleCount / 2, 1);
+        begin = firstVisible > half ? firstVisible - half : 0;
+        end = lastVisible + 1 + half;
+    } else {
+        float ahead = std::min(visibleCount + speed * m_lookahead, visibleCount * kMaxAheadScreens);
+        size_t aheadRows = static_cast<size_t>(std::ceil(ahead));
+        if (m_velocity > 0) {
+            end = lastVisible + 1 + aheadRows;
+        } else {
+            begin = firstVisible > aheadRows ? firstVisible - aheadRows : 0;
+        }
+    }
+    end = std::min(end, rowCount);
+
+    // 新窗口与已提交窗口不相交（跳转、反向快速滚动）：整体取消后重新提交
+    bool overlaps = begin < m_submittedEnd && m_submittedBegin < end;
+    if (!overlaps && m_submittedEnd > m_submittedBegin) {
+        cancel();
+    }
+    m_state->windowBegin.store(begin);
+    m_state->windowEnd.store(end);
+
+    // 需要提交的行：窗口内、不可见、且之前未提交过，按与视口的距离由近到远
+    std::vector<size_t> rows;
+    for (size_t row = begin; row < end; ++row) {
+        if (row >= firstVisible && row <= lastVisible) continue;
+        if (row >= m_submittedBegin && row < m_submittedEnd) continue;
+        rows.push_back(row);
+    }
+    m_submittedBegin = begin;
+    m_submittedEnd = end;
+    if (rows.empty()) return;
+
+    std::stable_sort(rows.begin(), rows.end(), [firstVisible, lastVisible](size_t a, size_t b) {
+        size_t da = a < firstVisible ? firstVisible - a : a - lastVisible;
+        size_t db = b < firstVisible ? firstVisible - b : b - lastVisible;
+        return da < db;
+    });
+
+    Batch batch;
+    for (size_t row : rows) {
+        batch.rows.push_back(row);
+        batch.texts.emplace_back();
+        provider(row, batch.texts.back());
+        if (batch.rows.size() == kBatchRows) {
+            submitBatch(std::move(batch));
+            batch = Batch();
+        }
+    }
+    if (!batch.rows.empty()) {
+        submitBatch(std::move(batch));
+    }
+}
+
+void LiteRowPrefetcher::submitBatch(Batch&& batch) {
+    auto state = m_state;
+    uint64_t generation = state->generation.load();
+    size_t shifted = state->shifted.load();
+    FontSpec font = m_font;
+    auto task = std::make_shared<Batch>(std::move(batch));
+
+    LiteTaskPool::getInstance().submit(m_group, [state, generation, shifted, font, task] {
+        auto& renderer = LiteTextRenderer::getInstance();
+        for (size_t i = 0; i < task->rows.size(); ++i) {
+            // 已取消，该行已被删除，或已滑出预取窗口
+            if (state->generation.load() != generation) return;
+            size_t delta = state->shifted.load() - shifted;
+            if (task->rows[i] < delta) continue;
+            size_t row = task->rows[i] - delta;
+            if (row < state->windowBegin.load() || row >= state->windowEnd.load()) continue;
+
+            for (const auto& text : task->texts[i]) {
+                // 只有快速路径的文本有整形缓存，其余文本绘制时走段落排版
+                if (!text.empty() && LiteTextRenderer::isSimpleText(text)) {
+                    renderer.shape(text, font);
+                }
+            }
+        }
+    });
+}
+
+} // namespace liteDui
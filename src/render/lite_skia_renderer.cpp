@@ -3,6 +3,7 @@
  */
 
 #include "lite_skia_renderer.h"
+#include "lite_font_manager.h"
 #include <GLFW/glfw3.h>
 #include "include/gpu/ganesh/GrBackendSurface.h"
 #include "include/gpu/ganesh/gl/GrGLInterface.h"
@@ -72,6 +73,7 @@ void LiteSkiaRenderer::initSkia() {
 }
 
 void LiteSkiaRenderer::cleanupSkia() {
+    m_warmUpSurface.reset();
     m_surface.reset();
     m_context.reset();
 }
@@ -95,4 +97,23 @@ void LiteSkiaRenderer::end() {
     }
 }
 
+bool LiteSkiaRenderer::warmUpGlyphs(double budgetMs) {
+    if (!m_context || !LiteFontManager::isInitialized()) return false;
+
+    auto& fontManager = LiteFontManager::getInstance();
+    if (m_warmUpCursor >= fontManager.getWarmUpTaskCount()) return false;
+
+    // 字形图集属于 GrDirectContext，绘制到同一上下文的小型离屏表面即可
+    if (!m_warmUpSurface) {
+        int size = LiteFontManager::kWarmUpSurfaceSize;
+        m_warmUpSurface = SkSurfaces::RenderTarget(m_context.get(), skgpu::Budgeted::kYes,
+                                                   SkImageInfo::MakeN32Premul(size, size));
+        if (!m_warmUpSurface) return false;
+    }
+
+    bool pending = fontManager.runWarmUp(m_warmUpSurface->getCanvas(), m_warmUpCursor, budgetMs);
+    m_context->flushAndSubmit();
+    return pending;
+}
+
 } // namespace liteDui
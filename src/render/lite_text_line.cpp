@@ -0,0 +1,301 @@
+/**
+ * lite_text_line.cpp - 可编辑单行文本布局实现
+ */
+
+#include "lite_text_line.h"
+#include "lite_utf8.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "modules/skparagraph/include/Paragraph.h"
+#include "modules/skparagraph/include/ParagraphBuilder.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace liteDui {
+
+namespace {
+
+// 片段最大字节数：无空格的长串按此长度强制切分
+constexpr size_t kMaxSegmentBytes = 64;
+
+inline uint32_t decodeAt(const std::string& text, size_t pos) {
+    auto c = static_cast<unsigned char>(text[pos]);
+    size_t n = static_cast<size_t>(Utf8Helper::getCharByteLength(c));
+    if (n == 1 || pos + n > text.size()) return c;
+    uint32_t cp = c & (0x7F >> n);
+    for (size_t k = 1; k < n; ++k) {
+        cp = (cp << 6) | (static_cast<unsigned char>(text[pos + k]) & 0x3F);
+    }
+    return cp;
+}
+
+// 不能作为片段起点的码点：组合附加符号、ZWJ、变体选择符、肤色修饰符
+inline bool isAttachingCodePoint(uint32_t cp) {
+    return (cp >= 0x0300 && cp <= 0x036F) ||
+           (cp >= 0x1AB0 && cp <= 0x1AFF) ||
+           (cp >= 0x1DC0 && cp <= 0x1DFF) ||
+           (cp >= 0x20D0 && cp <= 0x20FF) ||
+           (cp >= 0xFE00 && cp <= 0xFE0F) ||
+           (cp >= 0xFE20 && cp <= 0xFE2F) ||
+           (cp >= 0x1F3FB && cp <= 0x1F3FF) ||
+           (cp >= 0xE0100 && cp <= 0xE01EF) ||
+           cp == 0x200D;
+}
+
+} // namespace
+
+LiteTextLine::LiteTextLine() {
+    rebuild();
+}
+
+LiteTextLine::~LiteTextLine() = default;
+
+void LiteTextLine::setFont(const FontSpec& font) {
+    if (m_font == font) return;
+    m_font = font;
+    rebuild();
+}
+
+void LiteTextLine::setText(const std::string& text) {
+    if (m_text == text) return;
+    m_text = text;
+    rebuild();
+}
+
+void LiteTextLine::rebuild() {
+    m_generation++;
+    m_segments.clear();
+    m_complex = !LiteTextRenderer::isSimpleText(m_text);
+    if (!m_complex) {
+        buildSegments(0, m_text.size(), m_segments);
+    }
+    updateMetrics();
+}
+
+void LiteTextLine::replace(size_t start, size_t end, const std::string& replacement) {
+    size_t oldLength = m_text.size();
+    start = std::min(start, oldLength);
+    end = std::min(std::max(end, start), oldLength);
+    if (start == end && replacement.empty()) return;
+
+    m_text.replace(start, end - start, replacement);
+
+    bool complex = m_complex ? !LiteTextRenderer::isSimpleText(m_text)
+                             : !LiteTextRenderer::isSimpleText(replacement);
+    if (complex || m_complex || m_segments.empty()) {
+        // 复杂文本或状态切换时整体重建
+        rebuild();
+        return;
+    }
+
+    // 受影响的片段：包含 start 前一个字符的片段 ~ 包含 end 处字符的片段，
+    // 这样编辑点两侧的片段会被重新合并整形，不会丢失跨边界的字距
+    size_t first = segmentIndexAt(start > 0 ? start - 1 : 0);
+    size_t last = (end < oldLength) ? segmentIndexAt(end) : m_segments.size() - 1;
+    last = std::max(first, last);
+
+    size_t rangeBegin = m_segments[first].begin;
+    size_t oldRangeEnd = m_segments[last].begin + m_segments[last].length;
+    size_t newRangeEnd = oldRangeEnd + replacement.size() - (end - start);
+
+    std::vector<Segment> rebuilt;
+    buildSegments(rangeBegin, newRangeEnd, rebuilt);
+
+    // 后续片段只需平移起点
+    long delta = static_cast<long>(replacement.size()) - static_cast<long>(end - start);
+    for (size_t i = last + 1; i < m_segments.size(); i++) {
+        m_segments[i].begin = static_cast<size_t>(static_cast<long>(m_segments[i].begin) + delta);
+    }
+
+    m_segments.erase(m_segments.begin() + first, m_segments.begin() + last + 1);
+    m_segments.insert(m_segments.begin() + first,
+                      std::make_move_iterator(rebuilt.begin()),
+                      std::make_move_iterator(rebuilt.end()));
+
+    m_generation++;
+    updateMetrics();
+}
+
+void LiteTextLine::buildSegments(size_t from, size_t to, std::vector<Segment>& out) const {
+    auto& renderer = LiteTextRenderer::getInstance();
+    size_t segStart = from;
+    size_t pos = from;
+    while (pos < to) {
+        auto c = static_cast<unsigned char>(m_text[pos]);
+        size_t next = std::min(pos + static_cast<size_t>(Utf8Helper::getCharByteLength(c)), to);
+
+        bool split = false;
+        if (c == ' ') {
+            // 空格归入前一个片段
+            split = true;
+        } else if (next - segStart >= kMaxSegmentBytes && next < to &&
+                   !isAttachingCodePoint(decodeAt(m_text, next)) &&
+                   decodeAt(m_text, pos) != 0x200D) {
+            split = true;
+        }
+
+        pos = next;
+        if (split || pos >= to) {
+            Segment segment;
+            segment.begin = segStart;
+            segment.length = pos - segStart;
+            segment.shaped = renderer.shape(m_text.substr(segStart, segment.length), m_font);
+            out.push_back(std::move(segment));
+            segStart = pos;
+        }
+    }
+}
+
+size_t LiteTextLine::segmentIndexAt(size_t offset) const {
+    if (m_segments.empty()) return 0;
+    auto it = std::upper_bound(m_segments.begin(), m_segments.end(), offset,
+                               [](size_t value, const Segment& seg) { return value < seg.begin; });
+    if (it == m_segments.begin()) return 0;
+    return static_cast<size_t>(std::distance(m_segments.begin(), it)) - 1;
+}
+
+void LiteTextLine::updateMetrics() {
+    if (m_complex) {
+        m_segmentX.clear();
+        ensureParagraph(nullptr);
+        m_width = m_paragraph->getMaxIntrinsicWidth();
+        float baseline = m_paragraph->getAlphabeticBaseline();
+        m_ascent = -baseline;
+        m_descent = m_paragraph->getHeight() - baseline;
+        return;
+    }
+
+    // 空文本也需要行高（光标高度）
+    auto empty = LiteTextRenderer::getInstance().shape(std::string(), m_font);
+    m_ascent = empty ? -empty->getBaseline() : -m_font.fontSize;
+    m_descent = empty ? empty->getHeight() - empty->getBaseline() : m_font.fontSize * 0.2f;
+
+    m_segmentX.resize(m_segments.size() + 1);
+    float x = 0.0f;
+    for (size_t i = 0; i < m_segments.size(); i++) {
+        m_segmentX[i] = x;
+        const auto& shaped = m_segments[i].shaped;
+        if (!shaped) continue;
+        x += shaped->getWidth();
+        m_ascent = std::min(m_ascent, -shaped->getBaseline());
+        m_descent = std::max(m_descent, shaped->getHeight() - shaped->getBaseline());
+    }
+    m_segmentX[m_segments.size()] = x;
+    m_width = x;
+}
+
+float LiteTextLine::getXForOffset(size_t byteOffset) const {
+    if (byteOffset == 0 || m_text.empty()) return 0.0f;
+    if (byteOffset >= m_text.size()) return m_width;
+
+    if (m_complex) {
+        ensureParagraph(nullptr);
+        auto it = std::upper_bound(m_paragraphClusterX.begin(), m_paragraphClusterX.end(), byteOffset,
+                                   [](size_t offset, const auto& entry) { return offset < entry.first; });
+        if (it == m_paragraphClusterX.begin()) return 0.0f;
+        return std::prev(it)->second;
+    }
+
+    size_t index = segmentIndexAt(byteOffset);
+    const Segment& segment = m_segments[index];
+    float localX = segment.shaped ? segment.shaped->getXForOffset(byteOffset - segment.begin) : 0.0f;
+    return m_segmentX[index] + localX;
+}
+
+size_t LiteTextLine::getOffsetForX(float x) const {
+    if (m_text.empty() || x <= 0) return 0;
+    if (x >= m_width) return m_text.size();
+
+    if (m_complex) {
+        // 复杂文本可能包含从右到左的 run，直接取最近的簇边界
+        ensureParagraph(nullptr);
+        size_t best = m_text.size();
+        float bestDist = std::abs(m_width - x);
+        for (const auto& entry : m_paragraphClusterX) {
+            float dist = std::abs(entry.second - x);
+            if (dist < bestDist) {
+                bestDist = dist;
+                best = entry.first;
+            }
+        }
+        return best;
+    }
+
+    auto it = std::upper_bound(m_segmentX.begin(), m_segmentX.end() - 1, x);
+    size_t index = static_cast<size_t>(std::distance(m_segmentX.begin(), it));
+    index = (index == 0) ? 0 : index - 1;
+    const Segment& segment = m_segments[index];
+    if (!segment.shaped) return segment.begin;
+    return segment.begin + segment.shaped->getOffsetForX(x - m_segmentX[index]);
+}
+
+void LiteTextLine::draw(SkCanvas* canvas, float x, float top, const Color& color,
+                        float visibleLeft, float visibleRight) const {
+    if (m_text.empty()) return;
+
+    if (m_complex) {
+        ensureParagraph(&color);
+        m_paragraph->paint(canvas, x, top);
+        return;
+    }
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(color.toARGB());
+
+    float baselineY = top + getBaseline();
+    auto it = std::upper_bound(m_segmentX.begin(), m_segmentX.end() - 1, visibleLeft);
+    size_t index = static_cast<size_t>(std::distance(m_segmentX.begin(), it));
+    index = (index == 0) ? 0 : index - 1;
+    for (; index < m_segments.size() && m_segmentX[index] < visibleRight; index++) {
+        const auto& shaped = m_segments[index].shaped;
+        if (shaped && shaped->getBlob()) {
+            canvas->drawTextBlob(shaped->getBlob(), x + m_segmentX[index], baselineY, paint);
+        }
+    }
+}
+
+void LiteTextLine::ensureParagraph(const Color* color) const {
+    bool positionsValid = m_paragraph && m_paragraphGeneration == m_generation;
+    if (positionsValid && (!color || color->toARGB() == m_paragraphColor.toARGB())) {
+        return;
+    }
+    if (color) {
+        m_paragraphColor = *color;
+    }
+
+    using namespace skia::textlayout;
+    auto& fontMgr = LiteFontManager::getInstance();
+    ParagraphStyle paraStyle;
+    paraStyle.setTextAlign(skia::textlayout::TextAlign::kLeft);
+    auto textStyle = fontMgr.createTextStyle(m_paragraphColor, m_font.fontSize,
+                                             m_font.fontFamily, m_font.weight, m_font.style);
+
+    auto builder = ParagraphBuilder::make(paraStyle, fontMgr.getFontCollection());
+    builder->pushStyle(textStyle);
+    builder->addText(m_text.c_str(), m_text.size());
+    m_paragraph = builder->Build();
+    m_paragraph->layout(std::numeric_limits<float>::max());
+    m_paragraphGeneration = m_generation;
+
+    if (positionsValid) return;
+
+    // 一次遍历所有字形，建立 字节偏移 -> x 表
+    m_paragraphClusterX.clear();
+    m_paragraph->visit([this](int, const Paragraph::VisitorInfo* info) {
+        if (!info) return;
+        for (int i = 0; i < info->count; i++) {
+            m_paragraphClusterX.emplace_back(info->utf8Starts[i],
+                                             info->origin.fX + info->positions[i].fX);
+        }
+    });
+    std::stable_sort(m_paragraphClusterX.begin(), m_paragraphClusterX.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    m_paragraphClusterX.erase(
+        std::unique(m_paragraphClusterX.begin(), m_paragraphClusterX.end(),
+                    [](const auto& a, const auto& b) { return a.first == b.first; }),
+        m_paragraphClusterX.end());
+}
+
+} // namespace liteDui
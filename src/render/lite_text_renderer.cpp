@@ -0,0 +1,495 @@
+/**
+ * lite_text_renderer.cpp - 单行文本快速绘制实现
+ */
+
+#include "lite_text_renderer.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkFontMetrics.h"
+#include "include/core/SkPaint.h"
+#include "modules/skparagraph/include/Paragraph.h"
+#include "modules/skparagraph/include/ParagraphBuilder.h"
+#include "modules/skshaper/include/SkShaper.h"
+#include "modules/skshaper/include/SkShaper_harfbuzz.h"
+#include "modules/skunicode/include/SkUnicode_icu.h"
+#include <algorithm>
+
+namespace liteDui {
+
+namespace {
+
+// 解码一个 UTF-8 码点，非法序列按单字节处理
+inline uint32_t decodeUtf8(const unsigned char* s, size_t len, size_t& i) {
+    unsigned char c = s[i];
+    if (c < 0x80) { i += 1; return c; }
+    int n = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : (c >= 0xC0) ? 2 : 1;
+    if (n == 1 || i + n > len) { i += 1; return 0xFFFD; }
+    uint32_t cp = c & (0x7F >> n);
+    for (int k = 1; k < n; ++k) {
+        cp = (cp << 6) | (s[i + k] & 0x3F);
+    }
+    i += n;
+    return cp;
+}
+
+// 需要段落排版处理的码点：双向文本、复杂文字、双向控制符与行/段分隔符
+inline bool needsParagraphLayout(uint32_t cp) {
+    if (cp < 0x0590) return false;
+    return (cp >= 0x0590 && cp <= 0x08FF) ||    // 希伯来文、阿拉伯文、叙利亚文、它拿字母等
+           (cp >= 0x0900 && cp <= 0x0DFF) ||    // 印度系文字
+           (cp >= 0x0E00 && cp <= 0x0FFF) ||    // 泰文、老挝文、藏文
+           (cp >= 0x1000 && cp <= 0x109F) ||    // 缅甸文
+           (cp >= 0x1780 && cp <= 0x18AF) ||    // 高棉文、蒙古文
+           (cp >= 0x200E && cp <= 0x200F) ||    // LRM / RLM
+           (cp >= 0x2028 && cp <= 0x202E) ||    // 行/段分隔符、嵌入与覆盖控制符
+           (cp >= 0x2066 && cp <= 0x2069) ||    // 隔离控制符
+           (cp >= 0xA980 && cp <= 0xA9DF) ||    // 爪哇文
+           (cp >= 0xFB1D && cp <= 0xFDFF) ||    // 希伯来/阿拉伯表现形式 A
+           (cp >= 0xFE70 && cp <= 0xFEFF) ||    // 阿拉伯表现形式 B
+           (cp >= 0x10800 && cp <= 0x10FFF) ||  // 古代从右到左文字
+           (cp >= 0x1E800 && cp <= 0x1EFFF);    // 阿德拉姆文等
+}
+
+/**
+ * 字体分段迭代器
+ * 逻辑与 SkShaper::MakeFontMgrRunIterator 相同，但缺字时通过 LiteFontManager 的
+ * 回退缓存查找字体，避免每次整形都按字符搜索系统字体
+ */
+class CachedFallbackFontRunIterator final : public SkShaper::FontRunIterator {
+public:
+    CachedFallbackFontRunIterator(const char* utf8, size_t len, const SkFont& font, const FontSpec& spec)
+        : m_text(reinterpret_cast<const unsigned char*>(utf8))
+        , m_length(len)
+        , m_font(font)
+        , m_fallbackFont(font)
+        , m_currentFont(&m_font)
+        , m_spec(spec) {}
+
+    void consume() override {
+        uint32_t cp = decodeUtf8(m_text, m_length, m_pos);
+        if (m_font.unicharToGlyph(cp) != 0) {
+            m_currentFont = &m_font;
+        } else if (m_fallbackFont.getTypeface() != m_font.getTypeface() &&
+                   m_fallbackFont.unicharToGlyph(cp) != 0) {
+            m_currentFont = &m_fallbackFont;
+        } else {
+            sk_sp<SkTypeface> typeface = findFallback(cp);
+            if (typeface) {
+                m_fallbackFont.setTypeface(std::move(typeface));
+                m_currentFont = &m_fallbackFont;
+            } else {
+                m_currentFont = &m_font;
+            }
+        }
+
+        while (m_pos < m_length) {
+            size_t prev = m_pos;
+            cp = decodeUtf8(m_text, m_length, m_pos);
+
+            // 正在使用回退字体而主字体包含该字符：结束当前分段
+            if (m_currentFont != &m_font && m_font.unicharToGlyph(cp) != 0) {
+                m_pos = prev;
+                return;
+            }
+            // 当前字体缺字而其他字体包含：结束当前分段
+            if (m_currentFont->unicharToGlyph(cp) == 0 && findFallback(cp)) {
+                m_pos = prev;
+                return;
+            }
+        }
+    }
+
+    size_t endOfCurrentRun() const override { return m_pos; }
+    bool atEnd() const override { return m_pos >= m_length; }
+    const SkFont& currentFont() const override { return *m_currentFont; }
+
+private:
+    sk_sp<SkTypeface> findFallback(uint32_t cp) const {
+        return LiteFontManager::getInstance().matchFallbackTypeface(
+            m_spec.fontFamily, static_cast<SkUnichar>(cp), m_spec.weight, m_spec.style);
+    }
+
+    const unsigned char* m_text;
+    size_t m_length;
+    size_t m_pos = 0;
+    SkFont m_font;
+    SkFont m_fallbackFont;
+    const SkFont* m_currentFont;
+    const FontSpec& m_spec;
+};
+
+} // namespace
+
+// ==================== ShapedTextRunHandler ====================
+
+/**
+ * 收集 SkShaper 输出的字形，写入 LiteShapedText
+ */
+class ShapedTextRunHandler final : public SkShaper::RunHandler {
+public:
+    explicit ShapedTextRunHandler(LiteShapedText& out) : m_out(out) {}
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+
+    Buffer runBuffer(const RunInfo& info) override {
+        m_out.m_runs.emplace_back();
+        LiteShapedText::Run& run = m_out.m_runs.back();
+        run.font = info.fFont;
+        run.glyphs.resize(info.glyphCount);
+        run.positions.resize(info.glyphCount);
+        run.clusters.resize(info.glyphCount);
+        return {run.glyphs.data(), run.positions.data(), nullptr, run.clusters.data(), m_pen};
+    }
+
+    void commitRunBuffer(const RunInfo& info) override {
+        m_pen.fX += info.fAdvance.fX;
+    }
+
+    void commitLine() override {}
+
+    float getAdvance() const { return m_pen.fX; }
+
+private:
+    LiteShapedText& m_out;
+    SkPoint m_pen = {0, 0};
+};
+
+// ==================== LiteShapedText ====================
+
+void LiteShapedText::finish() {
+    // 行高按 skparagraph 的方式计算：上下各分摊一半 leading
+    m_ascent = 0.0f;
+    m_descent = 0.0f;
+    for (const auto& run : m_runs) {
+        SkFontMetrics metrics;
+        run.font.getMetrics(&metrics);
+        m_ascent = std::min(m_ascent, metrics.fAscent - metrics.fLeading / 2);
+        m_descent = std::max(m_descent, metrics.fDescent + metrics.fLeading / 2);
+    }
+
+    // 字形簇边界
+    m_clusterX.clear();
+    for (const auto& run : m_runs) {
+        for (size_t i = 0; i < run.glyphs.size(); i++) {
+            if (m_clusterX.empty() || m_clusterX.back().first != run.clusters[i]) {
+                m_clusterX.emplace_back(run.clusters[i], run.positions[i].fX);
+            }
+        }
+    }
+    std::stable_sort(m_clusterX.begin(), m_clusterX.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // 整行 blob
+    SkTextBlobBuilder builder;
+    for (const auto& run : m_runs) {
+        if (run.glyphs.empty()) continue;
+        const auto& buffer = builder.allocRunPos(run.font, static_cast<int>(run.glyphs.size()));
+        std::copy(run.glyphs.begin(), run.glyphs.end(), buffer.glyphs);
+        std::copy(run.positions.begin(), run.positions.end(), buffer.points());
+    }
+    m_blob = builder.make();
+}
+
+float LiteShapedText::getXForOffset(size_t byteOffset) const {
+    if (byteOffset >= m_textLength || m_clusterX.empty()) {
+        return byteOffset == 0 ? 0.0f : m_width;
+    }
+    auto it = std::upper_bound(m_clusterX.begin(), m_clusterX.end(), byteOffset,
+                               [](size_t offset, const auto& entry) { return offset < entry.first; });
+    if (it == m_clusterX.begin()) return 0.0f;
+    return std::prev(it)->second;
+}
+
+size_t LiteShapedText::getOffsetForX(float x) const {
+    if (m_clusterX.empty() || x <= 0) return 0;
+    if (x >= m_width) return m_textLength;
+
+    // 第一个起点不小于 x 的簇，与前一个簇比较中点
+    auto it = std::lower_bound(m_clusterX.begin(), m_clusterX.end(), x,
+                               [](const auto& entry, float value) { return entry.second < value; });
+    size_t nextOffset = (it == m_clusterX.end()) ? m_textLength : it->first;
+    float nextX = (it == m_clusterX.end()) ? m_width : it->second;
+    if (it == m_clusterX.begin()) return nextOffset;
+
+    auto prev = std::prev(it);
+    return (x < (prev->second + nextX) / 2) ? prev->first : nextOffset;
+}
+
+sk_sp<SkTextBlob> LiteShapedText::makeTruncatedBlob(float maxWidth, bool ellipsis,
+                                                    float* outWidth) const {
+    if (outWidth) *outWidth = 0.0f;
+    if (m_runs.empty() || maxWidth <= 0) return nullptr;
+
+    // 整行放得下时不截断，也不追加省略号
+    if (m_width <= maxWidth) {
+        if (outWidth) *outWidth = m_width;
+        return m_blob;
+    }
+
+    // 同一单元格每帧以相同宽度重绘，记住最近一次截断结果
+    {
+        std::lock_guard<std::mutex> lock(m_truncateMutex);
+        if (m_truncate.valid && m_truncate.maxWidth == maxWidth && m_truncate.ellipsis == ellipsis) {
+            if (outWidth) *outWidth = m_truncate.width;
+            return m_truncate.blob;
+        }
+    }
+
+    // 省略号字形：优先使用首个 run 的字体，不支持时退化为三个句点
+    SkFont ellipsisFont = m_runs.front().font;
+    SkGlyphID ellipsisGlyphs[3] = {0, 0, 0};
+    float ellipsisWidths[3] = {0, 0, 0};
+    int ellipsisCount = 0;
+    float ellipsisWidth = 0.0f;
+    if (ellipsis) {
+        ellipsisGlyphs[0] = ellipsisFont.unicharToGlyph(0x2026);
+        ellipsisCount = 1;
+        if (ellipsisGlyphs[0] == 0) {
+            SkGlyphID dot = ellipsisFont.unicharToGlyph('.');
+            ellipsisGlyphs[0] = ellipsisGlyphs[1] = ellipsisGlyphs[2] = dot;
+            ellipsisCount = 3;
+        }
+        ellipsisFont.getWidths(SkSpan<const SkGlyphID>(ellipsisGlyphs, ellipsisCount),
+                               SkSpan<SkScalar>(ellipsisWidths, ellipsisCount));
+        for (int i = 0; i < ellipsisCount; i++) ellipsisWidth += ellipsisWidths[i];
+    }
+
+    // 找到最后一个能放下的字形簇边界：Ellipsis 需为省略号留出宽度，Clip 保留所有放得下的字形
+    float reserved = ellipsis ? ellipsisWidth : 0.0f;
+    uint32_t cutCluster = 0;
+    float cutX = 0.0f;
+    for (const auto& entry : m_clusterX) {
+        if (entry.second + reserved > maxWidth) break;
+        cutCluster = entry.first;
+        cutX = entry.second;
+    }
+    if (cutCluster == 0 && reserved > maxWidth) return nullptr;
+
+    SkTextBlobBuilder builder;
+    for (const auto& run : m_runs) {
+        int count = 0;
+        while (count < static_cast<int>(run.glyphs.size()) && run.clusters[count] < cutCluster) {
+            count++;
+        }
+        if (count == 0) continue;
+        const auto& buffer = builder.allocRunPos(run.font, count);
+        std::copy(run.glyphs.begin(), run.glyphs.begin() + count, buffer.glyphs);
+        std::copy(run.positions.begin(), run.positions.begin() + count, buffer.points());
+    }
+
+    if (ellipsisCount > 0) {
+        const auto& buffer = builder.allocRunPosH(ellipsisFont, ellipsisCount, 0);
+        float x = cutX;
+        for (int i = 0; i < ellipsisCount; i++) {
+            buffer.glyphs[i] = ellipsisGlyphs[i];
+            buffer.pos[i] = x;
+            x += ellipsisWidths[i];
+        }
+    }
+
+    sk_sp<SkTextBlob> blob = builder.make();
+    float width = cutX + reserved;
+    {
+        std::lock_guard<std::mutex> lock(m_truncateMutex);
+        m_truncate = {true, maxWidth, ellipsis, width, blob};
+    }
+    if (outWidth) *outWidth = width;
+    return blob;
+}
+
+// ==================== LiteTextRenderer ====================
+
+LiteTextRenderer& LiteTextRenderer::getInstance() {
+    static LiteTextRenderer instance;
+    return instance;
+}
+
+SkFont LiteTextRenderer::makeFont(const FontSpec& spec) {
+    // 与 skparagraph 保持一致的字体设置，保证两条路径绘制效果相同
+    SkFont font = LiteFontManager::getInstance().createFont(spec);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setHinting(SkFontHinting::kSlight);
+    font.setSubpixel(true);
+    return font;
+}
+
+bool LiteTextRenderer::isSimpleText(const std::string& text) {
+    const auto* s = reinterpret_cast<const unsigned char*>(text.data());
+    size_t len = text.size();
+    size_t i = 0;
+    while (i < len) {
+        unsigned char c = s[i];
+        if (c < 0x80) {
+            // 控制字符（换行、制表等）交给段落排版
+            if (c < 0x20 || c == 0x7F) return false;
+            i++;
+            continue;
+        }
+        if (needsParagraphLayout(decodeUtf8(s, len, i))) return false;
+    }
+    return true;
+}
+
+LiteShapedTextPtr LiteTextRenderer::shape(const std::string& text, const FontSpec& font) {
+    CacheKey key{text, font};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_cache.find(key);
+        if (it != m_cache.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lruIt);
+            return it->second.shaped;
+        }
+    }
+
+    // 整形在锁外进行，允许多个线程并行整形不同文本
+    uint64_t generation = LiteFontManager::getInstance().getFontGeneration();
+    LiteShapedTextPtr shaped = shapeUncached(text, font);
+    if (!shaped) return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // 整形期间字体配置变化时缓存已被清空，不写回按旧字体整形的结果
+    if (generation != LiteFontManager::getInstance().getFontGeneration()) return shaped;
+    auto it = m_cache.find(key);
+    if (it != m_cache.end()) {
+        return it->second.shaped;
+    }
+    m_lru.push_front(key);
+    m_cache.emplace(std::move(key), CacheEntry{shaped, m_lru.begin()});
+    evictLocked();
+    return shaped;
+}
+
+LiteShapedTextPtr LiteTextRenderer::shapeUncached(const std::string& text, const FontSpec& spec) const {
+    auto shaped = std::make_shared<LiteShapedText>();
+    shaped->m_textLength = text.size();
+
+    SkFont font = makeFont(spec);
+    if (text.empty()) {
+        SkFontMetrics metrics;
+        font.getMetrics(&metrics);
+        shaped->m_ascent = metrics.fAscent - metrics.fLeading / 2;
+        shaped->m_descent = metrics.fDescent + metrics.fLeading / 2;
+        return shaped;
+    }
+
+    // SkShaper 实例不保证线程安全，每个线程持有一个
+    sk_sp<SkFontMgr> fontMgr = LiteFontManager::getInstance().getFontMgr();
+    thread_local std::unique_ptr<SkShaper> t_shaper;
+    thread_local sk_sp<SkFontMgr> t_shaperFontMgr;
+    if (!t_shaper || t_shaperFontMgr != fontMgr) {
+        t_shaper = SkShapers::HB::ShapeDontWrapOrReorder(SkUnicodes::ICU::Make(), fontMgr);
+        t_shaperFontMgr = fontMgr;
+    }
+    if (!t_shaper) return nullptr;
+
+    const char* utf8 = text.data();
+    size_t len = text.size();
+    CachedFallbackFontRunIterator fontRuns(utf8, len, font, spec);
+    SkShaper::TrivialBiDiRunIterator bidiRuns(0, len);
+    auto scriptRuns = SkShapers::HB::ScriptRunIterator(utf8, len);
+    auto languageRuns = SkShaper::MakeStdLanguageRunIterator(utf8, len);
+    if (!scriptRuns || !languageRuns) return nullptr;
+
+    ShapedTextRunHandler handler(*shaped);
+    t_shaper->shape(utf8, len, fontRuns, bidiRuns, *scriptRuns, *languageRuns,
+                    nullptr, 0, SK_ScalarMax, &handler);
+
+    shaped->m_width = handler.getAdvance();
+    shaped->finish();
+    if (shaped->m_runs.empty()) {
+        SkFontMetrics metrics;
+        font.getMetrics(&metrics);
+        shaped->m_ascent = metrics.fAscent - metrics.fLeading / 2;
+        shaped->m_descent = metrics.fDescent + metrics.fLeading / 2;
+    }
+    return shaped;
+}
+
+void LiteTextRenderer::evictLocked() {
+    while (m_cache.size() > m_capacity && !m_lru.empty()) {
+        m_cache.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+void LiteTextRenderer::setCacheCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = std::max<size_t>(capacity, 1);
+    evictLocked();
+}
+
+void LiteTextRenderer::clearCache() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.clear();
+    m_lru.clear();
+}
+
+bool LiteTextRenderer::drawLine(SkCanvas* canvas, const std::string& text, const FontSpec& font,
+                                const Color& color, float x, float top, float width,
+                                TextAlign align, LineOverflow overflow) {
+    if (text.empty()) return true;
+    if (!isSimpleText(text)) return false;
+
+    auto shaped = shape(text, font);
+    if (!shaped || !shaped->getBlob()) return false;
+
+    sk_sp<SkTextBlob> blob = shaped->getBlob();
+    float lineWidth = shaped->getWidth();
+    // 留半像素容差，避免浮点误差导致刚好放得下的文本被截断
+    if (lineWidth > width + 0.5f) {
+        if (overflow == LineOverflow::Reject) return false;
+        blob = shaped->makeTruncatedBlob(width, overflow == LineOverflow::Ellipsis, &lineWidth);
+        if (!blob) return true;
+    }
+
+    float offsetX = 0.0f;
+    if (align == TextAlign::Center) {
+        offsetX = std::max(0.0f, (width - lineWidth) / 2);
+    } else if (align == TextAlign::Right) {
+        offsetX = std::max(0.0f, width - lineWidth);
+    }
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(color.toARGB());
+    canvas->drawTextBlob(blob, x + offsetX, top + shaped->getBaseline(), paint);
+    return true;
+}
+
+void LiteTextRenderer::drawSingleLine(SkCanvas* canvas, const std::string& text, const FontSpec& font,
+                                      const Color& color, float x, float y, float w, float h,
+                                      TextAlign align, bool ellipsis) {
+    if (text.empty() || w <= 0) return;
+
+    if (isSimpleText(text)) {
+        auto shaped = shape(text, font);
+        if (shaped && shaped->getBlob()) {
+            float top = y + (h - shaped->getHeight()) / 2;
+            drawLine(canvas, text, font, color, x, top, w, align,
+                     ellipsis ? LineOverflow::Ellipsis : LineOverflow::Clip);
+            return;
+        }
+    }
+
+    // 回退：skparagraph 单行排版
+    using namespace skia::textlayout;
+    auto& fontMgr = LiteFontManager::getInstance();
+    ParagraphStyle paraStyle = fontMgr.createParagraphStyle(align);
+    paraStyle.setMaxLines(1);
+    if (ellipsis) {
+        paraStyle.setEllipsis(u"\u2026");
+    }
+    auto textStyle = fontMgr.createTextStyle(color, font.fontSize, font.fontFamily,
+                                             font.weight, font.style);
+
+    auto builder = ParagraphBuilder::make(paraStyle, fontMgr.getFontCollection());
+    builder->pushStyle(textStyle);
+    builder->addText(text.c_str());
+
+    auto paragraph = builder->Build();
+    paragraph->layout(w);
+    paragraph->paint(canvas, x, y + (h - paragraph->getHeight()) / 2);
+}
+
+} // namespace liteDui
@@ -0,0 +1,64 @@
+/**
+ * lite_keyed_diff.cpp - 按键比较新旧两组行实现
+ */
+
+#include "lite_keyed_diff.h"
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+namespace liteDui {
+
+std::vector<uint32_t> LiteKeyedDiff::targets() const {
+    std::vector<uint32_t> result(oldCount, kInserted);
+    for (size_t row = 0; row < sources.size(); ++row) {
+        if (sources[row] != kInserted) result[sources[row]] = static_cast<uint32_t>(row);
+    }
+    return result;
+}
+
+LiteKeyedDiff LiteKeyedDiff::compute(const std::vector<std::string>& oldKeys,
+                                     const std::vector<std::string>& newKeys) {
+    LiteKeyedDiff diff;
+    diff.oldCount = oldKeys.size();
+    diff.sources.assign(newKeys.size(), kInserted);
+
+    // 同键的旧行按行号串成链表，新行依次取链表头
+    std::unordered_map<std::string_view, uint32_t> heads;
+    heads.reserve(oldKeys.size());
+    std::vector<uint32_t> next(oldKeys.size(), kInserted);
+    for (size_t row = oldKeys.size(); row-- > 0;) {
+        auto result = heads.emplace(oldKeys[row], static_cast<uint32_t>(row));
+        if (!result.second) {
+            next[row] = result.first->second;
+            result.first->second = static_cast<uint32_t>(row);
+        }
+    }
+
+    size_t matched = 0;
+    for (size_t row = 0; row < newKeys.size(); ++row) {
+        auto it = heads.find(newKeys[row]);
+        if (it == heads.end() || it->second == kInserted) continue;
+        diff.sources[row] = it->second;
+        it->second = next[it->second];
+        ++matched;
+    }
+    diff.insertedCount = newKeys.size() - matched;
+    diff.removedCount = oldKeys.size() - matched;
+
+    // 按新顺序排列的旧行号的最长递增子序列保持原有相对顺序，其余保留行需要移动
+    std::vector<uint32_t> tails;
+    for (uint32_t source : diff.sources) {
+        if (source == kInserted) continue;
+        auto it = std::lower_bound(tails.begin(), tails.end(), source);
+        if (it == tails.end()) {
+            tails.push_back(source);
+        } else {
+            *it = source;
+        }
+    }
+    diff.movedCount = matched - tails.size();
+    return diff;
+}
+
+} // namespace liteDui
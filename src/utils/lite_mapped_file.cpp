@@ -0,0 +1,143 @@
+/**
+ * lite_mapped_file.cpp - 只读内存映射文件实现
+ */
+
+#include "lite_mapped_file.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace liteDui {
+
+// ==================== LiteMappedFile ====================
+
+LiteMappedFile::~LiteMappedFile() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mapping) CloseHandle(mapping);
+#else
+    if (data) munmap(const_cast<char*>(data), static_cast<size_t>(size));
+#endif
+}
+
+void LiteMappedFile::adviseSequential() const {
+#ifndef _WIN32
+    if (data) madvise(const_cast<char*>(data), static_cast<size_t>(size), MADV_SEQUENTIAL);
+#endif
+}
+
+void LiteMappedFile::release(uint64_t from, uint64_t to) const {
+#ifndef _WIN32
+    static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    uint64_t releaseBegin = from / pageSize * pageSize;
+    uint64_t releaseEnd = to / pageSize * pageSize;
+    if (data && releaseEnd > releaseBegin) {
+        madvise(const_cast<char*>(data) + releaseBegin, static_cast<size_t>(releaseEnd - releaseBegin),
+                MADV_DONTNEED);
+    }
+#else
+    (void)from;
+    (void)to;
+#endif
+}
+
+// ==================== LiteFileHandle ====================
+
+LiteFileHandle::~LiteFileHandle() {
+#ifdef _WIN32
+    if (m_handle != INVALID_HANDLE_VALUE) CloseHandle(m_handle);
+#else
+    if (m_fd >= 0) ::close(m_fd);
+#endif
+}
+
+bool LiteFileHandle::open(const std::string& path) {
+#ifdef _WIN32
+    m_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                           nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    return m_handle != INVALID_HANDLE_VALUE;
+#else
+    m_fd = ::open(path.c_str(), O_RDONLY);
+    return m_fd >= 0;
+#endif
+}
+
+uint64_t LiteFileHandle::querySize() const {
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_handle, &size)) return 0;
+    return static_cast<uint64_t>(size.QuadPart);
+#else
+    struct stat st;
+    if (fstat(m_fd, &st) != 0) return 0;
+    return static_cast<uint64_t>(st.st_size);
+#endif
+}
+
+size_t LiteFileHandle::read(uint64_t offset, char* buffer, size_t length) const {
+    size_t total = 0;
+#ifdef _WIN32
+    while (total < length) {
+        OVERLAPPED overlapped = {};
+        uint64_t position = offset + total;
+        overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+        DWORD request = static_cast<DWORD>(std::min<size_t>(length - total, 1u << 30));
+        DWORD got = 0;
+        if (!ReadFile(m_handle, buffer + total, request, &got, &overlapped) || got == 0) break;
+        total += got;
+    }
+#else
+    while (total < length) {
+        ssize_t got = ::pread(m_fd, buffer + total, length - total, static_cast<off_t>(offset + total));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        total += static_cast<size_t>(got);
+    }
+#endif
+    return total;
+}
+
+void LiteFileHandle::adviseSequential() const {
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+    if (m_fd >= 0) posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+std::shared_ptr<const LiteMappedFile> LiteFileHandle::map(uint64_t size) const {
+    auto mapped = std::make_shared<LiteMappedFile>();
+    if (size == 0) return mapped;
+#ifdef _WIN32
+    mapped->mapping = CreateFileMappingA(m_handle, nullptr, PAGE_READONLY, static_cast<DWORD>(size >> 32),
+                                         static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+    if (!mapped->mapping) return nullptr;
+    void* view = MapViewOfFile(mapped->mapping, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(size));
+    if (!view) return nullptr;
+    mapped->data = static_cast<const char*>(view);
+#else
+    void* view = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, m_fd, 0);
+    if (view == MAP_FAILED) return nullptr;
+    mapped->data = static_cast<const char*>(view);
+#endif
+    mapped->size = size;
+    return mapped;
+}
+
+std::shared_ptr<const LiteMappedFile> LiteFileHandle::mapFile(const std::string& path) {
+    LiteFileHandle file;
+    if (!file.open(path)) return nullptr;
+    return file.map(file.querySize());
+}
+
+} // namespace liteDui
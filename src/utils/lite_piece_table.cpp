@@ -0,0 +1,218 @@
+/**
+ * lite_piece_table.cpp - 分片表文本缓冲区实现
+ */
+
+#include "lite_piece_table.h"
+#include <algorithm>
+#include <cstring>
+
+namespace liteDui {
+
+namespace {
+
+// 把 text 中的换行符位置（加上 base）追加到 out
+void collectLineBreaks(const char* text, size_t length, size_t base, std::vector<size_t>& out) {
+    const char* p = text;
+    const char* end = text + length;
+    while (p < end) {
+        const void* hit = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        if (!hit) break;
+        const char* nl = static_cast<const char*>(hit);
+        out.push_back(base + static_cast<size_t>(nl - text));
+        p = nl + 1;
+    }
+}
+
+} // namespace
+
+LitePieceTable::LitePieceTable() {
+    rebuildPrefix();
+}
+
+LitePieceTable::LitePieceTable(std::string text) {
+    setText(std::move(text));
+}
+
+void LitePieceTable::setText(std::string text) {
+    m_original.text = std::move(text);
+    m_original.lineBreaks.clear();
+    collectLineBreaks(m_original.text.data(), m_original.text.size(), 0, m_original.lineBreaks);
+
+    m_add.text.clear();
+    m_add.lineBreaks.clear();
+
+    m_pieces.clear();
+    if (!m_original.text.empty()) {
+        m_pieces.push_back({Source::Original, 0, m_original.text.size(), m_original.lineBreaks.size()});
+    }
+    m_length = m_original.text.size();
+    m_lineBreaks = m_original.lineBreaks.size();
+    rebuildPrefix();
+}
+
+size_t LitePieceTable::countBufferBreaks(Source source, size_t start, size_t length) const {
+    const auto& breaks = buffer(source).lineBreaks;
+    auto first = std::lower_bound(breaks.begin(), breaks.end(), start);
+    auto last = std::lower_bound(first, breaks.end(), start + length);
+    return static_cast<size_t>(last - first);
+}
+
+void LitePieceTable::rebuildPrefix() {
+    m_pieceOffsets.resize(m_pieces.size());
+    m_pieceLineBreaks.resize(m_pieces.size());
+    size_t offset = 0;
+    size_t breaks = 0;
+    for (size_t i = 0; i < m_pieces.size(); i++) {
+        m_pieceOffsets[i] = offset;
+        m_pieceLineBreaks[i] = breaks;
+        offset += m_pieces[i].length;
+        breaks += m_pieces[i].lineBreaks;
+    }
+}
+
+size_t LitePieceTable::findPiece(size_t offset, size_t* pieceOffset) const {
+    if (offset >= m_length || m_pieces.empty()) {
+        if (pieceOffset) *pieceOffset = m_length;
+        return m_pieces.size();
+    }
+    auto it = std::upper_bound(m_pieceOffsets.begin(), m_pieceOffsets.end(), offset);
+    size_t index = static_cast<size_t>(it - m_pieceOffsets.begin()) - 1;
+    if (pieceOffset) *pieceOffset = m_pieceOffsets[index];
+    return index;
+}
+
+size_t LitePieceTable::splitAt(size_t offset) {
+    size_t pieceOffset = 0;
+    size_t index = findPiece(offset, &pieceOffset);
+    if (index >= m_pieces.size() || pieceOffset == offset) {
+        return index;
+    }
+
+    Piece& left = m_pieces[index];
+    size_t leftLength = offset - pieceOffset;
+    Piece right{left.source, left.start + leftLength, left.length - leftLength, 0};
+    right.lineBreaks = countBufferBreaks(right.source, right.start, right.length);
+    left.length = leftLength;
+    left.lineBreaks -= right.lineBreaks;
+
+    m_pieces.insert(m_pieces.begin() + index + 1, right);
+    rebuildPrefix();
+    return index + 1;
+}
+
+size_t LitePieceTable::getLineStart(size_t line) const {
+    if (line == 0) return 0;
+    if (line > m_lineBreaks) return m_length;
+
+    // 第 line 个换行符（从 1 计）所在的片段
+    auto it = std::upper_bound(m_pieceLineBreaks.begin(), m_pieceLineBreaks.end(), line - 1);
+    size_t index = static_cast<size_t>(it - m_pieceLineBreaks.begin()) - 1;
+    const Piece& piece = m_pieces[index];
+    size_t localIndex = line - 1 - m_pieceLineBreaks[index];
+
+    const auto& breaks = buffer(piece.source).lineBreaks;
+    auto first = std::lower_bound(breaks.begin(), breaks.end(), piece.start);
+    size_t breakPos = *(first + static_cast<std::ptrdiff_t>(localIndex));
+    return m_pieceOffsets[index] + (breakPos - piece.start) + 1;
+}
+
+size_t LitePieceTable::getLineLength(size_t line) const {
+    size_t start = getLineStart(line);
+    size_t end = (line < m_lineBreaks) ? getLineStart(line + 1) - 1 : m_length;
+    return end > start ? end - start : 0;
+}
+
+size_t LitePieceTable::getLineAt(size_t offset) const {
+    size_t pieceOffset = 0;
+    size_t index = findPiece(offset, &pieceOffset);
+    if (index >= m_pieces.size()) return m_lineBreaks;
+
+    const Piece& piece = m_pieces[index];
+    return m_pieceLineBreaks[index] + countBufferBreaks(piece.source, piece.start, offset - pieceOffset);
+}
+
+std::string LitePieceTable::getLine(size_t line) const {
+    return getText(getLineStart(line), getLineLength(line));
+}
+
+std::string LitePieceTable::getText(size_t offset, size_t count) const {
+    std::string result;
+    if (offset >= m_length || count == 0) return result;
+    count = std::min(count, m_length - offset);
+    result.reserve(count);
+
+    size_t pieceOffset = 0;
+    size_t index = findPiece(offset, &pieceOffset);
+    size_t skip = offset - pieceOffset;
+    for (; index < m_pieces.size() && result.size() < count; index++) {
+        const Piece& piece = m_pieces[index];
+        size_t take = std::min(piece.length - skip, count - result.size());
+        result.append(buffer(piece.source).text, piece.start + skip, take);
+        skip = 0;
+    }
+    return result;
+}
+
+void LitePieceTable::insert(size_t offset, const std::string& text) {
+    if (text.empty()) return;
+    offset = std::min(offset, m_length);
+
+    size_t addStart = m_add.text.size();
+    m_add.text.append(text);
+    size_t breaksBefore = m_add.lineBreaks.size();
+    collectLineBreaks(text.data(), text.size(), addStart, m_add.lineBreaks);
+    size_t breaks = m_add.lineBreaks.size() - breaksBefore;
+
+    m_length += text.size();
+    m_lineBreaks += breaks;
+
+    // 连续输入：插入点正好是上一次追加片段的末尾时直接延长该片段
+    if (offset > 0) {
+        size_t prevOffset = 0;
+        size_t prevIndex = findPiece(offset - 1, &prevOffset);
+        if (prevIndex < m_pieces.size()) {
+            Piece& prev = m_pieces[prevIndex];
+            if (prev.source == Source::Add && prev.start + prev.length == addStart &&
+                prevOffset + prev.length == offset) {
+                prev.length += text.size();
+                prev.lineBreaks += breaks;
+                rebuildPrefix();
+                return;
+            }
+        }
+    }
+
+    // findPiece 依赖旧长度，切分前先临时还原
+    m_length -= text.size();
+    size_t index = splitAt(offset);
+    m_length += text.size();
+
+    m_pieces.insert(m_pieces.begin() + index, Piece{Source::Add, addStart, text.size(), breaks});
+    rebuildPrefix();
+}
+
+void LitePieceTable::erase(size_t offset, size_t count) {
+    if (offset >= m_length || count == 0) return;
+    count = std::min(count, m_length - offset);
+
+    size_t first = splitAt(offset);
+    size_t last = splitAt(offset + count);
+
+    size_t removedBreaks = 0;
+    for (size_t i = first; i < last; i++) {
+        removedBreaks += m_pieces[i].lineBreaks;
+    }
+    m_pieces.erase(m_pieces.begin() + first, m_pieces.begin() + last);
+
+    m_length -= count;
+    m_lineBreaks -= removedBreaks;
+    rebuildPrefix();
+}
+
+size_t LitePieceTable::countLineBreaks(size_t offset, size_t count) const {
+    offset = std::min(offset, m_length);
+    count = std::min(count, m_length - offset);
+    return getLineAt(offset + count) - getLineAt(offset);
+}
+
+} // namespace liteDui
@@ -0,0 +1,221 @@
+/**
+ * lite_row_heights.cpp - 可变行高偏移索引实现
+ */
+
+#include "lite_row_heights.h"
+#include <algorithm>
+#include <cmath>
+
+namespace liteDui {
+
+namespace {
+
+size_t lowBit(size_t i) {
+    return i & (~i + 1);
+}
+
+size_t highestPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p <= n / 2) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+void LiteRowHeights::reset(size_t count) {
+    m_count = count;
+    m_heights.clear();
+    m_heights.shrink_to_fit();
+    m_measured = 0;
+    m_heightTree.clear();
+    m_countTree.clear();
+    m_treeDirty = false;
+}
+
+void LiteRowHeights::assign(std::vector<float> heights) {
+    m_count = heights.size();
+    m_measured = 0;
+    for (auto& height : heights) {
+        if (height > 0) {
+            ++m_measured;
+        } else {
+            height = 0;
+        }
+    }
+    if (m_measured == 0) {
+        reset(m_count);
+        return;
+    }
+    m_heights = std::move(heights);
+    m_treeDirty = true;
+}
+
+// ==================== 单行 ====================
+
+void LiteRowHeights::setHeight(size_t row, float height) {
+    if (row >= m_count) return;
+    if (!(height > 0)) height = 0;
+
+    if (m_heights.empty()) {
+        if (height == 0) return;
+        // 第一次出现已测量行：分配数组，树在下一次查询时建立
+        m_heights.assign(m_count, 0.0f);
+        m_treeDirty = true;
+    }
+
+    float old = m_heights[row];
+    if (old == height) return;
+    m_heights[row] = height;
+
+    int32_t countDelta = (height > 0 ? 1 : 0) - (old > 0 ? 1 : 0);
+    m_measured = static_cast<size_t>(static_cast<long long>(m_measured) + countDelta);
+    if (!m_treeDirty) {
+        addToTree(row, static_cast<double>(height) - old, countDelta);
+    }
+}
+
+float LiteRowHeights::getHeight(size_t row) const {
+    if (row >= m_count) return 0;
+    if (!m_heights.empty() && m_heights[row] > 0) return m_heights[row];
+    return m_estimate;
+}
+
+bool LiteRowHeights::isMeasured(size_t row) const {
+    return row < m_heights.size() && m_heights[row] > 0;
+}
+
+// ==================== 偏移 ====================
+
+float LiteRowHeights::getOffset(size_t row) const {
+    row = std::min(row, m_count);
+    if (m_measured == 0) {
+        return static_cast<float>(static_cast<double>(row) * m_estimate);
+    }
+
+    ensureTree();
+    double height = 0;
+    long long measured = 0;
+    for (size_t i = row; i > 0; i -= lowBit(i)) {
+        height += m_heightTree[i];
+        measured += m_countTree[i];
+    }
+    return static_cast<float>(height + static_cast<double>(static_cast<long long>(row) - measured) * m_estimate);
+}
+
+size_t LiteRowHeights::getRowAt(float y) const {
+    if (m_count == 0 || y < 0) return 0;
+    if (m_measured == 0) {
+        if (m_estimate <= 0) return m_count;
+        return std::min(static_cast<size_t>(std::floor(y / m_estimate)), m_count);
+    }
+
+    // 在 Fenwick 树上自顶向下查找：跳过总高度不超过剩余偏移的整段
+    ensureTree();
+    size_t pos = 0;
+    double remaining = y;
+    for (size_t step = highestPowerOfTwo(m_count); step > 0; step >>= 1) {
+        size_t next = pos + step;
+        if (next > m_count) continue;
+        double span = m_heightTree[next] + static_cast<double>(static_cast<long long>(step) - m_countTree[next]) * m_estimate;
+        if (span <= remaining) {
+            remaining -= span;
+            pos = next;
+        }
+    }
+    return pos;
+}
+
+// ==================== 行变化 ====================
+
+void LiteRowHeights::insertRows(size_t index, size_t count) {
+    if (count == 0) return;
+    index = std::min(index, m_count);
+    m_count += count;
+    if (!m_heights.empty()) {
+        m_heights.insert(m_heights.begin() + index, count, 0.0f);
+        updateTreeFrom(index);
+    }
+}
+
+void LiteRowHeights::removeRows(size_t index, size_t count) {
+    if (index >= m_count || count == 0) return;
+    count = std::min(count, m_count - index);
+    m_count -= count;
+    if (m_heights.empty()) return;
+
+    auto begin = m_heights.begin() + index;
+    auto end = begin + count;
+    m_measured -= static_cast<size_t>(std::count_if(begin, end, [](float height) { return height > 0; }));
+    m_heights.erase(begin, end);
+    if (m_measured == 0) {
+        reset(m_count);
+    } else {
+        updateTreeFrom(index);
+    }
+}
+
+// ==================== Fenwick 树 ====================
+
+void LiteRowHeights::ensureTree() const {
+    if (!m_treeDirty) return;
+
+    // O(n) 建树：每个节点把自己的和加到父节点
+    m_heightTree.assign(m_count + 1, 0.0);
+    m_countTree.assign(m_count + 1, 0);
+    for (size_t i = 1; i <= m_count; ++i) {
+        float height = m_heights[i - 1];
+        if (height > 0) {
+            m_heightTree[i] += height;
+            m_countTree[i] += 1;
+        }
+        size_t parent = i + lowBit(i);
+        if (parent <= m_count) {
+            m_heightTree[parent] += m_heightTree[i];
+            m_countTree[parent] += m_countTree[i];
+        }
+    }
+    m_treeDirty = false;
+}
+
+void LiteRowHeights::updateTreeFrom(size_t index) {
+    // 前 index 行对应的节点不受影响：截断到 index 后逐节点补齐；
+    // 需要补齐的行过多时与整体重建代价相当，改为在下一次查询时重建
+    if (m_treeDirty || m_heightTree.size() < index + 1 || m_count - index > m_count / 16) {
+        m_treeDirty = true;
+        return;
+    }
+    m_heightTree.resize(index + 1);
+    m_countTree.resize(index + 1);
+    extendTree(index);
+}
+
+void LiteRowHeights::extendTree(size_t from) const {
+    // 节点 i 覆盖 (i - lowBit(i), i]：第 i 行加上已有的子节点，每个节点 O(log n)
+    m_heightTree.resize(m_count + 1, 0.0);
+    m_countTree.resize(m_count + 1, 0);
+    for (size_t i = from + 1; i <= m_count; ++i) {
+        float height = m_heights[i - 1];
+        double sum = height > 0 ? height : 0.0;
+        int32_t count = height > 0 ? 1 : 0;
+        size_t first = i - lowBit(i);
+        for (size_t child = i - 1; child > first; child -= lowBit(child)) {
+            sum += m_heightTree[child];
+            count += m_countTree[child];
+        }
+        m_heightTree[i] = sum;
+        m_countTree[i] = count;
+    }
+}
+
+void LiteRowHeights::addToTree(size_t row, double height, int32_t count) {
+    if (m_heightTree.size() != m_count + 1) {
+        m_treeDirty = true;
+        return;
+    }
+    for (size_t i = row + 1; i <= m_count; i += lowBit(i)) {
+        m_heightTree[i] += height;
+        m_countTree[i] += count;
+    }
+}
+
+} // namespace liteDui
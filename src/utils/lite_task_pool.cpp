@@ -0,0 +1,75 @@
+/**
+ * lite_task_pool.cpp - 后台任务线程池实现
+ */
+
+#include "lite_task_pool.h"
+#include <algorithm>
+
+namespace liteDui {
+
+LiteTaskPool& LiteTaskPool::getInstance() {
+    static LiteTaskPool instance;
+    return instance;
+}
+
+LiteTaskPool::LiteTaskPool() {
+    // 给 UI 线程留出一个核心；预取类任务不需要太多线程
+    unsigned hardware = std::thread::hardware_concurrency();
+    size_t count = std::min<size_t>(std::max<unsigned>(hardware, 2) - 1, 4);
+    m_workers.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+LiteTaskPool::~LiteTaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+    }
+    m_cv.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void LiteTaskPool::submit(uint64_t group, Task task) {
+    if (!task) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop) return;
+        m_queue.push_back(Entry{group, std::move(task)});
+    }
+    m_cv.notify_one();
+}
+
+size_t LiteTaskPool::cancel(uint64_t group) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t before = m_queue.size();
+    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(),
+                                 [group](const Entry& entry) { return entry.group == group; }),
+                  m_queue.end());
+    return before - m_queue.size();
+}
+
+size_t LiteTaskPool::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+void LiteTaskPool::workerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+            task = std::move(m_queue.front().task);
+            m_queue.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace liteDui
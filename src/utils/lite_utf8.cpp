@@ -3,9 +3,214 @@
  */
 
 #include "lite_utf8.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LITE_UTF8_SSE2 1
+#include <immintrin.h>
+#endif
+
+// AVX2：GCC/Clang 通过 target 属性编译并在运行时检测，MSVC 需要 /arch:AVX2
+#if defined(LITE_UTF8_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define LITE_UTF8_AVX2 1
+#define LITE_UTF8_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(LITE_UTF8_SSE2) && defined(__AVX2__)
+#define LITE_UTF8_AVX2 1
+#define LITE_UTF8_AVX2_TARGET
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
 
 namespace liteDui {
 
+namespace {
+
+inline int popcount32(uint32_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(v);
+#else
+    v = v - ((v >> 1) & 0x55555555u);
+    v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+    return static_cast<int>((((v + (v >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+#endif
+}
+
+inline int countTrailingZeros32(uint32_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(v);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return static_cast<int>(index);
+#else
+    int n = 0;
+    while (!(v & 1u)) { v >>= 1; ++n; }
+    return n;
+#endif
+}
+
+// ==================== 标量实现 ====================
+// 三个基础内核：ASCII 前缀长度、首字节（非续字节）计数、4 字节首字节计数
+
+size_t asciiPrefixScalar(const char* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (static_cast<unsigned char>(data[i]) & 0x80) return i;
+    }
+    return length;
+}
+
+size_t countLeadsScalar(const char* data, size_t length) {
+    size_t count = 0;
+    for (size_t i = 0; i < length; ++i) {
+        count += (static_cast<unsigned char>(data[i]) & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+size_t countFourByteLeadsScalar(const char* data, size_t length) {
+    size_t count = 0;
+    for (size_t i = 0; i < length; ++i) {
+        count += (static_cast<unsigned char>(data[i]) & 0xF8) == 0xF0;
+    }
+    return count;
+}
+
+#ifdef LITE_UTF8_SSE2
+// ==================== SSE2 实现 ====================
+
+size_t asciiPrefixSse2(const char* data, size_t length) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(v));
+        if (mask) return i + countTrailingZeros32(mask);
+    }
+    return i + asciiPrefixScalar(data + i, length - i);
+}
+
+size_t countLeadsSse2(const char* data, size_t length) {
+    // 续字节 0x80~0xBF 按有符号数为 -128~-65，其余字节均大于 -65
+    const __m128i threshold = _mm_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        count += popcount32(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, threshold))));
+    }
+    return count + countLeadsScalar(data + i, length - i);
+}
+
+size_t countFourByteLeadsSse2(const char* data, size_t length) {
+    // 0xF0 <= b <= 0xF7（无符号比较用 max/min 实现）
+    const __m128i low = _mm_set1_epi8(static_cast<char>(0xF0));
+    const __m128i high = _mm_set1_epi8(static_cast<char>(0xF7));
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i geLow = _mm_cmpeq_epi8(_mm_max_epu8(v, low), v);
+        __m128i leHigh = _mm_cmpeq_epi8(_mm_min_epu8(v, high), v);
+        count += popcount32(static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(geLow, leHigh))));
+    }
+    return count + countFourByteLeadsScalar(data + i, length - i);
+}
+#endif
+
+#ifdef LITE_UTF8_AVX2
+// ==================== AVX2 实现 ====================
+
+LITE_UTF8_AVX2_TARGET size_t asciiPrefixAvx2(const char* data, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+        if (mask) return i + countTrailingZeros32(mask);
+    }
+    return i + asciiPrefixSse2(data + i, length - i);
+}
+
+LITE_UTF8_AVX2_TARGET size_t countLeadsAvx2(const char* data, size_t length) {
+    const __m256i threshold = _mm256_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        count += popcount32(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, threshold))));
+    }
+    return count + countLeadsSse2(data + i, length - i);
+}
+
+LITE_UTF8_AVX2_TARGET size_t countFourByteLeadsAvx2(const char* data, size_t length) {
+    const __m256i low = _mm256_set1_epi8(static_cast<char>(0xF0));
+    const __m256i high = _mm256_set1_epi8(static_cast<char>(0xF7));
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i geLow = _mm256_cmpeq_epi8(_mm256_max_epu8(v, low), v);
+        __m256i leHigh = _mm256_cmpeq_epi8(_mm256_min_epu8(v, high), v);
+        count += popcount32(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(geLow, leHigh))));
+    }
+    return count + countFourByteLeadsSse2(data + i, length - i);
+}
+#endif
+
+struct Utf8Kernels {
+    size_t (*asciiPrefix)(const char*, size_t);
+    size_t (*countLeads)(const char*, size_t);
+    size_t (*countFourByteLeads)(const char*, size_t);
+};
+
+Utf8Kernels selectKernels() {
+#if defined(LITE_UTF8_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx2")) {
+        return {asciiPrefixAvx2, countLeadsAvx2, countFourByteLeadsAvx2};
+    }
+#elif defined(LITE_UTF8_AVX2)
+    return {asciiPrefixAvx2, countLeadsAvx2, countFourByteLeadsAvx2};
+#endif
+#ifdef LITE_UTF8_SSE2
+    return {asciiPrefixSse2, countLeadsSse2, countFourByteLeadsSse2};
+#else
+    return {asciiPrefixScalar, countLeadsScalar, countFourByteLeadsScalar};
+#endif
+}
+
+// 运行时只选择一次
+const Utf8Kernels& kernels() {
+    static const Utf8Kernels selected = selectKernels();
+    return selected;
+}
+
+// 校验从 data[0] 开始的一个非 ASCII 字符，返回其字节数，非法时返回 0
+size_t validateSequence(const unsigned char* data, size_t remaining) {
+    unsigned char c = data[0];
+    size_t length;
+    uint32_t minCodepoint;
+    uint32_t codepoint;
+    if (c >= 0xC2 && c <= 0xDF) {
+        length = 2; minCodepoint = 0x80; codepoint = c & 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+        length = 3; minCodepoint = 0x800; codepoint = c & 0x0F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        length = 4; minCodepoint = 0x10000; codepoint = c & 0x07;
+    } else {
+        return 0;   // 续字节、0xC0/0xC1 过长编码或 0xF5 以上
+    }
+    if (remaining < length) return 0;
+    for (size_t k = 1; k < length; ++k) {
+        if ((data[k] & 0xC0) != 0x80) return 0;
+        codepoint = (codepoint << 6) | (data[k] & 0x3F);
+    }
+    if (codepoint < minCodepoint || codepoint > 0x10FFFF) return 0;
+    if (codepoint >= 0xD800 && codepoint <= 0xDFFF) return 0;
+    return length;
+}
+
+} // namespace
+
 std::vector<Utf8Helper::CodePointInfo> Utf8Helper::toCodePoints(const std::string& text) {
     std::vector<CodePointInfo> result;
     size_t i = 0;
@@ -67,15 +272,15 @@ std::vector<Utf8Helper::CodePointInfo> Utf8Helper::toCodePoints(const std::strin
 }
 
 int Utf8Helper::byteToCodePointIndex(const std::vector<CodePointInfo>& codePoints, int bytePos) {
-    for (size_t i = 0; i < codePoints.size(); ++i) {
-        if (codePoints[i].byteOffset == bytePos) {
-            return static_cast<int>(i);
-        }
-        if (codePoints[i].byteOffset > bytePos) {
-            return static_cast<int>(i > 0 ? i - 1 : 0);
-        }
+    // 码点按字节偏移递增，二分查找第一个起点大于 bytePos 的码点
+    auto it = std::upper_bound(codePoints.begin(), codePoints.end(), bytePos,
+                               [](int pos, const CodePointInfo& info) { return pos < info.byteOffset; });
+    size_t index = static_cast<size_t>(it - codePoints.begin());
+    if (index == codePoints.size()) {
+        bool exact = !codePoints.empty() && codePoints.back().byteOffset == bytePos;
+        return static_cast<int>(exact ? index - 1 : index);
     }
-    return static_cast<int>(codePoints.size());
+    return static_cast<int>(index > 0 ? index - 1 : 0);
 }
 
 int Utf8Helper::codePointIndexToByte(const std::vector<CodePointInfo>& codePoints, int cpIndex, int textLength) {
@@ -87,37 +292,23 @@ int Utf8Helper::codePointIndexToByte(const std::vector<CodePointInfo>& codePoint
 int Utf8Helper::getPrevCharPos(const std::string& text, int pos) {
     if (pos <= 0 || text.empty()) return 0;
     
-    auto codePoints = toCodePoints(text);
-    if (codePoints.empty()) return 0;
-    
-    // 找到当前位置对应的码点索引
-    int cpIndex = byteToCodePointIndex(codePoints, pos);
-    
-    // 移动到前一个码点
-    if (cpIndex > 0) {
-        cpIndex--;
+    // 向前跳过续字节（最多 3 个）即为前一个字符的起点
+    int i = std::min(pos, static_cast<int>(text.length())) - 1;
+    int limit = std::max(0, i - 3);
+    while (i > limit && isContinuationByte(static_cast<unsigned char>(text[i]))) {
+        --i;
     }
-    
-    // 返回前一个码点的字节位置
-    return codePointIndexToByte(codePoints, cpIndex, static_cast<int>(text.length()));
+    return i;
 }
 
 int Utf8Helper::getNextCharPos(const std::string& text, int pos) {
-    if (pos >= static_cast<int>(text.length()) || text.empty()) {
-        return static_cast<int>(text.length());
+    int length = static_cast<int>(text.length());
+    if (pos >= length || text.empty()) {
+        return length;
     }
+    if (pos < 0) return 0;
     
-    auto codePoints = toCodePoints(text);
-    if (codePoints.empty()) return static_cast<int>(text.length());
-    
-    // 找到当前位置对应的码点索引
-    int cpIndex = byteToCodePointIndex(codePoints, pos);
-    
-    // 移动到下一个码点
-    cpIndex++;
-    
-    // 返回下一个码点的字节位置
-    return codePointIndexToByte(codePoints, cpIndex, static_cast<int>(text.length()));
+    return std::min(pos + getCharByteLength(static_cast<unsigned char>(text[pos])), length);
 }
 
 std::string Utf8Helper::codepointToUtf8(uint32_t codepoint) {
@@ -143,7 +334,7 @@ std::string Utf8Helper::codepointToUtf8(uint32_t codepoint) {
 }
 
 int Utf8Helper::getCharCount(const std::string& text) {
-    return static_cast<int>(toCodePoints(text).size());
+    return static_cast<int>(countCodePoints(text.data(), text.size()));
 }
 
 bool Utf8Helper::isContinuationByte(unsigned char c) {
@@ -159,55 +350,125 @@ int Utf8Helper::getCharByteLength(unsigned char c) {
 }
 
 int Utf8Helper::utf8ByteToUtf16Index(const std::string& text, int bytePos) {
-    int utf16Index = 0;
-    int i = 0;
-    
-    while (i < bytePos && i < static_cast<int>(text.length())) {
-        unsigned char c = text[i];
-        int charBytes = getCharByteLength(c);
-        
-        // 解码当前字符的码点
-        uint32_t codepoint = 0;
-        if ((c & 0x80) == 0) {
-            // ASCII: 1 字节
-            codepoint = c;
-        } else if ((c & 0xE0) == 0xC0) {
-            // 2 字节
-            codepoint = (c & 0x1F) << 6;
-            if (i + 1 < static_cast<int>(text.length())) {
-                codepoint |= (text[i + 1] & 0x3F);
-            }
-        } else if ((c & 0xF0) == 0xE0) {
-            // 3 字节
-            codepoint = (c & 0x0F) << 12;
-            if (i + 1 < static_cast<int>(text.length())) {
-                codepoint |= (text[i + 1] & 0x3F) << 6;
-            }
-            if (i + 2 < static_cast<int>(text.length())) {
-                codepoint |= (text[i + 2] & 0x3F);
-            }
-        } else if ((c & 0xF8) == 0xF0) {
-            // 4 字节
-            codepoint = (c & 0x07) << 18;
-            if (i + 1 < static_cast<int>(text.length())) {
-                codepoint |= (text[i + 1] & 0x3F) << 12;
-            }
-            if (i + 2 < static_cast<int>(text.length())) {
-                codepoint |= (text[i + 2] & 0x3F) << 6;
-            }
-            if (i + 3 < static_cast<int>(text.length())) {
-                codepoint |= (text[i + 3] & 0x3F);
-            }
-        }
-        
-        // 码点 >= 0x10000 需要 2 个 UTF-16 代码单元 (surrogate pair)
-        // 否则只需要 1 个 UTF-16 代码单元
-        utf16Index += (codepoint >= 0x10000) ? 2 : 1;
-        
-        i += charBytes;
+    if (bytePos <= 0) return 0;
+    size_t length = std::min(static_cast<size_t>(bytePos), text.length());
+    return static_cast<int>(utf16Length(text.data(), length));
+}
+
+bool Utf8Helper::validate(const char* data, size_t length) {
+    const auto& k = kernels();
+    size_t i = 0;
+    while (i < length) {
+        i += k.asciiPrefix(data + i, length - i);
+        if (i >= length) break;
+        size_t n = validateSequence(reinterpret_cast<const unsigned char*>(data + i), length - i);
+        if (n == 0) return false;
+        i += n;
     }
-    
-    return utf16Index;
+    return true;
+}
+
+size_t Utf8Helper::countCodePoints(const char* data, size_t length) {
+    return kernels().countLeads(data, length);
+}
+
+size_t Utf8Helper::utf16Length(const char* data, size_t length) {
+    // 每个码点至少 1 个代码单元，4 字节字符（U+10000 以上）再多 1 个
+    const auto& k = kernels();
+    return k.countLeads(data, length) + k.countFourByteLeads(data, length);
+}
+
+// ==================== Utf8OffsetIndex ====================
+
+void Utf8OffsetIndex::clear() {
+    m_entries.clear();
+    m_byteLength = 0;
+    m_codePointCount = 0;
+    m_utf16Length = 0;
+}
+
+void Utf8OffsetIndex::build(const char* data, size_t length) {
+    m_entries.clear();   // 保留容量，重复构建不重新分配
+    m_byteLength = length;
+
+    const auto& k = kernels();
+    size_t cp = 0;
+    size_t u16 = 0;
+    size_t i = 0;
+    while (i < length) {
+        // ASCII 段三种偏移同步增长，不需要记录
+        size_t ascii = k.asciiPrefix(data + i, length - i);
+        i += ascii;
+        cp += ascii;
+        u16 += ascii;
+        if (i >= length) break;
+
+        // 与 toCodePoints 一致：非法首字节按单字节字符处理，末尾截断的字符按剩余长度处理
+        size_t charLength = static_cast<size_t>(
+            Utf8Helper::getCharByteLength(static_cast<unsigned char>(data[i])));
+        charLength = std::min(charLength, length - i);
+        m_entries.push_back({static_cast<uint32_t>(i), static_cast<uint32_t>(cp),
+                             static_cast<uint32_t>(u16), static_cast<uint32_t>(charLength)});
+        i += charLength;
+        cp += 1;
+        u16 += (charLength == 4) ? 2 : 1;
+    }
+    m_codePointCount = cp;
+    m_utf16Length = u16;
+}
+
+template <uint32_t Utf8OffsetIndex::Entry::*From, uint32_t Utf8OffsetIndex::Entry::*To>
+size_t Utf8OffsetIndex::convert(size_t key) const {
+    // 各坐标系下一个字符占用的跨度
+    auto span = [](const Entry& e, uint32_t Entry::*field) -> size_t {
+        if (field == &Entry::byteOffset) return e.byteLength;
+        if (field == &Entry::utf16Index) return e.byteLength == 4 ? 2 : 1;
+        return 1;
+    };
+    auto total = [this](uint32_t Entry::*field) -> size_t {
+        if (field == &Entry::byteOffset) return m_byteLength;
+        if (field == &Entry::utf16Index) return m_utf16Length;
+        return m_codePointCount;
+    };
+
+    if (key >= total(From)) return total(To);
+
+    auto it = std::upper_bound(m_entries.begin(), m_entries.end(), key,
+                               [](size_t value, const Entry& e) { return value < e.*From; });
+    if (it == m_entries.begin()) {
+        return key;   // 之前全是 ASCII
+    }
+
+    const Entry& e = *std::prev(it);
+    size_t fromEnd = e.*From + span(e, From);
+    if (key < fromEnd) {
+        return e.*To;   // 落在该字符内部，取字符起点
+    }
+    return e.*To + span(e, To) + (key - fromEnd);
+}
+
+size_t Utf8OffsetIndex::byteToCodePoint(size_t bytePos) const {
+    return convert<&Entry::byteOffset, &Entry::cpIndex>(bytePos);
+}
+
+size_t Utf8OffsetIndex::byteToUtf16(size_t bytePos) const {
+    return convert<&Entry::byteOffset, &Entry::utf16Index>(bytePos);
+}
+
+size_t Utf8OffsetIndex::codePointToByte(size_t cpIndex) const {
+    return convert<&Entry::cpIndex, &Entry::byteOffset>(cpIndex);
+}
+
+size_t Utf8OffsetIndex::codePointToUtf16(size_t cpIndex) const {
+    return convert<&Entry::cpIndex, &Entry::utf16Index>(cpIndex);
+}
+
+size_t Utf8OffsetIndex::utf16ToByte(size_t utf16Index) const {
+    return convert<&Entry::utf16Index, &Entry::byteOffset>(utf16Index);
+}
+
+size_t Utf8OffsetIndex::utf16ToCodePoint(size_t utf16Index) const {
+    return convert<&Entry::utf16Index, &Entry::cpIndex>(utf16Index);
 }
 
 } // namespace liteDui
@@ -6,6 +6,7 @@
 #include "lite_skia_renderer.h"
 #include "lite_container.h"
 #include "lite_tooltip.h"
+#include "lite_font_manager.h"
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <thread>
@@ -149,6 +150,11 @@ void LiteWindow::Render()
                 overlay->clearDirtyTree();
             }
         }
+        else
+        {
+            // 空闲帧：预先光栅化登记的字形，避免之后打开新界面时卡顿
+            skiaRenderer_->warmUpGlyphs(kIdleWarmUpBudgetMs);
+        }
     }
 }
 
@@ -489,6 +495,7 @@ void LiteWindow::MouseButtonCallback(GLFWwindow *window, int button, int action,
     liteDui::MouseEvent event(static_cast<float>(xpos), static_cast<float>(ypos), static_cast<liteDui::MouseButton>(button));
     event.pressed = (action == GLFW_PRESS);
     event.released = (action == GLFW_RELEASE);
+    event.mods = mods;
     
     // 优先处理 overlay 层
     if (win->hasOverlay()) {
@@ -560,7 +567,11 @@ void LiteWindow::CharCallback(GLFWwindow *window, unsigned int codepoint)
     }
 }
 
-LiteWindowManager::LiteWindowManager() : glfw_initialized_(false) {}
+LiteWindowManager::LiteWindowManager() : glfw_initialized_(false)
+{
+    // 字体初始化（fontconfig 扫描）与窗口、GL 初始化并行，首次绘制文本时才可能等待
+    LiteFontManager::startInitialization();
+}
 LiteWindowManager::~LiteWindowManager()
 {
     windows_.clear();